@@ -0,0 +1,79 @@
+//
+//  batch-issue-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Compares issuing licenses one by one with issuing them as Merkle batch (one RSA signature
+// per batch) and validating both kinds of licenses.
+//
+// Usage: ./licensepp-bench-batch [licenses]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+template <typename Operation>
+static void run(const char* operation, std::size_t count, Operation op)
+{
+    const auto started = std::chrono::steady_clock::now();
+    const std::size_t checksum = op();
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+    std::cout << operation << ": licenses=" << count << " us_per_license=" << (us / count)
+              << " checksum=" << checksum << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<std::string> licensees;
+    for (std::size_t i = 0; i < count; ++i) {
+        licensees.push_back("bench-licensee-" + std::to_string(i));
+    }
+
+    std::vector<License> single;
+    std::vector<License> batch;
+    run("issue", count, [&]() {
+        for (const std::string& licensee : licensees) {
+            single.push_back(licenseManager.issue(licensee, 24U, authority));
+        }
+        return single.size();
+    });
+    run("issue_batch", count, [&]() {
+        batch = licenseManager.issueBatch(licensees, 24U, authority);
+        return batch.size();
+    });
+
+    // loaded licenses so cached raw bytes of issued license are not reused
+    std::vector<License> loadedSingle(count);
+    std::vector<License> loadedBatch(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        loadedSingle[i].load(single[i].toString());
+        loadedBatch[i].load(batch[i].toString());
+    }
+    run("validate", count, [&]() {
+        std::size_t valid = 0;
+        for (License& license : loadedSingle) {
+            valid += licenseManager.validate(&license, false) ? 1 : 0;
+        }
+        return valid;
+    });
+    run("validate_batch", count, [&]() {
+        std::size_t valid = 0;
+        for (License& license : loadedBatch) {
+            valid += licenseManager.validate(&license, false) ? 1 : 0;
+        }
+        return valid;
+    });
+    return 0;
+}
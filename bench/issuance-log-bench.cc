@@ -0,0 +1,114 @@
+//
+//  issuance-log-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Durable appends per second to IssuanceLog from concurrent threads:
+//   per_record     every record synced on its own (maxBatch = 1), same as fsync after each issue()
+//   group          group commit without waiting (maxDelayUs = 0), batches what arrives during sync
+//   group_delayed  group commit waiting up to 1 ms for more records
+//   issue          issue() through license manager without and with issuance log
+//
+// Results depend on the file system, run it on the device log will be on (e.g, not tmpfs).
+//
+// Usage: ./licensepp-bench-issuance-log [threads] [records per thread] [directory]
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <license++/issuance-log.h>
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+///
+/// \brief Runs operation perThread times on each thread and returns operations per second
+///
+template <typename Operation>
+static double run(unsigned int threads, unsigned int perThread, Operation operation, std::atomic<uint64_t>* failures)
+{
+    std::vector<std::thread> workers;
+    const auto started = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            uint64_t failed = 0;
+            for (unsigned int i = 0; i < perThread; ++i) {
+                failed += operation() ? 0 : 1;
+            }
+            failures->fetch_add(failed);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return static_cast<double>(threads) * perThread / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int threads = argc > 1 ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : 16;
+    const unsigned int perThread = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 200;
+    const std::string directory = argc > 3 ? argv[3] : ".";
+
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const License license = licenseManager.issue("issuance-log-bench", 24U, authority);
+    std::atomic<uint64_t> failures(0);
+
+    struct Case
+    {
+        const char* name;
+        unsigned int maxDelayUs;
+        std::size_t maxBatch;
+    };
+    for (const Case& c : { Case { "per_record", 0, 1 }, Case { "group", 0, 4096 }, Case { "group_delayed", 1000, 4096 } }) {
+        const std::string path = directory + "/licensepp-bench-issuance-" + std::to_string(::getpid()) + ".log";
+        std::remove(path.c_str());
+        uint64_t commits = 0;
+        double perSecond = 0;
+        {
+            IssuanceLog issuanceLog(path, c.maxDelayUs, c.maxBatch);
+            perSecond = run(threads, perThread, [&]() { return issuanceLog.append(license); }, &failures);
+            commits = issuanceLog.commits();
+        }
+        failures += IssuanceLog::verify(path).records == static_cast<uint64_t>(threads) * perThread ? 0 : 1;
+        std::remove(path.c_str());
+        std::cout << c.name << ": threads=" << threads << " records_per_second=" << static_cast<uint64_t>(perSecond)
+                  << " records_per_commit=" << (static_cast<double>(threads) * perThread / commits) << std::endl;
+    }
+
+    const double withoutLog = run(threads, perThread / 4 + 1, [&]() {
+        return !licenseManager.issue("issuance-log-bench", 24U, authority).authoritySignature().empty();
+    }, &failures);
+    const std::string path = directory + "/licensepp-bench-issuance-" + std::to_string(::getpid()) + ".log";
+    std::remove(path.c_str());
+    double withLog = 0;
+    {
+        IssuanceLog issuanceLog(path);
+        licenseManager.setIssuanceLog(&issuanceLog);
+        withLog = run(threads, perThread / 4 + 1, [&]() {
+            return !licenseManager.issue("issuance-log-bench", 24U, authority).authoritySignature().empty();
+        }, &failures);
+        licenseManager.setIssuanceLog(nullptr);
+    }
+    std::remove(path.c_str());
+    std::cout << "issue: threads=" << threads << " issues_per_second=" << static_cast<uint64_t>(withoutLog)
+              << " with_log=" << static_cast<uint64_t>(withLog) << std::endl;
+
+    if (failures.load() != 0) {
+        std::cerr << "unexpected results: " << failures.load() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+//
+//  lease-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Lease operations per second of LeaseServer:
+//   in_process  threads acquire, renew and release leases on one pool (3 operations per cycle)
+//   reclaim     timer wheel expiring 1M leases (ns per reclaimed lease)
+//   socket      same cycle by LeaseClient per thread over UNIX socket (licensepp-leased)
+//
+// Usage: ./licensepp-bench-lease [threads] [ms]
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <license++/lease-client.h>
+#include <license++/lease-server.h>
+#include "src/lease-socket-server.h"
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+static uint64_t s_benchNow = 1000000;
+
+static uint64_t benchClock()
+{
+    return s_benchNow;
+}
+
+///
+/// \brief Runs cycle on each thread for milliseconds and returns operations per second
+///
+template <typename Cycle>
+static double run(unsigned int threads, unsigned int milliseconds, unsigned int operationsPerCycle,
+                  Cycle cycle, std::atomic<uint64_t>* failures)
+{
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> cycles(0);
+    std::vector<std::thread> workers;
+    const auto started = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            uint64_t count = 0;
+            uint64_t failed = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                failed += cycle(t) ? 0 : 1;
+                ++count;
+            }
+            cycles.fetch_add(count);
+            failures->fetch_add(failed);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return static_cast<double>(cycles.load()) * operationsPerCycle / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int threads = argc > 1 ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : 4;
+    const unsigned int milliseconds = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 1000;
+
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const int64_t seats = 1000000;
+    License license = licenseManager.issue("lease-bench", 24U, authority, "", "", "",
+                                           Entitlements().setLimit("seats", seats));
+    std::atomic<uint64_t> failures(0);
+
+    LeaseServer leaseServer;
+    const uint32_t pool = leaseServer.addLicense(license);
+    leaseServer.start();
+    const double inProcess = run(threads, milliseconds, 3, [&](unsigned int) {
+        Lease lease;
+        return leaseServer.acquire(pool, 30000, &lease) == LeaseStatus::Granted
+                && leaseServer.renew(lease.id, 30000, &lease) == LeaseStatus::Granted
+                && leaseServer.release(lease.id) == LeaseStatus::Granted;
+    }, &failures);
+    std::cout << "in_process: threads=" << threads << " ops_per_second=" << static_cast<uint64_t>(inProcess)
+              << std::endl;
+
+    LeaseServer wheelServer(1, 64, 100, &benchClock);
+    const uint32_t wheelPool = wheelServer.addLicense(license);
+    Lease lease;
+    for (int64_t i = 0; i < seats; ++i) {
+        // spread over 10 s, i.e, 100 ticks
+        failures += wheelServer.acquire(wheelPool, 1000 + static_cast<uint32_t>(i % 10000), &lease)
+                == LeaseStatus::Granted ? 0 : 1;
+    }
+    s_benchNow += 11000;
+    const auto reclaimStarted = std::chrono::steady_clock::now();
+    const std::size_t reclaimed = wheelServer.expire();
+    const double reclaimNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - reclaimStarted).count();
+    failures += reclaimed == static_cast<std::size_t>(seats) ? 0 : 1;
+    std::cout << "reclaim: leases=" << reclaimed << " ns_per_lease=" << (reclaimNs / seats) << std::endl;
+
+    const std::string socketPath = "/tmp/licensepp-bench-lease-" + std::to_string(::getpid()) + ".sock";
+    LeaseSocketServer server(socketPath, &leaseServer);
+    if (!server.start()) {
+        return 1;
+    }
+    std::thread serverThread([&]() { server.run(); });
+    std::vector<std::unique_ptr<LeaseClient>> clients;
+    for (unsigned int t = 0; t < threads; ++t) {
+        clients.emplace_back(new LeaseClient(socketPath));
+    }
+    const double overSocket = run(threads, milliseconds, 3, [&](unsigned int thread) {
+        uint64_t leaseId = 0;
+        LeaseClient& client = *clients[thread];
+        return client.acquire("lease-bench", 30000, &leaseId) == LeaseStatus::Granted
+                && client.renew(leaseId, 30000) == LeaseStatus::Granted
+                && client.release(leaseId) == LeaseStatus::Granted;
+    }, &failures);
+    std::cout << "socket: threads=" << threads << " ops_per_second=" << static_cast<uint64_t>(overSocket)
+              << std::endl;
+    clients.clear();
+    server.stop();
+    serverThread.join();
+    leaseServer.stop();
+
+    if (failures.load() != 0) {
+        std::cerr << "unexpected results: " << failures.load() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+//
+//  license-pool-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Compares heap allocation count, RSS and load time of one-heap-object-per-license
+// against LicensePool, which keeps licenses and their strings in its arena.
+//
+// Usage: ./licensepp-bench-pool [count] [heap|pool]
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <license++/license.h>
+#include <license++/license-pool.h>
+
+static std::atomic<unsigned long long> s_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    ++s_allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace licensepp;
+
+static const char* kLicense = "eyJhZGRpdGlvbmFsX3BheWxvYWQiOiJTb21lUmFuZG9tU3RyaW5nIiwiYXV0aG9yaXR5X3NpZ25hdHVyZSI6IjdBNjU2Qzg3QjdBOUVCRjhFMEVEMzQyMTdEMzIwQjNGQzZCMjAxNEJDRTI1OUZEQTQ3RUI5MzE1OUJGMzQzRTUwMjc5N0YwRjJCMjMwMDFFNjMwMEQwQTAzOTFCNjAzMkI1NUNCQzY4QTAzRkU2OTQ4MTZCN0JGMDA4NzJERTE0NEI2RkNDNkFGQ0E5MjRGNzEzRTZCQUQzQkZBRUI1QzU5RkUwNkUyNEI5RDA3QjMxN0QzRTc2N0RBOTcwNUY3REFDOUU2QzcxMUNCRDBBMzc3RjA5NTY5MTlENkZGMjk5NkMzN0U4OEM0NzFENzM3QjQwMUIxMzk1NzVCNEZDMzJGQzlBMkEyRUJGMTY0NjIxMjg1Qzk2NkM5NjZGRjI2MEMwOEQ1ODA2NUU5RkJFQTk5QUE5OTcwRDVCODZENzJDMDc2Nzg1NzkwQzk5NDIzRjYwMTdBMjcwNzY4RkQ1QzBGQjhFRDU4MERFOTg1QzlDMTM3OEQ3MTQ1QkQ4QzhCRDIzQzRBRDdBMkE0QzhDQ0NFQUU4NkI3OEYxODU4NDk4ODFGODZBNjBEQzhGMUFCNjI0M0I2RDBGOTUzNjI1QkMzREExMkRGNjE5Njc2MDIwQjEyQkU1QUEyNUIwQTVGMDJGMzFDREQ1ODExOUIxQzFDMjI1RTZDQUE5RjM2QzQ4IiwiZXhwaXJ5X2RhdGUiOjE5MDk1MTY1MjIsImlzc3VlX2RhdGUiOjE1OTQxNTY1MjIsImlzc3VpbmdfYXV0aG9yaXR5Ijoic2FtcGxlLWxpY2Vuc2UtYXV0aG9yaXR5IiwibGljZW5zZWUiOiJ1bml0LXRlc3QifQ==";
+
+///
+/// \brief Resident set size in KiB (linux only, 0 elsewhere)
+///
+static unsigned long rssKb()
+{
+    std::ifstream statm("/proc/self/statm");
+    unsigned long pages = 0;
+    unsigned long resident = 0;
+    if (statm >> pages >> resident) {
+        return resident * static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) / 1024UL;
+    }
+    return 0;
+}
+
+static void report(const char* model, std::size_t count, unsigned long long loadAllocs,
+                   unsigned long long freeAllocs, unsigned long rssBefore, unsigned long rssAfter,
+                   double loadMs, double freeMs)
+{
+    std::cout << model << ": licenses=" << count
+              << " allocations=" << loadAllocs
+              << " (" << (static_cast<double>(loadAllocs) / count) << "/license)"
+              << " rss_delta_kb=" << (rssAfter > rssBefore ? rssAfter - rssBefore : 0)
+              << " load_ms=" << loadMs
+              << " free_ms=" << freeMs
+              << " free_allocations=" << freeAllocs
+              << std::endl;
+}
+
+static void runHeap(const std::vector<std::string>& blobs)
+{
+    using Clock = std::chrono::steady_clock;
+    const unsigned long rssBefore = rssKb();
+    const unsigned long long allocsBefore = s_allocations;
+    auto start = Clock::now();
+    std::vector<std::unique_ptr<License>> licenses;
+    licenses.reserve(blobs.size());
+    for (const auto& blob : blobs) {
+        std::unique_ptr<License> license(new License());
+        license->load(blob);
+        licenses.push_back(std::move(license));
+    }
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const unsigned long long loadAllocs = s_allocations - allocsBefore;
+    const unsigned long rssAfter = rssKb();
+
+    start = Clock::now();
+    const unsigned long long freeBefore = s_allocations;
+    licenses.clear();
+    licenses.shrink_to_fit();
+    const double freeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    report("heap", blobs.size(), loadAllocs, s_allocations - freeBefore, rssBefore, rssAfter, loadMs, freeMs);
+}
+
+static void runPool(const std::vector<std::string>& blobs)
+{
+    using Clock = std::chrono::steady_clock;
+    const unsigned long rssBefore = rssKb();
+    const unsigned long long allocsBefore = s_allocations;
+    auto start = Clock::now();
+    LicensePool pool;
+    const std::size_t loaded = pool.load(blobs);
+    const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const unsigned long long loadAllocs = s_allocations - allocsBefore;
+    const unsigned long rssAfter = rssKb();
+
+    start = Clock::now();
+    const unsigned long long freeBefore = s_allocations;
+    pool.release();
+    const double freeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    report("pool", loaded, loadAllocs, s_allocations - freeBefore, rssBefore, rssAfter, loadMs, freeMs);
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t count = argc > 1 ? static_cast<std::size_t>(std::strtoul(argv[1], nullptr, 10)) : 100000UL;
+    const std::string model = argc > 2 ? argv[2] : "";
+    if (count == 0) {
+        count = 1;
+    }
+
+    const std::vector<std::string> blobs(count, kLicense);
+
+    // Run each model in its own process for a clean RSS reading, e.g,
+    //   ./licensepp-bench-pool 1000000 heap && ./licensepp-bench-pool 1000000 pool
+    if (model.empty() || model == "heap") {
+        runHeap(blobs);
+    }
+    if (model.empty() || model == "pool") {
+        runPool(blobs);
+    }
+    return 0;
+}
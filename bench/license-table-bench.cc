@@ -0,0 +1,94 @@
+//
+//  license-table-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Compares "expiring in next 30 days for authority X" query over vector of License
+// objects against LicenseTable with scalar and AVX2 kernels.
+//
+// Usage: ./licensepp-bench-table [count] [authorities]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <license++/license.h>
+#include <license++/license-table.h>
+#include "src/license-table-kernels.h"
+
+using namespace licensepp;
+
+static const int kRepeat = 20;
+static const uint64_t kNow = 1700000000ULL;
+static const uint64_t kThirtyDays = 30ULL * 86400ULL;
+
+template <typename Query>
+static void run(const char* model, Query query)
+{
+    std::size_t matched = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRepeat; ++i) {
+        matched = query();
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    std::cout << model << ": matched=" << matched << " query_ms=" << (ms / kRepeat) << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000UL;
+    const unsigned int authorities = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8U;
+
+    std::mt19937_64 random(1);
+    std::vector<License> licenses(count);
+    for (auto& license : licenses) {
+        license.setLicensee("licensee-" + std::to_string(random() % 100000));
+        license.setIssuingAuthorityId("authority-" + std::to_string(random() % authorities));
+        license.setIssueDate(kNow - random() % (365ULL * 86400ULL));
+        license.setExpiryDate(kNow + random() % (730ULL * 86400ULL));
+        license.setAuthoritySignature(std::string(512, 'A'));
+    }
+    LicenseTable table;
+    table.reserve(count);
+    for (const auto& license : licenses) {
+        table.append(license);
+    }
+    const std::string authority = "authority-0";
+    const uint16_t code = table.authorityCode(authority);
+
+    run("objects", [&]() {
+        std::vector<std::size_t> selection;
+        for (std::size_t i = 0; i < licenses.size(); ++i) {
+            const License& license = licenses[i];
+            if (license.expiryDate() >= kNow && license.expiryDate() < kNow + kThirtyDays
+                    && license.issuingAuthorityId() == authority) {
+                selection.push_back(i);
+            }
+        }
+        return selection.size();
+    });
+    run("table-scalar", [&]() {
+        LicenseTable::Selection selection(table.size());
+        return LicenseTableKernels::expiringFromScalar(table.expiryDates(), table.authorityCodes(), table.size(),
+                                                       kNow, kNow + kThirtyDays, code, selection.data());
+    });
+#if LICENSEPP_HAS_AVX2_KERNELS
+    if (LicenseTableKernels::avx2Supported()) {
+        run("table-avx2", [&]() {
+            LicenseTable::Selection selection(table.size());
+            return LicenseTableKernels::expiringFromAvx2(table.expiryDates(), table.authorityCodes(), table.size(),
+                                                         kNow, kNow + kThirtyDays, code, selection.data());
+        });
+    }
+#endif
+    run("table", [&]() {
+        return table.selectExpiring(kNow, kNow + kThirtyDays, authority).size();
+    });
+    return 0;
+}
@@ -0,0 +1,70 @@
+//
+//  rejection-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Measures cost of rejecting invalid licenses, i.e, what flood of bad submissions costs
+// public endpoint: expired and forged licenses, with and without negative cache.
+//
+// Usage: ./licensepp-bench-rejection [iterations]
+//
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <license++/negative-cache.h>
+#include "src/utils.h"
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+template <typename Operation>
+static void run(const char* operation, std::size_t iterations, Operation op)
+{
+    const auto started = std::chrono::steady_clock::now();
+    std::size_t rejected = 0;
+    for (std::size_t i = 0; i < iterations; ++i) {
+        rejected += op() ? 0 : 1;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    std::cout << operation << ": iterations=" << iterations << " ns_per_validation=" << (ns / iterations)
+              << " rejected=" << rejected << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("rejection-bench", 24U, authority);
+    License forged;
+    forged.load(issued.toString());
+    forged.setLicensee("rejection-bench-forged");
+    License expired;
+    expired.load(forged.toString());
+
+    run("valid", iterations, [&]() {
+        return licenseManager.tryValidate(&issued, false) == LicenseError::None;
+    });
+    run("forged", iterations, [&]() {
+        return licenseManager.tryValidate(&forged, false) == LicenseError::None;
+    });
+    Utils::setThreadClock(expired.expiryDate() + 1);
+    run("expired_forged", iterations, [&]() {
+        return licenseManager.tryValidate(&expired, false) == LicenseError::None;
+    });
+    Utils::setThreadClock(0);
+
+    NegativeCache negativeCache;
+    licenseManager.setNegativeCache(&negativeCache);
+    run("forged_negative_cache", iterations, [&]() {
+        return licenseManager.tryValidate(&forged, false) == LicenseError::None;
+    });
+    run("valid_negative_cache", iterations, [&]() {
+        return licenseManager.tryValidate(&issued, false) == LicenseError::None;
+    });
+    return 0;
+}
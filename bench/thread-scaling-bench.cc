@@ -0,0 +1,192 @@
+//
+//  thread-scaling-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Throughput of validating and issuing licenses from 1..N threads that share license
+// manager, authorities and licenses, to see what scales when shared by worker pool:
+//   validate_shared       all threads validate the same License object
+//   validate_copies       each thread validates its own copy of the license
+//   load_validate         License::tryLoad() + tryValidate() of base64 license
+//   forged_negative_cache forged license rejected by shared NegativeCache
+//   issue                 IssuingAuthority::issue() (RSA signing)
+//   c_validate            license_manager_validate_status() of C bindings
+//
+// Every result is checked, exit code is 1 if any operation returned unexpected result, so
+// this also runs under ThreadSanitizer (cmake -Dtsan=ON -Dbench=ON -Dtest=ON ..; ctest)
+//
+// Usage: ./licensepp-bench-threads [max_threads] [ms_per_point] [csv]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <license++/c-bindings.h>
+#include <license++/negative-cache.h>
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+namespace {
+
+struct Point
+{
+    unsigned int threads;
+    double opsPerSecond;
+};
+
+///
+/// \brief Operation for given thread, returns false on unexpected result
+///
+using Operation = std::function<bool(unsigned int thread)>;
+
+Point measure(const Operation& op, unsigned int threads, unsigned int milliseconds, std::atomic<uint64_t>* failures)
+{
+    std::atomic<bool> start(false);
+    std::atomic<bool> stop(false);
+    std::vector<uint64_t> counts(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            uint64_t count = 0;
+            uint64_t failed = 0;
+            // at least one operation, so each thread is checked at least once
+            do {
+                failed += op(t) ? 0 : 1;
+                ++count;
+            } while (!stop.load(std::memory_order_relaxed));
+            counts[t] = count;
+            failures->fetch_add(failed);
+        });
+    }
+    const auto started = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop.store(true);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    uint64_t total = 0;
+    for (uint64_t count : counts) {
+        total += count;
+    }
+    return { threads, static_cast<double>(total) / seconds };
+}
+
+void plot(const char* name, const std::vector<Point>& points)
+{
+    const double best = std::max_element(points.begin(), points.end(), [](const Point& a, const Point& b) {
+        return a.opsPerSecond < b.opsPerSecond;
+    })->opsPerSecond;
+    std::cout << name << std::endl;
+    for (const Point& point : points) {
+        const double speedup = point.opsPerSecond / points.front().opsPerSecond;
+        const int width = best > 0 ? static_cast<int>(40 * point.opsPerSecond / best + 0.5) : 0;
+        std::cout << "  " << std::setw(3) << point.threads << " | " << std::string(width, '#')
+                  << std::string(40 - width, ' ') << " | " << std::fixed << std::setprecision(0)
+                  << std::setw(10) << point.opsPerSecond << " ops/s  x" << std::setprecision(2) << speedup
+                  << "  efficiency=" << std::setprecision(0) << (100 * speedup / point.threads) << "%"
+                  << std::endl;
+    }
+}
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned int hardware = std::max(1U, std::thread::hardware_concurrency());
+    const unsigned int maxThreads = argc > 1 ? static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)) : hardware;
+    const unsigned int milliseconds = argc > 2 ? static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10)) : 500;
+    const bool csv = argc > 3 && std::strcmp(argv[3], "csv") == 0;
+
+    LicenseManagerForTest licenseManager;
+    NegativeCache negativeCache;
+    licenseManager.setNegativeCache(&negativeCache);
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("thread-scaling", 24U, authority, "", "thread-scaling-signature");
+    const std::string blob = issued.toString();
+    License shared;
+    shared.load(blob);
+    std::vector<License> copies(maxThreads, shared);
+    License forged;
+    forged.load(blob);
+    forged.setLicensee("thread-scaling-forged");
+
+    IssuingAuthorityParameters parameters = { "unittest-issuer-1", "Firewebkit (development)",
+                                              kUnitTestIssuer1Keypair, 24U, 1, nullptr };
+    license_key_register_init(LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY.data(), &parameters);
+    void* cManager = license_manager_create();
+    std::vector<void*> cLicenses(maxThreads);
+    for (void*& cLicense : cLicenses) {
+        cLicense = license_create();
+        license_load(cLicense, blob.c_str());
+    }
+
+    const std::vector<std::pair<const char*, Operation>> cases = {
+        { "validate_shared", [&](unsigned int) {
+            return licenseManager.tryValidate(&shared, true, "thread-scaling-signature") == LicenseError::None;
+        } },
+        { "validate_copies", [&](unsigned int thread) {
+            return licenseManager.tryValidate(&copies[thread], true, "thread-scaling-signature") == LicenseError::None;
+        } },
+        { "load_validate", [&](unsigned int) {
+            License license;
+            return license.tryLoad(blob) == LicenseError::None
+                    && licenseManager.tryValidate(&license, true, "thread-scaling-signature") == LicenseError::None;
+        } },
+        { "forged_negative_cache", [&](unsigned int) {
+            return licenseManager.tryValidate(&forged, true, "thread-scaling-signature")
+                    == LicenseError::InvalidAuthoritySignature;
+        } },
+        { "issue", [&](unsigned int thread) {
+            return !licenseManager.issue("thread-scaling-" + std::to_string(thread), 24U, authority)
+                    .authoritySignature().empty();
+        } },
+        { "c_validate", [&](unsigned int thread) {
+            return license_manager_validate_status(cManager, cLicenses[thread], 1, "thread-scaling-signature")
+                    == LICENSEPP_ERROR_NONE;
+        } },
+    };
+
+    std::atomic<uint64_t> failures(0);
+    if (csv) {
+        std::cout << "case,threads,ops_per_second" << std::endl;
+    }
+    for (const auto& c : cases) {
+        std::vector<Point> points;
+        for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+            points.push_back(measure(c.second, threads, milliseconds, &failures));
+            if (csv) {
+                std::cout << c.first << "," << threads << "," << std::fixed << std::setprecision(0)
+                          << points.back().opsPerSecond << std::endl;
+            }
+        }
+        if (!csv) {
+            plot(c.first, points);
+        }
+    }
+
+    for (void* cLicense : cLicenses) {
+        license_delete(cLicense);
+    }
+    license_manager_delete(cManager);
+    if (failures.load() != 0) {
+        std::cerr << "unexpected results: " << failures.load() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+//
+//  verify-batch-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Bulk authority signature verification:
+//   sha1_scalar     SHA-1 of licenses one at a time (ns per license)
+//   sha1_many       SHA1::hashMany(), AVX2 multi-buffer where CPU has it
+//   verify_each     IssuingAuthority::verifySignature() of each license
+//   verify_batched  IssuingAuthority::verifySignatures() of batch licenses
+//
+// Usage: ./licensepp-bench-verify-batch [licenses] [batch] [payload bytes]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "src/crypto/crypto-backend.h"
+#include "src/crypto/sha1.h"
+#include "test/license-manager-for-test.h"
+
+using namespace licensepp;
+
+template <typename Operation>
+static void run(const char* name, std::size_t licenses, Operation op)
+{
+    const auto started = std::chrono::steady_clock::now();
+    const std::size_t failed = op();
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    std::cout << name << ": licenses=" << licenses << " ns_per_license=" << (ns / licenses)
+              << " failed=" << failed << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    const std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    const std::size_t batch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : SHA1::kLanes;
+    const std::size_t payloadSize = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 256;
+    if (count == 0 || batch == 0) {
+        return 1;
+    }
+
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    // distinct licenses are costly to sign so few are signed and repeated
+    std::vector<License> signedLicenses;
+    for (std::size_t i = 0; i < 64; ++i) {
+        signedLicenses.push_back(licenseManager.issue("verify-batch-" + std::to_string(i), 24U, authority, "", "",
+                                                      std::string(payloadSize, 'p')));
+    }
+    std::vector<const License*> licenses;
+    std::vector<const std::string*> messages;
+    for (std::size_t i = 0; i < count; ++i) {
+        licenses.push_back(&signedLicenses[i % signedLicenses.size()]);
+        messages.push_back(&licenses.back()->raw());
+    }
+    std::cout << "backend=" << CryptoBackend::instance().name()
+              << " verifies_digests=" << (CryptoBackend::instance().verifiesDigests() ? 1 : 0)
+              << " avx2=" << (SHA1::avx2Supported() ? 1 : 0)
+              << " license_bytes=" << messages[0]->size() << " batch=" << batch << std::endl;
+
+    std::vector<std::string> digests(count);
+    std::vector<std::string> expected(count);
+    run("sha1_scalar", count, [&]() {
+        SHA1::hashManyScalar(messages.data(), count, expected.data());
+        return 0;
+    });
+    run("sha1_many", count, [&]() {
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < count; i += batch) {
+            SHA1::hashMany(&messages[i], std::min(batch, count - i), &digests[i]);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            failed += digests[i] == expected[i] ? 0 : 1;
+        }
+        return failed;
+    });
+
+    std::unique_ptr<bool[]> results(new bool[count]);
+    run("verify_each", count, [&]() {
+        std::size_t failed = 0;
+        for (const License* license : licenses) {
+            failed += authority->verifySignature(license) ? 0 : 1;
+        }
+        return failed;
+    });
+    run("verify_batched", count, [&]() {
+        std::size_t failed = 0;
+        for (std::size_t i = 0; i < count; i += batch) {
+            authority->verifySignatures(&licenses[i], std::min(batch, count - i), &results[i]);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            failed += results[i] ? 0 : 1;
+        }
+        return failed;
+    });
+    return 0;
+}
@@ -0,0 +1,107 @@
+//
+//  verify-lite-bench.cc
+//  License++ Benchmarks
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Built twice, as licensepp-bench-verify-full (licensepp) and licensepp-bench-verify-lite
+// (licensepp-verify-lite), to compare what client that only validates licenses pays for:
+//   - size of library that is loaded
+//   - startup: process that loads library, loads and validates one license and exits (each
+//     run is new process so dynamic linking and static initialization are included)
+//   - load and validate license in running process
+//
+// Usage: ./licensepp-bench-verify-lite [iterations] [processes]
+//
+
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "src/utils.h"
+#include "test/verify-lite-for-test.h"
+
+using namespace licensepp;
+
+static bool loadAndValidate(const VerifyLiteLicenseManager& licenseManager)
+{
+    License license;
+    return license.tryLoad(kVerifyLiteRichLicense) == LicenseError::None
+            && licenseManager.tryValidate(&license, true, "verify-lite-signature") == LicenseError::None;
+}
+
+static void reportLibrary()
+{
+    Dl_info info;
+    struct stat st;
+    if (dladdr(reinterpret_cast<void*>(&licenseErrorMessage), &info) != 0 && info.dli_fname != nullptr
+            && stat(info.dli_fname, &st) == 0) {
+        std::cout << "library: path=" << info.dli_fname << " bytes=" << st.st_size << std::endl;
+    }
+}
+
+static void runStartup(const char* self, std::size_t processes)
+{
+    std::size_t failed = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < processes; ++i) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            execl(self, self, "--startup", static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++failed;
+        }
+    }
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "startup: processes=" << processes << " us_per_process=" << (us / processes)
+              << " failed=" << failed << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    Utils::setThreadClock(kVerifyLiteIssueDate + 3600);
+    VerifyLiteLicenseManager licenseManager;
+    if (argc > 1 && std::strcmp(argv[1], "--startup") == 0) {
+        return loadAndValidate(licenseManager) ? 0 : 1;
+    }
+    const std::size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+    const std::size_t processes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200;
+
+    reportLibrary();
+    runStartup(argv[0], processes);
+
+    std::size_t failed = 0;
+    const auto started = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        failed += loadAndValidate(licenseManager) ? 0 : 1;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "load_validate: iterations=" << iterations << " ns_per_license=" << (ns / iterations)
+              << " failed=" << failed << std::endl;
+
+    // license JSON is read and written again, without crypto
+    failed = 0;
+    License license;
+    license.load(kVerifyLiteRichLicense);
+    const std::string json = license.raw(true);
+    const std::string blob = kVerifyLiteRichLicense;
+    const auto parseStarted = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        failed += license.tryLoad(blob) == LicenseError::None ? 0 : 1;
+        license.setLicensee(license.licensee());
+        failed += license.raw(false).empty() ? 1 : 0;
+    }
+    const double parseNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - parseStarted).count();
+    std::cout << "load_serialize: iterations=" << iterations << " ns_per_license=" << (parseNs / iterations)
+              << " json_bytes=" << json.size() << " failed=" << failed << std::endl;
+    return 0;
+}
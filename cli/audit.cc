@@ -0,0 +1,373 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "audit.h"
+#include "licensing/license-manager.h"
+
+namespace {
+
+// in-flight blobs per worker thread
+const std::size_t kRingSlotsPerThread = 256;
+
+// licenses verified together by worker thread, see IssuingAuthority::verifySignatures()
+const std::size_t kVerifyBatch = 8;
+
+const std::size_t kExpiryBuckets = 6;
+const char* kExpiryBucketNames[kExpiryBuckets] = {
+    "expired", "0-7 days", "8-30 days", "31-90 days", "91-365 days", "over 1 year"
+};
+
+///
+/// \brief Fixed size ring of blobs waiting to be verified
+///
+/// Strings are swapped in and out so their buffers are reused instead of reallocated
+///
+class WorkRing
+{
+public:
+    explicit WorkRing(std::size_t capacity) :
+        m_slots(capacity),
+        m_head(0),
+        m_tail(0),
+        m_size(0),
+        m_closed(false)
+    {
+    }
+
+    void push(std::string* blob)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [&]() { return m_size < m_slots.size(); });
+        m_slots[m_tail].swap(*blob);
+        m_tail = (m_tail + 1) % m_slots.size();
+        ++m_size;
+        m_notEmpty.notify_one();
+    }
+
+    ///
+    /// \return False when ring is closed and empty
+    ///
+    bool pop(std::string* blob)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [&]() { return m_size > 0 || m_closed; });
+        if (m_size == 0) {
+            return false;
+        }
+        m_slots[m_head].swap(*blob);
+        m_head = (m_head + 1) % m_slots.size();
+        --m_size;
+        m_notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+private:
+    std::vector<std::string> m_slots;
+    std::size_t m_head;
+    std::size_t m_tail;
+    std::size_t m_size;
+    bool m_closed;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+};
+
+struct AuthorityStats
+{
+    uint64_t total = 0;
+    uint64_t valid = 0;
+};
+
+struct AuditStats
+{
+    uint64_t total = 0;
+    uint64_t valid = 0;
+    uint64_t expired = 0;
+    uint64_t tampered = 0;
+    uint64_t malformed = 0;
+    uint64_t unknownAuthority = 0;
+    uint64_t signatureRequired = 0;
+    std::array<uint64_t, kExpiryBuckets> daysToExpiry {};
+    std::map<std::string, AuthorityStats> authorities;
+
+    void merge(const AuditStats& other)
+    {
+        total += other.total;
+        valid += other.valid;
+        expired += other.expired;
+        tampered += other.tampered;
+        malformed += other.malformed;
+        unknownAuthority += other.unknownAuthority;
+        signatureRequired += other.signatureRequired;
+        for (std::size_t i = 0; i < kExpiryBuckets; ++i) {
+            daysToExpiry[i] += other.daysToExpiry[i];
+        }
+        for (const auto& a : other.authorities) {
+            authorities[a.first].total += a.second.total;
+            authorities[a.first].valid += a.second.valid;
+        }
+    }
+};
+
+// same clock as validation (mktime() of gmtime()) so expiry agrees with validate() whatever
+// the time zone of host is
+int64_t nowUtc()
+{
+    const std::time_t t = std::time(nullptr);
+    std::tm nowTm;
+    if (gmtime_r(&t, &nowTm) == nullptr) {
+        return 0;
+    }
+    return static_cast<int64_t>(mktime(&nowTm));
+}
+
+std::size_t expiryBucket(int64_t secondsLeft)
+{
+    if (secondsLeft < 0) {
+        return 0;
+    }
+    const int64_t days = secondsLeft / 86400;
+    return days <= 7 ? 1 : days <= 30 ? 2 : days <= 90 ? 3 : days <= 365 ? 4 : 5;
+}
+
+void count(const License& license, bool signatureValid, int64_t now, AuditStats* stats)
+{
+    AuthorityStats& authorityStats = stats->authorities[license.issuingAuthorityId()];
+    ++authorityStats.total;
+    if (!signatureValid) {
+        ++stats->tampered;
+        return;
+    }
+    if (!license.licenseeSignature().empty()) {
+        ++stats->signatureRequired;
+    }
+    const int64_t secondsLeft = static_cast<int64_t>(license.expiryDate()) - now;
+    ++stats->daysToExpiry[expiryBucket(secondsLeft)];
+    if (secondsLeft < 0) {
+        ++stats->expired;
+    } else {
+        ++stats->valid;
+        ++authorityStats.valid;
+    }
+}
+
+void verify(const LicenseManager& licenseManager, WorkRing* ring, int64_t now, AuditStats* stats)
+{
+    // consecutive licenses of same authority are verified together so they are hashed together
+    std::array<License, kVerifyBatch> licenses;
+    std::array<const License*, kVerifyBatch> batch;
+    bool results[kVerifyBatch];
+    std::size_t batchSize = 0;
+    const IssuingAuthority* batchAuthority = nullptr;
+    auto verifyBatch = [&]() {
+        batchAuthority->verifySignatures(batch.data(), batchSize, results);
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            count(licenses[i], results[i], now, stats);
+        }
+        batchSize = 0;
+    };
+    std::string blob;
+    while (ring->pop(&blob)) {
+        ++stats->total;
+        License& license = licenses[batchSize];
+        try {
+            license.load(blob);
+        } catch (const std::exception&) {
+            ++stats->malformed;
+            continue;
+        }
+        const IssuingAuthority* issuingAuthority = licenseManager.getIssuingAuthority(&license);
+        if (issuingAuthority == nullptr) {
+            ++stats->unknownAuthority;
+            continue;
+        }
+        if (batchSize > 0 && issuingAuthority != batchAuthority) {
+            verifyBatch();
+            std::swap(licenses[0], license);
+        }
+        batchAuthority = issuingAuthority;
+        batch[batchSize] = &licenses[batchSize];
+        if (++batchSize == kVerifyBatch) {
+            verifyBatch();
+        }
+    }
+    if (batchSize > 0) {
+        verifyBatch();
+    }
+}
+
+///
+/// \brief Turns NDJSON line into base64 license in place, returns false for blank line
+///
+bool extractBlob(std::string* line)
+{
+    std::size_t begin = line->find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return false;
+    }
+    std::size_t end = line->find_last_not_of(" \t\r\n") + 1;
+    if ((*line)[begin] != '{') {
+        line->erase(end);
+        line->erase(0, begin);
+        return true;
+    }
+    // {"license":"<base64>", ...}
+    std::size_t key = line->find("\"license\"", begin);
+    std::size_t colon = key == std::string::npos ? key : line->find(':', key + 9);
+    std::size_t quote = colon == std::string::npos ? colon : line->find('"', colon + 1);
+    if (quote == std::string::npos) {
+        line->clear();
+        return true; // reported as malformed
+    }
+    std::string::size_type out = 0;
+    for (std::size_t i = quote + 1; i < end && (*line)[i] != '"'; ++i) {
+        if ((*line)[i] == '\\' && i + 1 < end) {
+            ++i; // base64 has no escapes other than \/
+        }
+        (*line)[out++] = (*line)[i];
+    }
+    line->resize(out);
+    return true;
+}
+
+bool readFile(const std::string& file, WorkRing* ring)
+{
+    std::ifstream stream(file);
+    if (!stream.is_open()) {
+        std::cerr << "Failed to open file " << file << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (extractBlob(&line)) {
+            ring->push(&line);
+        }
+    }
+    return true;
+}
+
+bool readPath(const std::string& path, WorkRing* ring)
+{
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        return readFile(path, ring);
+    }
+    DIR* dir = ::opendir(path.c_str());
+    if (dir == nullptr) {
+        std::cerr << "Failed to open directory " << path << std::endl;
+        return false;
+    }
+    std::vector<std::string> files;
+    while (struct dirent* entry = ::readdir(dir)) {
+        const std::string file = path + "/" + entry->d_name;
+        if (entry->d_name[0] != '.' && ::stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            files.push_back(file);
+        }
+    }
+    ::closedir(dir);
+    bool result = true;
+    for (const std::string& file : files) {
+        result = readFile(file, ring) && result;
+    }
+    return result;
+}
+
+void printCount(const char* name, uint64_t count, uint64_t total)
+{
+    std::cout << "  " << std::left << std::setw(32) << name << std::right << std::setw(12) << count;
+    if (total > 0) {
+        std::cout << std::fixed << std::setprecision(2) << std::setw(9) << (100.0 * count / total) << "%";
+    }
+    std::cout << std::endl;
+}
+}
+
+int audit(const std::string& path, unsigned int threads)
+{
+    if (threads == 0) {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    const auto started = std::chrono::steady_clock::now();
+    const int64_t now = nowUtc();
+
+    LicenseManager licenseManager;
+    WorkRing ring(kRingSlotsPerThread * threads);
+    std::vector<AuditStats> stats(threads);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < threads; ++i) {
+        workers.emplace_back(verify, std::cref(licenseManager), &ring, now, &stats[i]);
+    }
+    const bool readAll = readPath(path, &ring);
+    ring.close();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    AuditStats total;
+    for (const auto& s : stats) {
+        total.merge(s);
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << "Audited " << total.total << " licenses in " << std::fixed << std::setprecision(2) << elapsed
+              << "s using " << threads << " thread" << (threads > 1 ? "s" : "");
+    if (elapsed > 0) {
+        std::cout << " (" << static_cast<uint64_t>(total.total / elapsed) << " licenses/s)";
+    }
+    std::cout << std::endl << std::endl;
+
+    printCount("Valid", total.valid, total.total);
+    printCount("Expired", total.expired, total.total);
+    printCount("Tampered (signature mismatch)", total.tampered, total.total);
+    printCount("Malformed", total.malformed, total.total);
+    printCount("Unknown authority", total.unknownAuthority, total.total);
+    printCount("Licensee signature required", total.signatureRequired, total.total);
+
+    std::cout << std::endl << "Per authority (total / valid)" << std::endl;
+    for (const auto& a : total.authorities) {
+        std::cout << "  " << std::left << std::setw(32) << a.first << std::right << std::setw(12)
+                  << a.second.total << " / " << a.second.valid << std::endl;
+    }
+
+    uint64_t verified = 0;
+    for (uint64_t count : total.daysToExpiry) {
+        verified += count;
+    }
+    std::cout << std::endl << "Days to expiry (verified licenses)" << std::endl;
+    for (std::size_t i = 0; i < kExpiryBuckets; ++i) {
+        printCount(kExpiryBucketNames[i], total.daysToExpiry[i], verified);
+    }
+    return readAll ? 0 : 1;
+}
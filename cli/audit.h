@@ -0,0 +1,24 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef Audit_h
+#define Audit_h
+
+#include <string>
+
+///
+/// \brief Verifies every license in NDJSON file (or directory of them) and prints report
+///
+/// Each line is either base64 license or JSON object with "license" field. Lines are
+/// verified by `threads` workers through bounded ring so memory does not grow with input.
+///
+/// \return Process exit code
+///
+int audit(const std::string& path, unsigned int threads);
+
+#endif /* Audit_h */
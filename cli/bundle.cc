@@ -0,0 +1,136 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <license++/license-bundle.h>
+#include "bundle.h"
+#include "licensing/license-manager.h"
+
+namespace {
+
+bool collectFiles(const std::string& path, std::vector<std::string>* files)
+{
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    if (!S_ISDIR(st.st_mode)) {
+        files->push_back(path);
+        return true;
+    }
+    DIR* dir = ::opendir(path.c_str());
+    if (dir == nullptr) {
+        std::cerr << "Failed to open directory " << path << std::endl;
+        return false;
+    }
+    std::vector<std::string> found;
+    while (struct dirent* entry = ::readdir(dir)) {
+        const std::string file = path + "/" + entry->d_name;
+        if (entry->d_name[0] != '.' && ::stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            found.push_back(file);
+        }
+    }
+    ::closedir(dir);
+    std::sort(found.begin(), found.end());
+    files->insert(files->end(), found.begin(), found.end());
+    return true;
+}
+
+std::string fileName(const std::string& key)
+{
+    std::string name = key;
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.') {
+            c = '_';
+        }
+    }
+    return name.empty() || name[0] == '.' ? "_" + name : name;
+}
+}
+
+int packBundle(const std::string& bundleFile, const std::vector<std::string>& sources, const std::string& keyType)
+{
+    if (keyType != "licensee" && keyType != "fingerprint") {
+        std::cerr << "Invalid bundle key " << keyType << ", expected licensee or fingerprint" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> files;
+    for (const std::string& source : sources) {
+        if (!collectFiles(source, &files)) {
+            return 1;
+        }
+    }
+    std::vector<License> licenses;
+    licenses.reserve(files.size());
+    for (const std::string& file : files) {
+        licenses.emplace_back();
+        try {
+            if (!licenses.back().loadFromFile(file)) {
+                return 1;
+            }
+        } catch (const LicenseException& e) {
+            std::cerr << "Failed to load " << file << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    try {
+        licensepp::LicenseBundle::write(bundleFile, licenses, keyType == "fingerprint"
+                                        ? licensepp::LicenseBundle::KeyType::Fingerprint
+                                        : licensepp::LicenseBundle::KeyType::Licensee);
+    } catch (const LicenseException& e) {
+        std::cerr << "Failed to pack bundle: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << licenses.size() << " licenses into " << bundleFile << std::endl;
+    return 0;
+}
+
+int unpackBundle(const std::string& bundleFile, const std::string& directory, const std::string& key)
+{
+    try {
+        licensepp::LicenseBundle bundle(bundleFile);
+        if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            std::cerr << "Failed to create directory " << directory << std::endl;
+            return 1;
+        }
+        std::map<std::string, std::size_t> written;
+        std::size_t unpacked = 0;
+        for (std::size_t i = 0; i < bundle.size(); ++i) {
+            const std::string licenseKey = bundle.key(i);
+            if (!key.empty() && licenseKey != key) {
+                continue;
+            }
+            // licenses with same key are numbered
+            std::string name = fileName(licenseKey);
+            const std::size_t count = ++written[name];
+            if (count > 1) {
+                name += "." + std::to_string(count);
+            }
+            std::ofstream stream(directory + "/" + name + ".license", std::ios::trunc);
+            stream << bundle.licenseBase64(i);
+            if (!stream) {
+                std::cerr << "Failed to write " << directory << "/" << name << ".license" << std::endl;
+                return 1;
+            }
+            ++unpacked;
+        }
+        std::cout << "Unpacked " << unpacked << " of " << bundle.size() << " licenses to " << directory << std::endl;
+    } catch (const LicenseException& e) {
+        std::cerr << "Failed to unpack bundle: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
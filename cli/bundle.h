@@ -0,0 +1,29 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef Bundle_h
+#define Bundle_h
+
+#include <string>
+#include <vector>
+
+///
+/// \brief Packs license files (and license files in directories) into license bundle
+/// \param keyType "licensee" or "fingerprint"
+/// \return Process exit code
+///
+int packBundle(const std::string& bundleFile, const std::vector<std::string>& sources, const std::string& keyType);
+
+///
+/// \brief Writes licenses in bundle to directory, one <key>.license file per license
+/// \param key Only unpack licenses with this key (all if empty)
+/// \return Process exit code
+///
+int unpackBundle(const std::string& bundleFile, const std::string& directory, const std::string& key);
+
+#endif /* Bundle_h */
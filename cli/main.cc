@@ -6,15 +6,24 @@
 // See https://github.com/abumq/licensepp/blob/master/LICENSE
 //
 
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
+#include <license++/issuance-log.h>
+#include <license++/license-store.h>
+#include "audit.h"
+#include "bundle.h"
+#include "store.h"
 #include "licensing/license-manager.h"
 
 void displayUsage() {
-    std::cout << "USAGE: license-manager [--validate <file> --signature <signature>] [--issue --licensee <licensee> --signature <licensee_signature> --period <validation_period> --authority <issuing_authority> --passphrase <passphrase_for_issuing_authority> [--additional-payload <additional data>]]" << std::endl;
+    std::cout << "USAGE: license-manager [--validate <file> --signature <signature>] [--audit <ndjson_file_or_directory> [--threads <threads>]] [--issue --licensee <licensee> --signature <licensee_signature> --period <validation_period> --authority <issuing_authority> --passphrase <passphrase_for_issuing_authority> [--additional-payload <additional data>] [--feature <name>]... [--limit <name>=<value>]... [--module <name>=<expiry_epoch>]... [--store <store_directory>] [--issuance-log <log_file>]] [--query <store_directory> [--licensee <licensee>] [--authority <issuing_authority>] [--expiring-after <epoch>] [--expiring-before <epoch>]] [--compact <store_directory> --expired-before <epoch>] [--pack <bundle_file> --from <license_file_or_directory>... [--key licensee|fingerprint]] [--unpack <bundle_file> --to <directory> [--licensee <licensee>]]" << std::endl;
 }
 
 void displayVersion() {
@@ -39,17 +48,63 @@ int main(int argc, char* argv[])
     std::string secret;
     std::string authority = "default";
     std::string additionalPayload;
+    std::vector<std::string> features;
+    licensepp::Entitlements::Limits limits;
+    licensepp::Entitlements::ModuleExpiries moduleExpiries;
     unsigned int period = 0U;
     bool doIssue = false;
     bool doValidate = false;
+    std::string auditPath;
+    unsigned int threads = 0U;
+    std::string storeDirectory;
+    std::string issuanceLogFile;
+    std::string queryDirectory;
+    std::string compactDirectory;
+    bool authorityGiven = false;
+    uint64_t expiringAfter = 0U;
+    uint64_t expiringBefore = UINT64_MAX;
+    uint64_t expiredBefore = 0U;
+    std::string packFile;
+    std::string unpackFile;
+    std::vector<std::string> packSources;
+    std::string bundleKey = "licensee";
+    std::string unpackDirectory;
 
     for (int i = 0; i < argc; i++) {
         std::string arg(argv[i]);
         if (arg == "--validate" && i < argc) {
             licenseFile = argv[++i];
             doValidate = true;
+        } else if (arg == "--audit" && i < argc) {
+            auditPath = argv[++i];
+        } else if (arg == "--store" && i < argc) {
+            storeDirectory = argv[++i];
+        } else if (arg == "--query" && i < argc) {
+            queryDirectory = argv[++i];
+        } else if (arg == "--compact" && i < argc) {
+            compactDirectory = argv[++i];
+        } else if (arg == "--pack" && i < argc) {
+            packFile = argv[++i];
+        } else if (arg == "--from" && i < argc) {
+            packSources.push_back(argv[++i]);
+        } else if (arg == "--key" && i < argc) {
+            bundleKey = argv[++i];
+        } else if (arg == "--unpack" && i < argc) {
+            unpackFile = argv[++i];
+        } else if (arg == "--to" && i < argc) {
+            unpackDirectory = argv[++i];
+        } else if (arg == "--expiring-after" && i < argc) {
+            expiringAfter = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--expiring-before" && i < argc) {
+            expiringBefore = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--expired-before" && i < argc) {
+            expiredBefore = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && i < argc) {
+            threads = static_cast<unsigned int>(atoi(argv[++i]));
         } else if (arg == "--signature" && i < argc) {
             signature = argv[++i];
+        } else if (arg == "--issuance-log" && i < argc) {
+            issuanceLogFile = argv[++i];
         } else if (arg == "--issue" && i < argc) {
             doIssue = true;
         } else if (arg == "--licensee" && i < argc) {
@@ -58,13 +113,45 @@ int main(int argc, char* argv[])
             period = static_cast<unsigned int>(atoi(argv[++i]));
         } else if (arg == "--authority" && i < argc) {
             authority = argv[++i];
+            authorityGiven = true;
         } else if (arg == "--passphrase" && i < argc) {
             secret = argv[++i];
         } else if (arg == "--additional-payload" && i < argc) {
             additionalPayload = argv[++i];
+        } else if (arg == "--feature" && i < argc) {
+            features.push_back(argv[++i]);
+        } else if ((arg == "--limit" || arg == "--module") && i < argc) {
+            std::string entry(argv[++i]);
+            std::size_t separatorPos = entry.find('=');
+            if (separatorPos == std::string::npos) {
+                std::cout << "Invalid " << arg << " " << entry << ", expected <name>=<value>" << std::endl;
+                return 1;
+            }
+            const std::string value = entry.substr(separatorPos + 1);
+            if (arg == "--limit") {
+                limits[entry.substr(0, separatorPos)] = std::strtoll(value.c_str(), nullptr, 10);
+            } else {
+                moduleExpiries[entry.substr(0, separatorPos)] = std::strtoull(value.c_str(), nullptr, 10);
+            }
         }
     }
 
+    if (!auditPath.empty()) {
+        return audit(auditPath, threads);
+    }
+    if (!queryDirectory.empty()) {
+        return queryStore(queryDirectory, licensee, authorityGiven ? authority : "", expiringAfter, expiringBefore);
+    }
+    if (!compactDirectory.empty()) {
+        return compactStore(compactDirectory, expiredBefore);
+    }
+    if (!packFile.empty()) {
+        return packBundle(packFile, packSources, bundleKey);
+    }
+    if (!unpackFile.empty()) {
+        return unpackBundle(unpackFile, unpackDirectory.empty() ? "." : unpackDirectory, licensee);
+    }
+
     LicenseManager licenseManager;
     if (doValidate && !licenseFile.empty()) {
         License license;
@@ -91,10 +178,31 @@ int main(int argc, char* argv[])
             std::cout << "Invalid issuing authority." << std::endl;
             return 1;
         }
-        licensepp::License license = licenseManager.issue(licensee, period, issuingAuthority, secret, signature, additionalPayload);
+        std::unique_ptr<licensepp::IssuanceLog> issuanceLog;
+        licensepp::License license;
+        try {
+            if (!issuanceLogFile.empty()) {
+                issuanceLog.reset(new licensepp::IssuanceLog(issuanceLogFile));
+                licenseManager.setIssuanceLog(issuanceLog.get());
+            }
+            license = licenseManager.issue(licensee, period, issuingAuthority, secret, signature, additionalPayload,
+                                           licensepp::Entitlements(features, limits, moduleExpiries));
+        } catch (const LicenseException& e) {
+            std::cerr << "Failed to issue license: " << e.what() << std::endl;
+            return 1;
+        }
         std::cout << license.toString() << std::endl;
         std::cout << "Licensed to " << license.licensee() << std::endl;
         std::cout << "Subscription is active until " << license.formattedExpiry() << std::endl << std::endl;
+        if (!storeDirectory.empty()) {
+            try {
+                licensepp::LicenseStore store(storeDirectory);
+                store.append(license);
+            } catch (const LicenseException& e) {
+                std::cerr << "Failed to store license: " << e.what() << std::endl;
+                return 1;
+            }
+        }
     } else {
         displayUsage();
     }
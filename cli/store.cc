@@ -0,0 +1,58 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <iostream>
+#include <license++/license-store.h>
+#include "store.h"
+#include "licensing/license-manager.h"
+
+int queryStore(const std::string& directory, const std::string& licensee, const std::string& authority,
+               uint64_t expiringAfter, uint64_t expiringBefore)
+{
+    try {
+        licensepp::LicenseStore store(directory);
+        // narrowest index first, remaining filters are checked on loaded license
+        licensepp::LicenseStore::RecordIds ids;
+        if (!licensee.empty()) {
+            ids = store.findByLicensee(licensee);
+        } else if (!authority.empty()) {
+            ids = store.findByAuthority(authority);
+        } else {
+            ids = store.findExpiring(expiringAfter, expiringBefore);
+        }
+        std::size_t matched = 0;
+        for (licensepp::LicenseStore::RecordId id : ids) {
+            License license = store.get(id);
+            if ((!authority.empty() && license.issuingAuthorityId() != authority)
+                    || license.expiryDate() < expiringAfter || license.expiryDate() >= expiringBefore) {
+                continue;
+            }
+            std::cout << id << "\t" << license.licensee() << "\t" << license.issuingAuthorityId() << "\t"
+                      << license.formattedExpiry() << "\t" << license.toString() << std::endl;
+            ++matched;
+        }
+        std::cerr << matched << " of " << store.size() << " licenses matched" << std::endl;
+    } catch (const LicenseException& e) {
+        std::cerr << "Failed to query store: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int compactStore(const std::string& directory, uint64_t expiredBefore)
+{
+    try {
+        licensepp::LicenseStore store(directory);
+        const std::size_t removed = store.compact(expiredBefore);
+        std::cout << "Removed " << removed << " expired licenses, " << store.size() << " licenses left" << std::endl;
+    } catch (const LicenseException& e) {
+        std::cerr << "Failed to compact store: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,31 @@
+//
+// License++
+//
+// Copyright © 2018-present @abumq (Majid Q.)
+//
+// See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef Store_h
+#define Store_h
+
+#include <cstdint>
+#include <string>
+
+///
+/// \brief Prints licenses in store that match all given filters (empty filter matches everything)
+///
+/// One license per line: record id, licensee, issuing authority, expiry and the license
+///
+/// \return Process exit code
+///
+int queryStore(const std::string& directory, const std::string& licensee, const std::string& authority,
+               uint64_t expiringAfter, uint64_t expiringBefore);
+
+///
+/// \brief Removes licenses that expired before expiredBefore from store
+/// \return Process exit code
+///
+int compactStore(const std::string& directory, uint64_t expiredBefore);
+
+#endif /* Store_h */
@@ -10,13 +10,21 @@
 #ifndef LICENSEPP_BaseLicenseManager_h
 #define LICENSEPP_BaseLicenseManager_h
 
+#include <atomic>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #include <vector>
+#include <license++/issuance-log.h>
 #include <license++/license.h>
+#include <license++/license-error.h>
 #include <license++/license-exception.h>
+#include <license++/negative-cache.h>
 #include <license++/issuing-authority.h>
+#include <license++/validation-recorder.h>
+#include <license++/verifying-authority.h>
 
 namespace licensepp {
 
@@ -65,19 +73,35 @@ namespace licensepp {
 /// };
 /// </pre>
 ///
+/// Binaries that only validate licenses can register VerifyingAuthority instead, i.e,
+/// `static const std::vector<licensepp::VerifyingAuthority> LICENSE_ISSUING_AUTHORITIES;`
+/// so private keys are not compiled in. issue() is not available with such register.
+///
 /// \see https://github.com/abumq/licensepp/blob/master/sample/
 ///
 template <class LicenseKeysRegister>
 class BaseLicenseManager
 {
 public:
-    BaseLicenseManager() = default;
+    ///
+    /// \brief IssuingAuthority or VerifyingAuthority, whichever register is made up of
+    ///
+    using Authority = typename std::remove_cv<typename std::remove_reference<
+            decltype(*std::begin(LicenseKeysRegister::LICENSE_ISSUING_AUTHORITIES))>::type>::type;
+
+    BaseLicenseManager() :
+        m_recorder(nullptr),
+        m_negativeCache(nullptr),
+        m_issuanceLog(nullptr)
+    {
+    }
+
     virtual ~BaseLicenseManager() = default;
 
     ///
     /// \brief Read and return issuing authority from license
     ///
-    const IssuingAuthority* getIssuingAuthority(const License* license) const
+    const Authority* getIssuingAuthority(const License* license) const
     {
         if (license == nullptr) {
             return nullptr;
@@ -96,18 +120,129 @@ public:
     /// \param licenseeSignature Signature of the licensee
     /// \param validityPeriod Validity of license from time of creation.
     /// This is number of hours (for one year provide 8760, for one month [30 days] provide 720)
-    /// \return New license object
+    /// \param entitlements Features, limits and module expiries signed with license
+    /// \return New license object, recorded in issuance log if one is set
+    /// \note Built without exceptions, empty License() is returned if license cannot be
+    /// recorded in issuance log, use tryIssue() to tell
     ///
     License issue(const std::string& licensee,
                   unsigned int validityPeriod,
                   const IssuingAuthority* issuingAuthority,
                   const std::string& issuingAuthoritySecret = "",
                   const std::string& licenseeSignature = "",
-                  const std::string& additionalPayload = "") const
+                  const std::string& additionalPayload = "",
+                  const Entitlements& entitlements = Entitlements()) const
+    {
+        License license = issuingAuthority->issue(licensee, validityPeriod, keydec(),
+                                                  issuingAuthoritySecret, licenseeSignature,
+                                                  additionalPayload, entitlements);
+        IssuanceLog* issuanceLog = m_issuanceLog.load(std::memory_order_acquire);
+        if (issuanceLog != nullptr && !issuanceLog->append(license)) {
+#if LICENSEPP_EXCEPTIONS
+            throw LicenseException("Failed to record license in issuance log " + issuanceLog->path());
+#else
+            return License();
+#endif
+        }
+        return license;
+    }
+
+    ///
+    /// \brief Generates licenses for all licensees with one signature, see IssuingAuthority::issueBatch()
+    ///
+    std::vector<License> issueBatch(const std::vector<std::string>& licensees,
+                                    unsigned int validityPeriod,
+                                    const IssuingAuthority* issuingAuthority,
+                                    const std::string& issuingAuthoritySecret = "",
+                                    const std::string& licenseeSignature = "",
+                                    const std::string& additionalPayload = "",
+                                    const Entitlements& entitlements = Entitlements()) const
+    {
+        std::vector<License> licenses = issuingAuthority->issueBatch(licensees, validityPeriod, keydec(),
+                                                                     issuingAuthoritySecret, licenseeSignature,
+                                                                     additionalPayload, entitlements);
+        IssuanceLog* issuanceLog = m_issuanceLog.load(std::memory_order_acquire);
+        if (issuanceLog != nullptr && !issuanceLog->append(licenses)) {
+#if LICENSEPP_EXCEPTIONS
+            throw LicenseException("Failed to record licenses in issuance log " + issuanceLog->path());
+#else
+            return std::vector<License>();
+#endif
+        }
+        return licenses;
+    }
+
+    ///
+    /// \brief Same as issue() but reports failure with error instead of exception, so code
+    /// built with -fno-exceptions can tell that license was not recorded in issuance log
+    /// \param license Issued license, only set when result is LicenseError::None
+    /// \return LicenseError::UnknownAuthority if issuingAuthority is null, LicenseError::Internal
+    /// if license could not be issued or recorded in issuance log
+    ///
+    LicenseError tryIssue(License* license,
+                          const std::string& licensee,
+                          unsigned int validityPeriod,
+                          const IssuingAuthority* issuingAuthority,
+                          const std::string& issuingAuthoritySecret = "",
+                          const std::string& licenseeSignature = "",
+                          const std::string& additionalPayload = "",
+                          const Entitlements& entitlements = Entitlements()) const noexcept
     {
-        return issuingAuthority->issue(licensee, validityPeriod, keydec(),
-                                       issuingAuthoritySecret, licenseeSignature,
-                                       additionalPayload);
+        if (issuingAuthority == nullptr) {
+            return LicenseError::UnknownAuthority;
+        }
+#if LICENSEPP_EXCEPTIONS
+        try {
+#endif
+            License issued = issuingAuthority->issue(licensee, validityPeriod, keydec(),
+                                                     issuingAuthoritySecret, licenseeSignature,
+                                                     additionalPayload, entitlements);
+            IssuanceLog* issuanceLog = m_issuanceLog.load(std::memory_order_acquire);
+            if (issuanceLog != nullptr && !issuanceLog->append(issued)) {
+                return LicenseError::Internal;
+            }
+            *license = std::move(issued);
+#if LICENSEPP_EXCEPTIONS
+        } catch (const std::exception&) {
+            return LicenseError::Internal;
+        }
+#endif
+        return LicenseError::None;
+    }
+
+    ///
+    /// \brief Same as issueBatch() but reports failure with error instead of exception
+    /// \param licenses Issued licenses, only set when result is LicenseError::None
+    ///
+    LicenseError tryIssueBatch(std::vector<License>* licenses,
+                               const std::vector<std::string>& licensees,
+                               unsigned int validityPeriod,
+                               const IssuingAuthority* issuingAuthority,
+                               const std::string& issuingAuthoritySecret = "",
+                               const std::string& licenseeSignature = "",
+                               const std::string& additionalPayload = "",
+                               const Entitlements& entitlements = Entitlements()) const noexcept
+    {
+        if (issuingAuthority == nullptr) {
+            return LicenseError::UnknownAuthority;
+        }
+#if LICENSEPP_EXCEPTIONS
+        try {
+#endif
+            std::vector<License> issued = issuingAuthority->issueBatch(licensees, validityPeriod, keydec(),
+                                                                       issuingAuthoritySecret, licenseeSignature,
+                                                                       additionalPayload, entitlements);
+            IssuanceLog* issuanceLog = m_issuanceLog.load(std::memory_order_acquire);
+            if (issuanceLog != nullptr && !issuanceLog->append(issued)) {
+                return LicenseError::Internal;
+            }
+            licenses->swap(issued);
+#if LICENSEPP_EXCEPTIONS
+        } catch (const std::exception&) {
+            return LicenseError::Internal;
+        }
+#endif
+        return LicenseError::None;
     }
 
     ///
@@ -117,11 +252,109 @@ public:
     /// \param licenseeSignature Plain signature from licensee
     /// \return True if license is still valid
     ///
+#if LICENSEPP_EXCEPTIONS
+    bool validate(const License* license,
+                  bool verifyLicenseeSignature,
+                  const std::string& licenseeSignature = "") const
+    {
+        ValidationRecorder* recorder = m_recorder.load(std::memory_order_acquire);
+        if (recorder == nullptr) {
+            return validateLicense(license, verifyLicenseeSignature, licenseeSignature);
+        }
+        const uint64_t started = ValidationRecorder::clock();
+        bool result = false;
+        try {
+            result = validateLicense(license, verifyLicenseeSignature, licenseeSignature);
+        } catch (...) {
+            recorder->record(license, verifyLicenseeSignature, !licenseeSignature.empty(),
+                             started, ValidationRecorder::Exception);
+            throw;
+        }
+        recorder->record(license, verifyLicenseeSignature, !licenseeSignature.empty(), started,
+                         result ? ValidationRecorder::Valid : ValidationRecorder::Invalid);
+        return result;
+    }
+#else
+    // without exceptions unknown issuing authority is invalid license
     bool validate(const License* license,
                   bool verifyLicenseeSignature,
                   const std::string& licenseeSignature = "") const
     {
-        const IssuingAuthority* issuingAuthority = getIssuingAuthority(license);
+        return tryValidate(license, verifyLicenseeSignature, licenseeSignature) == LicenseError::None;
+    }
+#endif
+
+    ///
+    /// \brief Same as validate() but reports why license is not valid instead of throwing
+    /// or writing to stderr
+    ///
+    /// Failures do not unwind exceptions so this is what to use for untrusted input, and it
+    /// can be used by code built with -fno-exceptions (with License::tryLoad())
+    ///
+    /// \return LicenseError::None if license is valid
+    ///
+    LicenseError tryValidate(const License* license,
+                             bool verifyLicenseeSignature,
+                             const std::string& licenseeSignature = "") const noexcept
+    {
+        ValidationRecorder* recorder = m_recorder.load(std::memory_order_acquire);
+        const uint64_t started = recorder == nullptr ? 0 : ValidationRecorder::clock();
+        const Authority* issuingAuthority = getIssuingAuthority(license);
+        const LicenseError error = issuingAuthority == nullptr
+                ? LicenseError::UnknownAuthority
+                : issuingAuthority->tryValidate(license, keydec(), verifyLicenseeSignature, licenseeSignature,
+                                                m_negativeCache.load(std::memory_order_acquire));
+        if (recorder != nullptr) {
+            // recorded same as validate() would have ended
+            recorder->record(license, verifyLicenseeSignature, !licenseeSignature.empty(), started,
+                             error == LicenseError::None ? ValidationRecorder::Valid
+                             : error == LicenseError::UnknownAuthority ? ValidationRecorder::Exception
+                             : ValidationRecorder::Invalid);
+        }
+        return error;
+    }
+
+    ///
+    /// \brief Records every validate() call to recorder, nullptr stops recording
+    ///
+    /// Recorder must outlive recording, see licensepp-replay to replay recorded trace
+    ///
+    void setRecorder(ValidationRecorder* recorder)
+    {
+        m_recorder.store(recorder, std::memory_order_release);
+    }
+
+    ///
+    /// \brief Remembers licenses that fail authority signature verification so validate()
+    /// and tryValidate() reject them again without it, nullptr stops using cache
+    ///
+    /// Cache must outlive its use, it can be shared by license managers with same key register
+    ///
+    void setNegativeCache(NegativeCache* negativeCache)
+    {
+        m_negativeCache.store(negativeCache, std::memory_order_release);
+    }
+
+    ///
+    /// \brief Records every license issued by issue() and issueBatch() to issuance log, they
+    /// return after record is durable. nullptr stops recording
+    ///
+    /// Log must outlive its use, it can be shared by license managers
+    ///
+    void setIssuanceLog(IssuanceLog* issuanceLog)
+    {
+        m_issuanceLog.store(issuanceLog, std::memory_order_release);
+    }
+private:
+    BaseLicenseManager(const BaseLicenseManager&) = delete;
+    BaseLicenseManager& operator=(const BaseLicenseManager&) = delete;
+
+#if LICENSEPP_EXCEPTIONS
+    bool validateLicense(const License* license,
+                         bool verifyLicenseeSignature,
+                         const std::string& licenseeSignature) const
+    {
+        const Authority* issuingAuthority = getIssuingAuthority(license);
         if (issuingAuthority == nullptr) {
             throw LicenseException("Issuing authority [" +
                                    license->issuingAuthorityId() + "] not found");
@@ -132,24 +365,31 @@ public:
                       << " cannot issue new licenses. Please update your license."
                       << std::endl;
         }
-        return issuingAuthority->validate(license, keydec(), verifyLicenseeSignature, licenseeSignature);
+        return issuingAuthority->validate(license, keydec(), verifyLicenseeSignature, licenseeSignature,
+                                          m_negativeCache.load(std::memory_order_acquire));
     }
-private:
-    BaseLicenseManager(const BaseLicenseManager&) = delete;
-    BaseLicenseManager& operator=(const BaseLicenseManager&) = delete;
+#endif
 
     ///
     /// \brief Decode signature key
     ///
-    inline std::string keydec() const
+    /// Decoded key is written to per-thread buffer that is reused for every call
+    ///
+    inline const std::string& keydec() const
     {
-        const std::string b16list = "0123456789ABCDEF";
-        std::stringstream ss;
+        static const char* kB16List = "0123456789ABCDEF";
+        static thread_local std::string key;
+        key.clear();
         for (const auto c : LicenseKeysRegister::LICENSE_MANAGER_SIGNATURE_KEY) {
-            ss << b16list[c >> 4] << b16list[c & 0xf];
+            key.push_back(kB16List[c >> 4]);
+            key.push_back(kB16List[c & 0xf]);
         }
-        return ss.str();
+        return key;
     }
+
+    std::atomic<ValidationRecorder*> m_recorder;
+    std::atomic<NegativeCache*> m_negativeCache;
+    std::atomic<IssuanceLog*> m_issuanceLog;
 };
 }
 #endif // LICENSEPP_BaseLicenseManager_h
@@ -3,6 +3,28 @@
 
 #include <stdint.h>
 
+// Error codes returned by *_status() functions (same as licensepp::LicenseError).
+// No function in C bindings lets exception through, failures (including out of
+// memory) are reported with return value (NULL, 0 or LICENSEPP_ERROR_INTERNAL).
+// license_set_*() leave license unchanged if value cannot be copied
+#define LICENSEPP_ERROR_NONE 0
+#define LICENSEPP_ERROR_INVALID_BASE64 1
+#define LICENSEPP_ERROR_INVALID_FORMAT 2
+#define LICENSEPP_ERROR_UNKNOWN_AUTHORITY 3
+#define LICENSEPP_ERROR_KEY_NOT_AVAILABLE 4
+#define LICENSEPP_ERROR_INVALID_AUTHORITY_KEY 5
+#define LICENSEPP_ERROR_INVALID_AUTHORITY_SIGNATURE 6
+#define LICENSEPP_ERROR_EXPIRED 7
+#define LICENSEPP_ERROR_LICENSEE_SIGNATURE_REQUIRED 8
+#define LICENSEPP_ERROR_INVALID_LICENSEE_SIGNATURE 9
+#define LICENSEPP_ERROR_INTERNAL 10
+
+#ifdef __cplusplus
+extern "C"
+#endif
+    const char*
+    license_error_message(int error);
+
 // License
 #ifdef __cplusplus
 extern "C"
@@ -22,6 +44,12 @@ extern "C"
     int
     license_load(void* license, const char* license_contents_base64);
 
+#ifdef __cplusplus
+extern "C"
+#endif
+    int
+    license_load_status(void* license, const char* license_contents_base64);
+
 #ifdef __cplusplus
 extern "C"
 #endif
@@ -110,6 +138,31 @@ extern "C"
     const char*
     license_get_additional_payload(const void* license);
 
+#ifdef __cplusplus
+extern "C"
+#endif
+    int
+    license_has_feature(const void* license, const char* feature);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+    int64_t
+    license_get_limit(const void* license, const char* name,
+                      int64_t default_value);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+    uint64_t
+    license_get_module_expiry(const void* license, const char* module);
+
+#ifdef __cplusplus
+extern "C"
+#endif
+    uint32_t
+    license_get_key_id(const void* license);
+
 // Issuing Authority
 #ifdef __cplusplus
 extern "C"
@@ -188,6 +241,15 @@ extern "C"
     license_manager_get_issuing_authority(const void* license_manager,
                                           const void* license);
 
+// Authority returned by license_manager_get_issuing_authority() stays valid
+// when license_key_register_init() replaces its register, until it is
+// released (once for every time it was returned)
+#ifdef __cplusplus
+extern "C"
+#endif
+    void
+    license_manager_release_issuing_authority(const void* issuing_authority);
+
 #ifdef __cplusplus
 extern "C"
 #endif
@@ -207,6 +269,15 @@ extern "C"
                              int verify_licensee_signature,
                              const char* licensee_signature);
 
+#ifdef __cplusplus
+extern "C"
+#endif
+    int
+    license_manager_validate_status(const void* license_manager,
+                                    const void* license,
+                                    int verify_licensee_signature,
+                                    const char* licensee_signature);
+
 typedef struct IssuingAuthorityParameters {
   const char* authority_id;
   const char* authority_name;
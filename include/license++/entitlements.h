@@ -0,0 +1,152 @@
+//
+//  entitlements.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_Entitlements_h
+#define LICENSEPP_Entitlements_h
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace licensepp {
+
+///
+/// \brief Feature flags, numeric limits and module expiries granted by license
+///
+/// Entitlements are part of license raw format so they are signed by issuing authority.
+/// Lookups do not parse anything; names are compiled to flat arrays sorted by hash when
+/// entitlements are created (i.e, when license is loaded) and feature flags are
+/// additionally kept in a bitset so most missing features are rejected with single load.
+///
+/// <pre>
+/// if (license.entitlements().hasFeature("export")) {
+///     ...
+/// }
+/// int64_t seats = license.entitlements().limit("seats");
+/// </pre>
+///
+class Entitlements
+{
+public:
+    using Limits = std::map<std::string, int64_t>;
+    using ModuleExpiries = std::map<std::string, uint64_t>;
+
+    Entitlements();
+    Entitlements(std::vector<std::string> features,
+                 const Limits& limits,
+                 const ModuleExpiries& moduleExpiries);
+
+    ///
+    /// \brief Adds feature flag. Index is rebuilt so prefer constructor for many entries
+    ///
+    Entitlements& addFeature(const std::string& feature);
+
+    Entitlements& setLimit(const std::string& name, int64_t value);
+
+    Entitlements& setModuleExpiry(const std::string& module, uint64_t expiryDate);
+
+    bool hasFeature(const char* feature, std::size_t size) const;
+
+    inline bool hasFeature(const char* feature) const
+    {
+        return hasFeature(feature, std::strlen(feature));
+    }
+
+    inline bool hasFeature(const std::string& feature) const
+    {
+        return hasFeature(feature.data(), feature.size());
+    }
+
+    ///
+    /// \brief Returns limit or defaultValue if license does not set this limit
+    ///
+    int64_t limit(const char* name, std::size_t size, int64_t defaultValue) const;
+
+    inline int64_t limit(const char* name, int64_t defaultValue = 0) const
+    {
+        return limit(name, std::strlen(name), defaultValue);
+    }
+
+    inline int64_t limit(const std::string& name, int64_t defaultValue = 0) const
+    {
+        return limit(name.data(), name.size(), defaultValue);
+    }
+
+    ///
+    /// \brief Returns module expiry date (epoch seconds) or 0 if license does not have this module
+    ///
+    uint64_t moduleExpiry(const char* module, std::size_t size) const;
+
+    inline uint64_t moduleExpiry(const char* module) const
+    {
+        return moduleExpiry(module, std::strlen(module));
+    }
+
+    inline uint64_t moduleExpiry(const std::string& module) const
+    {
+        return moduleExpiry(module.data(), module.size());
+    }
+
+    ///
+    /// \brief Sorted feature names
+    ///
+    inline const std::vector<std::string>& features() const
+    {
+        return m_features;
+    }
+
+    ///
+    /// \brief Limits sorted by name
+    ///
+    inline const std::vector<std::pair<std::string, int64_t>>& limits() const
+    {
+        return m_limits;
+    }
+
+    ///
+    /// \brief Module expiries sorted by module name
+    ///
+    inline const std::vector<std::pair<std::string, uint64_t>>& moduleExpiries() const
+    {
+        return m_moduleExpiries;
+    }
+
+    inline bool empty() const
+    {
+        return m_features.empty() && m_limits.empty() && m_moduleExpiries.empty();
+    }
+
+private:
+    struct IndexEntry
+    {
+        uint64_t hash;
+        uint32_t position;
+    };
+
+    static const std::size_t kFeatureBits = 256;
+
+    void compile();
+    const IndexEntry* find(const std::vector<IndexEntry>& index, uint64_t hash) const;
+
+    std::vector<std::string> m_features;
+    std::vector<std::pair<std::string, int64_t>> m_limits;
+    std::vector<std::pair<std::string, uint64_t>> m_moduleExpiries;
+
+    // compiled index, each sorted by hash and pointing to position in vectors above
+    uint64_t m_featureBits[kFeatureBits / 64];
+    std::vector<IndexEntry> m_featureIndex;
+    std::vector<IndexEntry> m_limitIndex;
+    std::vector<IndexEntry> m_moduleIndex;
+};
+}
+
+#endif /* LICENSEPP_Entitlements_h */
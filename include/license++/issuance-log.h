@@ -0,0 +1,172 @@
+//
+//  issuance-log.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_IssuanceLog_h
+#define LICENSEPP_IssuanceLog_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace licensepp {
+
+class License;
+
+///
+/// \brief Durable append-only audit log of issued licenses
+///
+/// <pre>
+/// IssuanceLog issuanceLog("/var/lib/myapp/issuance.log");
+/// licenseManager.setIssuanceLog(&issuanceLog);
+/// License license = licenseManager.issue(...); // returns once license is on disk
+/// </pre>
+///
+/// Every license issued through license manager is recorded with its fingerprint (SHA-256 of
+/// full raw license), issuing authority, licensee, issue and expiry date and time it was
+/// logged, and issue() does not return before the record is on disk.
+///
+/// Concurrent issues are group committed: background thread writes records that are waiting
+/// (up to maxBatch) with one write() and one fdatasync(), and records that arrive while batch
+/// is being synced go to the next batch. By default batch is written as soon as previous one
+/// is synced; maxDelayUs > 0 also waits up to that long after first record of batch arrived
+/// (or until batch has maxBatch records) so more records share the sync, which bounds
+/// latency it adds to issue().
+///
+/// Each record ends with SHA-256 of previous record hash and the record itself, so changing,
+/// removing or reordering records breaks the chain and verify() (licensepp-verify-issuance-log)
+/// reports first broken record. Keep head() of verified log elsewhere to also detect records
+/// removed from the end.
+///
+/// \note Only available on unix. One process may append to a log at a time
+///
+class IssuanceLog
+{
+public:
+    struct Record
+    {
+        uint64_t sequence;
+        uint64_t loggedAtUs;    // wall clock when record was written
+        uint64_t issueDate;
+        uint64_t expiryDate;
+        std::string fingerprint; // hex SHA-256 of License::raw(true)
+        std::string issuingAuthorityId;
+        std::string licensee;
+        std::string hash;        // hex chain hash up to and including this record
+    };
+
+    struct Verification
+    {
+        bool valid;
+        uint64_t records;
+        ///
+        /// \brief Hex hash of last valid record (log header hash for empty log)
+        ///
+        std::string head;
+        ///
+        /// \brief Offset of first record that is incomplete or breaks the chain (end of log if valid)
+        ///
+        uint64_t brokenAt;
+        std::string error;
+    };
+
+    ///
+    /// \brief Opens (or creates) log. Incomplete record at end of log (crash during write) is
+    /// removed, chain of existing records is checked
+    /// \param maxDelayUs Longest time batch waits for more records before it is written
+    /// \param maxBatch Most records written with one sync
+    /// \throws LicenseException if log cannot be opened or its chain is broken
+    ///
+    explicit IssuanceLog(const std::string& path, unsigned int maxDelayUs = 0,
+                         std::size_t maxBatch = 4096);
+
+    ///
+    /// \brief Writes records that are waiting and closes the log
+    ///
+    ~IssuanceLog();
+
+    IssuanceLog(const IssuanceLog&) = delete;
+    IssuanceLog& operator=(const IssuanceLog&) = delete;
+
+    ///
+    /// \brief Appends record of license and waits until it is durable
+    /// \return False if record could not be written; log refuses further appends
+    ///
+    bool append(const License& license);
+
+    ///
+    /// \brief Appends records of licenses in one batch and waits until they are durable
+    ///
+    bool append(const std::vector<License>& licenses);
+
+    ///
+    /// \brief Number of durable records
+    ///
+    uint64_t size() const;
+
+    ///
+    /// \brief Hex hash of last durable record
+    ///
+    std::string head() const;
+
+    ///
+    /// \brief Number of batches written (i.e, fdatasync calls)
+    ///
+    uint64_t commits() const;
+
+    inline const std::string& path() const
+    {
+        return m_path;
+    }
+
+    ///
+    /// \brief Checks framing and hash chain of every record
+    /// \param records If not null, valid records are added to it
+    ///
+    static Verification verify(const std::string& path, std::vector<Record>* records = nullptr);
+
+private:
+    struct Pending
+    {
+        std::string fingerprint;
+        std::string issuingAuthorityId;
+        std::string licensee;
+        uint64_t issueDate;
+        uint64_t expiryDate;
+    };
+
+    bool append(std::vector<Pending>* records);
+    void commitLoop();
+
+    std::string m_path;
+    unsigned int m_maxDelayUs;
+    std::size_t m_maxBatch;
+    int m_fd;
+    uint64_t m_size;        // bytes, only touched by writer thread after opening
+    std::string m_chain;    // raw hash of last written record, only touched by writer thread
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_pendingReady;
+    std::condition_variable m_committed;
+    std::vector<Pending> m_pending;
+    std::chrono::steady_clock::time_point m_batchStarted;
+    uint64_t m_queued;      // sequence of last queued record
+    uint64_t m_durable;     // sequence of last durable record
+    uint64_t m_commits;
+    std::string m_head;
+    bool m_failed;
+    bool m_stopping;
+    std::thread m_writer;
+};
+}
+
+#endif /* LICENSEPP_IssuanceLog_h */
@@ -10,23 +10,46 @@
 #ifndef LICENSEPP_IssuingAuthority_h
 #define LICENSEPP_IssuingAuthority_h
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <license++/license.h>
+#include <license++/negative-cache.h>
 
 namespace licensepp {
 
+class RSAPublicKey;
+
 ///
 /// \brief License issuing authority
 ///
+/// Authority can verify licenses signed with more than one key. Licenses are stamped with
+/// key ID of the keypair that signed them (unless it is 0) and verified with public key
+/// registered for that key ID. This is how keys are rotated:
+/// <pre>
+/// // keypair with key id 2 signs new licenses, licenses signed with key 1 and licenses
+/// // issued before key ids (key id 0) are still valid
+/// IssuingAuthority("authority_id", "<authority name>", "<new keypair>", 8760U, true, 2)
+///     .addPublicKey(1, "<public key 1>")
+///     .addPublicKey(0, "<original public key>"),
+/// </pre>
+///
 class IssuingAuthority
 {
 public:
+    ///
+    /// \param keyId Key ID of keypair. Licenses signed with it are stamped with this ID
+    ///
     IssuingAuthority(const std::string& id, const std::string& name,
                      const std::string& keypair, unsigned int maxValidity,
-                     bool active = true);
+                     bool active = true, uint32_t keyId = 0);
 
     IssuingAuthority(const IssuingAuthority&);
-    IssuingAuthority& operator=(IssuingAuthority);
+    IssuingAuthority(IssuingAuthority&&) noexcept;
+    IssuingAuthority& operator=(const IssuingAuthority&);
+    IssuingAuthority& operator=(IssuingAuthority&&) noexcept;
 
     inline const std::string& id() const
     {
@@ -48,6 +71,30 @@ public:
         return m_maxValidity;
     }
 
+    ///
+    /// \brief Key ID of keypair that signs new licenses
+    ///
+    inline uint32_t keyId() const
+    {
+        return m_keyId;
+    }
+
+    ///
+    /// \brief Registers (older) public key to verify licenses stamped with keyId
+    /// \param publicKey Base64 encoded public key, i.e, second part of keypair
+    ///
+    IssuingAuthority& addPublicKey(uint32_t keyId, const std::string& publicKey);
+
+    ///
+    /// \brief Licenses stamped with this keyId are no longer valid
+    ///
+    IssuingAuthority& retirePublicKey(uint32_t keyId);
+
+    inline bool hasPublicKey(uint32_t keyId) const
+    {
+        return m_publicKeys.find(keyId) != m_publicKeys.end();
+    }
+
     ///
     /// \brief Issue a new license
     /// \param licensee Name of license holder
@@ -55,6 +102,7 @@ public:
     /// \param masterKey The decrypted master key
     /// \param secret Secret for issuing authority RSA keypair
     /// \param licenseeSignature Licensee signature to make license even more secure
+    /// \param entitlements Features, limits and module expiries signed with license
     /// \return New license object
     /// \note Do not use this function directly. Use BaseLicenseManager::issue()
     ///
@@ -63,7 +111,27 @@ public:
                   const std::string& masterKey,
                   const std::string& secret = "",
                   const std::string& licenseeSignature = "",
-                  const std::string& additionalPayload = "") const;
+                  const std::string& additionalPayload = "",
+                  const Entitlements& entitlements = Entitlements()) const;
+
+    ///
+    /// \brief Issues licenses for all licensees with one RSA signature
+    ///
+    /// Licenses are hashed in to Merkle tree and only root of the tree is signed. Each
+    /// license carries root signature as authority signature and its inclusion proof
+    /// (License::batchProof()). Validating batch signed license verifies the proof and
+    /// signature of root, which is then cached so rest of the batch is not RSA verified again.
+    /// Parameters other than licensees are same as issue() and apply to every license
+    /// \return Licenses in order of licensees
+    /// \note Do not use this function directly. Use BaseLicenseManager::issueBatch()
+    ///
+    std::vector<License> issueBatch(const std::vector<std::string>& licensees,
+                                    unsigned int validityPeriod,
+                                    const std::string& masterKey,
+                                    const std::string& secret = "",
+                                    const std::string& licenseeSignature = "",
+                                    const std::string& additionalPayload = "",
+                                    const Entitlements& entitlements = Entitlements()) const;
 
     ///
     /// \brief validate Validates license
@@ -71,19 +139,77 @@ public:
     /// \param masterKey The decrypted master key
     /// \param validateSignature Should signature be validated
     /// \param licenseeSignature If validateSignature what is the licensee signature
+    /// \param negativeCache Optional cache of licenses that failed authority signature verification
     /// \return True if license is valid and false if license is expired
     /// \note Do not use this function directly. Use BaseLicenseManager::validate()
     ///
     bool validate(const License* license,
                   const std::string& masterKey,
                   bool validateSignature,
-                  const std::string& licenseeSignature = "") const;
+                  const std::string& licenseeSignature = "",
+                  NegativeCache* negativeCache = nullptr) const;
+
+    ///
+    /// \brief Same as validate() but reports why license is not valid, without writing to
+    /// stderr or throwing
+    /// \return LicenseError::None if license is valid
+    /// \note Do not use this function directly. Use BaseLicenseManager::tryValidate()
+    ///
+    LicenseError tryValidate(const License* license,
+                             const std::string& masterKey,
+                             bool validateSignature,
+                             const std::string& licenseeSignature = "",
+                             NegativeCache* negativeCache = nullptr) const noexcept;
+
+    ///
+    /// \brief Only verifies authority signature (with key the license was signed with)
+    ///
+    /// Unlike validate(), this does not check expiry or licensee signature and does not
+    /// write anything to stderr so it can be used to scan large number of licenses
+    ///
+    bool verifySignature(const License* license) const;
+
+    ///
+    /// \brief verifySignature() of n licenses, results[i] is result for licenses[i]
+    ///
+    /// Faster than verifySignature() of each license when crypto backend verifies digests
+    /// (OpenSSL), as licenses are hashed together with AVX2 where CPU has it
+    ///
+    void verifySignatures(const License* const* licenses, std::size_t n, bool* results) const;
 private:
+    License issueLicense(const std::string& licensee,
+                         unsigned int validityPeriod,
+                         const std::string& masterKey,
+                         const std::string& secret,
+                         const std::string& licenseeSignature,
+                         const std::string& additionalPayload,
+                         const Entitlements& entitlements) const;
+
+    ///
+    /// \brief Validated license that is not signed yet
+    ///
+    License prepareLicense(const std::string& licensee,
+                           unsigned int validityPeriod,
+                           const std::string& masterKey,
+                           const std::string& licenseeSignature,
+                           const std::string& additionalPayload,
+                           const Entitlements& entitlements) const;
+
+    std::string sign(const std::string& data, const std::string& secret) const;
+
+    ///
+    /// \brief Parsed public key for keyId, nullptr if authority does not have it
+    ///
+    const RSAPublicKey* publicKey(uint32_t keyId) const;
+
     std::string m_id;
     std::string m_name;
     std::string m_keypair;
+    // public keys by key id, parsed once (shared by copies) so validate() does not parse them
+    std::unordered_map<uint32_t, std::shared_ptr<const RSAPublicKey>> m_publicKeys;
     bool m_active;
     unsigned int m_maxValidity;
+    uint32_t m_keyId;
 };
 }
 
@@ -0,0 +1,84 @@
+//
+//  lease-client.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LeaseClient_h
+#define LICENSEPP_LeaseClient_h
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <license++/lease-server.h>
+
+namespace licensepp {
+
+///
+/// \brief Client for licensepp-leased, the floating license lease server
+///
+/// <pre>
+/// LeaseClient client;
+/// uint64_t leaseId;
+/// if (client.acquire("licensee", 30000, &leaseId) == LeaseStatus::Granted) {
+///     ... // client.renew(leaseId, 30000) every few seconds
+///     client.release(leaseId);
+/// }
+/// </pre>
+///
+/// Connection is opened on first request and kept open; requests of all threads are sent
+/// over it one at a time. Use one client per thread to lease from many threads at once.
+/// Unlike VerifyClient there is no in-process fallback, LeaseStatus::Unavailable means
+/// no seat is held.
+///
+class LeaseClient
+{
+public:
+    static const char* kDefaultSocketPath;
+
+    ///
+    /// \param socketPath Path to server UNIX socket
+    /// \param timeoutMs Send / receive timeout before server is considered unavailable
+    ///
+    explicit LeaseClient(const std::string& socketPath = kDefaultSocketPath,
+                         unsigned int timeoutMs = 500U);
+    ~LeaseClient();
+
+    LeaseClient(const LeaseClient&) = delete;
+    LeaseClient& operator=(const LeaseClient&) = delete;
+
+    ///
+    /// \brief Takes one seat of licensee's floating license
+    /// \param ttlMs Lease expires unless renewed within this time
+    /// \param grantedTtlMs If not null, time-to-live that server granted (capped by server)
+    /// \param seatsAvailable If not null, seats that are still free
+    ///
+    LeaseStatus acquire(const std::string& licensee, uint32_t ttlMs, uint64_t* leaseId,
+                        uint32_t* grantedTtlMs = nullptr, uint32_t* seatsAvailable = nullptr);
+
+    LeaseStatus renew(uint64_t leaseId, uint32_t ttlMs, uint32_t* grantedTtlMs = nullptr);
+
+    LeaseStatus release(uint64_t leaseId);
+
+    inline const std::string& socketPath() const
+    {
+        return m_socketPath;
+    }
+
+private:
+    LeaseStatus call(uint8_t opcode, const std::string& licensee, uint32_t ttlMs, uint64_t* leaseId,
+                     uint32_t* grantedTtlMs, uint32_t* seatsAvailable);
+    bool connect();
+    void disconnect();
+
+    std::string m_socketPath;
+    unsigned int m_timeoutMs;
+    std::mutex m_mutex;
+    int m_fd;
+};
+}
+
+#endif /* LICENSEPP_LeaseClient_h */
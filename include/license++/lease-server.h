@@ -0,0 +1,249 @@
+//
+//  lease-server.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LeaseServer_h
+#define LICENSEPP_LeaseServer_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Result of lease operation
+///
+enum class LeaseStatus : uint8_t
+{
+    Granted = 0,
+    NoSeatAvailable = 1,
+    UnknownPool = 2,
+    UnknownLease = 3,
+    LicenseExpired = 4,
+    InvalidRequest = 5,
+    Unavailable = 255 // LeaseClient only, server could not be reached
+};
+
+///
+/// \brief Time-bounded hold of one seat of floating license
+///
+struct Lease
+{
+    uint64_t id;
+    ///
+    /// \brief Milliseconds of LeaseServer::now() when lease expires unless renewed
+    ///
+    uint64_t expiresAt;
+    uint32_t ttlMs;
+};
+
+///
+/// \brief Grants, renews and expires leases on seats of floating licenses
+///
+/// Floating license declares number of concurrent seats with signed "seats" limit of its
+/// entitlements. Each license that is added becomes seat pool and every lease holds one
+/// seat until it is released or its time-to-live passes without renewal.
+///
+/// <pre>
+/// LeaseServer leaseServer;
+/// if (licenseManager.validate(&license, false)) {
+///     pool = leaseServer.addLicense(license);
+/// }
+/// leaseServer.start(); // reclaims expired leases in background
+///
+/// Lease lease;
+/// if (leaseServer.acquire(pool, 30000, &lease) == LeaseStatus::Granted) {
+///     ... // renew(lease.id, 30000, &lease) before lease.expiresAt, release(lease.id) when done
+/// }
+/// </pre>
+///
+/// Seats in use are counted with compare-and-swap per pool so seat accounting never blocks
+/// and never grants more seats than license declares. Leases are kept in table sharded by
+/// lease ID, each shard with its own lock, and acquiring thread picks shard by its thread ID
+/// so threads rarely wait for each other. Expired leases are reclaimed by timer wheel of
+/// each shard (kWheelSlots slots of tickMs) in O(expired leases); renewal only updates
+/// expiry and lease is moved to later slot when its slot comes up. Lease IDs are random
+/// (keyed hash), so a client cannot guess IDs of other clients' leases.
+///
+/// Lease operations and expire() are safe to call from any thread. addLicense() must not
+/// run while leases are acquired, i.e, add all licenses before serving. Over UNIX socket
+/// see LeaseClient and licensepp-leased.
+///
+class LeaseServer
+{
+public:
+    ///
+    /// \brief Monotonic clock in milliseconds (tests use fake clock)
+    ///
+    using Clock = uint64_t (*)();
+
+    static const uint32_t kInvalidPool = UINT32_MAX;
+    static const uint32_t kMaxTtlMs = 24U * 3600U * 1000U;
+    static const std::size_t kWheelSlots = 512;
+
+    ///
+    /// \param maxPools Number of licenses that can be added
+    /// \param shards Number of lease table shards, rounded up to power of two
+    /// \param tickMs Timer wheel resolution, leases are reclaimed at most this late
+    /// \param clock Milliseconds clock, nullptr for std::chrono::steady_clock
+    ///
+    explicit LeaseServer(std::size_t maxPools = 64, std::size_t shards = 64,
+                         unsigned int tickMs = 100U, Clock clock = nullptr);
+    ~LeaseServer();
+
+    LeaseServer(const LeaseServer&) = delete;
+    LeaseServer& operator=(const LeaseServer&) = delete;
+
+    ///
+    /// \brief Adds seat pool for (validated) floating license
+    /// \return Pool ID, or kInvalidPool if license does not declare seats, licensee already
+    /// has pool or there is no room for more pools
+    ///
+    uint32_t addLicense(const License& license);
+
+    ///
+    /// \brief Pool ID of licensee or kInvalidPool
+    ///
+    uint32_t findPool(const std::string& licensee) const;
+
+    ///
+    /// \brief Takes one seat of pool for ttlMs (capped to kMaxTtlMs)
+    ///
+    LeaseStatus acquire(uint32_t pool, uint32_t ttlMs, Lease* lease);
+
+    ///
+    /// \brief Extends lease to ttlMs from now. Lease that has expired can not be renewed, and
+    /// lease of license that has expired is released (LicenseExpired)
+    ///
+    LeaseStatus renew(uint64_t leaseId, uint32_t ttlMs, Lease* lease);
+
+    ///
+    /// \brief Returns seat of the lease to its pool
+    ///
+    LeaseStatus release(uint64_t leaseId);
+
+    ///
+    /// \brief Reclaims seats of leases that expired up to now
+    /// \return Number of leases reclaimed
+    ///
+    std::size_t expire();
+
+    ///
+    /// \brief Starts background thread that calls expire() every tick
+    ///
+    void start();
+
+    ///
+    /// \brief Stops background thread, leases are kept
+    ///
+    void stop();
+
+    uint64_t now() const;
+
+    ///
+    /// \brief Seats declared by license of the pool, 0 for unknown pool
+    ///
+    int64_t seats(uint32_t pool) const;
+
+    int64_t seatsInUse(uint32_t pool) const;
+
+    inline std::size_t pools() const
+    {
+        return m_poolCount.load(std::memory_order_acquire);
+    }
+
+    inline uint64_t granted() const
+    {
+        return m_granted.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t denied() const
+    {
+        return m_denied.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t reclaimed() const
+    {
+        return m_reclaimed.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Pool
+    {
+        std::string licensee;
+        int64_t seats;
+        uint64_t expiryDate;
+        std::atomic<int64_t> inUse;
+    };
+
+    struct Entry
+    {
+        uint32_t pool;
+        uint64_t expiresAt;
+        ///
+        /// \brief Wheel tick this lease is scheduled in, older wheel items are stale
+        ///
+        uint64_t tick;
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Entry> leases;
+        ///
+        /// \brief (lease ID, tick) per slot, a slot holds ticks that are kWheelSlots apart
+        ///
+        std::vector<std::vector<std::pair<uint64_t, uint64_t>>> wheel;
+        std::vector<std::pair<uint64_t, uint64_t>> scratch;
+        uint64_t nextTick;
+        uint64_t sequence;
+    };
+
+    void schedule(Shard* shard, uint64_t id, Entry* entry);
+    std::size_t expire(Shard* shard, uint64_t now);
+    void reclaim(const Entry& entry);
+
+    inline Shard& shardOf(uint64_t leaseId) const
+    {
+        return m_shards[leaseId & m_shardMask];
+    }
+
+    std::size_t m_maxPools;
+    std::unique_ptr<Pool[]> m_pools;
+    std::atomic<uint32_t> m_poolCount;
+    std::unordered_map<std::string, uint32_t> m_poolIndex;
+
+    std::size_t m_shardMask;
+    unsigned int m_shardBits;
+    std::unique_ptr<Shard[]> m_shards;
+    // SipHash key of lease IDs
+    uint64_t m_idKey[2];
+    unsigned int m_tickMs;
+    Clock m_clock;
+
+    std::atomic<uint64_t> m_granted;
+    std::atomic<uint64_t> m_denied;
+    std::atomic<uint64_t> m_reclaimed;
+
+    std::mutex m_timerMutex;
+    std::condition_variable m_timerWakeup;
+    bool m_timerRunning;
+    std::thread m_timer;
+};
+}
+
+#endif /* LICENSEPP_LeaseServer_h */
@@ -0,0 +1,139 @@
+//
+//  license-bundle.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseBundle_h
+#define LICENSEPP_LicenseBundle_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Read-only file of many licenses with sorted index
+///
+/// Bundle is header, index sorted by hash of key (licensee or license fingerprint) and
+/// contiguous records. It is memory-mapped so finding license is binary search of the
+/// index and only matching records are read (and decoded), which is what appliances that
+/// receive thousands of licenses want instead of thousands of license files.
+///
+/// <pre>
+/// LicenseBundle::write("licenses.lpb", licenses);
+///
+/// LicenseBundle bundle("licenses.lpb");
+/// License license;
+/// if (bundle.find("john-citizen", &license)) {
+///     licenseManager.validate(&license, false);
+/// }
+/// </pre>
+///
+/// \note Only available on unix
+///
+class LicenseBundle
+{
+public:
+    enum class KeyType : uint32_t
+    {
+        Licensee = 0,
+        Fingerprint = 1
+    };
+
+    ///
+    /// \brief Maps bundle file
+    /// \throws LicenseException if bundle cannot be opened or is not valid
+    ///
+    explicit LicenseBundle(const std::string& path);
+
+    ~LicenseBundle();
+
+    LicenseBundle(const LicenseBundle&) = delete;
+    LicenseBundle& operator=(const LicenseBundle&) = delete;
+
+    ///
+    /// \brief Writes licenses to bundle (to temporary file that is then renamed)
+    /// \throws LicenseException if bundle cannot be written
+    ///
+    static void write(const std::string& path, const std::vector<License>& licenses,
+                      KeyType keyType = KeyType::Licensee);
+
+    ///
+    /// \brief Hex SHA-256 of full raw license
+    ///
+    static std::string fingerprint(const License& license);
+
+    ///
+    /// \brief Loads first license with key (licenses with same key are kept in order they were written)
+    /// \return False if bundle does not have license with key
+    ///
+    bool find(const std::string& key, License* license) const;
+
+    ///
+    /// \brief All licenses with key
+    ///
+    std::vector<License> findAll(const std::string& key) const;
+
+    inline KeyType keyType() const
+    {
+        return m_keyType;
+    }
+
+    ///
+    /// \brief Number of licenses
+    ///
+    inline std::size_t size() const
+    {
+        return m_count;
+    }
+
+    ///
+    /// \brief Key of index-th license (in index order)
+    ///
+    std::string key(std::size_t index) const;
+
+    ///
+    /// \brief Base64 license at index, as it would be in license file
+    ///
+    std::string licenseBase64(std::size_t index) const;
+
+    License get(std::size_t index) const;
+
+    inline const std::string& path() const
+    {
+        return m_path;
+    }
+
+private:
+    struct Entry
+    {
+        const char* key;
+        uint32_t keySize;
+        const char* license;
+        uint32_t licenseSize;
+    };
+
+    Entry entry(std::size_t index) const;
+
+    ///
+    /// \brief First index entry with key, size() if there is none
+    ///
+    std::size_t lowerBound(const std::string& key) const;
+
+    std::string m_path;
+    void* m_map;
+    std::size_t m_mapSize;
+    KeyType m_keyType;
+    std::size_t m_count;
+    const unsigned char* m_index;
+};
+}
+
+#endif /* LICENSEPP_LicenseBundle_h */
@@ -0,0 +1,53 @@
+//
+//  license-error.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseError_h
+#define LICENSEPP_LicenseError_h
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#   define LICENSEPP_EXCEPTIONS 1
+#else
+#   define LICENSEPP_EXCEPTIONS 0
+#endif
+
+namespace licensepp {
+
+///
+/// \brief Result of exception-free API (License::tryLoad(), BaseLicenseManager::tryValidate() etc)
+///
+/// Values are stable, C bindings return them as LICENSEPP_ERROR_* codes
+///
+enum class LicenseError : int
+{
+    None = 0,
+    InvalidBase64 = 1,
+    ///
+    /// \brief Not JSON, or required field is missing or has wrong type
+    ///
+    InvalidFormat = 2,
+    UnknownAuthority = 3,
+    ///
+    /// \brief Authority does not have key license is stamped with (retired?)
+    ///
+    KeyNotAvailable = 4,
+    InvalidAuthorityKey = 5,
+    InvalidAuthoritySignature = 6,
+    Expired = 7,
+    ///
+    /// \brief License is signed by licensee but signature was not verified
+    ///
+    LicenseeSignatureRequired = 8,
+    InvalidLicenseeSignature = 9,
+    Internal = 10
+};
+
+const char* licenseErrorMessage(LicenseError error) noexcept;
+}
+
+#endif /* LICENSEPP_LicenseError_h */
@@ -0,0 +1,304 @@
+//
+//  license-pool.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicensePool_h
+#define LICENSEPP_LicensePool_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <license++/entitlements.h>
+#include <license++/license.h>
+#include <license++/license-error.h>
+
+namespace licensepp {
+
+///
+/// \brief Monotonic arena. Memory is handed out from large blocks and only freed all at
+/// once by release()
+///
+class LicenseArena
+{
+public:
+    static const std::size_t kDefaultBlockSize = 64 * 1024;
+
+    explicit LicenseArena(std::size_t blockSize = kDefaultBlockSize);
+    ~LicenseArena();
+
+    ///
+    /// \param alignment Power of two, at most alignof(std::max_align_t)
+    ///
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    ///
+    /// \brief Frees all the blocks, everything allocated from arena is gone
+    ///
+    void release();
+
+    ///
+    /// \brief Bytes of blocks that arena holds
+    ///
+    inline std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    LicenseArena(const LicenseArena&) = delete;
+    LicenseArena& operator=(const LicenseArena&) = delete;
+
+    std::size_t m_blockSize;
+    std::vector<char*> m_blocks;
+    char* m_current;
+    std::size_t m_remaining;
+    std::size_t m_capacity;
+};
+
+///
+/// \brief Stateful allocator of LicenseArena, deallocate() does nothing
+///
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(LicenseArena* arena) noexcept :
+        m_arena(arena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+        m_arena(other.arena())
+    {
+    }
+
+    inline T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    inline void deallocate(T*, std::size_t) noexcept
+    {
+    }
+
+    inline LicenseArena* arena() const noexcept
+    {
+        return m_arena;
+    }
+
+private:
+    LicenseArena* m_arena;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return a.arena() != b.arena();
+}
+
+///
+/// \brief License loaded by LicensePool, its strings are stored in arena of the pool
+///
+/// Read-only view with same accessors as License. To validate, copy it to (reused) License:
+/// <pre>
+/// License license;
+/// for (std::size_t i = 0; i < pool.size(); ++i) {
+///     pool.at(i)->copyTo(&license);
+///     licenseManager.validate(&license, false);
+/// }
+/// </pre>
+///
+class PooledLicense
+{
+public:
+    using String = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    inline const String& licensee() const
+    {
+        return m_licensee;
+    }
+
+    inline const String& issuingAuthorityId() const
+    {
+        return m_issuingAuthorityId;
+    }
+
+    inline const String& licenseeSignature() const
+    {
+        return m_licenseeSignature;
+    }
+
+    inline const String& authoritySignature() const
+    {
+        return m_authoritySignature;
+    }
+
+    inline const String& batchProof() const
+    {
+        return m_batchProof;
+    }
+
+    inline const String& additionalPayload() const
+    {
+        return m_additionalPayload;
+    }
+
+    inline uint64_t expiryDate() const
+    {
+        return m_expiryDate;
+    }
+
+    inline uint64_t issueDate() const
+    {
+        return m_issueDate;
+    }
+
+    inline uint32_t keyId() const
+    {
+        return m_keyId;
+    }
+
+    ///
+    /// \brief Entitlements, unlike strings these are stored on heap as they are compiled to index
+    ///
+    const Entitlements& entitlements() const;
+
+    ///
+    /// \brief Exact JSON license was loaded from, same as License::raw(true)
+    ///
+    inline const String& raw() const
+    {
+        return m_raw;
+    }
+
+    ///
+    /// \brief Copies license to license, i.e, License::load() of same input. Strings of license
+    /// are assigned so reused license does not allocate for them once they are large enough
+    ///
+    void copyTo(License* license) const;
+
+private:
+    friend class LicensePool;
+
+    explicit PooledLicense(LicenseArena* arena);
+    ~PooledLicense();
+    PooledLicense(const PooledLicense&) = delete;
+    PooledLicense& operator=(const PooledLicense&) = delete;
+
+    uint64_t m_issueDate;
+    uint64_t m_expiryDate;
+    uint32_t m_keyId;
+    String m_licensee;
+    String m_issuingAuthorityId;
+    String m_licenseeSignature;
+    String m_authoritySignature;
+    String m_batchProof;
+    String m_additionalPayload;
+    String m_raw;
+    // nullptr if license has no entitlements
+    Entitlements* m_entitlements;
+};
+
+///
+/// \brief Loads licenses in bulk in to monotonic arena
+///
+/// License objects and their strings are stored in large blocks instead of a heap
+/// allocation for each of them, and all of them are freed in one shot by release() or
+/// when the pool goes out of scope. Base64 and JSON are decoded in to buffers of the pool
+/// that are reused by next load.
+///
+/// <pre>
+/// LicensePool pool;
+/// std::vector<const PooledLicense*> licenses;
+/// pool.load(blobs, &licenses); // invalid blobs are skipped
+/// ...
+/// pool.release(); // all licenses are gone at this point
+/// </pre>
+///
+/// \note Pointers returned by the pool stay valid until release() is called.
+/// The pool itself is not thread-safe.
+///
+class LicensePool
+{
+public:
+    ///
+    /// \param blockSize Bytes of each arena block
+    ///
+    explicit LicensePool(std::size_t blockSize = LicenseArena::kDefaultBlockSize);
+    ~LicensePool();
+
+    ///
+    /// \brief Loads license from base64 input in to the pool
+    /// \throws LicenseException if license is invalid. Pool is left unchanged in this case
+    ///
+    const PooledLicense* load(const std::string& licenseBase64);
+
+    ///
+    /// \brief Same as load() but reports invalid license with error instead of exception
+    /// \param license Loaded license, only set when result is LicenseError::None
+    ///
+    LicenseError tryLoad(const std::string& licenseBase64, const PooledLicense** license) noexcept;
+
+    ///
+    /// \brief Loads all the base64 licenses. Invalid licenses are skipped
+    /// \param loaded If not null, loaded licenses are appended to it (in input order)
+    /// \return Number of licenses successfully loaded
+    ///
+    std::size_t load(const std::vector<std::string>& licensesBase64,
+                     std::vector<const PooledLicense*>* loaded = nullptr);
+
+    ///
+    /// \brief Destroys all the licenses in one shot and frees the arena
+    ///
+    void release();
+
+    ///
+    /// \brief Returns license at position (in order of loading)
+    ///
+    inline const PooledLicense* at(std::size_t index) const
+    {
+        return m_licenses[index];
+    }
+
+    inline std::size_t size() const
+    {
+        return m_licenses.size();
+    }
+
+    ///
+    /// \brief Bytes of arena blocks that the pool holds
+    ///
+    inline std::size_t capacity() const
+    {
+        return m_arena.capacity();
+    }
+
+private:
+    LicensePool(const LicensePool&) = delete;
+    LicensePool& operator=(const LicensePool&) = delete;
+
+    struct Scratch;
+
+    LicenseArena m_arena;
+    std::vector<PooledLicense*> m_licenses;
+    std::unique_ptr<Scratch> m_scratch;
+};
+}
+
+#endif /* LICENSEPP_LicensePool_h */
@@ -0,0 +1,165 @@
+//
+//  license-store.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseStore_h
+#define LICENSEPP_LicenseStore_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Embedded store of issued licenses
+///
+/// Licenses are appended to checksummed log (`licenses.log`) in store directory and
+/// looked up using three memory-mapped secondary indexes: licensee, issuing authority
+/// and expiry date. Indexes are sorted arrays (binary searched) so lookups and range
+/// scans only read matching records. Each record keeps licensee and authority next to
+/// the license so lookups do not decode licenses to rule out hash collisions.
+///
+/// Appends are written in one write() and synced by default. Licenses appended after
+/// indexes were last persisted (see flush()) are recovered from log when store is
+/// opened, and incomplete record at end of log (e.g, crash during append) is dropped
+/// after it is copied to `licenses.log.damaged.<offset>`. Store with invalid record
+/// anywhere else is not opened.
+///
+/// <pre>
+/// LicenseStore store("/var/lib/myapp/licenses");
+/// store.append(licenseManager.issue(...));
+/// for (LicenseStore::RecordId id : store.findExpiring(now, now + 30 * 86400)) {
+///     License license = store.get(id);
+/// }
+/// </pre>
+///
+/// \note Store is not thread-safe and only one process may open store directory at a time
+/// (log is locked, opening store that is in use throws).
+/// Only available on unix
+///
+class LicenseStore
+{
+public:
+    ///
+    /// \brief Position of record in log. Stays valid until compact()
+    ///
+    using RecordId = uint64_t;
+    using RecordIds = std::vector<RecordId>;
+
+    ///
+    /// \brief Opens (or creates) store in directory
+    /// \param syncAppends Whether every append() waits for data to reach the disk
+    /// \throws LicenseException if store cannot be opened
+    ///
+    explicit LicenseStore(const std::string& directory, bool syncAppends = true);
+
+    ///
+    /// \brief Persists indexes
+    ///
+    ~LicenseStore();
+
+    LicenseStore(const LicenseStore&) = delete;
+    LicenseStore& operator=(const LicenseStore&) = delete;
+
+    ///
+    /// \throws LicenseException if write fails (store is left as it was)
+    ///
+    RecordId append(const License& license);
+
+    ///
+    /// \throws LicenseException if id is not valid record
+    ///
+    License get(RecordId id) const;
+
+    ///
+    /// \brief Licensee of record without decoding license
+    ///
+    std::string licensee(RecordId id) const;
+
+    ///
+    /// \brief Records issued to licensee, in order of issue
+    ///
+    RecordIds findByLicensee(const std::string& licensee) const;
+
+    ///
+    /// \brief Records issued by authority, in order of issue
+    ///
+    RecordIds findByAuthority(const std::string& issuingAuthorityId) const;
+
+    ///
+    /// \brief Records with from <= expiry date < to, ordered by expiry date
+    ///
+    RecordIds findExpiring(uint64_t from, uint64_t to) const;
+
+    ///
+    /// \brief Number of records
+    ///
+    std::size_t size() const;
+
+    ///
+    /// \brief Writes indexes for records appended so far
+    ///
+    /// Called automatically every few thousand appends and on destruction
+    ///
+    void flush();
+
+    ///
+    /// \brief Rewrites log without licenses that expired before expiredBefore
+    ///
+    /// All record ids change after compaction
+    ///
+    /// \return Number of removed licenses
+    ///
+    std::size_t compact(uint64_t expiredBefore);
+
+    inline const std::string& directory() const
+    {
+        return m_directory;
+    }
+
+private:
+    class Index;
+
+    enum IndexType : unsigned int
+    {
+        LicenseeIndex = 0,
+        AuthorityIndex = 1,
+        ExpiryIndex = 2,
+        IndexCount = 3
+    };
+
+    struct RecordHeader
+    {
+        uint32_t payloadSize;
+        uint32_t licenseeSize;
+        uint32_t authoritySize;
+        uint64_t expiryDate;
+    };
+
+    void openLog();
+    void openIndexes();
+    uint64_t recover(uint64_t from);
+    void index(RecordId id, const RecordHeader& header, const char* licensee, const char* authority);
+    bool readHeader(RecordId id, RecordHeader* header) const;
+    bool readRecord(RecordId id, RecordHeader* header, std::string* payload) const;
+    RecordIds matching(IndexType type, const std::string& value) const;
+
+    std::string m_directory;
+    bool m_syncAppends;
+    int m_logFd;
+    uint64_t m_logId;
+    uint64_t m_logSize;
+    std::unique_ptr<Index> m_indexes[IndexCount];
+};
+}
+
+#endif /* LICENSEPP_LicenseStore_h */
@@ -0,0 +1,159 @@
+//
+//  license-table.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseTable_h
+#define LICENSEPP_LicenseTable_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Column store for analytics over large number of loaded licenses
+///
+/// Dates are kept in contiguous uint64_t columns, issuing authorities are dictionary
+/// encoded into 16-bit codes and string fields are appended to one pooled buffer.
+/// Filters scan columns (with AVX2 when CPU supports it) and return selection vector,
+/// i.e, sorted row ids that matched.
+///
+/// <pre>
+/// LicenseTable table;
+/// for (const auto& license : licenses) {
+///     table.append(license);
+/// }
+/// LicenseTable::Selection expiring = table.selectExpiring(now, now + 30 * 86400, "authority-x");
+/// for (LicenseTable::RowId row : expiring) {
+///     std::cout << table.licensee(row) << std::endl;
+/// }
+/// </pre>
+///
+class LicenseTable
+{
+public:
+    using RowId = uint32_t;
+    using Selection = std::vector<RowId>;
+
+    ///
+    /// \brief Authority code that does not match any row
+    ///
+    static const uint16_t kUnknownAuthority = 0xFFFF;
+
+    LicenseTable();
+
+    ///
+    /// \brief Adds license to the table
+    /// \throws LicenseException if table is full or it has too many authorities
+    ///
+    RowId append(const License& license);
+
+    void reserve(std::size_t rows);
+
+    inline std::size_t size() const
+    {
+        return m_expiryDates.size();
+    }
+
+    ///
+    /// \brief Builds license object for row (including signatures, so it can be validated)
+    ///
+    License row(RowId row) const;
+
+    inline const uint64_t* issueDates() const
+    {
+        return m_issueDates.data();
+    }
+
+    inline const uint64_t* expiryDates() const
+    {
+        return m_expiryDates.data();
+    }
+
+    ///
+    /// \brief Authority code per row, see authorityId()
+    ///
+    inline const uint16_t* authorityCodes() const
+    {
+        return m_authorityCodes.data();
+    }
+
+    uint16_t authorityCode(const std::string& issuingAuthorityId) const;
+
+    inline const std::string& authorityId(uint16_t code) const
+    {
+        return m_authorityIds.at(code);
+    }
+
+    inline std::string licensee(RowId row) const
+    {
+        return string(row, Licensee);
+    }
+
+    inline std::string additionalPayload(RowId row) const
+    {
+        return string(row, AdditionalPayload);
+    }
+
+    ///
+    /// \brief Rows with from <= expiry date < to
+    ///
+    Selection selectExpiring(uint64_t from, uint64_t to) const;
+
+    ///
+    /// \brief Rows with from <= expiry date < to that were issued by issuingAuthorityId
+    ///
+    Selection selectExpiring(uint64_t from, uint64_t to, const std::string& issuingAuthorityId) const;
+
+    Selection selectByAuthority(const std::string& issuingAuthorityId) const;
+
+    ///
+    /// \brief Whether filters use AVX2 kernels on this CPU
+    ///
+    static bool simdEnabled();
+
+private:
+    enum StringField : unsigned int
+    {
+        Licensee = 0,
+        LicenseeSignature = 1,
+        AuthoritySignature = 2,
+        AdditionalPayload = 3,
+        BatchProof = 4,
+        StringFieldCount = 5
+    };
+
+    struct Span
+    {
+        uint64_t offset;
+        uint32_t size;
+    };
+
+    void appendString(StringField field, const std::string& value);
+    std::string string(RowId row, StringField field) const;
+
+    std::vector<uint64_t> m_issueDates;
+    std::vector<uint64_t> m_expiryDates;
+    std::vector<uint16_t> m_authorityCodes;
+    std::vector<uint32_t> m_keyIds;
+    std::vector<Span> m_strings[StringFieldCount];
+    std::string m_stringPool;
+
+    std::vector<std::string> m_authorityIds;
+    std::unordered_map<std::string, uint16_t> m_authorityCodeMap;
+
+    // only few licenses have entitlements so they are not stored per row
+    std::unordered_map<RowId, Entitlements> m_entitlements;
+};
+}
+
+#endif /* LICENSEPP_LicenseTable_h */
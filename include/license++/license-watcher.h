@@ -0,0 +1,125 @@
+//
+//  license-watcher.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseWatcher_h
+#define LICENSEPP_LicenseWatcher_h
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Keeps license state up to date in background so feature checks do not
+/// need to validate the license
+///
+/// License file is loaded and validated once on start(). After that background thread
+/// revalidates it when license file is replaced (inotify on linux, modification time
+/// on other unix) and exactly when license expires.
+///
+/// <pre>
+/// LicenseManager licenseManager;
+/// LicenseWatcher watcher("/etc/myapp/license", [&](const License& license) {
+///     return licenseManager.validate(&license, true, signature);
+/// });
+/// watcher.start();
+/// ...
+/// if (watcher.isLicensed()) { // relaxed atomic load
+///     ...
+/// }
+/// </pre>
+///
+/// \note Background revalidation is only available on unix. On other platforms
+/// call revalidate() yourself.
+///
+class LicenseWatcher
+{
+public:
+    ///
+    /// \brief Validates loaded license (usually calls BaseLicenseManager::validate)
+    ///
+    using Validator = std::function<bool(const License& license)>;
+
+    LicenseWatcher(const std::string& licenseFile, Validator validator);
+    ~LicenseWatcher();
+
+    ///
+    /// \brief Validates license and starts watching it
+    /// \return Result of first validation
+    ///
+    bool start();
+
+    ///
+    /// \brief Stops background thread. State is kept as it was
+    ///
+    void stop();
+
+    ///
+    /// \brief Loads and validates license file now and publishes the result
+    ///
+    bool revalidate();
+
+    ///
+    /// \brief Whether license was valid at last (re)validation
+    ///
+    inline bool isLicensed() const
+    {
+        return m_licensed.load(std::memory_order_relaxed);
+    }
+
+    ///
+    /// \brief Snapshot of last license that was loaded, nullptr if license could not be loaded
+    ///
+    inline std::shared_ptr<const License> license() const
+    {
+        return std::atomic_load(&m_license);
+    }
+
+    ///
+    /// \brief Number of times license has been (re)validated
+    ///
+    inline uint64_t generation() const
+    {
+        return m_generation.load(std::memory_order_relaxed);
+    }
+
+    inline const std::string& licenseFile() const
+    {
+        return m_licenseFile;
+    }
+
+private:
+    LicenseWatcher(const LicenseWatcher&) = delete;
+    LicenseWatcher& operator=(const LicenseWatcher&) = delete;
+
+    void watch(int inotifyFd, uint64_t fileStamp);
+
+    ///
+    /// \brief Milliseconds until license expires (plus one second), -1 when nothing to wait for
+    ///
+    int64_t msUntilExpiry() const;
+
+    std::string m_licenseFile;
+    Validator m_validator;
+    std::atomic<bool> m_licensed;
+    std::atomic<uint64_t> m_generation;
+    std::shared_ptr<const License> m_license;
+    std::mutex m_revalidateMutex;
+    std::thread m_thread;
+    int m_wakeupPipe[2];
+};
+}
+
+#endif /* LICENSEPP_LicenseWatcher_h */
@@ -10,7 +10,13 @@
 #ifndef LICENSEPP_License_h
 #define LICENSEPP_License_h
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <license++/entitlements.h>
+#include <license++/license-error.h>
 
 namespace licensepp {
 
@@ -22,43 +28,112 @@ class License
 public:
     License();
     License(const License&);
-    License& operator=(License);
+    License(License&&) noexcept;
+    License& operator=(const License&);
+    License& operator=(License&&) noexcept;
 
     inline void setLicensee(const std::string& licensee)
     {
+        invalidateRaw();
         m_licensee = licensee;
     }
 
+    inline void setLicensee(std::string&& licensee)
+    {
+        invalidateRaw();
+        m_licensee = std::move(licensee);
+    }
+
     inline void setIssuingAuthorityId(const std::string& issuingAuthorityId)
     {
+        invalidateRaw();
         m_issuingAuthorityId = issuingAuthorityId;
     }
 
+    inline void setIssuingAuthorityId(std::string&& issuingAuthorityId)
+    {
+        invalidateRaw();
+        m_issuingAuthorityId = std::move(issuingAuthorityId);
+    }
+
     inline void setLicenseeSignature(const std::string& licenseeSignature)
     {
+        invalidateRaw();
         m_licenseeSignature = licenseeSignature;
     }
 
+    inline void setLicenseeSignature(std::string&& licenseeSignature)
+    {
+        invalidateRaw();
+        m_licenseeSignature = std::move(licenseeSignature);
+    }
+
     inline void setAuthoritySignature(const std::string& authoritySignature)
     {
+        invalidateRaw(true);
         m_authoritySignature = authoritySignature;
     }
 
+    inline void setAuthoritySignature(std::string&& authoritySignature)
+    {
+        invalidateRaw(true);
+        m_authoritySignature = std::move(authoritySignature);
+    }
+
+    inline void setBatchProof(const std::string& batchProof)
+    {
+        invalidateRaw(true);
+        m_batchProof = batchProof;
+    }
+
+    inline void setBatchProof(std::string&& batchProof)
+    {
+        invalidateRaw(true);
+        m_batchProof = std::move(batchProof);
+    }
+
     inline void setExpiryDate(uint64_t expiryDate)
     {
+        invalidateRaw();
         m_expiryDate = expiryDate;
     }
 
     inline void setIssueDate(uint64_t issueDate)
     {
+        invalidateRaw();
         m_issueDate = issueDate;
     }
 
+    inline void setKeyId(uint32_t keyId)
+    {
+        invalidateRaw();
+        m_keyId = keyId;
+    }
+
     inline void setAdditionalPayload(const std::string& additionalPayload)
     {
+        invalidateRaw();
         m_additionalPayload = additionalPayload;
     }
 
+    inline void setAdditionalPayload(std::string&& additionalPayload)
+    {
+        invalidateRaw();
+        m_additionalPayload = std::move(additionalPayload);
+    }
+
+    inline void setEntitlements(const Entitlements& entitlements)
+    {
+        invalidateRaw();
+        m_entitlements = entitlements;
+    }
+
+    inline void setEntitlements(Entitlements&& entitlements)
+    {
+        invalidateRaw();
+        m_entitlements = std::move(entitlements);
+    }
+
     inline const std::string& licensee() const
     {
         return m_licensee;
@@ -79,6 +154,17 @@ public:
         return m_authoritySignature;
     }
 
+    ///
+    /// \brief Merkle inclusion proof of batch signed license (empty if license is signed on its own)
+    ///
+    /// Authority signature of batch signed license signs root of the batch, see
+    /// IssuingAuthority::issueBatch()
+    ///
+    inline const std::string& batchProof() const
+    {
+        return m_batchProof;
+    }
+
     inline uint64_t expiryDate() const
     {
         return m_expiryDate;
@@ -89,29 +175,62 @@ public:
         return m_issueDate;
     }
 
+    ///
+    /// \brief ID of issuing authority key that signed this license (0 if authority did not use key ids)
+    ///
+    inline uint32_t keyId() const
+    {
+        return m_keyId;
+    }
+
     inline const std::string& additionalPayload() const
     {
         return m_additionalPayload;
     }
 
+    ///
+    /// \brief Features, limits and module expiries signed with this license
+    ///
+    inline const Entitlements& entitlements() const
+    {
+        return m_entitlements;
+    }
+
     std::string toString();
 
     ///
     /// \brief Returns raw format of license
     ///
-    std::string raw(bool full = false) const;
+    /// Raw bytes are serialized on first use and kept until license is changed
+    /// with any of the setters. For loaded license, full raw format is the
+    /// exact JSON that was loaded.
+    ///
+    const std::string& raw(bool full = false) const;
 
     ///
     /// \brief Returns expiry date in <pre>%d %b, %Y %H:%m UTC</pre> format
     ///
     std::string formattedExpiry() const;
 
+    ///
+    /// \brief Writes formatted expiry date to buf without allocating
+    /// \return Length of formatted expiry date, output was truncated if this is >= size
+    ///
+    std::size_t formattedExpiry(char* buf, std::size_t size) const;
+
     ///
     /// \brief Loads itself from base64 input
     /// \throws LicenseException if license is invalid
     ///
     bool load(const std::string& licenseBase64);
 
+    ///
+    /// \brief Same as load() but reports invalid license with error instead of exception
+    ///
+    /// License is only changed when it is loaded successfully
+    ///
+    LicenseError tryLoad(const std::string& licenseBase64) noexcept;
+
     ///
     /// \brief Loads itself from license file containing base64 license
     /// \throws LicenseException if license is invalid
@@ -120,14 +239,51 @@ public:
 
 protected:
 
+    ///
+    /// \brief Drops cached raw bytes. Must be called by subclasses that change
+    /// protected members directly
+    /// \param fullOnly Only drop full raw format (i.e, signature has changed)
+    ///
+    inline void invalidateRaw(bool fullOnly = false)
+    {
+        if (!fullOnly) {
+            m_rawState[0].store(0, std::memory_order_relaxed);
+        }
+        m_rawState[1].store(0, std::memory_order_relaxed);
+    }
+
     uint64_t m_issueDate;
     uint64_t m_expiryDate;
+    uint32_t m_keyId;
 
     std::string m_licensee;
     std::string m_issuingAuthorityId;
     std::string m_licenseeSignature;
     std::string m_authoritySignature;
+    std::string m_batchProof;
     std::string m_additionalPayload;
+    Entitlements m_entitlements;
+
+private:
+    // copies itself to license that can be validated
+    friend class PooledLicense;
+
+    // JSON is read and written with nlohmann::json (license-json.cc), or with built-in
+    // reader in licensepp-verify-lite (license-lite.cc)
+    std::string serialize(bool full) const;
+    LicenseError deserialize(const std::string& json) noexcept;
+    LicenseError parse(const std::string& licenseBase64) noexcept;
+    void copyRaw(const License& other);
+    void moveRaw(License& other) noexcept;
+
+    ///
+    /// \brief Keeps json as full raw format, i.e, exact bytes license was loaded from
+    ///
+    void keepRaw(const char* json, std::size_t size);
+
+    // cached raw(false) and raw(true) and their states (0: empty, 1: building, 2: ready)
+    mutable std::string m_raw[2];
+    mutable std::atomic<int> m_rawState[2];
 };
 }
 
@@ -0,0 +1,96 @@
+//
+//  negative-cache.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_NegativeCache_h
+#define LICENSEPP_NegativeCache_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace licensepp {
+
+class License;
+
+///
+/// \brief Bounded cache of licenses that failed authority signature verification
+///
+/// Validation checks format, authority, expiry and whether licensee signature is required
+/// before any crypto, so expired or malformed licenses are already rejected without it.
+/// Forged licenses are not, every submission costs RSA verification. With negative cache
+/// digest of license blob (License::raw(true)) is remembered once verification fails and
+/// the same blob is rejected again at cost of hashing it:
+///
+/// <pre>
+/// NegativeCache negativeCache(16384);
+/// licenseManager.setNegativeCache(&negativeCache);
+/// </pre>
+///
+/// Digest is SipHash-2-4 with random key of each cache, so submitted blobs cannot be made
+/// to collide with valid license. Cache is fixed size lock-free table indexed by digest, it
+/// does not allocate after construction and newer entry replaces older one in the same slot.
+/// Only authority signature failures are cached, as they depend on nothing but the blob
+/// and authority keys. Call clear() after changing public key of key ID that is in use.
+///
+class NegativeCache
+{
+public:
+    ///
+    /// \param capacity Number of blobs to remember, rounded up to power of two
+    ///
+    explicit NegativeCache(std::size_t capacity = 4096);
+
+    NegativeCache(const NegativeCache&) = delete;
+    NegativeCache& operator=(const NegativeCache&) = delete;
+
+    ///
+    /// \brief True if license blob failed authority signature verification before
+    ///
+    bool contains(const License* license) const;
+
+    ///
+    /// \brief Remembers that license blob failed authority signature verification
+    ///
+    void insert(const License* license);
+
+    void clear();
+
+    inline std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    ///
+    /// \brief Number of remembered blobs (counts slots in use, for monitoring)
+    ///
+    std::size_t size() const;
+
+    ///
+    /// \brief Number of times contains() found blob, i.e, verifications saved
+    ///
+    inline uint64_t hits() const
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+private:
+    ///
+    /// \brief Digest of raw(true), never 0 as that marks empty slot
+    ///
+    uint64_t digest(const License* license) const;
+
+    uint64_t m_key[2];
+    std::size_t m_capacity;
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+    mutable std::atomic<uint64_t> m_hits;
+};
+}
+
+#endif /* LICENSEPP_NegativeCache_h */
@@ -0,0 +1,53 @@
+//
+//  tracing.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_Tracing_h
+#define LICENSEPP_Tracing_h
+
+#include <string>
+
+namespace licensepp {
+
+///
+/// \brief Export of timing spans recorded by License++ (load, base64, JSON parse, RSA, AES, clock...)
+///
+/// Spans are only recorded when library is built with tracing (`cmake -Dtracing=ON ..`),
+/// otherwise span recording is compiled out and export is empty. Each thread records to
+/// its own fixed size ring (oldest spans are overwritten), so recording does not lock.
+/// Ring of thread that exited is reused by next new thread, so spans of both have same `tid`.
+///
+/// Output is Chrome trace event format, open it with chrome://tracing or https://ui.perfetto.dev
+///
+class Tracing
+{
+public:
+    ///
+    /// \brief Whether library was built with tracing
+    ///
+    static bool enabled();
+
+    ///
+    /// \brief Recorded spans of all threads in Chrome trace JSON
+    ///
+    static std::string chromeTrace();
+
+    ///
+    /// \brief Writes chromeTrace() to file
+    /// \return False if file could not be written
+    ///
+    static bool dump(const std::string& file);
+
+    ///
+    /// \brief Drops spans recorded so far
+    ///
+    static void clear();
+};
+}
+
+#endif /* LICENSEPP_Tracing_h */
@@ -0,0 +1,134 @@
+//
+//  validation-recorder.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_ValidationRecorder_h
+#define LICENSEPP_ValidationRecorder_h
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace licensepp {
+
+class License;
+
+///
+/// \brief Records BaseLicenseManager::validate() calls to compact binary trace that
+/// licensepp-replay replays
+///
+/// <pre>
+/// ValidationRecorder recorder("/var/tmp/validations.lpvt");
+/// licenseManager.setRecorder(&recorder);
+/// </pre>
+///
+/// Each distinct license is written once, validations refer to it by ID and keep clock used
+/// for expiry, whether licensee signature was verified (signature itself is not recorded),
+/// result and latency. Records are buffered, call flush() or destroy recorder to write them.
+///
+class ValidationRecorder
+{
+public:
+    enum Result : uint8_t
+    {
+        Invalid = 0,
+        Valid = 1,
+        Exception = 2
+    };
+
+    ///
+    /// \brief Truncates file and writes trace header
+    /// \throws LicenseException if file cannot be opened
+    ///
+    explicit ValidationRecorder(const std::string& file);
+    ~ValidationRecorder();
+
+    ValidationRecorder(const ValidationRecorder&) = delete;
+    ValidationRecorder& operator=(const ValidationRecorder&) = delete;
+
+    ///
+    /// \brief Steady clock in nanoseconds, for start of record()
+    ///
+    static uint64_t clock();
+
+    ///
+    /// \param started clock() before validation
+    ///
+    void record(const License* license, bool verifyLicenseeSignature, bool licenseeSignatureGiven,
+                uint64_t started, Result result);
+
+    void flush();
+
+    ///
+    /// \brief Number of validations recorded
+    ///
+    uint64_t size() const;
+
+private:
+    void write(const void* data, std::size_t size);
+
+    mutable std::mutex m_mutex;
+    std::FILE* m_file;
+    std::unordered_map<std::string, uint32_t> m_blobIds;
+    uint64_t m_size;
+};
+
+///
+/// \brief Validations read from ValidationRecorder trace
+///
+class ValidationTrace
+{
+public:
+    struct Record
+    {
+        uint32_t blobId;
+        uint32_t latencyNs;
+        uint64_t timestampUs;   // wall clock of validation
+        uint64_t clock;         // Utils::nowUtc() used for expiry check
+        bool verifyLicenseeSignature;
+        bool licenseeSignatureGiven;
+        ValidationRecorder::Result result;
+    };
+
+    ///
+    /// \throws LicenseException if file cannot be read or is not a trace
+    ///
+    explicit ValidationTrace(const std::string& file);
+
+    ///
+    /// \brief Base64 licenses by blob ID
+    ///
+    inline const std::vector<std::string>& blobs() const
+    {
+        return m_blobs;
+    }
+
+    inline const std::vector<Record>& records() const
+    {
+        return m_records;
+    }
+
+    ///
+    /// \brief False if trace ends with partial record (recorder was not flushed)
+    ///
+    inline bool complete() const
+    {
+        return m_complete;
+    }
+
+private:
+    std::vector<std::string> m_blobs;
+    std::vector<Record> m_records;
+    bool m_complete;
+};
+}
+
+#endif /* LICENSEPP_ValidationRecorder_h */
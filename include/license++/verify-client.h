@@ -0,0 +1,99 @@
+//
+//  verify-client.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_VerifyClient_h
+#define LICENSEPP_VerifyClient_h
+
+#include <cstdint>
+#include <string>
+#include <license++/license.h>
+
+namespace licensepp {
+
+///
+/// \brief Client for licensepp-verifyd, the local license verification daemon
+///
+/// The daemon keeps parsed authority keys and results of previous verifications in memory
+/// so short-lived processes do not need to verify license themselves. When daemon is not
+/// running, validate() falls back to in-process validation using provided license manager.
+///
+/// <pre>
+/// VerifyClient client;
+/// LicenseManager licenseManager;
+/// if (client.validate(licenseManager, licenseBase64, true, signature)) {
+///     ...
+/// }
+/// </pre>
+///
+/// \note Daemon answers are trusted. Make sure socket is created in a directory that only
+/// daemon user can write to.
+///
+class VerifyClient
+{
+public:
+    static const char* kDefaultSocketPath;
+
+    enum class Status : uint8_t
+    {
+        Valid = 0,
+        Invalid = 1,
+        Malformed = 2,
+        UnknownAuthority = 3,
+        Unavailable = 255
+    };
+
+    ///
+    /// \param socketPath Path to daemon UNIX socket
+    /// \param timeoutMs Send / receive timeout before daemon is considered unavailable
+    ///
+    explicit VerifyClient(const std::string& socketPath = kDefaultSocketPath,
+                          unsigned int timeoutMs = 500U);
+
+    ///
+    /// \brief Asks daemon to validate the license
+    /// \param expiryDate If not null and license is loaded by daemon, expiry date is set
+    /// \return Status::Unavailable if daemon could not be reached
+    ///
+    Status query(const std::string& licenseBase64,
+                 bool verifyLicenseeSignature,
+                 const std::string& licenseeSignature = "",
+                 uint64_t* expiryDate = nullptr) const;
+
+    ///
+    /// \brief Validates license using daemon and falls back to licenseManager if daemon
+    /// is not available
+    /// \throws LicenseException from in-process validation (daemon answers never throw)
+    ///
+    template <class LicenseManager>
+    bool validate(const LicenseManager& licenseManager,
+                  const std::string& licenseBase64,
+                  bool verifyLicenseeSignature,
+                  const std::string& licenseeSignature = "") const
+    {
+        const Status status = query(licenseBase64, verifyLicenseeSignature, licenseeSignature);
+        if (status != Status::Unavailable) {
+            return status == Status::Valid;
+        }
+        License license;
+        license.load(licenseBase64);
+        return licenseManager.validate(&license, verifyLicenseeSignature, licenseeSignature);
+    }
+
+    inline const std::string& socketPath() const
+    {
+        return m_socketPath;
+    }
+
+private:
+    std::string m_socketPath;
+    unsigned int m_timeoutMs;
+};
+}
+
+#endif /* LICENSEPP_VerifyClient_h */
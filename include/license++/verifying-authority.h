@@ -0,0 +1,116 @@
+//
+//  verifying-authority.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_VerifyingAuthority_h
+#define LICENSEPP_VerifyingAuthority_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <license++/license.h>
+#include <license++/negative-cache.h>
+
+namespace licensepp {
+
+class RSAPublicKey;
+
+///
+/// \brief Verify-only counterpart of IssuingAuthority for products that only validate licenses
+///
+/// Holds authority ID and decoded public keys only. Private key (and authority name and
+/// max validity) is not compiled in, so register of these is smaller and faster to initialize.
+/// BaseLicenseManager accepts register of VerifyingAuthority:
+/// <pre>
+/// const std::vector<VerifyingAuthority> LicenseKeysRegister::LICENSE_ISSUING_AUTHORITIES = {
+///     VerifyingAuthority("authority_id", "<public key>"),
+///     // rotated keys
+///     VerifyingAuthority("other_authority_id", "<public key 2>", true, 2)
+///         .addPublicKey(1, "<public key 1>"),
+/// };
+/// </pre>
+/// Public keys are base64 encoded, i.e, second part of keypair.
+///
+class VerifyingAuthority
+{
+public:
+    ///
+    /// \param keyId Key ID licenses signed with this public key are stamped with
+    ///
+    VerifyingAuthority(const std::string& id, const std::string& publicKey,
+                       bool active = true, uint32_t keyId = 0);
+
+    inline const std::string& id() const
+    {
+        return m_id;
+    }
+
+    inline bool active() const
+    {
+        return m_active;
+    }
+
+    ///
+    /// \brief Registers (older) public key to verify licenses stamped with keyId
+    ///
+    VerifyingAuthority& addPublicKey(uint32_t keyId, const std::string& publicKey);
+
+    ///
+    /// \brief Licenses stamped with this keyId are no longer valid
+    ///
+    VerifyingAuthority& retirePublicKey(uint32_t keyId);
+
+    inline bool hasPublicKey(uint32_t keyId) const
+    {
+        return publicKey(keyId) != nullptr;
+    }
+
+    ///
+    /// \brief Validates license, same as IssuingAuthority::validate()
+    /// \note Do not use this function directly. Use BaseLicenseManager::validate()
+    ///
+    bool validate(const License* license,
+                  const std::string& masterKey,
+                  bool validateSignature,
+                  const std::string& licenseeSignature = "",
+                  NegativeCache* negativeCache = nullptr) const;
+
+    ///
+    /// \brief Same as validate() without writing to stderr or throwing
+    ///
+    LicenseError tryValidate(const License* license,
+                             const std::string& masterKey,
+                             bool validateSignature,
+                             const std::string& licenseeSignature = "",
+                             NegativeCache* negativeCache = nullptr) const noexcept;
+
+    ///
+    /// \brief Only verifies authority signature, same as IssuingAuthority::verifySignature()
+    ///
+    bool verifySignature(const License* license) const;
+
+    ///
+    /// \brief verifySignature() of n licenses, results[i] is result for licenses[i]
+    ///
+    /// Faster than verifySignature() of each license when crypto backend verifies digests
+    /// (OpenSSL), as licenses are hashed together with AVX2 where CPU has it
+    ///
+    void verifySignatures(const License* const* licenses, std::size_t n, bool* results) const;
+private:
+    const RSAPublicKey* publicKey(uint32_t keyId) const;
+
+    std::string m_id;
+    // public keys parsed once by key id, few keys per authority so vector is smaller than map
+    std::vector<std::pair<uint32_t, std::shared_ptr<const RSAPublicKey>>> m_publicKeys;
+    bool m_active;
+};
+}
+
+#endif /* LICENSEPP_VerifyingAuthority_h */
@@ -1,5 +1,6 @@
 #include <license++/issuing-authority.h>
 #include <license++/c-bindings.h>
+#include <license++/license-error.h>
 #include <license++/license-exception.h>
 #include <license++/license.h>
 #include <stdio.h>
@@ -7,24 +8,59 @@
 
 #include <array>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "license++/base-license-manager.h"
 
+static_assert(LICENSEPP_ERROR_INTERNAL ==
+                  static_cast<int>(::licensepp::LicenseError::Internal),
+              "C error codes must match LicenseError");
+
 namespace licensepp {
 class CLicenseKeysRegister {
  public:
-  static const std::array<unsigned char, 16> LICENSE_MANAGER_SIGNATURE_KEY;
-  static const std::vector<::licensepp::IssuingAuthority>
-      LICENSE_ISSUING_AUTHORITIES;
+  using Register = std::vector<::licensepp::IssuingAuthority>;
+
+  // authorities of current register, iterated by license managers
+  class Authorities {
+   public:
+    explicit Authorities(std::shared_ptr<const Register> authorities)
+        : current(std::move(authorities)) {}
+
+    inline Register::const_iterator begin() const { return current->begin(); }
+
+    inline Register::const_iterator end() const { return current->end(); }
+
+    std::shared_ptr<const Register> current;
+  };
+
+  // not const, unlike compiled-in registers, as they are set at runtime
+  static std::array<unsigned char, 16> LICENSE_MANAGER_SIGNATURE_KEY;
+  static Authorities LICENSE_ISSUING_AUTHORITIES;
+
+  // register is replaced under exclusive lock, license managers read it under
+  // shared lock
+  static std::shared_timed_mutex mutex;
+
+  // authorities returned by license_manager_get_issuing_authority() are used
+  // by caller after lock is released, so each of them holds register it
+  // belongs to (with number of times it is handed out) until it is released
+  // by license_manager_release_issuing_authority()
+  using Handles = std::unordered_map<
+      const void*, std::pair<std::shared_ptr<const Register>, std::size_t>>;
+  static std::mutex handles_mutex;
+  static Handles handles;
 
   static void initialize_license_issuing_authorities(
       const unsigned char* license_manager_signature_key,
       const IssuingAuthorityParameters* issuing_authority_parameters) {
-    auto authorities = (std::vector<IssuingAuthority>*)&CLicenseKeysRegister::
-        LICENSE_ISSUING_AUTHORITIES;
-    authorities->clear();
-
+    // keys are decoded before lock is taken
+    std::shared_ptr<Register> authorities = std::make_shared<Register>();
     auto p = issuing_authority_parameters;
     while (p) {
       authorities->emplace_back(::licensepp::IssuingAuthority(
@@ -33,21 +69,50 @@ class CLicenseKeysRegister {
       p = p->next;
     }
 
-    auto signature_key =
-        (std::array<unsigned char,
-                    16>*)&CLicenseKeysRegister::LICENSE_MANAGER_SIGNATURE_KEY;
+    // replaced register is freed after lock is released, unless it is still
+    // held by handed out authorities
+    std::shared_ptr<const Register> replaced = std::move(authorities);
+    std::lock_guard<std::shared_timed_mutex> lock(mutex);
+    LICENSE_ISSUING_AUTHORITIES.current.swap(replaced);
+    auto signature_key = &CLicenseKeysRegister::LICENSE_MANAGER_SIGNATURE_KEY;
     memcpy(signature_key->data(), license_manager_signature_key,
            16 * sizeof(unsigned char));
   }
+
+  static void hand_out(const void* issuing_authority) {
+    std::lock_guard<std::mutex> lock(handles_mutex);
+    auto& handle = handles[issuing_authority];
+    if (handle.second++ == 0) {
+      handle.first = LICENSE_ISSUING_AUTHORITIES.current;
+    }
+  }
+
+  static void release(const void* issuing_authority) {
+    // register is freed (if it is last handle of replaced register) after
+    // lock is released
+    std::shared_ptr<const Register> released;
+    std::lock_guard<std::mutex> lock(handles_mutex);
+    auto handle = handles.find(issuing_authority);
+    if (handle != handles.end() && --handle->second.second == 0) {
+      released = std::move(handle->second.first);
+      handles.erase(handle);
+    }
+  }
 };
 
-const std::array<unsigned char, 16>
+std::array<unsigned char, 16>
     CLicenseKeysRegister::LICENSE_MANAGER_SIGNATURE_KEY = {
         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
-const std::vector<::licensepp::IssuingAuthority>
-    CLicenseKeysRegister::LICENSE_ISSUING_AUTHORITIES =
-        std::vector<IssuingAuthority>();
+CLicenseKeysRegister::Authorities
+    CLicenseKeysRegister::LICENSE_ISSUING_AUTHORITIES(
+        std::make_shared<CLicenseKeysRegister::Register>());
+
+std::shared_timed_mutex CLicenseKeysRegister::mutex;
+
+std::mutex CLicenseKeysRegister::handles_mutex;
+
+CLicenseKeysRegister::Handles CLicenseKeysRegister::handles;
 
 }  // namespace licensepp
 
@@ -55,12 +120,27 @@ const std::vector<::licensepp::IssuingAuthority>
 extern "C" void license_key_register_init(
     const unsigned char* license_manager_signature_key,
     const IssuingAuthorityParameters* issuing_authority_parameters) {
-  ::licensepp::CLicenseKeysRegister::initialize_license_issuing_authorities(
-      license_manager_signature_key, issuing_authority_parameters);
+  try {
+    ::licensepp::CLicenseKeysRegister::initialize_license_issuing_authorities(
+        license_manager_signature_key, issuing_authority_parameters);
+  } catch (...) {
+    // register is unchanged
+  }
+}
+
+extern "C" const char* license_error_message(int error) {
+  return ::licensepp::licenseErrorMessage(
+      static_cast<::licensepp::LicenseError>(error));
 }
 
 // License
-extern "C" void* license_create() { return new ::licensepp::License(); }
+extern "C" void* license_create() {
+  try {
+    return new ::licensepp::License();
+  } catch (...) {
+    return nullptr;
+  }
+}
 
 extern "C" void license_delete(void* license) {
   ::licensepp::License* p = (::licensepp::License*)license;
@@ -69,31 +149,58 @@ extern "C" void license_delete(void* license) {
 
 extern "C" int license_load(void* license,
                             const char* license_contents_base64) {
+  return license_load_status(license, license_contents_base64) ==
+         LICENSEPP_ERROR_NONE;
+}
+
+extern "C" int license_load_status(void* license,
+                                   const char* license_contents_base64) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  return p->load(license_contents_base64);
+  try {
+    return static_cast<int>(p->tryLoad(license_contents_base64));
+  } catch (...) {
+    // input could not be copied
+    return LICENSEPP_ERROR_INTERNAL;
+  }
 }
 
 extern "C" void license_set_licensee(void* license, const char* licensee) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  p->setLicensee(licensee);
+  try {
+    p->setLicensee(licensee);
+  } catch (...) {
+    // license is unchanged
+  }
 }
 
 extern "C" void license_set_issuing_authority_id(
     void* license, const char* issuing_authority_id) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  p->setIssuingAuthorityId(issuing_authority_id);
+  try {
+    p->setIssuingAuthorityId(issuing_authority_id);
+  } catch (...) {
+    // license is unchanged
+  }
 }
 
 extern "C" void license_set_licensee_signature(void* license,
                                                const char* licensee_signature) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  p->setLicenseeSignature(licensee_signature);
+  try {
+    p->setLicenseeSignature(licensee_signature);
+  } catch (...) {
+    // license is unchanged
+  }
 }
 
 extern "C" void license_set_authority_signature(
     void* license, const char* authority_signature) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  p->setAuthoritySignature(authority_signature);
+  try {
+    p->setAuthoritySignature(authority_signature);
+  } catch (...) {
+    // license is unchanged
+  }
 }
 
 extern "C" void license_set_expiry_date(void* license,
@@ -111,7 +218,11 @@ extern "C" void license_set_issue_date(void* license,
 extern "C" void license_set_additional_payload(void* license,
                                                const char* additional_payload) {
   ::licensepp::License* p = (::licensepp::License*)license;
-  p->setAdditionalPayload(additional_payload);
+  try {
+    p->setAdditionalPayload(additional_payload);
+  } catch (...) {
+    // license is unchanged
+  }
 }
 
 extern "C" const char* license_get_licensee(const void* license) {
@@ -149,16 +260,42 @@ extern "C" const char* license_get_additional_payload(const void* license) {
   return p->additionalPayload().c_str();
 }
 
+extern "C" int license_has_feature(const void* license, const char* feature) {
+  const ::licensepp::License* p = (const ::licensepp::License*)license;
+  return p->entitlements().hasFeature(feature);
+}
+
+extern "C" int64_t license_get_limit(const void* license, const char* name,
+                                     int64_t default_value) {
+  const ::licensepp::License* p = (const ::licensepp::License*)license;
+  return p->entitlements().limit(name, std::strlen(name), default_value);
+}
+
+extern "C" uint64_t license_get_module_expiry(const void* license,
+                                              const char* module) {
+  const ::licensepp::License* p = (const ::licensepp::License*)license;
+  return p->entitlements().moduleExpiry(module, std::strlen(module));
+}
+
+extern "C" uint32_t license_get_key_id(const void* license) {
+  const ::licensepp::License* p = (const ::licensepp::License*)license;
+  return p->keyId();
+}
+
 // Issuing Authority
 extern "C" void* issuing_authority_create(const char* id, const char* name,
                                           const char* keypair,
                                           unsigned int max_validity,
                                           int active) {
-  std::string _id(id);
-  std::string _name(name);
-  std::string _keypair(keypair);
-  return new ::licensepp::IssuingAuthority(_id, _name, _keypair, max_validity,
-                                           active);
+  try {
+    std::string _id(id);
+    std::string _name(name);
+    std::string _keypair(keypair);
+    return new ::licensepp::IssuingAuthority(_id, _name, _keypair,
+                                             max_validity, active);
+  } catch (...) {
+    return nullptr;
+  }
 }
 
 extern "C" void issuing_authority_delete(void* issuing_authority) {
@@ -199,15 +336,19 @@ extern "C" void* issuing_authority_issue(
     const char* licensee_signature, const char* additional_payload) {
   ::licensepp::IssuingAuthority* p =
       (::licensepp::IssuingAuthority*)issuing_authority;
-  std::string _licensee(licensee);
-  std::string _master_key(master_key);
-  std::string _secret(secret);
-  std::string _licensee_signature(licensee_signature);
-  std::string _additional_payload(additional_payload);
-
-  auto license = p->issue(_licensee, validity_period, _master_key, _secret,
-                          _licensee_signature, _additional_payload);
-  return new ::licensepp::License(license);
+  try {
+    std::string _licensee(licensee);
+    std::string _master_key(master_key);
+    std::string _secret(secret);
+    std::string _licensee_signature(licensee_signature);
+    std::string _additional_payload(additional_payload);
+    return new ::licensepp::License(p->issue(_licensee, validity_period,
+                                            _master_key, _secret,
+                                            _licensee_signature,
+                                            _additional_payload));
+  } catch (...) {
+    return nullptr;
+  }
 }
 
 extern "C" int issuing_authority_validate(const void* issuing_authority,
@@ -218,16 +359,25 @@ extern "C" int issuing_authority_validate(const void* issuing_authority,
   ::licensepp::IssuingAuthority* p =
       (::licensepp::IssuingAuthority*)issuing_authority;
   ::licensepp::License* _license = (::licensepp::License*)license;
-  std::string _master_key(master_key);
-  std::string _licensee_signature(licensee_signature);
-  return p->validate(_license, _master_key, validate_signature,
-                     _licensee_signature);
+  try {
+    std::string _master_key(master_key);
+    std::string _licensee_signature(licensee_signature);
+    return p->tryValidate(_license, _master_key, validate_signature,
+                          _licensee_signature) ==
+           ::licensepp::LicenseError::None;
+  } catch (...) {
+    return 0;
+  }
 }
 
 // License Manager
 extern "C" void* license_manager_create() {
-  return new ::licensepp::BaseLicenseManager<
-      ::licensepp::CLicenseKeysRegister>();
+  try {
+    return new ::licensepp::BaseLicenseManager<
+        ::licensepp::CLicenseKeysRegister>();
+  } catch (...) {
+    return nullptr;
+  }
 }
 
 extern "C" void license_manager_delete(void* license_manager) {
@@ -242,7 +392,27 @@ extern "C" const void* license_manager_get_issuing_authority(
   ::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>* p =
       (::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>*)
           license_manager;
-  return p->getIssuingAuthority((const ::licensepp::License*)license);
+  try {
+    std::shared_lock<std::shared_timed_mutex> lock(
+        ::licensepp::CLicenseKeysRegister::mutex);
+    const void* issuing_authority =
+        p->getIssuingAuthority((const ::licensepp::License*)license);
+    if (issuing_authority != nullptr) {
+      ::licensepp::CLicenseKeysRegister::hand_out(issuing_authority);
+    }
+    return issuing_authority;
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+extern "C" void license_manager_release_issuing_authority(
+    const void* issuing_authority) {
+  try {
+    ::licensepp::CLicenseKeysRegister::release(issuing_authority);
+  } catch (...) {
+    // authority stays held
+  }
 }
 
 extern "C" const void* license_manager_issue(
@@ -253,19 +423,42 @@ extern "C" const void* license_manager_issue(
   ::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>* p =
       (::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>*)
           license_manager;
-  return new ::licensepp::License(p->issue(
-      licensee, validity_period,
-      (const ::licensepp::IssuingAuthority*)issuing_authority,
-      issuing_authority_secret, licensee_signature, additional_payload));
+  try {
+    std::shared_lock<std::shared_timed_mutex> lock(
+        ::licensepp::CLicenseKeysRegister::mutex);
+    return new ::licensepp::License(p->issue(
+        licensee, validity_period,
+        (const ::licensepp::IssuingAuthority*)issuing_authority,
+        issuing_authority_secret, licensee_signature, additional_payload));
+  } catch (...) {
+    return nullptr;
+  }
 }
 
 extern "C" int license_manager_validate(const void* license_manager,
                                         const void* license,
                                         int verify_licensee_signature,
                                         const char* licensee_signature) {
+  return license_manager_validate_status(license_manager, license,
+                                         verify_licensee_signature,
+                                         licensee_signature) ==
+         LICENSEPP_ERROR_NONE;
+}
+
+extern "C" int license_manager_validate_status(const void* license_manager,
+                                               const void* license,
+                                               int verify_licensee_signature,
+                                               const char* licensee_signature) {
   ::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>* p =
       (::licensepp::BaseLicenseManager<::licensepp::CLicenseKeysRegister>*)
           license_manager;
-  return p->validate((const ::licensepp::License*)license,
-                     verify_licensee_signature, licensee_signature);
+  try {
+    std::shared_lock<std::shared_timed_mutex> lock(
+        ::licensepp::CLicenseKeysRegister::mutex);
+    return static_cast<int>(p->tryValidate(
+        (const ::licensepp::License*)license, verify_licensee_signature,
+        licensee_signature));
+  } catch (...) {
+    return LICENSEPP_ERROR_INTERNAL;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,284 @@
+//
+//  calendar.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include "src/calendar.h"
+
+using namespace licensepp;
+
+static_assert(Calendar::daysFromCivil(1970, 1, 1) == 0, "Unix epoch must be day 0");
+static_assert(Calendar::civilFromSeconds(1830791460).year == 2028
+              && Calendar::civilFromSeconds(1830791460).month == 1
+              && Calendar::civilFromSeconds(1830791460).day == 6
+              && Calendar::civilFromSeconds(1830791460).hour == 17
+              && Calendar::civilFromSeconds(1830791460).minute == 11
+              && Calendar::civilFromSeconds(1830791460).weekday == 4, "2028-01-06T17:11:00Z (Thursday)");
+static_assert(Calendar::civilFromSeconds(-1).year == 1969
+              && Calendar::civilFromSeconds(-1).second == 59, "1969-12-31T23:59:59Z");
+
+const char* Calendar::kDays[7] = { "Sunday", "Monday", "Tuesday",
+                                   "Wednesday", "Thursday", "Friday",
+                                   "Saturday" };
+const char* Calendar::kDaysAbbrev[7] = { "Sun", "Mon", "Tue",
+                                         "Wed", "Thu", "Fri", "Sat" };
+const char* Calendar::kMonths[12] = { "January", "February", "March",
+                                      "April", "May", "June", "July",
+                                      "August", "September", "October",
+                                      "November", "December" };
+const char* Calendar::kMonthsAbbrev[12] = { "Jan", "Feb", "Mar", "Apr",
+                                            "May", "Jun", "Jul", "Aug",
+                                            "Sep", "Oct", "Nov", "Dec" };
+
+constexpr std::size_t Calendar::kRfc3339Length;
+
+namespace {
+
+///
+/// \brief snprintf-like output to caller's buffer that keeps counting after buffer is full
+///
+class Writer
+{
+public:
+    Writer(char* buf, std::size_t size) :
+        m_buf(buf),
+        m_size(size),
+        m_length(0)
+    {
+    }
+
+    inline void put(char c)
+    {
+        if (m_length + 1 < m_size) {
+            m_buf[m_length] = c;
+        }
+        ++m_length;
+    }
+
+    inline void put(const char* str)
+    {
+        while (*str != '\0') {
+            put(*str++);
+        }
+    }
+
+    ///
+    /// \brief Writes last width digits of n, zero padded
+    ///
+    inline void putNumber(uint64_t n, int width)
+    {
+        char digits[20];
+        int len = 0;
+        do {
+            digits[len++] = static_cast<char>('0' + n % 10);
+            n /= 10;
+        } while (n > 0 && len < width);
+        while (len < width) {
+            digits[len++] = '0';
+        }
+        while (len > 0) {
+            put(digits[--len]);
+        }
+    }
+
+    inline void putYear(int64_t year, int width)
+    {
+        if (year < 0) {
+            put('-');
+            year = -year;
+        }
+        putNumber(static_cast<uint64_t>(year), width);
+    }
+
+    inline std::size_t finish()
+    {
+        if (m_size > 0) {
+            m_buf[m_length < m_size ? m_length : m_size - 1] = '\0';
+        }
+        return m_length;
+    }
+
+private:
+    char* m_buf;
+    std::size_t m_size;
+    std::size_t m_length;
+};
+
+inline bool parseNumber(const char*& p, const char* end, int count, unsigned int* out)
+{
+    if (end - p < count) {
+        return false;
+    }
+    unsigned int n = 0;
+    for (int i = 0; i < count; ++i, ++p) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        n = n * 10 + static_cast<unsigned int>(*p - '0');
+    }
+    *out = n;
+    return true;
+}
+
+inline bool expect(const char*& p, const char* end, char c)
+{
+    if (p == end || *p != c) {
+        return false;
+    }
+    ++p;
+    return true;
+}
+}
+
+std::size_t Calendar::format(int64_t seconds, unsigned int milliseconds, const char* format,
+                             char* buf, std::size_t size)
+{
+    const CivilTime t = civilFromSeconds(seconds);
+    Writer w(buf, size);
+    for (; *format; ++format) {
+        if (*format == '%') {
+            switch (*++format) {
+            case '%':  // Escape
+                break;
+            case '\0':  // End
+                --format;
+                break;
+            case 'd':  // Day
+                w.putNumber(t.day, 2);
+                continue;
+            case 'a':  // Day of week (short)
+                w.put(kDaysAbbrev[t.weekday]);
+                continue;
+            case 'A':  // Day of week (long)
+                w.put(kDays[t.weekday]);
+                continue;
+            case 'M':  // month
+                w.putNumber(t.month, 2);
+                continue;
+            case 'b':  // month (short)
+                w.put(kMonthsAbbrev[t.month - 1]);
+                continue;
+            case 'B':  // month (long)
+                w.put(kMonths[t.month - 1]);
+                continue;
+            case 'y':  // year (two digits)
+                w.putYear(t.year, 2);
+                continue;
+            case 'Y':  // year (four digits)
+                w.putYear(t.year, 4);
+                continue;
+            case 'h':  // hour (12-hour)
+                w.putNumber(t.hour % 12, 2);
+                continue;
+            case 'H':  // hour (24-hour)
+                w.putNumber(t.hour, 2);
+                continue;
+            case 'm':  // minute
+                w.putNumber(t.minute, 2);
+                continue;
+            case 's':  // second
+                w.putNumber(t.second, 2);
+                continue;
+            case 'z':  // subsecond part
+            case 'g':
+                w.putNumber(milliseconds, 3 /* subsecond precision */);
+                continue;
+            case 'F':  // AM/PM
+                w.put(t.hour >= 12 ? "PM" : "AM");
+                continue;
+            default:
+                continue;
+            }
+        }
+        w.put(*format);
+    }
+    return w.finish();
+}
+
+std::size_t Calendar::formatRfc3339(int64_t seconds, char* buf, std::size_t size)
+{
+    const CivilTime t = civilFromSeconds(seconds);
+    if (size <= kRfc3339Length || t.year < 0 || t.year > 9999) {
+        if (size > 0) {
+            buf[0] = '\0';
+        }
+        return 0;
+    }
+    Writer w(buf, size);
+    w.putNumber(static_cast<uint64_t>(t.year), 4);
+    w.put('-');
+    w.putNumber(t.month, 2);
+    w.put('-');
+    w.putNumber(t.day, 2);
+    w.put('T');
+    w.putNumber(t.hour, 2);
+    w.put(':');
+    w.putNumber(t.minute, 2);
+    w.put(':');
+    w.putNumber(t.second, 2);
+    w.put('Z');
+    return w.finish();
+}
+
+bool Calendar::parseRfc3339(const char* str, std::size_t size, int64_t* seconds)
+{
+    const char* p = str;
+    const char* end = str + size;
+    unsigned int year = 0;
+    CivilTime t {};
+    if (!parseNumber(p, end, 4, &year) || !expect(p, end, '-')
+            || !parseNumber(p, end, 2, &t.month) || !expect(p, end, '-')
+            || !parseNumber(p, end, 2, &t.day)) {
+        return false;
+    }
+    if (p == end || (*p != 'T' && *p != 't' && *p != ' ')) {
+        return false;
+    }
+    ++p;
+    if (!parseNumber(p, end, 2, &t.hour) || !expect(p, end, ':')
+            || !parseNumber(p, end, 2, &t.minute) || !expect(p, end, ':')
+            || !parseNumber(p, end, 2, &t.second)) {
+        return false;
+    }
+    t.year = year;
+    if (t.month < 1 || t.month > 12 || t.day < 1 || t.day > daysInMonth(t.year, t.month)
+            || t.hour > 23 || t.minute > 59 || t.second > 60 /* leap second */) {
+        return false;
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        const char* fraction = p;
+        while (p != end && *p >= '0' && *p <= '9') {
+            ++p;
+        }
+        if (p == fraction) {
+            return false;
+        }
+    }
+    int64_t offset = 0;
+    if (p != end && (*p == 'Z' || *p == 'z')) {
+        ++p;
+    } else if (p != end && (*p == '+' || *p == '-')) {
+        const int64_t sign = *p == '-' ? -1 : 1;
+        ++p;
+        unsigned int offsetHour = 0;
+        unsigned int offsetMinute = 0;
+        if (!parseNumber(p, end, 2, &offsetHour) || !expect(p, end, ':')
+                || !parseNumber(p, end, 2, &offsetMinute)
+                || offsetHour > 23 || offsetMinute > 59) {
+            return false;
+        }
+        offset = sign * (static_cast<int64_t>(offsetHour) * 3600 + offsetMinute * 60);
+    } else {
+        return false;
+    }
+    if (p != end) {
+        return false;
+    }
+    *seconds = secondsFromCivil(t) - offset;
+    return true;
+}
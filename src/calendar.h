@@ -0,0 +1,142 @@
+//
+//  calendar.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_Calendar_h
+#define LICENSEPP_Calendar_h
+
+#include <cstddef>
+#include <cstdint>
+
+namespace licensepp {
+
+///
+/// \brief Broken down UTC time
+///
+struct CivilTime
+{
+    int64_t year;
+    unsigned int month;   // 1-12
+    unsigned int day;     // 1-31
+    unsigned int hour;    // 0-23
+    unsigned int minute;  // 0-59
+    unsigned int second;  // 0-59
+    unsigned int weekday; // 0-6, 0 is Sunday
+};
+
+///
+/// \brief Proleptic gregorian calendar for UTC epoch seconds
+///
+/// Conversions do not use libc time functions (no timezone, no locale, no static
+/// buffers) and formatting writes to caller's buffer. Conversions are constexpr.
+///
+class Calendar
+{
+public:
+    static const char* kDays[7];
+    static const char* kDaysAbbrev[7];
+    static const char* kMonths[12];
+    static const char* kMonthsAbbrev[12];
+
+    ///
+    /// \brief Length of RFC 3339 timestamp, i.e, 2028-01-06T17:11:00Z (without null terminator)
+    ///
+    static constexpr std::size_t kRfc3339Length = 20;
+
+    ///
+    /// \brief Days since 1970-01-01 for given date
+    ///
+    static constexpr int64_t daysFromCivil(int64_t year, unsigned int month, unsigned int day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        const int64_t era = (year >= 0 ? year : year - 399) / 400;
+        const unsigned int yearOfEra = static_cast<unsigned int>(year - era * 400);
+        const unsigned int dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const unsigned int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+    }
+
+    static constexpr bool isLeapYear(int64_t year)
+    {
+        return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    }
+
+    static constexpr unsigned int daysInMonth(int64_t year, unsigned int month)
+    {
+        return month == 2 ? (isLeapYear(year) ? 29 : 28)
+                          : (month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31);
+    }
+
+    ///
+    /// \brief Epoch seconds to UTC date and time
+    ///
+    static constexpr CivilTime civilFromSeconds(int64_t seconds)
+    {
+        int64_t days = seconds / 86400;
+        int64_t secondOfDay = seconds % 86400;
+        if (secondOfDay < 0) {
+            secondOfDay += 86400;
+            --days;
+        }
+        CivilTime t {};
+        t.hour = static_cast<unsigned int>(secondOfDay / 3600);
+        t.minute = static_cast<unsigned int>(secondOfDay % 3600 / 60);
+        t.second = static_cast<unsigned int>(secondOfDay % 60);
+        t.weekday = static_cast<unsigned int>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+
+        const int64_t z = days + 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned int dayOfEra = static_cast<unsigned int>(z - era * 146097);
+        const unsigned int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const unsigned int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const unsigned int mp = (5 * dayOfYear + 2) / 153;
+        t.day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        t.month = mp < 10 ? mp + 3 : mp - 9;
+        t.year = static_cast<int64_t>(yearOfEra) + era * 400 + (t.month <= 2 ? 1 : 0);
+        return t;
+    }
+
+    ///
+    /// \brief UTC date and time to epoch seconds (weekday is ignored)
+    ///
+    static constexpr int64_t secondsFromCivil(const CivilTime& t)
+    {
+        return daysFromCivil(t.year, t.month, t.day) * 86400
+                + static_cast<int64_t>(t.hour) * 3600 + t.minute * 60 + t.second;
+    }
+
+    ///
+    /// \brief Formats time using license++ format specifiers
+    ///
+    /// <pre>
+    /// %d day, %a/%A weekday, %M month, %b/%B month name, %y/%Y year,
+    /// %h/%H hour (12/24), %m minute, %s second, %z/%g milliseconds, %F AM/PM
+    /// </pre>
+    ///
+    /// Like snprintf, at most size - 1 characters are written followed by null terminator
+    /// \return Length of full output, output was truncated if this is >= size
+    ///
+    static std::size_t format(int64_t seconds, unsigned int milliseconds, const char* format,
+                              char* buf, std::size_t size);
+
+    ///
+    /// \brief Writes RFC 3339 UTC timestamp (kRfc3339Length characters and null terminator)
+    /// \return Number of characters written or 0 if buffer is too small or year is not in 0-9999
+    ///
+    static std::size_t formatRfc3339(int64_t seconds, char* buf, std::size_t size);
+
+    ///
+    /// \brief Parses RFC 3339 timestamp, e.g, 2028-01-06T17:11:00Z or 2028-01-06T19:11:00.250+02:00
+    ///
+    /// Fraction of second is ignored and time offset is applied
+    ///
+    static bool parseRfc3339(const char* str, std::size_t size, int64_t* seconds);
+};
+}
+
+#endif /* LICENSEPP_Calendar_h */
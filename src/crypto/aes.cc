@@ -7,24 +7,32 @@
 //  See https://github.com/abumq/licensepp/blob/master/LICENSE
 //
 
-#include <Ripe.h>
-
 #include "src/crypto/aes.h"
+#include "src/crypto/crypto-backend.h"
+#include "src/probes.h"
+#include "src/tracing.h"
 
 using namespace licensepp;
 
 std::string AES::decrypt(std::string& raw, const std::string& key, std::string& iv)
 {
-    return Ripe::decryptAES(raw, key, iv, true);
+    LICENSEPP_TRACE_SPAN(span, "aes.decrypt");
+    LICENSEPP_PROBE1(aes__decrypt__entry, raw.size());
+    std::string result = CryptoBackend::instance().aesDecrypt(raw, key, iv);
+    LICENSEPP_PROBE1(aes__decrypt__return, result.size());
+    return result;
 }
 
 std::string AES::encrypt(const std::string& plain, const std::string& key, const std::string& iv)
 {
-    std::string plainCopy(plain);
-    return Ripe::encryptAES(plainCopy, key, "", "", iv);
+    LICENSEPP_TRACE_SPAN(span, "aes.encrypt");
+    LICENSEPP_PROBE1(aes__encrypt__entry, plain.size());
+    std::string result = CryptoBackend::instance().aesEncrypt(plain, key, iv);
+    LICENSEPP_PROBE1(aes__encrypt__return, result.size());
+    return result;
 }
 
 std::string AES::generateKey(unsigned int bits)
 {
-    return Ripe::generateNewKey(bits / 8);
+    return CryptoBackend::instance().generateKey(bits / 8);
 }
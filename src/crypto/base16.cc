@@ -7,17 +7,17 @@
 //  See https://github.com/abumq/licensepp/blob/master/LICENSE
 //
 
-#include <Ripe.h>
 #include "src/crypto/base16.h"
+#include "src/crypto/crypto-backend.h"
 
 using namespace licensepp;
 
 std::string Base16::decode(const std::string& encoded)
 {
-    return Ripe::hexToString(encoded);
+    return CryptoBackend::instance().base16Decode(encoded);
 }
 
 std::string Base16::encode(const std::string& raw)
 {
-    return Ripe::stringToHex(raw);
+    return CryptoBackend::instance().base16Encode(raw);
 }
@@ -7,18 +7,78 @@
 //  See https://github.com/abumq/licensepp/blob/master/LICENSE
 //
 
-#include <Ripe.h>
-
+#include <cstdint>
+#include <cstring>
 #include "src/crypto/base64.h"
+#include "src/crypto/crypto-backend.h"
+#include "src/tracing.h"
 
 using namespace licensepp;
 
+namespace {
+
+const unsigned char kInvalid = 0xFF;
+const unsigned char kSkip = 0xFE;
+
+const unsigned char* decodeTable() noexcept
+{
+    static const struct Table
+    {
+        Table()
+        {
+            std::memset(values, kInvalid, sizeof(values));
+            const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (unsigned char i = 0; i < 64; ++i) {
+                values[static_cast<unsigned char>(alphabet[i])] = i;
+            }
+            for (unsigned char c : { ' ', '\t', '\r', '\n', '\v', '\f' }) {
+                values[c] = kSkip;
+            }
+        }
+        unsigned char values[256];
+    } s_table;
+    return s_table.values;
+}
+}
+
 std::string Base64::decode(const std::string& encoded)
 {
-    return Ripe::base64Decode(encoded);
+    LICENSEPP_TRACE_SPAN(span, "base64.decode");
+    return CryptoBackend::instance().base64Decode(encoded);
 }
 
 std::string Base64::encode(const std::string& raw)
 {
-    return Ripe::base64Encode(raw);
+    LICENSEPP_TRACE_SPAN(span, "base64.encode");
+    return CryptoBackend::instance().base64Encode(raw);
+}
+
+bool Base64::decode(const std::string& encoded, std::string* raw) noexcept
+{
+    const unsigned char* table = decodeTable();
+    raw->clear();
+    raw->reserve(encoded.size() / 4 * 3 + 3);
+    uint32_t buffer = 0;
+    int bits = 0;
+    std::size_t padding = 0;
+    for (char c : encoded) {
+        if (c == '=') {
+            ++padding;
+            continue;
+        }
+        const unsigned char value = table[static_cast<unsigned char>(c)];
+        if (value == kSkip) {
+            continue;
+        }
+        if (value == kInvalid || padding > 0) {
+            return false;
+        }
+        buffer = (buffer << 6) | value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            raw->push_back(static_cast<char>((buffer >> bits) & 0xFF));
+        }
+    }
+    return bits < 6 && padding <= 2;
 }
@@ -21,6 +21,12 @@ class Base64
 {
 public:
     static std::string decode(const std::string& encoded);
+
+    ///
+    /// \brief Decodes without throwing (whitespace is skipped)
+    /// \return False if encoded is not valid base64
+    ///
+    static bool decode(const std::string& encoded, std::string* raw) noexcept;
     static std::string encode(const std::string& raw);
 };
 }
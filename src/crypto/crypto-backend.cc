@@ -0,0 +1,141 @@
+//
+//  crypto-backend.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <stdexcept>
+#include "src/crypto/crypto-backend.h"
+
+#ifndef LICENSEPP_CRYPTO_RIPE
+#   define LICENSEPP_CRYPTO_RIPE 0
+#endif
+#ifndef LICENSEPP_CRYPTO_OPENSSL
+#   define LICENSEPP_CRYPTO_OPENSSL 0
+#endif
+#ifndef LICENSEPP_CRYPTO_DEFAULT_OPENSSL
+#   define LICENSEPP_CRYPTO_DEFAULT_OPENSSL 0
+#endif
+
+#if LICENSEPP_CRYPTO_RIPE
+#   include "src/crypto/ripe-backend.h"
+#endif
+#if LICENSEPP_CRYPTO_OPENSSL
+#   include "src/crypto/openssl-backend.h"
+#endif
+
+#if LICENSEPP_CRYPTO_DEFAULT_OPENSSL && !LICENSEPP_CRYPTO_OPENSSL
+#   error "Default crypto backend openssl is not built"
+#endif
+#if !LICENSEPP_CRYPTO_DEFAULT_OPENSSL && !LICENSEPP_CRYPTO_RIPE
+#   error "Default crypto backend ripe is not built"
+#endif
+
+using namespace licensepp;
+
+namespace {
+
+#if LICENSEPP_CRYPTO_RIPE
+const CryptoBackend& ripeBackend()
+{
+    static const RipeBackend s_backend;
+    return s_backend;
+}
+#endif
+
+#if LICENSEPP_CRYPTO_OPENSSL
+const CryptoBackend& opensslBackend()
+{
+    static const OpenSslBackend s_backend;
+    return s_backend;
+}
+#endif
+}
+
+const CryptoBackend& CryptoBackend::instance()
+{
+#if LICENSEPP_CRYPTO_DEFAULT_OPENSSL
+    static const CryptoBackend& s_instance = opensslBackend();
+#else
+    static const CryptoBackend& s_instance = ripeBackend();
+#endif
+    return s_instance;
+}
+
+const CryptoBackend* CryptoBackend::get(const std::string& name)
+{
+#if LICENSEPP_CRYPTO_RIPE
+    if (name == "ripe") {
+        return &ripeBackend();
+    }
+#endif
+#if LICENSEPP_CRYPTO_OPENSSL
+    if (name == "openssl") {
+        return &opensslBackend();
+    }
+#endif
+    (void) name;
+    return nullptr;
+}
+
+std::vector<std::string> CryptoBackend::available()
+{
+    std::vector<std::string> names;
+    names.push_back(instance().name());
+#if LICENSEPP_CRYPTO_RIPE && LICENSEPP_CRYPTO_OPENSSL
+    names.push_back(LICENSEPP_CRYPTO_DEFAULT_OPENSSL ? "ripe" : "openssl");
+#endif
+    return names;
+}
+
+bool CryptoBackend::verifiesDigests() const
+{
+    return false;
+}
+
+bool CryptoBackend::rsaVerifyDigest(const std::string&, const std::string&, const std::string&) const
+{
+    throw std::logic_error(std::string("Verifying digest is not supported by ") + name() + " backend");
+}
+
+namespace {
+
+///
+/// \brief Parsed key of backends that only take PEM
+///
+class PemPublicKey final : public ParsedPublicKey
+{
+public:
+    explicit PemPublicKey(const std::string& pem) :
+        pem(pem)
+    {
+    }
+
+    const std::string pem;
+};
+}
+
+std::shared_ptr<const ParsedPublicKey> CryptoBackend::parsePublicKey(const std::string& publicKeyPem) const
+{
+    return std::make_shared<PemPublicKey>(publicKeyPem);
+}
+
+std::string CryptoBackend::rsaEncrypt(const std::string& data, const ParsedPublicKey& publicKey) const
+{
+    return rsaEncrypt(data, static_cast<const PemPublicKey&>(publicKey).pem);
+}
+
+bool CryptoBackend::rsaVerify(const std::string& data, const std::string& signHex,
+                              const ParsedPublicKey& publicKey) const
+{
+    return rsaVerify(data, signHex, static_cast<const PemPublicKey&>(publicKey).pem);
+}
+
+bool CryptoBackend::rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                                    const ParsedPublicKey& publicKey) const
+{
+    return rsaVerifyDigest(digest, signHex, static_cast<const PemPublicKey&>(publicKey).pem);
+}
@@ -0,0 +1,130 @@
+//
+//  crypto-backend.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_CryptoBackend_h
+#define LICENSEPP_CryptoBackend_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace licensepp {
+
+///
+/// \brief Public key parsed by crypto backend, only usable with backend that parsed it
+///
+class ParsedPublicKey
+{
+public:
+    virtual ~ParsedPublicKey() = default;
+};
+
+///
+/// \brief Implementation behind RSA, AES, Base64 and Base16 wrappers
+///
+/// Backends must produce byte-identical output formats so licenses issued with
+/// one backend validate with another:
+/// <pre>
+///   RSA signature     PKCS#1 v1.5 over SHA-1, upper case hex
+///   RSA encryption    PKCS#1 v1.5, raw bytes
+///   AES               CBC with PKCS#7 padding, key size from key length (128/192/256),
+///                     encrypted as [lower case hex iv]:[base64 cipher]\r\n\r\n
+///   Base16            upper case
+/// </pre>
+/// Keys are PEM (private keys optionally encrypted with secret), AES keys and IVs are hex.
+/// Public keys that are used more than once are parsed once with parsePublicKey().
+/// Errors are thrown as std::exception.
+///
+/// Default backend is selected at build time (`cmake -Dcrypto=ripe|openssl ..`), with
+/// `-Dcrypto_interop=ON` both backends are built so they can be compared.
+///
+class CryptoBackend
+{
+public:
+    virtual ~CryptoBackend() = default;
+
+    ///
+    /// \brief Backend selected at build time
+    ///
+    static const CryptoBackend& instance();
+
+    ///
+    /// \brief Backend by name (ripe or openssl)
+    /// \return nullptr if backend is not built
+    ///
+    static const CryptoBackend* get(const std::string& name);
+
+    ///
+    /// \brief Names of backends that are built, default first
+    ///
+    static std::vector<std::string> available();
+
+    virtual const char* name() const = 0;
+
+    virtual std::string base64Encode(const std::string& raw) const = 0;
+    virtual std::string base64Decode(const std::string& encoded) const = 0;
+    virtual std::string base16Encode(const std::string& raw) const = 0;
+    virtual std::string base16Decode(const std::string& encoded) const = 0;
+
+    virtual std::string rsaEncrypt(const std::string& data, const std::string& publicKeyPem) const = 0;
+    virtual std::string rsaDecrypt(const std::string& data, const std::string& privateKeyPem,
+                                   const std::string& secret) const = 0;
+    virtual std::string rsaSign(const std::string& data, const std::string& privateKeyPem,
+                                const std::string& secret) const = 0;
+    virtual bool rsaVerify(const std::string& data, const std::string& signHex,
+                           const std::string& publicKeyPem) const = 0;
+
+    ///
+    /// \brief Whether backend implements rsaVerifyDigest()
+    ///
+    virtual bool verifiesDigests() const;
+
+    ///
+    /// \brief Same as rsaVerify() with raw SHA-1 digest of data instead of data, so digests of
+    /// many messages can be computed together (SHA1::hashMany()). Throws if not verifiesDigests()
+    ///
+    virtual bool rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                                 const std::string& publicKeyPem) const;
+
+    ///
+    /// \brief Parses public key for RSA functions below so PEM is not parsed on every call.
+    /// Default keeps PEM as it is, for backends that only take PEM
+    /// \throws std::exception if PEM is not a valid public key (backends that parse it)
+    ///
+    virtual std::shared_ptr<const ParsedPublicKey> parsePublicKey(const std::string& publicKeyPem) const;
+
+    ///
+    /// \brief Same as rsaEncrypt(), rsaVerify() and rsaVerifyDigest() with PEM, with key
+    /// parsed by parsePublicKey() of this backend
+    ///
+    virtual std::string rsaEncrypt(const std::string& data, const ParsedPublicKey& publicKey) const;
+    virtual bool rsaVerify(const std::string& data, const std::string& signHex,
+                           const ParsedPublicKey& publicKey) const;
+    virtual bool rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                                 const ParsedPublicKey& publicKey) const;
+
+    ///
+    /// \param hexIv Random IV is generated when empty
+    ///
+    virtual std::string aesEncrypt(const std::string& plain, const std::string& hexKey,
+                                   const std::string& hexIv) const = 0;
+    ///
+    /// \param cipher Base64 encoded cipher (without iv)
+    ///
+    virtual std::string aesDecrypt(const std::string& cipher, const std::string& hexKey,
+                                   const std::string& hexIv) const = 0;
+
+    ///
+    /// \brief Random key of size bytes in hex
+    ///
+    virtual std::string generateKey(unsigned int size) const = 0;
+};
+}
+
+#endif /* LICENSEPP_CryptoBackend_h */
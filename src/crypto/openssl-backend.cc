@@ -0,0 +1,420 @@
+//
+//  openssl-backend.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <openssl/bio.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rand.h>
+#include <openssl/rsa.h>
+
+#include "src/crypto/base64.h"
+#include "src/crypto/openssl-backend.h"
+
+using namespace licensepp;
+
+namespace {
+
+struct PKeyDeleter
+{
+    void operator()(EVP_PKEY* key) const { EVP_PKEY_free(key); }
+};
+struct PKeyCtxDeleter
+{
+    void operator()(EVP_PKEY_CTX* ctx) const { EVP_PKEY_CTX_free(ctx); }
+};
+struct MdCtxDeleter
+{
+    void operator()(EVP_MD_CTX* ctx) const { EVP_MD_CTX_free(ctx); }
+};
+struct CipherCtxDeleter
+{
+    void operator()(EVP_CIPHER_CTX* ctx) const { EVP_CIPHER_CTX_free(ctx); }
+};
+struct BioDeleter
+{
+    void operator()(BIO* bio) const { BIO_free(bio); }
+};
+
+using PKeyPtr = std::shared_ptr<EVP_PKEY>;
+using PKeyCtxPtr = std::unique_ptr<EVP_PKEY_CTX, PKeyCtxDeleter>;
+using MdCtxPtr = std::unique_ptr<EVP_MD_CTX, MdCtxDeleter>;
+using CipherCtxPtr = std::unique_ptr<EVP_CIPHER_CTX, CipherCtxDeleter>;
+using BioPtr = std::unique_ptr<BIO, BioDeleter>;
+
+[[noreturn]] void fail(const char* what)
+{
+    std::string message(what);
+    const unsigned long code = ERR_get_error();
+    if (code != 0) {
+        char reason[256];
+        ERR_error_string_n(code, reason, sizeof(reason));
+        message.append(": ").append(reason);
+    }
+    ERR_clear_error();
+    throw std::runtime_error(message);
+}
+
+///
+/// \brief Algorithms are fetched once, implicit fetch by EVP_sha1() etc. costs a lookup per call
+///
+struct Algorithms
+{
+    Algorithms() :
+        sha1(EVP_MD_fetch(nullptr, "SHA1", nullptr)),
+        aes128(EVP_CIPHER_fetch(nullptr, "AES-128-CBC", nullptr)),
+        aes192(EVP_CIPHER_fetch(nullptr, "AES-192-CBC", nullptr)),
+        aes256(EVP_CIPHER_fetch(nullptr, "AES-256-CBC", nullptr))
+    {
+    }
+
+    // not freed, used until exit
+    EVP_MD* sha1;
+    EVP_CIPHER* aes128;
+    EVP_CIPHER* aes192;
+    EVP_CIPHER* aes256;
+};
+
+const Algorithms& algorithms()
+{
+    static const Algorithms s_algorithms;
+    return s_algorithms;
+}
+
+const EVP_CIPHER* aesCipher(std::size_t keySize)
+{
+    const Algorithms& a = algorithms();
+    const EVP_CIPHER* cipher = keySize == 16 ? a.aes128 : keySize == 24 ? a.aes192 : keySize == 32 ? a.aes256 : nullptr;
+    if (cipher == nullptr) {
+        throw std::invalid_argument("Invalid AES key size " + std::to_string(keySize * 8) + " bits");
+    }
+    return cipher;
+}
+
+int passwordCallback(char* buf, int size, int, void* userdata)
+{
+    const std::string* secret = static_cast<const std::string*>(userdata);
+    const int length = static_cast<int>(std::min(secret->size(), static_cast<std::size_t>(size)));
+    std::memcpy(buf, secret->data(), static_cast<std::size_t>(length));
+    return length;
+}
+
+PKeyPtr readPrivateKey(const std::string& pem, const std::string& secret)
+{
+    BioPtr bio(BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size())));
+    EVP_PKEY* key = PEM_read_bio_PrivateKey(bio.get(), nullptr, passwordCallback,
+                                            const_cast<std::string*>(&secret));
+    if (key == nullptr) {
+        fail("Could not load private key");
+    }
+    return PKeyPtr(key, PKeyDeleter());
+}
+
+PKeyPtr readPublicKey(const std::string& pem)
+{
+    BioPtr bio(BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size())));
+    EVP_PKEY* key = PEM_read_bio_PUBKEY(bio.get(), nullptr, nullptr, nullptr);
+    if (key == nullptr) {
+        fail("Could not load public key");
+    }
+    return PKeyPtr(key, PKeyDeleter());
+}
+
+inline int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+inline const unsigned char* bytes(const std::string& str)
+{
+    return reinterpret_cast<const unsigned char*>(str.data());
+}
+}
+
+///
+/// \brief Public key parsed once, EVP_PKEY is safe to use from many threads at a time
+///
+class OpenSslPublicKey final : public ParsedPublicKey
+{
+public:
+    explicit OpenSslPublicKey(PKeyPtr key) :
+        key(std::move(key))
+    {
+    }
+
+    const PKeyPtr key;
+};
+
+const char* OpenSslBackend::name() const
+{
+    return "openssl";
+}
+
+std::string OpenSslBackend::base64Encode(const std::string& raw) const
+{
+    std::string result(4 * ((raw.size() + 2) / 3), '\0');
+    if (!result.empty()) {
+        const int size = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&result[0]), bytes(raw),
+                                         static_cast<int>(raw.size()));
+        result.resize(static_cast<std::size_t>(size));
+    }
+    return result;
+}
+
+std::string OpenSslBackend::base64Decode(const std::string& encoded) const
+{
+    // EVP_DecodeBlock does not skip whitespace or strip padding so portable decoder is used
+    std::string result;
+    if (!Base64::decode(encoded, &result)) {
+        throw std::invalid_argument("Invalid base64 encoding");
+    }
+    return result;
+}
+
+std::string OpenSslBackend::base16Encode(const std::string& raw) const
+{
+    static const char kDigits[] = "0123456789ABCDEF";
+    std::string result(raw.size() * 2, '\0');
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(raw[i]);
+        result[2 * i] = kDigits[c >> 4];
+        result[2 * i + 1] = kDigits[c & 0x0F];
+    }
+    return result;
+}
+
+std::string OpenSslBackend::base16Decode(const std::string& encoded) const
+{
+    if (encoded.size() % 2 != 0) {
+        throw std::invalid_argument("Invalid base16 encoding");
+    }
+    std::string result(encoded.size() / 2, '\0');
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        const int high = hexValue(encoded[2 * i]);
+        const int low = hexValue(encoded[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            throw std::invalid_argument("Invalid base16 encoding");
+        }
+        result[i] = static_cast<char>((high << 4) | low);
+    }
+    return result;
+}
+
+std::shared_ptr<const ParsedPublicKey> OpenSslBackend::parsePublicKey(const std::string& publicKeyPem) const
+{
+    return std::make_shared<OpenSslPublicKey>(readPublicKey(publicKeyPem));
+}
+
+std::string OpenSslBackend::rsaEncrypt(const std::string& data, const std::string& publicKeyPem) const
+{
+    return rsaEncrypt(data, OpenSslPublicKey(readPublicKey(publicKeyPem)));
+}
+
+std::string OpenSslBackend::rsaEncrypt(const std::string& data, const ParsedPublicKey& publicKey) const
+{
+    EVP_PKEY* key = static_cast<const OpenSslPublicKey&>(publicKey).key.get();
+    PKeyCtxPtr ctx(EVP_PKEY_CTX_new(key, nullptr));
+    std::size_t size = 0;
+    if (ctx == nullptr || EVP_PKEY_encrypt_init(ctx.get()) <= 0
+            || EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_PADDING) <= 0
+            || EVP_PKEY_encrypt(ctx.get(), nullptr, &size, bytes(data), data.size()) <= 0) {
+        fail("RSA encryption failed");
+    }
+    std::string result(size, '\0');
+    if (EVP_PKEY_encrypt(ctx.get(), reinterpret_cast<unsigned char*>(&result[0]), &size,
+                         bytes(data), data.size()) <= 0) {
+        fail("RSA encryption failed");
+    }
+    result.resize(size);
+    return result;
+}
+
+std::string OpenSslBackend::rsaDecrypt(const std::string& data, const std::string& privateKeyPem,
+                                       const std::string& secret) const
+{
+    PKeyPtr key = readPrivateKey(privateKeyPem, secret);
+    PKeyCtxPtr ctx(EVP_PKEY_CTX_new(key.get(), nullptr));
+    std::size_t size = 0;
+    if (ctx == nullptr || EVP_PKEY_decrypt_init(ctx.get()) <= 0
+            || EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_PADDING) <= 0
+            || EVP_PKEY_decrypt(ctx.get(), nullptr, &size, bytes(data), data.size()) <= 0) {
+        fail("RSA decryption failed");
+    }
+    std::string result(size, '\0');
+    if (EVP_PKEY_decrypt(ctx.get(), reinterpret_cast<unsigned char*>(&result[0]), &size,
+                         bytes(data), data.size()) <= 0) {
+        fail("RSA decryption failed");
+    }
+    result.resize(size);
+    return result;
+}
+
+std::string OpenSslBackend::rsaSign(const std::string& data, const std::string& privateKeyPem,
+                                    const std::string& secret) const
+{
+    PKeyPtr key = readPrivateKey(privateKeyPem, secret);
+    MdCtxPtr ctx(EVP_MD_CTX_new());
+    std::size_t size = 0;
+    if (ctx == nullptr || EVP_DigestSignInit(ctx.get(), nullptr, algorithms().sha1, nullptr, key.get()) <= 0
+            || EVP_DigestSign(ctx.get(), nullptr, &size, bytes(data), data.size()) <= 0) {
+        fail("RSA signing failed");
+    }
+    std::string signature(size, '\0');
+    if (EVP_DigestSign(ctx.get(), reinterpret_cast<unsigned char*>(&signature[0]), &size,
+                       bytes(data), data.size()) <= 0) {
+        fail("RSA signing failed");
+    }
+    signature.resize(size);
+    return base16Encode(signature);
+}
+
+bool OpenSslBackend::rsaVerify(const std::string& data, const std::string& signHex,
+                               const std::string& publicKeyPem) const
+{
+    return rsaVerify(data, signHex, OpenSslPublicKey(readPublicKey(publicKeyPem)));
+}
+
+bool OpenSslBackend::rsaVerify(const std::string& data, const std::string& signHex,
+                               const ParsedPublicKey& publicKey) const
+{
+    EVP_PKEY* key = static_cast<const OpenSslPublicKey&>(publicKey).key.get();
+    std::string signature;
+    try {
+        signature = base16Decode(signHex);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    MdCtxPtr ctx(EVP_MD_CTX_new());
+    if (ctx == nullptr || EVP_DigestVerifyInit(ctx.get(), nullptr, algorithms().sha1, nullptr, key) <= 0) {
+        fail("RSA verification failed");
+    }
+    const bool result = EVP_DigestVerify(ctx.get(), bytes(signature), signature.size(),
+                                         bytes(data), data.size()) == 1;
+    if (!result) {
+        ERR_clear_error();
+    }
+    return result;
+}
+
+bool OpenSslBackend::verifiesDigests() const
+{
+    return true;
+}
+
+bool OpenSslBackend::rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                                     const std::string& publicKeyPem) const
+{
+    return rsaVerifyDigest(digest, signHex, OpenSslPublicKey(readPublicKey(publicKeyPem)));
+}
+
+bool OpenSslBackend::rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                                     const ParsedPublicKey& publicKey) const
+{
+    EVP_PKEY* key = static_cast<const OpenSslPublicKey&>(publicKey).key.get();
+    std::string signature;
+    try {
+        signature = base16Decode(signHex);
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    // same PKCS#1 v1.5 SHA-1 check as rsaVerify() without hashing data
+    PKeyCtxPtr ctx(EVP_PKEY_CTX_new_from_pkey(nullptr, key, nullptr));
+    if (ctx == nullptr || EVP_PKEY_verify_init(ctx.get()) <= 0
+            || EVP_PKEY_CTX_set_rsa_padding(ctx.get(), RSA_PKCS1_PADDING) <= 0
+            || EVP_PKEY_CTX_set_signature_md(ctx.get(), algorithms().sha1) <= 0) {
+        fail("RSA verification failed");
+    }
+    const bool result = EVP_PKEY_verify(ctx.get(), bytes(signature), signature.size(),
+                                        bytes(digest), digest.size()) == 1;
+    if (!result) {
+        ERR_clear_error();
+    }
+    return result;
+}
+
+std::string OpenSslBackend::aesEncrypt(const std::string& plain, const std::string& hexKey,
+                                       const std::string& hexIv) const
+{
+    const std::string key = base16Decode(hexKey);
+    std::string iv;
+    if (hexIv.empty()) {
+        iv.resize(16);
+        if (RAND_bytes(reinterpret_cast<unsigned char*>(&iv[0]), 16) != 1) {
+            fail("Could not generate IV");
+        }
+    } else {
+        iv = base16Decode(hexIv);
+    }
+    if (iv.size() != 16) {
+        throw std::invalid_argument("Invalid AES initialization vector");
+    }
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new());
+    std::string cipher(plain.size() + 16, '\0');
+    int size = 0;
+    int finalSize = 0;
+    if (ctx == nullptr || EVP_EncryptInit_ex(ctx.get(), aesCipher(key.size()), nullptr, bytes(key), bytes(iv)) != 1
+            || EVP_EncryptUpdate(ctx.get(), reinterpret_cast<unsigned char*>(&cipher[0]), &size,
+                                 bytes(plain), static_cast<int>(plain.size())) != 1
+            || EVP_EncryptFinal_ex(ctx.get(), reinterpret_cast<unsigned char*>(&cipher[0]) + size, &finalSize) != 1) {
+        fail("AES encryption failed");
+    }
+    cipher.resize(static_cast<std::size_t>(size + finalSize));
+
+    std::string result = base16Encode(iv);
+    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    result.push_back(':');
+    result.append(base64Encode(cipher));
+    result.append("\r\n\r\n");
+    return result;
+}
+
+std::string OpenSslBackend::aesDecrypt(const std::string& cipher, const std::string& hexKey,
+                                       const std::string& hexIv) const
+{
+    const std::string key = base16Decode(hexKey);
+    const std::string iv = base16Decode(hexIv);
+    if (iv.size() != 16) {
+        throw std::invalid_argument("Invalid AES initialization vector");
+    }
+    const std::string raw = base64Decode(cipher);
+    CipherCtxPtr ctx(EVP_CIPHER_CTX_new());
+    std::string result(raw.size() + 16, '\0');
+    int size = 0;
+    int finalSize = 0;
+    if (ctx == nullptr || EVP_DecryptInit_ex(ctx.get(), aesCipher(key.size()), nullptr, bytes(key), bytes(iv)) != 1
+            || EVP_DecryptUpdate(ctx.get(), reinterpret_cast<unsigned char*>(&result[0]), &size,
+                                 bytes(raw), static_cast<int>(raw.size())) != 1
+            || EVP_DecryptFinal_ex(ctx.get(), reinterpret_cast<unsigned char*>(&result[0]) + size, &finalSize) != 1) {
+        fail("AES decryption failed");
+    }
+    result.resize(static_cast<std::size_t>(size + finalSize));
+    return result;
+}
+
+std::string OpenSslBackend::generateKey(unsigned int size) const
+{
+    std::string key(size, '\0');
+    if (size > 0 && RAND_bytes(reinterpret_cast<unsigned char*>(&key[0]), static_cast<int>(size)) != 1) {
+        fail("Could not generate key");
+    }
+    return base16Encode(key);
+}
@@ -0,0 +1,66 @@
+//
+//  openssl-backend.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_OpenSslBackend_h
+#define LICENSEPP_OpenSslBackend_h
+
+#include <memory>
+#include "src/crypto/crypto-backend.h"
+
+namespace licensepp {
+
+///
+/// \brief OpenSSL 3 (libcrypto) backend
+///
+/// Public keys parsed by parsePublicKey() hold EVP_PKEY, so authorities verify without
+/// parsing PEM. PEM keys (public and private) are parsed for every call.
+///
+class OpenSslBackend final : public CryptoBackend
+{
+public:
+    OpenSslBackend() = default;
+
+    OpenSslBackend(const OpenSslBackend&) = delete;
+    OpenSslBackend& operator=(const OpenSslBackend&) = delete;
+
+    const char* name() const override;
+
+    std::string base64Encode(const std::string& raw) const override;
+    std::string base64Decode(const std::string& encoded) const override;
+    std::string base16Encode(const std::string& raw) const override;
+    std::string base16Decode(const std::string& encoded) const override;
+
+    std::string rsaEncrypt(const std::string& data, const std::string& publicKeyPem) const override;
+    std::string rsaDecrypt(const std::string& data, const std::string& privateKeyPem,
+                           const std::string& secret) const override;
+    std::string rsaSign(const std::string& data, const std::string& privateKeyPem,
+                        const std::string& secret) const override;
+    bool rsaVerify(const std::string& data, const std::string& signHex,
+                   const std::string& publicKeyPem) const override;
+    bool verifiesDigests() const override;
+    bool rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                         const std::string& publicKeyPem) const override;
+
+    std::shared_ptr<const ParsedPublicKey> parsePublicKey(const std::string& publicKeyPem) const override;
+    std::string rsaEncrypt(const std::string& data, const ParsedPublicKey& publicKey) const override;
+    bool rsaVerify(const std::string& data, const std::string& signHex,
+                   const ParsedPublicKey& publicKey) const override;
+    bool rsaVerifyDigest(const std::string& digest, const std::string& signHex,
+                         const ParsedPublicKey& publicKey) const override;
+
+    std::string aesEncrypt(const std::string& plain, const std::string& hexKey,
+                           const std::string& hexIv) const override;
+    std::string aesDecrypt(const std::string& cipher, const std::string& hexKey,
+                           const std::string& hexIv) const override;
+
+    std::string generateKey(unsigned int size) const override;
+};
+}
+
+#endif /* LICENSEPP_OpenSslBackend_h */
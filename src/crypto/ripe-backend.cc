@@ -0,0 +1,86 @@
+//
+//  ripe-backend.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <Ripe.h>
+
+#include "src/crypto/ripe-backend.h"
+
+using namespace licensepp;
+
+const char* RipeBackend::name() const
+{
+    return "ripe";
+}
+
+std::string RipeBackend::base64Encode(const std::string& raw) const
+{
+    return Ripe::base64Encode(raw);
+}
+
+std::string RipeBackend::base64Decode(const std::string& encoded) const
+{
+    return Ripe::base64Decode(encoded);
+}
+
+std::string RipeBackend::base16Encode(const std::string& raw) const
+{
+    return Ripe::stringToHex(raw);
+}
+
+std::string RipeBackend::base16Decode(const std::string& encoded) const
+{
+    return Ripe::hexToString(encoded);
+}
+
+std::string RipeBackend::rsaEncrypt(const std::string& data, const std::string& publicKeyPem) const
+{
+    return Ripe::encryptRSA(data, publicKeyPem);
+}
+
+std::string RipeBackend::rsaDecrypt(const std::string& data, const std::string& privateKeyPem,
+                                    const std::string& secret) const
+{
+    // Ripe takes data by non-const reference
+    std::string copy(data);
+    return Ripe::decryptRSA(copy, privateKeyPem, false, false, secret);
+}
+
+std::string RipeBackend::rsaSign(const std::string& data, const std::string& privateKeyPem,
+                                 const std::string& secret) const
+{
+    return Ripe::signRSA(data, privateKeyPem, secret);
+}
+
+bool RipeBackend::rsaVerify(const std::string& data, const std::string& signHex,
+                            const std::string& publicKeyPem) const
+{
+    return Ripe::verifyRSA(data, signHex, publicKeyPem);
+}
+
+std::string RipeBackend::aesEncrypt(const std::string& plain, const std::string& hexKey,
+                                    const std::string& hexIv) const
+{
+    // Ripe takes plain text by non-const reference; reuse per thread buffer for the copy
+    static thread_local std::string plainCopy;
+    plainCopy.assign(plain);
+    return Ripe::encryptAES(plainCopy, hexKey, "", "", hexIv);
+}
+
+std::string RipeBackend::aesDecrypt(const std::string& cipher, const std::string& hexKey,
+                                    const std::string& hexIv) const
+{
+    std::string cipherCopy(cipher);
+    std::string iv(hexIv);
+    return Ripe::decryptAES(cipherCopy, hexKey, iv, true);
+}
+
+std::string RipeBackend::generateKey(unsigned int size) const
+{
+    return Ripe::generateNewKey(static_cast<int>(size));
+}
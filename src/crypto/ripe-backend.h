@@ -0,0 +1,51 @@
+//
+//  ripe-backend.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_RipeBackend_h
+#define LICENSEPP_RipeBackend_h
+
+#include "src/crypto/crypto-backend.h"
+
+namespace licensepp {
+
+///
+/// \brief Crypto++ backend using Ripe
+///
+class RipeBackend final : public CryptoBackend
+{
+public:
+    // Ripe only takes PEM, parsed keys are PEM kept by CryptoBackend
+    using CryptoBackend::rsaEncrypt;
+    using CryptoBackend::rsaVerify;
+
+    const char* name() const override;
+
+    std::string base64Encode(const std::string& raw) const override;
+    std::string base64Decode(const std::string& encoded) const override;
+    std::string base16Encode(const std::string& raw) const override;
+    std::string base16Decode(const std::string& encoded) const override;
+
+    std::string rsaEncrypt(const std::string& data, const std::string& publicKeyPem) const override;
+    std::string rsaDecrypt(const std::string& data, const std::string& privateKeyPem,
+                           const std::string& secret) const override;
+    std::string rsaSign(const std::string& data, const std::string& privateKeyPem,
+                        const std::string& secret) const override;
+    bool rsaVerify(const std::string& data, const std::string& signHex,
+                   const std::string& publicKeyPem) const override;
+
+    std::string aesEncrypt(const std::string& plain, const std::string& hexKey,
+                           const std::string& hexIv) const override;
+    std::string aesDecrypt(const std::string& cipher, const std::string& hexKey,
+                           const std::string& hexIv) const override;
+
+    std::string generateKey(unsigned int size) const override;
+};
+}
+
+#endif /* LICENSEPP_RipeBackend_h */
@@ -7,31 +7,69 @@
 //  See https://github.com/abumq/licensepp/blob/master/LICENSE
 //
 
-#include <Ripe.h>
-
+#include <stdexcept>
 #include "src/crypto/rsa.h"
 #include "src/crypto/base64.h"
+#include "src/crypto/crypto-backend.h"
+#include "src/probes.h"
+#include "src/tracing.h"
 
 using namespace licensepp;
 
+RSA::PublicKey RSA::loadPublicKey(const std::string& pem)
+{
+    return PublicKey(pem, CryptoBackend::instance().parsePublicKey(pem));
+}
+
 std::string RSA::encrypt(const std::string& data, const PublicKey& publicKey)
 {
-    return Ripe::encryptRSA(data, publicKey);
+    if (publicKey.empty()) {
+        throw std::invalid_argument("Public key is not loaded");
+    }
+    return CryptoBackend::instance().rsaEncrypt(data, *publicKey.parsed());
 }
 
 std::string RSA::decrypt(std::string& data, const PrivateKey& privateKey, const std::string& secret)
 {
-    return Ripe::decryptRSA(data, privateKey, true, false, secret);
+    return CryptoBackend::instance().rsaDecrypt(Base64::decode(data), privateKey, secret);
 }
 
 std::string RSA::sign(const std::string& data, const PrivateKey& key, const std::string& secret)
 {
-    return Ripe::signRSA(data, key, secret);
+    LICENSEPP_TRACE_SPAN(span, "rsa.sign");
+    LICENSEPP_PROBE1(rsa__sign__entry, data.size());
+    std::string signature = CryptoBackend::instance().rsaSign(data, key, secret);
+    LICENSEPP_PROBE1(rsa__sign__return, data.size());
+    return signature;
 }
 
 bool RSA::verify(const std::string& data, const std::string& signHex, const PublicKey& key)
 {
-    return Ripe::verifyRSA(data, signHex, key);
+    LICENSEPP_TRACE_SPAN(span, "rsa.verify");
+    LICENSEPP_PROBE1(rsa__verify__entry, data.size());
+    if (key.empty()) {
+        throw std::invalid_argument("Public key is not loaded");
+    }
+    const bool result = CryptoBackend::instance().rsaVerify(data, signHex, *key.parsed());
+    LICENSEPP_PROBE2(rsa__verify__return, result ? 1 : 0, data.size());
+    LICENSEPP_TRACE_RESULT(span, result);
+    return result;
+}
+
+bool RSA::verifyDigest(const std::string& digest, const std::string& signHex, const PublicKey& key)
+{
+    LICENSEPP_TRACE_SPAN(span, "rsa.verify_digest");
+    if (key.empty()) {
+        throw std::invalid_argument("Public key is not loaded");
+    }
+    const bool result = CryptoBackend::instance().rsaVerifyDigest(digest, signHex, *key.parsed());
+    LICENSEPP_TRACE_RESULT(span, result);
+    return result;
+}
+
+bool RSA::verifiesDigests()
+{
+    return CryptoBackend::instance().verifiesDigests();
 }
 
 bool RSA::verifyKeyPair(const PrivateKey& privateKey, const PublicKey& publicKey, const std::string& secret)
@@ -39,7 +77,7 @@ bool RSA::verifyKeyPair(const PrivateKey& privateKey, const PublicKey& publicKey
     try {
         std::string testData = "test_rsa";
         std::string encr = RSA::encrypt(testData, publicKey);
-        std::string decr = Ripe::decryptRSA(encr, privateKey, false, false, secret);
+        std::string decr = CryptoBackend::instance().rsaDecrypt(encr, privateKey, secret);
         return testData == decr;
     } catch (const std::exception& e) {
         return false;
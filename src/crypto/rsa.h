@@ -10,10 +10,51 @@
 #ifndef LICENSEPP_RSA_h
 #define LICENSEPP_RSA_h
 
+#include <memory>
 #include <string>
 
 namespace licensepp {
 
+class ParsedPublicKey;
+
+///
+/// \brief Public key PEM and key parsed from it by crypto backend, so RSA functions do not
+/// parse PEM every time
+///
+class RSAPublicKey
+{
+public:
+    RSAPublicKey() = default;
+
+    RSAPublicKey(const std::string& pem, std::shared_ptr<const ParsedPublicKey> parsed) :
+        m_pem(pem),
+        m_parsed(std::move(parsed))
+    {
+    }
+
+    inline const std::string& pem() const
+    {
+        return m_pem;
+    }
+
+    inline const ParsedPublicKey* parsed() const
+    {
+        return m_parsed.get();
+    }
+
+    ///
+    /// \brief True if key could not be loaded
+    ///
+    inline bool empty() const
+    {
+        return m_parsed == nullptr;
+    }
+
+private:
+    std::string m_pem;
+    std::shared_ptr<const ParsedPublicKey> m_parsed;
+};
+
 ///
 /// \brief RSA crypto wrappers
 ///
@@ -22,16 +63,18 @@ class RSA
 public:
 
     using PrivateKey = std::string;
-    using PublicKey = std::string;
+    using PublicKey = RSAPublicKey;
 
     static PrivateKey loadPrivateKey(const std::string& pem, const std::string& secret = "") {
         (void) secret;
         return pem;
     }
 
-    static PublicKey loadPublicKey(const std::string& pem) {
-        return pem;
-    }
+    ///
+    /// \brief Parses public key with crypto backend
+    /// \throws std::exception if PEM is not a valid public key
+    ///
+    static PublicKey loadPublicKey(const std::string& pem);
 
     struct KeyPair {
         PrivateKey privateKey;
@@ -46,6 +89,17 @@ public:
 
     static bool verify(const std::string& data, const std::string& signHex, const PublicKey& key);
 
+    ///
+    /// \brief Same as verify() with raw SHA-1 digest of data (see SHA1::hashMany()),
+    /// only when verifiesDigests()
+    ///
+    static bool verifyDigest(const std::string& digest, const std::string& signHex, const PublicKey& key);
+
+    ///
+    /// \brief Whether crypto backend supports verifyDigest()
+    ///
+    static bool verifiesDigests();
+
     static bool verifyKeyPair(const PrivateKey& privateKey, const PublicKey& publicKey, const std::string& secret = "");
 
 };
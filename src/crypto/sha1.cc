@@ -0,0 +1,340 @@
+//
+//  sha1.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "src/crypto/sha1.h"
+
+#if LICENSEPP_HAS_AVX2_SHA1
+#   include <immintrin.h>
+#endif
+
+using namespace licensepp;
+
+namespace {
+
+const uint32_t kInitialState[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+const uint32_t kRoundConstants[4] = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+// groups smaller than this are hashed one message at a time, lanes left empty cost as much
+// as used ones
+const std::size_t kMinLanesUsed = 3;
+
+inline uint32_t rotl(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+inline void writeDigest(const uint32_t* state, std::string* digest)
+{
+    digest->resize(SHA1::kDigestSize);
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            (*digest)[4 * i + j] = static_cast<char>(state[i] >> (24 - 8 * j));
+        }
+    }
+}
+}
+
+SHA1::SHA1() :
+    m_state { kInitialState[0], kInitialState[1], kInitialState[2], kInitialState[3], kInitialState[4] },
+    m_size(0),
+    m_bufferSize(0)
+{
+}
+
+void SHA1::update(const void* data, std::size_t size)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    m_size += size;
+    if (m_bufferSize > 0) {
+        const std::size_t n = std::min(size, sizeof(m_buffer) - m_bufferSize);
+        std::memcpy(m_buffer + m_bufferSize, p, n);
+        m_bufferSize += n;
+        p += n;
+        size -= n;
+        if (m_bufferSize < sizeof(m_buffer)) {
+            return;
+        }
+        transform(m_buffer);
+        m_bufferSize = 0;
+    }
+    for (; size >= 64; p += 64, size -= 64) {
+        transform(p);
+    }
+    std::memcpy(m_buffer, p, size);
+    m_bufferSize = size;
+}
+
+std::string SHA1::digest()
+{
+    const uint64_t bits = m_size * 8;
+    const unsigned char pad = 0x80;
+    const unsigned char zero[64] = {};
+    update(&pad, 1);
+    update(zero, (m_bufferSize <= 56 ? 56 : 120) - m_bufferSize);
+    unsigned char length[8];
+    for (int i = 0; i < 8; ++i) {
+        length[i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+    }
+    update(length, sizeof(length));
+
+    std::string result;
+    writeDigest(m_state, &result);
+    return result;
+}
+
+std::string SHA1::hash(const std::string& data)
+{
+    SHA1 sha;
+    sha.update(data);
+    return sha.digest();
+}
+
+void SHA1::transform(const unsigned char* block)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) | (static_cast<uint32_t>(block[4 * i + 1]) << 16)
+                | (static_cast<uint32_t>(block[4 * i + 2]) << 8) | static_cast<uint32_t>(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 80; ++i) {
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3], e = m_state[4];
+    auto round = [&](int i, uint32_t f, uint32_t k) {
+        const uint32_t t = rotl(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+    };
+    // one loop per round function so they are not selected on every round
+    for (int i = 0; i < 20; ++i) {
+        round(i, d ^ (b & (c ^ d)), kRoundConstants[0]);
+    }
+    for (int i = 20; i < 40; ++i) {
+        round(i, b ^ c ^ d, kRoundConstants[1]);
+    }
+    for (int i = 40; i < 60; ++i) {
+        round(i, (b & c) | (d & (b | c)), kRoundConstants[2]);
+    }
+    for (int i = 60; i < 80; ++i) {
+        round(i, b ^ c ^ d, kRoundConstants[3]);
+    }
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+}
+
+void SHA1::hashManyScalar(const std::string* const* messages, std::size_t n, std::string* digests)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        digests[i] = hash(*messages[i]);
+    }
+}
+
+#if LICENSEPP_HAS_AVX2_SHA1
+
+namespace {
+
+// Multi-buffer SHA-1: each 32-bit lane of AVX2 register is state of different message, so one
+// instruction does same step of 8 hashes. Messages are padded up front and lane of message that
+// has no more blocks hashes zero block that is ignored
+
+__attribute__((target("avx2")))
+inline __m256i rotlV(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+}
+
+///
+/// \brief Words [offset, offset + 8) of block of each lane, one register per word
+///
+__attribute__((target("avx2")))
+inline void loadWords(const unsigned char* const* blocks, std::size_t offset, __m256i* w)
+{
+    // big endian words
+    const __m256i byteSwap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    __m256i r[8];
+    for (int i = 0; i < 8; ++i) {
+        r[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + offset)), byteSwap);
+    }
+    // 8x8 transpose, lane i word j to word j lane i
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    const __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    const __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    w[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    w[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    w[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    w[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    w[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    w[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    w[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    w[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+__attribute__((target("avx2")))
+void transformLanes(const unsigned char* const* blocks, __m256i* state)
+{
+    __m256i w[16];
+    loadWords(blocks, 0, w);
+    loadWords(blocks, 32, w + 8);
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+    for (int i = 0; i < 80; ++i) {
+        if (i >= 16) {
+            // message schedule kept as ring of last 16 words
+            w[i & 15] = rotlV(_mm256_xor_si256(_mm256_xor_si256(w[(i - 3) & 15], w[(i - 8) & 15]),
+                                               _mm256_xor_si256(w[(i - 14) & 15], w[i & 15])), 1);
+        }
+        __m256i f;
+        if (i < 20) {
+            f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+        } else if (i < 40 || i >= 60) {
+            f = _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+        } else {
+            f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+        }
+        const __m256i k = _mm256_set1_epi32(static_cast<int>(kRoundConstants[i / 20]));
+        const __m256i t = _mm256_add_epi32(_mm256_add_epi32(rotlV(a, 5), f),
+                                           _mm256_add_epi32(_mm256_add_epi32(e, k), w[i & 15]));
+        e = d;
+        d = c;
+        c = rotlV(b, 30);
+        b = a;
+        a = t;
+    }
+    state[0] = _mm256_add_epi32(state[0], a);
+    state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c);
+    state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e);
+}
+
+///
+/// \brief Hashes up to SHA1::kLanes messages together
+///
+__attribute__((target("avx2")))
+void hashLanes(const std::string* const* messages, std::size_t count, std::string* const* digests)
+{
+    static const unsigned char kZeroBlock[64] = {};
+    // padded copies, buffers are reused by next call on same thread
+    static thread_local std::string s_padded[SHA1::kLanes];
+    std::size_t blockCounts[SHA1::kLanes] = {};
+    std::size_t maxBlocks = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string& message = *messages[i];
+        const uint64_t bits = static_cast<uint64_t>(message.size()) * 8;
+        std::string& padded = s_padded[i];
+        padded.assign(message);
+        padded.push_back(static_cast<char>(0x80));
+        padded.append((padded.size() % 64 <= 56 ? 56 : 120) - padded.size() % 64, '\0');
+        for (int j = 0; j < 8; ++j) {
+            padded.push_back(static_cast<char>(bits >> (56 - 8 * j)));
+        }
+        blockCounts[i] = padded.size() / 64;
+        maxBlocks = std::max(maxBlocks, blockCounts[i]);
+    }
+    __m256i state[5];
+    for (int i = 0; i < 5; ++i) {
+        state[i] = _mm256_set1_epi32(static_cast<int>(kInitialState[i]));
+    }
+    const unsigned char* blocks[SHA1::kLanes];
+    for (std::size_t block = 0; block < maxBlocks; ++block) {
+        bool finished = false;
+        for (std::size_t i = 0; i < SHA1::kLanes; ++i) {
+            blocks[i] = block < blockCounts[i]
+                    ? reinterpret_cast<const unsigned char*>(s_padded[i].data()) + block * 64 : kZeroBlock;
+            finished = finished || (i < count && blockCounts[i] == block + 1);
+        }
+        transformLanes(blocks, state);
+        if (finished) {
+            uint32_t lanes[5][SHA1::kLanes];
+            for (int j = 0; j < 5; ++j) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes[j]), state[j]);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                if (blockCounts[i] == block + 1) {
+                    const uint32_t laneState[5] = { lanes[0][i], lanes[1][i], lanes[2][i], lanes[3][i], lanes[4][i] };
+                    writeDigest(laneState, digests[i]);
+                }
+            }
+        }
+    }
+}
+}
+
+bool SHA1::avx2Supported()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+void SHA1::hashMany(const std::string* const* messages, std::size_t n, std::string* digests)
+{
+    if (!avx2Supported() || n < kMinLanesUsed) {
+        hashManyScalar(messages, n, digests);
+        return;
+    }
+    // messages with same number of blocks share lanes so fewer lanes idle
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) {
+        return messages[x]->size() < messages[y]->size();
+    });
+    const std::string* group[kLanes];
+    std::string* groupDigests[kLanes];
+    for (std::size_t i = 0; i < n; i += kLanes) {
+        const std::size_t count = std::min(kLanes, n - i);
+        if (count < kMinLanesUsed) {
+            for (std::size_t j = 0; j < count; ++j) {
+                digests[order[i + j]] = hash(*messages[order[i + j]]);
+            }
+            break;
+        }
+        for (std::size_t j = 0; j < count; ++j) {
+            group[j] = messages[order[i + j]];
+            groupDigests[j] = &digests[order[i + j]];
+        }
+        hashLanes(group, count, groupDigests);
+    }
+}
+
+#else
+
+bool SHA1::avx2Supported()
+{
+    return false;
+}
+
+void SHA1::hashMany(const std::string* const* messages, std::size_t n, std::string* digests)
+{
+    hashManyScalar(messages, n, digests);
+}
+
+#endif // LICENSEPP_HAS_AVX2_SHA1
@@ -0,0 +1,82 @@
+//
+//  sha1.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_SHA1_h
+#define LICENSEPP_SHA1_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define LICENSEPP_HAS_AVX2_SHA1 1
+#else
+#   define LICENSEPP_HAS_AVX2_SHA1 0
+#endif
+
+namespace licensepp {
+
+///
+/// \brief Portable SHA-1 (FIPS 180-4), digest RSA signatures are made over
+/// (see CryptoBackend), so signatures can be verified from digests computed in bulk
+///
+class SHA1
+{
+public:
+    static const std::size_t kDigestSize = 20;
+
+    ///
+    /// \brief Messages hashed together by hashMany() on AVX2, one per 32-bit lane
+    ///
+    static const std::size_t kLanes = 8;
+
+    SHA1();
+
+    void update(const void* data, std::size_t size);
+
+    inline void update(const std::string& data)
+    {
+        update(data.data(), data.size());
+    }
+
+    ///
+    /// \brief Raw 20-byte digest, object must not be updated after this
+    ///
+    std::string digest();
+
+    static std::string hash(const std::string& data);
+
+    ///
+    /// \brief Raw digests of n messages, same as hash() of each
+    ///
+    /// With AVX2 messages are hashed kLanes at a time, messages of similar size together
+    ///
+    static void hashMany(const std::string* const* messages, std::size_t n, std::string* digests);
+
+    ///
+    /// \brief hashMany() one message at a time, for comparison
+    ///
+    static void hashManyScalar(const std::string* const* messages, std::size_t n, std::string* digests);
+
+    ///
+    /// \brief Whether CPU (and build) supports AVX2 hashMany(), checked once
+    ///
+    static bool avx2Supported();
+
+private:
+    void transform(const unsigned char* block);
+
+    uint32_t m_state[5];
+    uint64_t m_size;
+    unsigned char m_buffer[64];
+    std::size_t m_bufferSize;
+};
+}
+
+#endif /* LICENSEPP_SHA1_h */
@@ -0,0 +1,53 @@
+//
+//  sha256.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_SHA256_h
+#define LICENSEPP_SHA256_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace licensepp {
+
+///
+/// \brief Portable SHA-256 (FIPS 180-4), same with every crypto backend
+///
+class SHA256
+{
+public:
+    static const std::size_t kDigestSize = 32;
+
+    SHA256();
+
+    void update(const void* data, std::size_t size);
+
+    inline void update(const std::string& data)
+    {
+        update(data.data(), data.size());
+    }
+
+    ///
+    /// \brief Raw 32-byte digest, object must not be updated after this
+    ///
+    std::string digest();
+
+    static std::string hash(const std::string& data);
+
+private:
+    void transform(const unsigned char* block);
+
+    uint32_t m_state[8];
+    uint64_t m_size;
+    unsigned char m_buffer[64];
+    std::size_t m_bufferSize;
+};
+}
+
+#endif /* LICENSEPP_SHA256_h */
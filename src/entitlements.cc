@@ -0,0 +1,170 @@
+//
+//  entitlements.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <license++/entitlements.h>
+
+using namespace licensepp;
+
+namespace {
+
+// FNV-1a
+inline uint64_t hashName(const char* name, std::size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline bool nameEquals(const std::string& name, const char* other, std::size_t size)
+{
+    return name.size() == size && std::memcmp(name.data(), other, size) == 0;
+}
+}
+
+Entitlements::Entitlements()
+{
+    compile();
+}
+
+Entitlements::Entitlements(std::vector<std::string> features,
+                           const Limits& limits,
+                           const ModuleExpiries& moduleExpiries) :
+    m_features(std::move(features)),
+    m_limits(limits.begin(), limits.end()),
+    m_moduleExpiries(moduleExpiries.begin(), moduleExpiries.end())
+{
+    std::sort(m_features.begin(), m_features.end());
+    m_features.erase(std::unique(m_features.begin(), m_features.end()), m_features.end());
+    compile();
+}
+
+Entitlements& Entitlements::addFeature(const std::string& feature)
+{
+    auto pos = std::lower_bound(m_features.begin(), m_features.end(), feature);
+    if (pos == m_features.end() || *pos != feature) {
+        m_features.insert(pos, feature);
+        compile();
+    }
+    return *this;
+}
+
+Entitlements& Entitlements::setLimit(const std::string& name, int64_t value)
+{
+    auto pos = std::lower_bound(m_limits.begin(), m_limits.end(), name,
+                                [](const std::pair<std::string, int64_t>& e, const std::string& n) {
+        return e.first < n;
+    });
+    if (pos != m_limits.end() && pos->first == name) {
+        pos->second = value;
+    } else {
+        m_limits.insert(pos, std::make_pair(name, value));
+        compile();
+    }
+    return *this;
+}
+
+Entitlements& Entitlements::setModuleExpiry(const std::string& module, uint64_t expiryDate)
+{
+    auto pos = std::lower_bound(m_moduleExpiries.begin(), m_moduleExpiries.end(), module,
+                                [](const std::pair<std::string, uint64_t>& e, const std::string& n) {
+        return e.first < n;
+    });
+    if (pos != m_moduleExpiries.end() && pos->first == module) {
+        pos->second = expiryDate;
+    } else {
+        m_moduleExpiries.insert(pos, std::make_pair(module, expiryDate));
+        compile();
+    }
+    return *this;
+}
+
+void Entitlements::compile()
+{
+    std::fill(m_featureBits, m_featureBits + kFeatureBits / 64, 0ULL);
+    m_featureIndex.clear();
+    m_limitIndex.clear();
+    m_moduleIndex.clear();
+
+    const auto byHash = [](const IndexEntry& a, const IndexEntry& b) {
+        return a.hash < b.hash;
+    };
+    m_featureIndex.reserve(m_features.size());
+    for (std::size_t i = 0; i < m_features.size(); ++i) {
+        const uint64_t hash = hashName(m_features[i].data(), m_features[i].size());
+        m_featureBits[(hash % kFeatureBits) / 64] |= 1ULL << (hash % 64);
+        m_featureIndex.push_back({ hash, static_cast<uint32_t>(i) });
+    }
+    std::sort(m_featureIndex.begin(), m_featureIndex.end(), byHash);
+
+    m_limitIndex.reserve(m_limits.size());
+    for (std::size_t i = 0; i < m_limits.size(); ++i) {
+        m_limitIndex.push_back({ hashName(m_limits[i].first.data(), m_limits[i].first.size()),
+                                 static_cast<uint32_t>(i) });
+    }
+    std::sort(m_limitIndex.begin(), m_limitIndex.end(), byHash);
+
+    m_moduleIndex.reserve(m_moduleExpiries.size());
+    for (std::size_t i = 0; i < m_moduleExpiries.size(); ++i) {
+        m_moduleIndex.push_back({ hashName(m_moduleExpiries[i].first.data(), m_moduleExpiries[i].first.size()),
+                                  static_cast<uint32_t>(i) });
+    }
+    std::sort(m_moduleIndex.begin(), m_moduleIndex.end(), byHash);
+}
+
+const Entitlements::IndexEntry* Entitlements::find(const std::vector<IndexEntry>& index, uint64_t hash) const
+{
+    auto pos = std::lower_bound(index.begin(), index.end(), hash, [](const IndexEntry& e, uint64_t h) {
+        return e.hash < h;
+    });
+    return pos == index.end() || pos->hash != hash ? nullptr : &(*pos);
+}
+
+bool Entitlements::hasFeature(const char* feature, std::size_t size) const
+{
+    const uint64_t hash = hashName(feature, size);
+    if ((m_featureBits[(hash % kFeatureBits) / 64] & (1ULL << (hash % 64))) == 0) {
+        return false;
+    }
+    // entries with same hash are adjacent
+    for (const IndexEntry* e = find(m_featureIndex, hash);
+         e != nullptr && e != m_featureIndex.data() + m_featureIndex.size() && e->hash == hash; ++e) {
+        if (nameEquals(m_features[e->position], feature, size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int64_t Entitlements::limit(const char* name, std::size_t size, int64_t defaultValue) const
+{
+    const uint64_t hash = hashName(name, size);
+    for (const IndexEntry* e = find(m_limitIndex, hash);
+         e != nullptr && e != m_limitIndex.data() + m_limitIndex.size() && e->hash == hash; ++e) {
+        if (nameEquals(m_limits[e->position].first, name, size)) {
+            return m_limits[e->position].second;
+        }
+    }
+    return defaultValue;
+}
+
+uint64_t Entitlements::moduleExpiry(const char* module, std::size_t size) const
+{
+    const uint64_t hash = hashName(module, size);
+    for (const IndexEntry* e = find(m_moduleIndex, hash);
+         e != nullptr && e != m_moduleIndex.data() + m_moduleIndex.size() && e->hash == hash; ++e) {
+        if (nameEquals(m_moduleExpiries[e->position].first, module, size)) {
+            return m_moduleExpiries[e->position].second;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,492 @@
+//
+//  issuance-log.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <license++/issuance-log.h>
+#include <license++/license.h>
+#include <license++/license-exception.h>
+#include "src/crypto/sha256.h"
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <fcntl.h>
+#   include <sys/file.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+namespace {
+
+// Log is 16-byte header followed by records, all little endian:
+//
+//   header:  u32 magic, u32 version, u64 log id
+//   record:  u32 magic, u32 record size, u64 sequence, u64 logged at (us), u64 issue date,
+//            u64 expiry date, 32-byte SHA-256 of License::raw(true), u32 authority size,
+//            u32 licensee size, authority, licensee, 32-byte hash
+//
+// hash = SHA-256(hash of previous record || record up to hash); hash before first record is
+// SHA-256 of header so records cannot be moved between logs
+
+const uint32_t kLogMagic = 0x4C49504CU;  // LPIL
+const uint32_t kLogVersion = 1;
+const std::size_t kHeaderSize = 16;
+const uint32_t kRecordMagic = 0x5249504CU;  // LPIR
+const std::size_t kRecordFixedSize = 80;
+const std::size_t kHashSize = SHA256::kDigestSize;
+const std::size_t kMaxNameSize = 64 * 1024;
+
+inline void writeU32(unsigned char* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void writeU64(unsigned char* p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t readU32(const unsigned char* p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+std::string toHex(const std::string& raw)
+{
+    static const char* kHexDigits = "0123456789abcdef";
+    std::string result;
+    result.reserve(raw.size() * 2);
+    for (unsigned char c : raw) {
+        result.push_back(kHexDigits[c >> 4]);
+        result.push_back(kHexDigits[c & 0x0f]);
+    }
+    return result;
+}
+
+std::string chainHash(const std::string& previous, const unsigned char* record, std::size_t size)
+{
+    SHA256 sha;
+    sha.update(previous);
+    sha.update(record, size);
+    return sha.digest();
+}
+
+uint64_t nowUs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+///
+/// \brief Reads records of log and checks the chain
+/// \param chain Raw hash of last valid record
+/// \param torn Set when log ends with incomplete record (crash during write) rather than
+/// record that breaks the chain
+///
+IssuanceLog::Verification scan(std::FILE* file, std::vector<IssuanceLog::Record>* records,
+                               std::string* chain, bool* torn)
+{
+    IssuanceLog::Verification result { false, 0, "", 0, "" };
+    *torn = false;
+    unsigned char header[kHeaderSize];
+    if (std::fread(header, 1, kHeaderSize, file) != kHeaderSize || readU32(header) != kLogMagic
+            || readU32(header + 4) != kLogVersion) {
+        result.error = "Not an issuance log";
+        return result;
+    }
+    *chain = SHA256::hash(std::string(reinterpret_cast<const char*>(header), kHeaderSize));
+    uint64_t offset = kHeaderSize;
+    std::vector<unsigned char> record;
+    while (true) {
+        result.head = toHex(*chain);
+        result.brokenAt = offset;
+        unsigned char prefix[8];
+        const std::size_t read = std::fread(prefix, 1, sizeof(prefix), file);
+        if (read == 0) {
+            break;
+        }
+        if (read < sizeof(prefix) || readU32(prefix) == 0) {
+            // partly written or zero-filled by file system after crash
+            *torn = true;
+            result.error = "Incomplete record";
+            return result;
+        }
+        const uint32_t size = readU32(prefix + 4);
+        if (readU32(prefix) != kRecordMagic || size < kRecordFixedSize + kHashSize
+                || size > kRecordFixedSize + 2 * kMaxNameSize + kHashSize) {
+            result.error = "Invalid record";
+            return result;
+        }
+        record.resize(size);
+        std::memcpy(record.data(), prefix, sizeof(prefix));
+        if (std::fread(record.data() + sizeof(prefix), 1, size - sizeof(prefix), file) != size - sizeof(prefix)) {
+            *torn = true;
+            result.error = "Incomplete record";
+            return result;
+        }
+        const unsigned char* p = record.data();
+        const uint32_t authoritySize = readU32(p + 72);
+        const uint32_t licenseeSize = readU32(p + 76);
+        if (static_cast<uint64_t>(kRecordFixedSize) + authoritySize + licenseeSize + kHashSize != size) {
+            result.error = "Invalid record";
+            return result;
+        }
+        if (readU64(p + 8) != result.records + 1) {
+            result.error = "Record out of sequence";
+            return result;
+        }
+        const std::string hash = chainHash(*chain, p, size - kHashSize);
+        if (std::memcmp(hash.data(), p + size - kHashSize, kHashSize) != 0) {
+            result.error = "Hash chain broken";
+            return result;
+        }
+        if (records != nullptr) {
+            const char* names = reinterpret_cast<const char*>(p + kRecordFixedSize);
+            records->push_back(IssuanceLog::Record {
+                readU64(p + 8),
+                readU64(p + 16),
+                readU64(p + 24),
+                readU64(p + 32),
+                toHex(std::string(reinterpret_cast<const char*>(p + 40), kHashSize)),
+                std::string(names, authoritySize),
+                std::string(names + authoritySize, licenseeSize),
+                toHex(hash)
+            });
+        }
+        *chain = hash;
+        ++result.records;
+        offset += size;
+    }
+    result.valid = true;
+    return result;
+}
+}
+
+IssuanceLog::Verification IssuanceLog::verify(const std::string& path, std::vector<Record>* records)
+{
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file) {
+        return Verification { false, 0, "", 0, "Failed to open " + path };
+    }
+    std::string chain;
+    bool torn = false;
+    return scan(file.get(), records, &chain, &torn);
+}
+
+#if LICENSEPP_OS_UNIX
+
+IssuanceLog::IssuanceLog(const std::string& path, unsigned int maxDelayUs, std::size_t maxBatch) :
+    m_path(path),
+    m_maxDelayUs(maxDelayUs),
+    m_maxBatch(maxBatch == 0 ? 1 : maxBatch),
+    m_fd(-1),
+    m_size(0),
+    m_queued(0),
+    m_durable(0),
+    m_commits(0),
+    m_failed(false),
+    m_stopping(false)
+{
+    m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    struct stat st;
+    if (m_fd < 0 || ::fstat(m_fd, &st) != 0) {
+        throw LicenseException("Failed to open issuance log " + m_path);
+    }
+    if (::flock(m_fd, LOCK_EX | LOCK_NB) != 0) {
+        ::close(m_fd);
+        throw LicenseException("Issuance log " + m_path + " is in use by another process");
+    }
+    if (static_cast<uint64_t>(st.st_size) < kHeaderSize) {
+        // new log (or crashed while creating it)
+        std::random_device device;
+        unsigned char header[kHeaderSize];
+        writeU32(header, kLogMagic);
+        writeU32(header + 4, kLogVersion);
+        writeU64(header + 8, (static_cast<uint64_t>(device()) << 32) ^ device() ^ nowUs());
+        if (::ftruncate(m_fd, 0) != 0 || ::pwrite(m_fd, header, kHeaderSize, 0) != static_cast<ssize_t>(kHeaderSize)
+                || ::fsync(m_fd) != 0) {
+            ::close(m_fd);
+            throw LicenseException("Failed to create issuance log " + m_path);
+        }
+        const std::size_t slash = m_path.find_last_of('/');
+        const int dirFd = ::open(slash == std::string::npos ? "." : m_path.substr(0, slash + 1).c_str(),
+                                 O_RDONLY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+    std::unique_ptr<std::FILE, int(*)(std::FILE*)> file(std::fopen(m_path.c_str(), "rb"), &std::fclose);
+    bool torn = false;
+    const Verification verification = file ? scan(file.get(), nullptr, &m_chain, &torn)
+                                            : Verification { false, 0, "", 0, "Failed to read" };
+    if (!verification.valid && !torn) {
+        ::close(m_fd);
+        throw LicenseException("Invalid issuance log " + m_path + ": " + verification.error + " at offset "
+                               + std::to_string(verification.brokenAt));
+    }
+    if (torn && (::ftruncate(m_fd, static_cast<off_t>(verification.brokenAt)) != 0 || ::fsync(m_fd) != 0)) {
+        ::close(m_fd);
+        throw LicenseException("Failed to recover issuance log " + m_path);
+    }
+    m_size = verification.brokenAt;
+    m_queued = m_durable = verification.records;
+    m_head = verification.head;
+    m_writer = std::thread(&IssuanceLog::commitLoop, this);
+}
+
+IssuanceLog::~IssuanceLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_pendingReady.notify_one();
+    m_writer.join();
+    ::close(m_fd);
+}
+
+bool IssuanceLog::append(const License& license)
+{
+    std::vector<Pending> records;
+    records.push_back(Pending { SHA256::hash(license.raw(true)), license.issuingAuthorityId(), license.licensee(),
+                                license.issueDate(), license.expiryDate() });
+    return append(&records);
+}
+
+bool IssuanceLog::append(const std::vector<License>& licenses)
+{
+    std::vector<Pending> records;
+    records.reserve(licenses.size());
+    for (const License& license : licenses) {
+        records.push_back(Pending { SHA256::hash(license.raw(true)), license.issuingAuthorityId(),
+                                    license.licensee(), license.issueDate(), license.expiryDate() });
+    }
+    return append(&records);
+}
+
+bool IssuanceLog::append(std::vector<Pending>* records)
+{
+    if (records->empty()) {
+        return true;
+    }
+    for (Pending& record : *records) {
+        record.issuingAuthorityId.resize(std::min(record.issuingAuthorityId.size(), kMaxNameSize));
+        record.licensee.resize(std::min(record.licensee.size(), kMaxNameSize));
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_failed) {
+        return false;
+    }
+    const bool wasEmpty = m_pending.empty();
+    if (wasEmpty) {
+        m_pending.swap(*records);
+    } else {
+        m_pending.insert(m_pending.end(), std::make_move_iterator(records->begin()),
+                         std::make_move_iterator(records->end()));
+    }
+    m_queued += wasEmpty ? m_pending.size() : records->size();
+    const uint64_t sequence = m_queued;
+    if (wasEmpty) {
+        m_batchStarted = std::chrono::steady_clock::now();
+    }
+    if (wasEmpty || m_pending.size() >= m_maxBatch) {
+        m_pendingReady.notify_one();
+    }
+    m_committed.wait(lock, [&]() { return m_durable >= sequence || m_failed; });
+    return m_durable >= sequence;
+}
+
+void IssuanceLog::commitLoop()
+{
+    std::string buffer;
+    std::vector<Pending> batch;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_pendingReady.wait(lock, [&]() { return m_stopping || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            return;
+        }
+        if (m_maxDelayUs > 0) {
+            // wait for more records to share the sync, up to latency bound of first one
+            m_pendingReady.wait_until(lock, m_batchStarted + std::chrono::microseconds(m_maxDelayUs), [&]() {
+                return m_stopping || m_pending.size() >= m_maxBatch;
+            });
+        }
+        uint64_t sequence = m_queued - m_pending.size();
+        batch.clear();
+        if (m_pending.size() <= m_maxBatch) {
+            batch.swap(m_pending);
+        } else {
+            // rest keeps batch start time so it is written right after this batch
+            batch.assign(std::make_move_iterator(m_pending.begin()),
+                         std::make_move_iterator(m_pending.begin() + m_maxBatch));
+            m_pending.erase(m_pending.begin(), m_pending.begin() + m_maxBatch);
+        }
+        lock.unlock();
+
+        buffer.clear();
+        std::string chain = m_chain;
+        const uint64_t loggedAt = nowUs();
+        for (const Pending& pending : batch) {
+            const std::size_t start = buffer.size();
+            const std::size_t size = kRecordFixedSize + pending.issuingAuthorityId.size()
+                    + pending.licensee.size() + kHashSize;
+            buffer.resize(start + size);
+            unsigned char* p = reinterpret_cast<unsigned char*>(&buffer[start]);
+            writeU32(p, kRecordMagic);
+            writeU32(p + 4, static_cast<uint32_t>(size));
+            writeU64(p + 8, ++sequence);
+            writeU64(p + 16, loggedAt);
+            writeU64(p + 24, pending.issueDate);
+            writeU64(p + 32, pending.expiryDate);
+            std::memcpy(p + 40, pending.fingerprint.data(), kHashSize);
+            writeU32(p + 72, static_cast<uint32_t>(pending.issuingAuthorityId.size()));
+            writeU32(p + 76, static_cast<uint32_t>(pending.licensee.size()));
+            std::memcpy(p + kRecordFixedSize, pending.issuingAuthorityId.data(), pending.issuingAuthorityId.size());
+            std::memcpy(p + kRecordFixedSize + pending.issuingAuthorityId.size(), pending.licensee.data(),
+                        pending.licensee.size());
+            chain = chainHash(chain, p, size - kHashSize);
+            std::memcpy(p + size - kHashSize, chain.data(), kHashSize);
+        }
+        bool ok = true;
+        std::size_t written = 0;
+        while (ok && written < buffer.size()) {
+            const ssize_t result = ::pwrite(m_fd, buffer.data() + written, buffer.size() - written,
+                                            static_cast<off_t>(m_size + written));
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            ok = result > 0;
+            written += ok ? static_cast<std::size_t>(result) : 0;
+        }
+        ok = ok && ::fdatasync(m_fd) == 0;
+        if (ok) {
+            m_size += buffer.size();
+            m_chain = chain;
+        } else if (::ftruncate(m_fd, static_cast<off_t>(m_size)) == 0) {
+            // nothing of failed batch is acknowledged; records after this are refused since log
+            // would otherwise have gap in what callers were told about
+            ::fdatasync(m_fd);
+        }
+
+        lock.lock();
+        if (ok) {
+            m_durable = sequence;
+            m_head = toHex(m_chain);
+            ++m_commits;
+        } else {
+            m_failed = true;
+        }
+        m_committed.notify_all();
+        if (m_failed) {
+            return;
+        }
+    }
+}
+
+uint64_t IssuanceLog::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_durable;
+}
+
+std::string IssuanceLog::head() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_head;
+}
+
+uint64_t IssuanceLog::commits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_commits;
+}
+
+#else
+
+IssuanceLog::IssuanceLog(const std::string& path, unsigned int maxDelayUs, std::size_t maxBatch) :
+    m_path(path),
+    m_maxDelayUs(maxDelayUs),
+    m_maxBatch(maxBatch),
+    m_fd(-1),
+    m_size(0),
+    m_queued(0),
+    m_durable(0),
+    m_commits(0),
+    m_failed(true),
+    m_stopping(false)
+{
+    throw LicenseException("Issuance log is only available on unix");
+}
+
+IssuanceLog::~IssuanceLog()
+{
+}
+
+bool IssuanceLog::append(const License&)
+{
+    return false;
+}
+
+bool IssuanceLog::append(const std::vector<License>&)
+{
+    return false;
+}
+
+bool IssuanceLog::append(std::vector<Pending>*)
+{
+    return false;
+}
+
+void IssuanceLog::commitLoop()
+{
+}
+
+uint64_t IssuanceLog::size() const
+{
+    return 0;
+}
+
+std::string IssuanceLog::head() const
+{
+    return "";
+}
+
+uint64_t IssuanceLog::commits() const
+{
+    return 0;
+}
+
+#endif // LICENSEPP_OS_UNIX
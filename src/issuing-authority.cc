@@ -7,7 +7,6 @@
 //  See https://github.com/abumq/licensepp/blob/master/LICENSE 
 //
 
-#include <cmath>
 #include <iostream>
 #include <license++/issuing-authority.h>
 #include <license++/license.h>
@@ -16,6 +15,10 @@
 #include "src/crypto/base16.h"
 #include "src/crypto/base64.h"
 #include "src/crypto/rsa.h"
+#include "src/license-check.h"
+#include "src/merkle-tree.h"
+#include "src/probes.h"
+#include "src/tracing.h"
 #include "src/utils.h"
 
 using namespace licensepp;
@@ -24,13 +27,18 @@ IssuingAuthority::IssuingAuthority(const std::string& id,
                                    const std::string& name,
                                    const std::string& keypair,
                                    unsigned int maxValidity,
-                                   bool active) :
+                                   bool active,
+                                   uint32_t keyId) :
     m_id(id),
     m_name(name),
     m_keypair(keypair),
     m_active(active),
-    m_maxValidity(maxValidity)
+    m_maxValidity(maxValidity),
+    m_keyId(keyId)
 {
+    auto separatorPos = m_keypair.find(":");
+    // empty key for invalid keypair is reported by validate()
+    addPublicKey(m_keyId, separatorPos == std::string::npos ? "" : m_keypair.substr(separatorPos + 1));
     if (m_maxValidity < 24U) {
         std::cerr << "Could not activate issuing authority "
                   << id << ", it should be able to issue at least 24 hours license" << std::endl;
@@ -42,19 +50,66 @@ IssuingAuthority::IssuingAuthority(const IssuingAuthority& other):
     m_id(other.m_id),
     m_name(other.m_name),
     m_keypair(other.m_keypair),
+    m_publicKeys(other.m_publicKeys),
+    m_active(other.m_active),
+    m_maxValidity(other.m_maxValidity),
+    m_keyId(other.m_keyId)
+{
+}
+
+IssuingAuthority::IssuingAuthority(IssuingAuthority&& other) noexcept:
+    m_id(std::move(other.m_id)),
+    m_name(std::move(other.m_name)),
+    m_keypair(std::move(other.m_keypair)),
+    m_publicKeys(std::move(other.m_publicKeys)),
     m_active(other.m_active),
-    m_maxValidity(other.m_maxValidity)
+    m_maxValidity(other.m_maxValidity),
+    m_keyId(other.m_keyId)
 {
 }
 
-IssuingAuthority& IssuingAuthority::operator=(IssuingAuthority other)
+IssuingAuthority& IssuingAuthority::operator=(const IssuingAuthority& other)
 {
-    std::swap(m_id, other.m_id);
-    std::swap(m_name, other.m_name);
-    std::swap(m_keypair, other.m_keypair);
-    std::swap(m_active, other.m_active);
-    std::swap(m_maxValidity, other.m_maxValidity);
+    if (this != &other) {
+        m_id = other.m_id;
+        m_name = other.m_name;
+        m_keypair = other.m_keypair;
+        m_publicKeys = other.m_publicKeys;
+        m_active = other.m_active;
+        m_maxValidity = other.m_maxValidity;
+        m_keyId = other.m_keyId;
+    }
+    return *this;
+}
 
+IssuingAuthority& IssuingAuthority::operator=(IssuingAuthority&& other) noexcept
+{
+    m_id = std::move(other.m_id);
+    m_name = std::move(other.m_name);
+    m_keypair = std::move(other.m_keypair);
+    m_publicKeys = std::move(other.m_publicKeys);
+    m_active = other.m_active;
+    m_maxValidity = other.m_maxValidity;
+    m_keyId = other.m_keyId;
+    return *this;
+}
+
+IssuingAuthority& IssuingAuthority::addPublicKey(uint32_t keyId, const std::string& publicKey)
+{
+    std::shared_ptr<const RSAPublicKey> key;
+    try {
+        key = std::make_shared<RSAPublicKey>(RSA::loadPublicKey(Base64::decode(publicKey)));
+    } catch (const std::exception&) {
+        // empty key is reported by validate()
+        key = std::make_shared<RSAPublicKey>();
+    }
+    m_publicKeys[keyId] = std::move(key);
+    return *this;
+}
+
+IssuingAuthority& IssuingAuthority::retirePublicKey(uint32_t keyId)
+{
+    m_publicKeys.erase(keyId);
     return *this;
 }
 
@@ -63,7 +118,82 @@ License IssuingAuthority::issue(const std::string& licensee,
                                 const std::string& masterKey,
                                 const std::string& secret,
                                 const std::string& licenseeSignature,
-                                const std::string& additionalPayload) const
+                                const std::string& additionalPayload,
+                                const Entitlements& entitlements) const
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.issue");
+    LICENSEPP_TRACE_AUTHORITY(span, id());
+    LICENSEPP_PROBE2(issue__entry, m_id.c_str(), licensee.c_str());
+    try {
+        License license = issueLicense(licensee, validityPeriod, masterKey, secret,
+                                       licenseeSignature, additionalPayload, entitlements);
+        LICENSEPP_PROBE3(issue__return, m_id.c_str(), 1, additionalPayload.size());
+        return license;
+    } catch (...) {
+        LICENSEPP_PROBE3(issue__return, m_id.c_str(), 0, additionalPayload.size());
+        throw;
+    }
+}
+
+License IssuingAuthority::issueLicense(const std::string& licensee,
+                                       unsigned int validityPeriod,
+                                       const std::string& masterKey,
+                                       const std::string& secret,
+                                       const std::string& licenseeSignature,
+                                       const std::string& additionalPayload,
+                                       const Entitlements& entitlements) const
+{
+    License license = prepareLicense(licensee, validityPeriod, masterKey, licenseeSignature,
+                                     additionalPayload, entitlements);
+    license.setAuthoritySignature(sign(license.raw(), secret));
+
+    if (!validate(&license, masterKey, true, licenseeSignature)) {
+        throw LicenseException("Failed to validate new license. Please report it @ https://github.com/abumq/licensepp");
+    }
+    return license;
+}
+
+std::vector<License> IssuingAuthority::issueBatch(const std::vector<std::string>& licensees,
+                                                  unsigned int validityPeriod,
+                                                  const std::string& masterKey,
+                                                  const std::string& secret,
+                                                  const std::string& licenseeSignature,
+                                                  const std::string& additionalPayload,
+                                                  const Entitlements& entitlements) const
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.issue_batch");
+    LICENSEPP_TRACE_AUTHORITY(span, id());
+    if (licensees.empty()) {
+        throw LicenseException("Please provide at least one licensee for batch");
+    }
+    std::vector<License> licenses;
+    licenses.reserve(licensees.size());
+    std::vector<std::string> leaves;
+    leaves.reserve(licensees.size());
+    for (const std::string& licensee : licensees) {
+        licenses.push_back(prepareLicense(licensee, validityPeriod, masterKey, licenseeSignature,
+                                          additionalPayload, entitlements));
+        leaves.push_back(MerkleTree::leafHash(licenses.back().raw()));
+    }
+    const MerkleTree tree(std::move(leaves));
+    const std::string rootSignature = sign(MerkleTree::signedRoot(tree.root()), secret);
+    for (std::size_t i = 0; i < licenses.size(); ++i) {
+        licenses[i].setAuthoritySignature(rootSignature);
+        licenses[i].setBatchProof(tree.proof(static_cast<uint32_t>(i)));
+        // root signature is verified once, rest of the batch hits verified root cache
+        if (!validate(&licenses[i], masterKey, true, licenseeSignature)) {
+            throw LicenseException("Failed to validate new license. Please report it @ https://github.com/abumq/licensepp");
+        }
+    }
+    return licenses;
+}
+
+License IssuingAuthority::prepareLicense(const std::string& licensee,
+                                         unsigned int validityPeriod,
+                                         const std::string& masterKey,
+                                         const std::string& licenseeSignature,
+                                         const std::string& additionalPayload,
+                                         const Entitlements& entitlements) const
 {
     if (licensee.empty()) {
         throw LicenseException("Please provide valid licensee name and signature");
@@ -91,7 +221,9 @@ License IssuingAuthority::issue(const std::string& licensee,
     license.setIssueDate(now);
     license.setExpiryDate(now + (validityPeriod * 3600));
     license.setIssuingAuthorityId(id());
+    license.setKeyId(m_keyId);
     license.setAdditionalPayload(additionalPayload);
+    license.setEntitlements(entitlements);
     if (!licenseeSignature.empty()) {
         try {
             license.setLicenseeSignature(Base16::encode(AES::encrypt(licenseeSignature, masterKey)));
@@ -99,7 +231,11 @@ License IssuingAuthority::issue(const std::string& licensee,
             throw LicenseException("Failed to issue the license; " + std::string(e.what()));
         }
     }
+    return license;
+}
 
+std::string IssuingAuthority::sign(const std::string& data, const std::string& secret) const
+{
     // issuing authority signs this license
     auto separatorPos = m_keypair.find(":");
     if (separatorPos == std::string::npos) {
@@ -109,70 +245,45 @@ License IssuingAuthority::issue(const std::string& licensee,
     const RSA::PrivateKey key = RSA::loadPrivateKey(Base64::decode(m_keypair.substr(0, separatorPos)), secret);
 
     try {
-        license.setAuthoritySignature(RSA::sign(license.raw(), key, secret));
+        return RSA::sign(data, key, secret);
     } catch (const std::exception& e) {
         std::cerr << "Failed to sign the license" + std::string(e.what()) << std::endl;
         throw LicenseException(e.what());
     }
+}
 
-    if (!validate(&license, masterKey, true, licenseeSignature)) {
-        throw LicenseException("Failed to validate new license. Please report it @ https://github.com/abumq/licensepp");
-    }
-    return license;
+LicenseError IssuingAuthority::tryValidate(const License* license,
+                                           const std::string& masterKey,
+                                           bool validateSignature,
+                                           const std::string& licenseeSignature,
+                                           NegativeCache* negativeCache) const noexcept
+{
+    return LicenseCheck::tryValidate(license, m_id, publicKey(license->keyId()), masterKey, validateSignature,
+                                     licenseeSignature, negativeCache);
+}
+
+bool IssuingAuthority::verifySignature(const License* license) const
+{
+    return LicenseCheck::verifySignature(license, m_id, publicKey(license->keyId()));
+}
+
+void IssuingAuthority::verifySignatures(const License* const* licenses, std::size_t n, bool* results) const
+{
+    LicenseCheck::verifySignatures(licenses, n, m_id, [this](uint32_t keyId) { return publicKey(keyId); }, results);
 }
 
 bool IssuingAuthority::validate(const License* license,
                                 const std::string& masterKey,
                                 bool validateSignature,
-                                const std::string& licenseeSignature) const
+                                const std::string& licenseeSignature,
+                                NegativeCache* negativeCache) const
 {
-    bool result = false;
-    try {
-
-        // issuing authority signs this license
-        auto separatorPos = m_keypair.find(":");
-        if (separatorPos == std::string::npos) {
-            throw LicenseException("Issuing authority could not be loaded. Invalid keypair");
-        }
-
-        RSA::PublicKey key = RSA::loadPublicKey(Base64::decode(m_keypair.substr(separatorPos + 1)));
-
-        result = RSA::verify(license->raw(), license->authoritySignature(), key);
-        if (!result) {
-            std::cerr << "Failed to verify the licensing authority" << std::endl;
-            return false;
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to verify the licensing authority. " << e.what() << std::endl;
-        return false;
-    }
-    auto now = Utils::nowUtc();
-    if (now == 0) {
-        // This should never happen with gcc or clang compilers
-        std::cerr << "WARN: Could not find UTC time, using local time" << std::endl;
-        now = static_cast<unsigned long long>(Utils::now());
-    }
-
-    auto diff = static_cast<int64_t>(license->expiryDate() - now);
-    if (diff < 0) {
-        int64_t hourDiff = ceil(llabs(diff) / 3600LL);
-        std::cerr << "License was expired " << hourDiff << " hour"
-                  << (hourDiff > 1 ? "s" : "") << " ago" << std::endl;
-        return false;
-    }
+    return LicenseCheck::validate(license, m_id, publicKey(license->keyId()), masterKey, validateSignature,
+                                  licenseeSignature, negativeCache);
+}
 
-    if (!validateSignature && !license->licenseeSignature().empty()) {
-        std::cerr << "Signature available on license, you should verify the signature" << std::endl;
-        return false;
-    }
-    if (validateSignature && !license->licenseeSignature().empty()) {
-        std::string decodedLicense = Base16::decode(license->licenseeSignature());
-        std::string iv;
-        auto ivPos = decodedLicense.find(":");
-        if (ivPos != std::string::npos) {
-            iv = decodedLicense.substr(0, ivPos);
-        }
-        result = result && AES::encrypt(licenseeSignature, masterKey, iv) == decodedLicense;
-    }
-    return result;
+const RSAPublicKey* IssuingAuthority::publicKey(uint32_t keyId) const
+{
+    auto publicKey = m_publicKeys.find(keyId);
+    return publicKey == m_publicKeys.end() ? nullptr : publicKey->second.get();
 }
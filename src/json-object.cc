@@ -8,6 +8,7 @@
 //
 
 #include "src/json-object.h"
+#include "src/json-reader.h"
 
 using namespace licensepp;
 
@@ -58,3 +59,8 @@ bool JsonObject::hasKeys(const JsonObject::Keys* keys) const
     }
     return true;
 }
+
+bool JsonObject::isWellFormed(const std::string& json) noexcept
+{
+    return JsonReader(json).document();
+}
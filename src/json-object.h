@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <json.h>
+#include "src/json-reader.h"
 
 namespace licensepp {
 
@@ -86,6 +87,16 @@ public:
 
     bool hasKeys(const Keys* keys) const;
 
+    ///
+    /// \brief Checks JSON syntax without throwing
+    ///
+    /// Json::parse() only reports errors with exceptions, so input that is not known to be
+    /// valid is checked with this first (nesting is limited to kMaxDepth, strings must be UTF-8)
+    ///
+    static bool isWellFormed(const std::string& json) noexcept;
+
+    static const int kMaxDepth = JsonReader::kMaxDepth;
+
     template <typename T>
     T get(const std::string& key, const T& defaultValue) const
     {
@@ -0,0 +1,314 @@
+//
+//  json-reader.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <cstring>
+#include "src/json-reader.h"
+
+using namespace licensepp;
+
+namespace {
+
+inline bool inRange(const char* p, unsigned char low, unsigned char high)
+{
+    const unsigned char c = static_cast<unsigned char>(*p);
+    return c >= low && c <= high;
+}
+
+///
+/// \brief Length of well-formed UTF-8 sequence (RFC 3629) starting at p or 0
+///
+std::size_t utf8Length(const char* p, const char* end)
+{
+    const unsigned char c = static_cast<unsigned char>(*p);
+    const std::size_t available = static_cast<std::size_t>(end - p);
+    if (c >= 0xC2 && c <= 0xDF) {
+        return available >= 2 && inRange(p + 1, 0x80, 0xBF) ? 2 : 0;
+    }
+    if (c >= 0xE0 && c <= 0xEF) {
+        // no overlong forms and no surrogates
+        const unsigned char low = c == 0xE0 ? 0xA0 : 0x80;
+        const unsigned char high = c == 0xED ? 0x9F : 0xBF;
+        return available >= 3 && inRange(p + 1, low, high) && inRange(p + 2, 0x80, 0xBF) ? 3 : 0;
+    }
+    if (c >= 0xF0 && c <= 0xF4) {
+        // no overlong forms and nothing above U+10FFFF
+        const unsigned char low = c == 0xF0 ? 0x90 : 0x80;
+        const unsigned char high = c == 0xF4 ? 0x8F : 0xBF;
+        return available >= 4 && inRange(p + 1, low, high) && inRange(p + 2, 0x80, 0xBF)
+                && inRange(p + 3, 0x80, 0xBF) ? 4 : 0;
+    }
+    return 0;
+}
+
+void appendUtf8(std::string* out, uint32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        out->push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out->push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+        out->push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out->push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        out->push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out->push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+}
+
+bool JsonReader::document() noexcept
+{
+    return skip(0) && atEnd();
+}
+
+void JsonReader::skipWhitespace() noexcept
+{
+    while (m_p != m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r')) {
+        ++m_p;
+    }
+}
+
+bool JsonReader::atEnd() noexcept
+{
+    skipWhitespace();
+    return m_p == m_end;
+}
+
+bool JsonReader::consume(char c) noexcept
+{
+    if (peek(c)) {
+        ++m_p;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::peek(char c) noexcept
+{
+    skipWhitespace();
+    return m_p != m_end && *m_p == c;
+}
+
+bool JsonReader::peekNumber() noexcept
+{
+    skipWhitespace();
+    return m_p != m_end && (*m_p == '-' || (*m_p >= '0' && *m_p <= '9'));
+}
+
+bool JsonReader::literal(const char* text) noexcept
+{
+    for (; *text != '\0'; ++text, ++m_p) {
+        if (m_p == m_end || *m_p != *text) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool JsonReader::digits() noexcept
+{
+    const char* start = m_p;
+    while (m_p != m_end && *m_p >= '0' && *m_p <= '9') {
+        ++m_p;
+    }
+    return m_p != start;
+}
+
+JsonReader::Number JsonReader::number(uint64_t* value) noexcept
+{
+    skipWhitespace();
+    if (m_p == m_end) {
+        return Number::Invalid;
+    }
+    const bool negative = *m_p == '-';
+    if (negative) {
+        ++m_p;
+    }
+    const char* start = m_p;
+    if (m_p != m_end && *m_p == '0') {
+        ++m_p;
+    } else if (!digits()) {
+        return Number::Invalid;
+    }
+    const char* integerEnd = m_p;
+    bool fraction = false;
+    if (m_p != m_end && *m_p == '.') {
+        ++m_p;
+        if (!digits()) {
+            return Number::Invalid;
+        }
+        fraction = true;
+    }
+    if (m_p != m_end && (*m_p == 'e' || *m_p == 'E')) {
+        ++m_p;
+        if (m_p != m_end && (*m_p == '+' || *m_p == '-')) {
+            ++m_p;
+        }
+        if (!digits()) {
+            return Number::Invalid;
+        }
+        fraction = true;
+    }
+    *value = 0;
+    if (fraction) {
+        return Number::Float;
+    }
+    // magnitude of INT64_MIN is allowed for negative numbers, same as nlohmann::json
+    const uint64_t max = negative ? static_cast<uint64_t>(INT64_MAX) + 1 : UINT64_MAX;
+    uint64_t magnitude = 0;
+    for (const char* p = start; p != integerEnd; ++p) {
+        const uint64_t digit = static_cast<uint64_t>(*p - '0');
+        if (magnitude > (max - digit) / 10) {
+            return Number::Float;
+        }
+        magnitude = magnitude * 10 + digit;
+    }
+    if (negative) {
+        *value = 0 - magnitude;
+        return Number::Integer;
+    }
+    *value = magnitude;
+    return Number::Unsigned;
+}
+
+int JsonReader::hex4() noexcept
+{
+    int result = 0;
+    for (int i = 0; i < 4; ++i, ++m_p) {
+        if (m_p == m_end) {
+            return -1;
+        }
+        const char c = *m_p;
+        const int v = c >= '0' && c <= '9' ? c - '0'
+                    : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                    : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (v < 0) {
+            return -1;
+        }
+        result = (result << 4) | v;
+    }
+    return result;
+}
+
+bool JsonReader::string(std::string* out)
+{
+    if (!consume('"')) {
+        return false;
+    }
+    if (out != nullptr) {
+        out->clear();
+    }
+    while (m_p != m_end) {
+        // unescaped runs are copied at once
+        const char* run = m_p;
+        while (m_p != m_end && *m_p != '"' && *m_p != '\\'
+               && static_cast<unsigned char>(*m_p) >= 0x20) {
+            if (static_cast<unsigned char>(*m_p) < 0x80) {
+                ++m_p;
+                continue;
+            }
+            const std::size_t length = utf8Length(m_p, m_end);
+            if (length == 0) {
+                return false;
+            }
+            m_p += length;
+        }
+        if (out != nullptr) {
+            out->append(run, m_p);
+        }
+        if (m_p == m_end) {
+            return false;
+        }
+        const char c = *m_p++;
+        if (c == '"') {
+            return true;
+        }
+        if (c != '\\' || m_p == m_end) {
+            return false;
+        }
+        const char escaped = *m_p++;
+        if (escaped == 'u') {
+            // surrogates must be paired
+            int code = hex4();
+            if (code < 0 || (code >= 0xDC00 && code <= 0xDFFF)) {
+                return false;
+            }
+            if (code >= 0xD800 && code <= 0xDBFF) {
+                if (!literal("\\u")) {
+                    return false;
+                }
+                const int low = hex4();
+                if (low < 0xDC00 || low > 0xDFFF) {
+                    return false;
+                }
+                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            }
+            if (out != nullptr) {
+                appendUtf8(out, static_cast<uint32_t>(code));
+            }
+            continue;
+        }
+        const char* escapes = "\"\\/bfnrt";
+        const char* found = escaped == '\0' ? nullptr : std::strchr(escapes, escaped);
+        if (found == nullptr) {
+            return false;
+        }
+        if (out != nullptr) {
+            out->push_back("\"\\/\b\f\n\r\t"[found - escapes]);
+        }
+    }
+    return false;
+}
+
+bool JsonReader::skip(int depth) noexcept
+{
+    skipWhitespace();
+    if (m_p == m_end || depth > kMaxDepth) {
+        return false;
+    }
+    uint64_t value;
+    switch (*m_p) {
+    case '{':
+        ++m_p;
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            if (!string(nullptr) || !consume(':') || !skip(depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}');
+    case '[':
+        ++m_p;
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            if (!skip(depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(']');
+    case '"':
+        return string(nullptr);
+    case 't':
+        return literal("true");
+    case 'f':
+        return literal("false");
+    case 'n':
+        return literal("null");
+    default:
+        return number(&value) != Number::Invalid;
+    }
+}
@@ -0,0 +1,109 @@
+//
+//  json-reader.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_JsonReader_h
+#define LICENSEPP_JsonReader_h
+
+#include <cstdint>
+#include <string>
+
+namespace licensepp {
+
+///
+/// \brief Recursive descent JSON (RFC 8259) reader that does not depend on nlohmann
+///
+/// Reads values in place without building a document, anything that is not needed is
+/// checked and skipped with skip(). Every read returns false on malformed input and reader
+/// must not be used after that.
+///
+class JsonReader
+{
+public:
+    ///
+    /// \brief Number types as classified by nlohmann::json parser
+    ///
+    enum class Number
+    {
+        Invalid,
+        Unsigned,
+        ///
+        /// \brief Negative number that fits int64_t
+        ///
+        Integer,
+        ///
+        /// \brief Fraction, exponent or integer that does not fit 64 bits
+        ///
+        Float
+    };
+
+    static const int kMaxDepth = 64;
+
+    JsonReader(const char* begin, const char* end) noexcept :
+        m_p(begin),
+        m_end(end)
+    {
+    }
+
+    explicit JsonReader(const std::string& json) noexcept :
+        JsonReader(json.data(), json.data() + json.size())
+    {
+    }
+
+    ///
+    /// \brief Checks that input is exactly one well-formed value (nesting is limited to kMaxDepth)
+    ///
+    bool document() noexcept;
+
+    ///
+    /// \brief True if there is nothing but whitespace left
+    ///
+    bool atEnd() noexcept;
+
+    ///
+    /// \brief Consumes c if it is the next character after whitespace
+    ///
+    bool consume(char c) noexcept;
+
+    ///
+    /// \brief True if c is the next character after whitespace, nothing is consumed
+    ///
+    bool peek(char c) noexcept;
+
+    ///
+    /// \brief True if number is the next value, nothing is consumed
+    ///
+    bool peekNumber() noexcept;
+
+    ///
+    /// \brief Reads string and unescapes it as UTF-8 to out, unless out is nullptr
+    ///
+    bool string(std::string* out);
+
+    ///
+    /// \brief Reads number, value is two's complement for Number::Integer and 0 for Number::Float
+    ///
+    Number number(uint64_t* value) noexcept;
+
+    ///
+    /// \brief Checks and skips any value at given nesting depth
+    ///
+    bool skip(int depth) noexcept;
+
+private:
+    void skipWhitespace() noexcept;
+    bool literal(const char* text) noexcept;
+    bool digits() noexcept;
+    int hex4() noexcept;
+
+    const char* m_p;
+    const char* m_end;
+};
+}
+
+#endif /* LICENSEPP_JsonReader_h */
@@ -0,0 +1,156 @@
+//
+//  lease-client.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <license++/lease-client.h>
+#include "src/lease-protocol.h"
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <sys/socket.h>
+#   include <sys/time.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+const char* LeaseClient::kDefaultSocketPath = "/var/run/licensepp-leased.sock";
+
+LeaseClient::LeaseClient(const std::string& socketPath, unsigned int timeoutMs) :
+    m_socketPath(socketPath),
+    m_timeoutMs(timeoutMs),
+    m_fd(-1)
+{
+}
+
+LeaseClient::~LeaseClient()
+{
+    disconnect();
+}
+
+LeaseStatus LeaseClient::acquire(const std::string& licensee, uint32_t ttlMs, uint64_t* leaseId,
+                                 uint32_t* grantedTtlMs, uint32_t* seatsAvailable)
+{
+    *leaseId = 0;
+    return call(LeaseProtocol::OpAcquire, licensee, ttlMs, leaseId, grantedTtlMs, seatsAvailable);
+}
+
+LeaseStatus LeaseClient::renew(uint64_t leaseId, uint32_t ttlMs, uint32_t* grantedTtlMs)
+{
+    return call(LeaseProtocol::OpRenew, "", ttlMs, &leaseId, grantedTtlMs, nullptr);
+}
+
+LeaseStatus LeaseClient::release(uint64_t leaseId)
+{
+    return call(LeaseProtocol::OpRelease, "", 0, &leaseId, nullptr, nullptr);
+}
+
+LeaseStatus LeaseClient::call(uint8_t opcode, const std::string& licensee, uint32_t ttlMs, uint64_t* leaseId,
+                              uint32_t* grantedTtlMs, uint32_t* seatsAvailable)
+{
+#if LICENSEPP_OS_UNIX
+    if (licensee.size() > LeaseProtocol::kMaxLicenseeSize) {
+        return LeaseStatus::InvalidRequest;
+    }
+    unsigned char request[LeaseProtocol::kHeaderSize + LeaseProtocol::kMaxLicenseeSize] = {};
+    VerifyProtocol::writeU32(request, LeaseProtocol::kMagic);
+    request[4] = LeaseProtocol::kVersion;
+    request[5] = opcode;
+    LeaseProtocol::writeU16(&request[6], static_cast<uint16_t>(licensee.size()));
+    VerifyProtocol::writeU32(&request[8], ttlMs);
+    VerifyProtocol::writeU64(&request[16], *leaseId);
+    std::memcpy(&request[LeaseProtocol::kHeaderSize], licensee.data(), licensee.size());
+    const std::size_t requestSize = LeaseProtocol::kHeaderSize + licensee.size();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    unsigned char response[LeaseProtocol::kResponseSize];
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        const bool reused = m_fd >= 0;
+        if (!reused && !connect()) {
+            return LeaseStatus::Unavailable;
+        }
+        errno = 0;
+        if (VerifyProtocol::writeFully(m_fd, request, requestSize)
+                && VerifyProtocol::readFully(m_fd, response, sizeof(response))) {
+            break;
+        }
+        // server closes idle connections before reading anything from them so request on
+        // closed connection is sent again; after timeout it may have been handled
+        const bool closed = errno != EAGAIN && errno != EWOULDBLOCK;
+        disconnect();
+        if (!reused || !closed || attempt == 1) {
+            return LeaseStatus::Unavailable;
+        }
+    }
+    if (VerifyProtocol::readU32(response) != LeaseProtocol::kMagic
+            || response[4] != LeaseProtocol::kVersion
+            || response[5] > static_cast<uint8_t>(LeaseStatus::InvalidRequest)) {
+        disconnect();
+        return LeaseStatus::Unavailable;
+    }
+    if (grantedTtlMs != nullptr) {
+        *grantedTtlMs = VerifyProtocol::readU32(&response[8]);
+    }
+    if (seatsAvailable != nullptr) {
+        *seatsAvailable = VerifyProtocol::readU32(&response[12]);
+    }
+    if (opcode == LeaseProtocol::OpAcquire) {
+        *leaseId = VerifyProtocol::readU64(&response[16]);
+    }
+    return static_cast<LeaseStatus>(response[5]);
+#else
+    (void) opcode;
+    (void) licensee;
+    (void) ttlMs;
+    (void) leaseId;
+    (void) grantedTtlMs;
+    (void) seatsAvailable;
+    return LeaseStatus::Unavailable;
+#endif // LICENSEPP_OS_UNIX
+}
+
+bool LeaseClient::connect()
+{
+#if LICENSEPP_OS_UNIX
+    struct sockaddr_un addr;
+    if (m_socketPath.empty() || m_socketPath.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_fd < 0) {
+        return false;
+    }
+    struct timeval tv;
+    tv.tv_sec = static_cast<long>(m_timeoutMs / 1000U);
+    tv.tv_usec = static_cast<long>((m_timeoutMs % 1000U) * 1000U);
+    ::setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(m_fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, m_socketPath.c_str(), m_socketPath.size());
+    if (::connect(m_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        disconnect();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif // LICENSEPP_OS_UNIX
+}
+
+void LeaseClient::disconnect()
+{
+#if LICENSEPP_OS_UNIX
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif // LICENSEPP_OS_UNIX
+}
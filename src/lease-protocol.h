@@ -0,0 +1,59 @@
+//
+//  lease-protocol.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LeaseProtocol_h
+#define LICENSEPP_LeaseProtocol_h
+
+#include <cstdint>
+#include "src/verify-protocol.h"
+
+namespace licensepp {
+
+///
+/// \brief Wire format between LeaseClient and licensepp-leased
+///
+/// Integers are little-endian and framing helpers are the ones of VerifyProtocol. Every
+/// request is answered with exactly one response and clients keep connection open.
+/// <pre>
+/// request:  | magic (4) | version (1) | opcode (1) | licensee length (2) | ttl ms (4) | reserved (4) | lease id (8) | licensee |
+/// response: | magic (4) | version (1) | status (1) | reserved (2) | ttl ms (4) | seats available (4) | lease id (8) |
+/// </pre>
+/// Licensee is only sent with OpAcquire, lease ID with OpRenew and OpRelease. Status is
+/// LeaseStatus.
+///
+namespace LeaseProtocol {
+
+static const uint32_t kMagic = 0x534C504CU; // "LPLS"
+static const uint8_t kVersion = 1;
+static const std::size_t kHeaderSize = 24;
+static const std::size_t kResponseSize = 24;
+static const uint16_t kMaxLicenseeSize = 1024;
+
+enum Opcode : uint8_t
+{
+    OpAcquire = 1,
+    OpRenew = 2,
+    OpRelease = 3
+};
+
+inline void writeU16(unsigned char* buf, uint16_t v)
+{
+    buf[0] = static_cast<unsigned char>(v);
+    buf[1] = static_cast<unsigned char>(v >> 8);
+}
+
+inline uint16_t readU16(const unsigned char* buf)
+{
+    return static_cast<uint16_t>(buf[0] | (buf[1] << 8));
+}
+
+}
+}
+
+#endif /* LICENSEPP_LeaseProtocol_h */
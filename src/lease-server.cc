@@ -0,0 +1,308 @@
+//
+//  lease-server.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <license++/lease-server.h>
+#include "src/utils.h"
+
+using namespace licensepp;
+
+const uint32_t LeaseServer::kInvalidPool;
+const uint32_t LeaseServer::kMaxTtlMs;
+const std::size_t LeaseServer::kWheelSlots;
+
+namespace {
+
+uint64_t steadyClock()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+///
+/// \brief Shard that acquiring thread inserts leases into, so threads do not share locks
+///
+std::size_t threadShardHint()
+{
+    static thread_local const std::size_t t_hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return t_hint;
+}
+
+}
+
+LeaseServer::LeaseServer(std::size_t maxPools, std::size_t shards, unsigned int tickMs, Clock clock) :
+    m_maxPools(maxPools),
+    m_pools(new Pool[maxPools]),
+    m_poolCount(0),
+    m_shardBits(0),
+    m_tickMs(std::max(1U, tickMs)),
+    m_clock(clock != nullptr ? clock : &steadyClock),
+    m_granted(0),
+    m_denied(0),
+    m_reclaimed(0),
+    m_timerRunning(false)
+{
+    // shard index is in low bits of lease ID and keyed hash of shard sequence above it
+    while ((static_cast<std::size_t>(1) << m_shardBits) < shards && m_shardBits < 16) {
+        ++m_shardBits;
+    }
+    m_shardMask = (static_cast<std::size_t>(1) << m_shardBits) - 1;
+    m_shards.reset(new Shard[m_shardMask + 1]);
+    const uint64_t tick = now() / m_tickMs;
+    std::random_device device;
+    for (uint64_t& key : m_idKey) {
+        key = (static_cast<uint64_t>(device()) << 32) ^ static_cast<uint64_t>(device());
+    }
+    for (std::size_t i = 0; i <= m_shardMask; ++i) {
+        m_shards[i].wheel.resize(kWheelSlots);
+        m_shards[i].nextTick = tick;
+        m_shards[i].sequence = 0;
+    }
+}
+
+LeaseServer::~LeaseServer()
+{
+    stop();
+}
+
+uint32_t LeaseServer::addLicense(const License& license)
+{
+    const int64_t seats = license.entitlements().limit("seats", 0);
+    const uint32_t id = m_poolCount.load(std::memory_order_relaxed);
+    if (seats <= 0 || id >= m_maxPools || m_poolIndex.count(license.licensee()) != 0) {
+        return kInvalidPool;
+    }
+    Pool& pool = m_pools[id];
+    pool.licensee = license.licensee();
+    pool.seats = seats;
+    pool.expiryDate = license.expiryDate();
+    pool.inUse.store(0, std::memory_order_relaxed);
+    m_poolIndex.emplace(pool.licensee, id);
+    m_poolCount.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+uint32_t LeaseServer::findPool(const std::string& licensee) const
+{
+    auto iter = m_poolIndex.find(licensee);
+    return iter == m_poolIndex.end() ? kInvalidPool : iter->second;
+}
+
+LeaseStatus LeaseServer::acquire(uint32_t poolId, uint32_t ttlMs, Lease* lease)
+{
+    if (poolId >= m_poolCount.load(std::memory_order_acquire)) {
+        return LeaseStatus::UnknownPool;
+    }
+    if (ttlMs == 0) {
+        return LeaseStatus::InvalidRequest;
+    }
+    Pool& pool = m_pools[poolId];
+    if (pool.expiryDate < Utils::nowUtc()) {
+        return LeaseStatus::LicenseExpired;
+    }
+    int64_t inUse = pool.inUse.load(std::memory_order_relaxed);
+    do {
+        if (inUse >= pool.seats) {
+            m_denied.fetch_add(1, std::memory_order_relaxed);
+            return LeaseStatus::NoSeatAvailable;
+        }
+    } while (!pool.inUse.compare_exchange_weak(inUse, inUse + 1, std::memory_order_relaxed));
+
+    const std::size_t shardIndex = threadShardHint() & m_shardMask;
+    Shard& shard = m_shards[shardIndex];
+    const uint32_t ttl = std::min(ttlMs, kMaxTtlMs);
+    Entry entry;
+    entry.pool = poolId;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        entry.expiresAt = now() + ttl;
+        uint64_t id;
+        do {
+            // keyed hash of shard sequence, client cannot work out IDs of other clients' leases
+            // from its own to renew or release them
+            const uint64_t sequence = shard.sequence++;
+            id = (Utils::sipHash(m_idKey, &sequence, sizeof(sequence)) << m_shardBits) | shardIndex;
+        } while (id == 0 || shard.leases.count(id) != 0);
+        Entry& inserted = shard.leases.emplace(id, entry).first->second;
+        schedule(&shard, id, &inserted);
+        lease->id = id;
+    }
+    lease->expiresAt = entry.expiresAt;
+    lease->ttlMs = ttl;
+    m_granted.fetch_add(1, std::memory_order_relaxed);
+    return LeaseStatus::Granted;
+}
+
+LeaseStatus LeaseServer::renew(uint64_t leaseId, uint32_t ttlMs, Lease* lease)
+{
+    if (ttlMs == 0) {
+        return LeaseStatus::InvalidRequest;
+    }
+    Shard& shard = shardOf(leaseId);
+    const uint32_t ttl = std::min(ttlMs, kMaxTtlMs);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.leases.find(leaseId);
+    if (iter == shard.leases.end()) {
+        return LeaseStatus::UnknownLease;
+    }
+    Entry& entry = iter->second;
+    const uint64_t current = now();
+    if (entry.expiresAt <= current) {
+        // expired but wheel has not come to it yet
+        reclaim(entry);
+        shard.leases.erase(iter);
+        return LeaseStatus::UnknownLease;
+    }
+    if (m_pools[entry.pool].expiryDate < Utils::nowUtc()) {
+        // license expired while lease was held, its seat is not held any longer
+        reclaim(entry);
+        shard.leases.erase(iter);
+        return LeaseStatus::LicenseExpired;
+    }
+    const uint64_t scheduledTick = entry.tick;
+    entry.expiresAt = current + ttl;
+    if ((entry.expiresAt + m_tickMs - 1) / m_tickMs < scheduledTick) {
+        // shorter than before, item at old tick becomes stale
+        schedule(&shard, leaseId, &entry);
+    }
+    lease->id = leaseId;
+    lease->expiresAt = entry.expiresAt;
+    lease->ttlMs = ttl;
+    return LeaseStatus::Granted;
+}
+
+LeaseStatus LeaseServer::release(uint64_t leaseId)
+{
+    Shard& shard = shardOf(leaseId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.leases.find(leaseId);
+    if (iter == shard.leases.end()) {
+        return LeaseStatus::UnknownLease;
+    }
+    // wheel item is left behind and dropped when its slot comes up
+    m_pools[iter->second.pool].inUse.fetch_sub(1, std::memory_order_relaxed);
+    shard.leases.erase(iter);
+    return LeaseStatus::Granted;
+}
+
+std::size_t LeaseServer::expire()
+{
+    const uint64_t current = now();
+    std::size_t reclaimed = 0;
+    for (std::size_t i = 0; i <= m_shardMask; ++i) {
+        Shard& shard = m_shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        reclaimed += expire(&shard, current);
+    }
+    return reclaimed;
+}
+
+void LeaseServer::schedule(Shard* shard, uint64_t id, Entry* entry)
+{
+    // lease is due at first tick that is not before its expiry, never in tick already passed
+    entry->tick = std::max((entry->expiresAt + m_tickMs - 1) / m_tickMs, shard->nextTick);
+    shard->wheel[entry->tick % kWheelSlots].emplace_back(id, entry->tick);
+}
+
+std::size_t LeaseServer::expire(Shard* shard, uint64_t current)
+{
+    const uint64_t lastTick = current / m_tickMs;
+    if (shard->nextTick > lastTick) {
+        return 0;
+    }
+    // after long pause every slot is visited once, items of all skipped ticks are due
+    const uint64_t firstTick = lastTick - shard->nextTick >= kWheelSlots ? lastTick - kWheelSlots + 1 : shard->nextTick;
+    shard->nextTick = lastTick + 1;
+    std::size_t reclaimed = 0;
+    for (uint64_t tick = firstTick; tick <= lastTick; ++tick) {
+        std::vector<std::pair<uint64_t, uint64_t>>& slot = shard->wheel[tick % kWheelSlots];
+        if (slot.empty()) {
+            continue;
+        }
+        shard->scratch.swap(slot);
+        for (const auto& item : shard->scratch) {
+            if (item.second > tick) {
+                // later round of the wheel
+                slot.push_back(item);
+                continue;
+            }
+            auto iter = shard->leases.find(item.first);
+            if (iter == shard->leases.end() || iter->second.tick != item.second) {
+                // released, or rescheduled to earlier tick
+                continue;
+            }
+            if (iter->second.expiresAt <= current) {
+                reclaim(iter->second);
+                shard->leases.erase(iter);
+                ++reclaimed;
+            } else {
+                // renewed
+                schedule(shard, item.first, &iter->second);
+            }
+        }
+        shard->scratch.clear();
+    }
+    return reclaimed;
+}
+
+void LeaseServer::reclaim(const Entry& entry)
+{
+    m_pools[entry.pool].inUse.fetch_sub(1, std::memory_order_relaxed);
+    m_reclaimed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LeaseServer::start()
+{
+    std::lock_guard<std::mutex> lock(m_timerMutex);
+    if (m_timerRunning) {
+        return;
+    }
+    m_timerRunning = true;
+    m_timer = std::thread([this]() {
+        std::unique_lock<std::mutex> timerLock(m_timerMutex);
+        while (m_timerRunning) {
+            m_timerWakeup.wait_for(timerLock, std::chrono::milliseconds(m_tickMs));
+            timerLock.unlock();
+            expire();
+            timerLock.lock();
+        }
+    });
+}
+
+void LeaseServer::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_timerMutex);
+        if (!m_timerRunning) {
+            return;
+        }
+        m_timerRunning = false;
+    }
+    m_timerWakeup.notify_all();
+    m_timer.join();
+}
+
+uint64_t LeaseServer::now() const
+{
+    return m_clock();
+}
+
+int64_t LeaseServer::seats(uint32_t pool) const
+{
+    return pool < m_poolCount.load(std::memory_order_acquire) ? m_pools[pool].seats : 0;
+}
+
+int64_t LeaseServer::seatsInUse(uint32_t pool) const
+{
+    return pool < m_poolCount.load(std::memory_order_acquire)
+            ? m_pools[pool].inUse.load(std::memory_order_relaxed) : 0;
+}
@@ -0,0 +1,79 @@
+//
+//  lease-socket-server.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include "src/lease-protocol.h"
+#include "src/lease-socket-server.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+const unsigned int LeaseSocketServer::kIdleTimeoutMs;
+
+LeaseSocketServer::LeaseSocketServer(const std::string& socketPath, LeaseServer* leaseServer,
+                                     unsigned int socketMode, std::size_t maxConnections) :
+    m_leaseServer(leaseServer),
+    m_requests(0),
+    m_server(socketPath, [this](int fd) { return serve(fd); }, socketMode, maxConnections,
+             SocketServer::kDefaultWorkers, kIdleTimeoutMs)
+{
+}
+
+bool LeaseSocketServer::serve(int fd)
+{
+#if LICENSEPP_OS_UNIX
+    const auto deadline = SocketServer::requestDeadline();
+    unsigned char header[LeaseProtocol::kHeaderSize];
+    if (!VerifyProtocol::readFully(fd, header, sizeof(header), deadline)) {
+        return false;
+    }
+    const uint16_t licenseeSize = LeaseProtocol::readU16(&header[6]);
+    if (VerifyProtocol::readU32(header) != LeaseProtocol::kMagic
+            || header[4] != LeaseProtocol::kVersion
+            || licenseeSize > LeaseProtocol::kMaxLicenseeSize) {
+        return false;
+    }
+    std::string licensee(licenseeSize, '\0');
+    if (licenseeSize > 0 && !VerifyProtocol::readFully(fd, &licensee[0], licenseeSize, deadline)) {
+        return false;
+    }
+    ++m_requests;
+    const uint32_t ttlMs = VerifyProtocol::readU32(&header[8]);
+    Lease lease = { VerifyProtocol::readU64(&header[16]), 0, 0 };
+    uint32_t pool = LeaseServer::kInvalidPool;
+    LeaseStatus status = LeaseStatus::InvalidRequest;
+    switch (header[5]) {
+    case LeaseProtocol::OpAcquire:
+        pool = m_leaseServer->findPool(licensee);
+        status = m_leaseServer->acquire(pool, ttlMs, &lease);
+        break;
+    case LeaseProtocol::OpRenew:
+        status = m_leaseServer->renew(lease.id, ttlMs, &lease);
+        break;
+    case LeaseProtocol::OpRelease:
+        status = m_leaseServer->release(lease.id);
+        break;
+    default:
+        break;
+    }
+    const int64_t available = pool == LeaseServer::kInvalidPool ? 0
+            : m_leaseServer->seats(pool) - m_leaseServer->seatsInUse(pool);
+
+    unsigned char response[LeaseProtocol::kResponseSize] = {};
+    VerifyProtocol::writeU32(response, LeaseProtocol::kMagic);
+    response[4] = LeaseProtocol::kVersion;
+    response[5] = static_cast<uint8_t>(status);
+    VerifyProtocol::writeU32(&response[8], status == LeaseStatus::Granted ? lease.ttlMs : 0);
+    VerifyProtocol::writeU32(&response[12], static_cast<uint32_t>(available > 0 ? available : 0));
+    VerifyProtocol::writeU64(&response[16], status == LeaseStatus::Granted ? lease.id : 0);
+    return VerifyProtocol::writeFully(fd, response, sizeof(response));
+#else
+    (void) fd;
+    return false;
+#endif // LICENSEPP_OS_UNIX
+}
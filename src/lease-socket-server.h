@@ -0,0 +1,92 @@
+//
+//  lease-socket-server.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LeaseSocketServer_h
+#define LICENSEPP_LeaseSocketServer_h
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <license++/lease-server.h>
+#include "src/socket-server.h"
+
+namespace licensepp {
+
+///
+/// \brief Serves LeaseServer to LeaseClient connections on UNIX socket (licensepp-leased)
+///
+/// Connections may carry any number of requests and are served by fixed number of worker
+/// threads (see SocketServer); connection that is idle for kIdleTimeoutMs is closed and
+/// client reconnects.
+///
+class LeaseSocketServer
+{
+public:
+    static const unsigned int kIdleTimeoutMs = 60000U;
+
+    ///
+    /// \param socketMode Permission bits of socket file, i.e, who may lease seats
+    /// \param maxConnections Open connections at a time, more clients wait until one is closed
+    ///
+    LeaseSocketServer(const std::string& socketPath, LeaseServer* leaseServer,
+                      unsigned int socketMode = SocketServer::kDefaultSocketMode,
+                      std::size_t maxConnections = SocketServer::kDefaultMaxConnections);
+
+    ///
+    /// \brief Binds and listens on socket. Existing socket file is replaced
+    ///
+    inline bool start()
+    {
+        return m_server.start("licensepp-leased");
+    }
+
+    ///
+    /// \brief Serves connections until stop() is called
+    ///
+    inline void run()
+    {
+        m_server.run();
+    }
+
+    ///
+    /// \brief Stops run() loop. Safe to call from signal handler
+    ///
+    inline void stop()
+    {
+        m_server.stop();
+    }
+
+    inline uint64_t requests() const
+    {
+        return m_requests;
+    }
+
+    inline std::size_t connections() const
+    {
+        return m_server.connections();
+    }
+
+private:
+    LeaseSocketServer(const LeaseSocketServer&) = delete;
+    LeaseSocketServer& operator=(const LeaseSocketServer&) = delete;
+
+    ///
+    /// \brief Serves one request, false if connection should be closed
+    ///
+    bool serve(int fd);
+
+    LeaseServer* m_leaseServer;
+    std::atomic<uint64_t> m_requests;
+
+    // last so connections are closed before other members are destroyed
+    SocketServer m_server;
+};
+}
+
+#endif /* LICENSEPP_LeaseSocketServer_h */
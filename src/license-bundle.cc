@@ -0,0 +1,339 @@
+//
+//  license-bundle.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <license++/license-bundle.h>
+#include <license++/license-exception.h>
+#include "src/crypto/base64.h"
+#include "src/crypto/sha256.h"
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+namespace {
+
+// Bundle is little endian:
+//
+//   header:  u32 magic, u32 version, u32 key type, u32 count, u64 index offset, u64 records offset
+//   index:   count entries sorted by (key hash, key), each
+//            u64 key hash, u64 record offset, u32 key size, u32 license size
+//   records: key followed by base64 license
+
+const uint32_t kBundleMagic = 0x4E42504CU;  // LPBN
+const uint32_t kBundleVersion = 1;
+const uint64_t kHeaderSize = 32;
+const uint64_t kEntrySize = 24;
+
+inline void writeU32(unsigned char* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void writeU64(unsigned char* p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t readU32(const unsigned char* p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t hashKey(const char* key, std::size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(key[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+///
+/// \brief Compares (hash, key) of index entry with key that is looked up
+///
+inline int compareKey(uint64_t hash, const char* key, std::size_t keySize,
+                      uint64_t otherHash, const std::string& other)
+{
+    if (hash != otherHash) {
+        return hash < otherHash ? -1 : 1;
+    }
+    const int cmp = std::memcmp(key, other.data(), std::min(keySize, other.size()));
+    if (cmp != 0) {
+        return cmp;
+    }
+    return keySize == other.size() ? 0 : (keySize < other.size() ? -1 : 1);
+}
+}
+
+std::string LicenseBundle::fingerprint(const License& license)
+{
+    static const char* kHexDigits = "0123456789abcdef";
+    const std::string digest = SHA256::hash(license.raw(true));
+    std::string result;
+    result.reserve(digest.size() * 2);
+    for (unsigned char c : digest) {
+        result.push_back(kHexDigits[c >> 4]);
+        result.push_back(kHexDigits[c & 0x0f]);
+    }
+    return result;
+}
+
+void LicenseBundle::write(const std::string& path, const std::vector<License>& licenses, KeyType keyType)
+{
+    struct Pending
+    {
+        uint64_t hash;
+        std::string key;
+        std::string license;
+    };
+    std::vector<Pending> pending;
+    pending.reserve(licenses.size());
+    for (const License& license : licenses) {
+        std::string key = keyType == KeyType::Fingerprint ? fingerprint(license) : license.licensee();
+        std::string blob = Base64::encode(license.raw(true));
+        if (key.size() > UINT32_MAX || blob.size() > UINT32_MAX) {
+            throw LicenseException("License is too large for license bundle");
+        }
+        const uint64_t hash = hashKey(key.data(), key.size());
+        pending.push_back(Pending { hash, std::move(key), std::move(blob) });
+    }
+    if (pending.size() > UINT32_MAX) {
+        throw LicenseException("Too many licenses for license bundle");
+    }
+    // stable so licenses with same key stay in order they were given
+    std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+        return a.hash < b.hash || (a.hash == b.hash && a.key < b.key);
+    });
+
+    const uint64_t recordsOffset = kHeaderSize + kEntrySize * pending.size();
+    std::string head(static_cast<std::size_t>(recordsOffset), '\0');
+    unsigned char* p = reinterpret_cast<unsigned char*>(&head[0]);
+    writeU32(p, kBundleMagic);
+    writeU32(p + 4, kBundleVersion);
+    writeU32(p + 8, static_cast<uint32_t>(keyType));
+    writeU32(p + 12, static_cast<uint32_t>(pending.size()));
+    writeU64(p + 16, kHeaderSize);
+    writeU64(p + 24, recordsOffset);
+    uint64_t offset = recordsOffset;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        unsigned char* e = p + kHeaderSize + kEntrySize * i;
+        writeU64(e, pending[i].hash);
+        writeU64(e + 8, offset);
+        writeU32(e + 16, static_cast<uint32_t>(pending[i].key.size()));
+        writeU32(e + 20, static_cast<uint32_t>(pending[i].license.size()));
+        offset += pending[i].key.size() + pending[i].license.size();
+    }
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream stream(tmpPath, std::ios::binary | std::ios::trunc);
+        stream.write(head.data(), static_cast<std::streamsize>(head.size()));
+        for (const Pending& record : pending) {
+            stream.write(record.key.data(), static_cast<std::streamsize>(record.key.size()));
+            stream.write(record.license.data(), static_cast<std::streamsize>(record.license.size()));
+        }
+        stream.flush();
+        if (!stream) {
+            stream.close();
+            std::remove(tmpPath.c_str());
+            throw LicenseException("Failed to write license bundle " + path);
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw LicenseException("Failed to write license bundle " + path);
+    }
+}
+
+#if LICENSEPP_OS_UNIX
+
+LicenseBundle::LicenseBundle(const std::string& path) :
+    m_path(path),
+    m_map(nullptr),
+    m_mapSize(0),
+    m_keyType(KeyType::Licensee),
+    m_count(0),
+    m_index(nullptr)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw LicenseException("Failed to open license bundle " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < kHeaderSize) {
+        ::close(fd);
+        throw LicenseException("Invalid license bundle " + path);
+    }
+    void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        throw LicenseException("Failed to map license bundle " + path);
+    }
+    m_map = map;
+    m_mapSize = static_cast<std::size_t>(st.st_size);
+    const unsigned char* header = static_cast<const unsigned char*>(map);
+    const uint32_t keyType = readU32(header + 8);
+    const uint64_t count = readU32(header + 12);
+    const uint64_t indexOffset = readU64(header + 16);
+    const uint64_t recordsOffset = readU64(header + 24);
+    if (readU32(header) != kBundleMagic || readU32(header + 4) != kBundleVersion
+            || keyType > static_cast<uint32_t>(KeyType::Fingerprint)
+            || indexOffset < kHeaderSize || indexOffset > m_mapSize
+            || (m_mapSize - indexOffset) / kEntrySize < count
+            || recordsOffset < indexOffset + count * kEntrySize || recordsOffset > m_mapSize) {
+        ::munmap(m_map, m_mapSize);
+        throw LicenseException("Invalid license bundle " + path);
+    }
+    m_keyType = static_cast<KeyType>(keyType);
+    m_count = static_cast<std::size_t>(count);
+    m_index = header + indexOffset;
+}
+
+LicenseBundle::~LicenseBundle()
+{
+    if (m_map != nullptr) {
+        ::munmap(m_map, m_mapSize);
+    }
+}
+
+#else
+
+LicenseBundle::LicenseBundle(const std::string& path) :
+    m_path(path),
+    m_map(nullptr),
+    m_mapSize(0),
+    m_keyType(KeyType::Licensee),
+    m_count(0),
+    m_index(nullptr)
+{
+    throw LicenseException("License bundle is only available on unix");
+}
+
+LicenseBundle::~LicenseBundle()
+{
+}
+
+#endif
+
+LicenseBundle::Entry LicenseBundle::entry(std::size_t index) const
+{
+    const unsigned char* e = m_index + kEntrySize * index;
+    const uint64_t offset = readU64(e + 8);
+    const uint32_t keySize = readU32(e + 16);
+    const uint32_t licenseSize = readU32(e + 20);
+    // records are only checked when they are read so opening bundle does not touch them
+    if (offset > m_mapSize || m_mapSize - offset < static_cast<uint64_t>(keySize) + licenseSize) {
+        throw LicenseException("Invalid license bundle record " + std::to_string(index) + " in " + m_path);
+    }
+    const char* record = static_cast<const char*>(m_map) + offset;
+    return Entry { record, keySize, record + keySize, licenseSize };
+}
+
+std::size_t LicenseBundle::lowerBound(const std::string& key) const
+{
+    const uint64_t hash = hashKey(key.data(), key.size());
+    std::size_t low = 0;
+    std::size_t high = m_count;
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        const uint64_t midHash = readU64(m_index + kEntrySize * mid);
+        int cmp = midHash < hash ? -1 : (midHash > hash ? 1 : 0);
+        if (cmp == 0) {
+            const Entry e = entry(mid);
+            cmp = compareKey(midHash, e.key, e.keySize, hash, key);
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool LicenseBundle::find(const std::string& key, License* license) const
+{
+    const std::size_t index = lowerBound(key);
+    if (index >= m_count) {
+        return false;
+    }
+    const Entry e = entry(index);
+    if (e.keySize != key.size() || std::memcmp(e.key, key.data(), key.size()) != 0) {
+        return false;
+    }
+    license->load(std::string(e.license, e.licenseSize));
+    return true;
+}
+
+std::vector<License> LicenseBundle::findAll(const std::string& key) const
+{
+    std::vector<License> licenses;
+    for (std::size_t index = lowerBound(key); index < m_count; ++index) {
+        const Entry e = entry(index);
+        if (e.keySize != key.size() || std::memcmp(e.key, key.data(), key.size()) != 0) {
+            break;
+        }
+        licenses.emplace_back();
+        licenses.back().load(std::string(e.license, e.licenseSize));
+    }
+    return licenses;
+}
+
+std::string LicenseBundle::key(std::size_t index) const
+{
+    if (index >= m_count) {
+        throw LicenseException("License bundle index out of range");
+    }
+    const Entry e = entry(index);
+    return std::string(e.key, e.keySize);
+}
+
+std::string LicenseBundle::licenseBase64(std::size_t index) const
+{
+    if (index >= m_count) {
+        throw LicenseException("License bundle index out of range");
+    }
+    const Entry e = entry(index);
+    return std::string(e.license, e.licenseSize);
+}
+
+License LicenseBundle::get(std::size_t index) const
+{
+    License license;
+    license.load(licenseBase64(index));
+    return license;
+}
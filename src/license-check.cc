@@ -0,0 +1,342 @@
+//
+//  license-check.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+#include <license++/license.h>
+#include <license++/license-exception.h>
+#include <license++/negative-cache.h>
+#include "src/crypto/aes.h"
+#include "src/crypto/base16.h"
+#include "src/crypto/rsa.h"
+#include "src/crypto/sha1.h"
+#include "src/license-check.h"
+#include "src/merkle-tree.h"
+#include "src/probes.h"
+#include "src/tracing.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+namespace {
+
+// 8192-bit RSA signature
+const std::size_t kMaxSignatureHexSize = 2048;
+
+// batch roots (with public key PEM) that were already verified, looked up under shared lock;
+// oldest root is evicted when full
+const std::size_t kMaxVerifiedRoots = 4096;
+std::shared_timed_mutex s_verifiedRootsMutex;
+std::unordered_set<std::string> s_verifiedRoots;
+// elements of s_verifiedRoots in order of insertion, element addresses are stable
+std::deque<const std::string*> s_verifiedRootsOrder;
+}
+
+bool LicenseCheck::validate(const License* license,
+                            const std::string& authorityId,
+                            const RSAPublicKey* publicKey,
+                            const std::string& masterKey,
+                            bool validateSignature,
+                            const std::string& licenseeSignature,
+                            NegativeCache* negativeCache)
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.validate");
+    LICENSEPP_TRACE_AUTHORITY(span, authorityId);
+    LICENSEPP_PROBE2(validate__entry, authorityId.c_str(), payloadSize(license));
+    const bool result = check(license, authorityId, publicKey, masterKey, validateSignature, licenseeSignature,
+                              negativeCache);
+    LICENSEPP_PROBE3(validate__return, authorityId.c_str(), result ? 1 : 0, payloadSize(license));
+    LICENSEPP_TRACE_RESULT(span, result);
+    return result;
+}
+
+LicenseError LicenseCheck::tryValidate(const License* license,
+                                       const std::string& authorityId,
+                                       const RSAPublicKey* publicKey,
+                                       const std::string& masterKey,
+                                       bool validateSignature,
+                                       const std::string& licenseeSignature,
+                                       NegativeCache* negativeCache) noexcept
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.validate");
+    LICENSEPP_TRACE_AUTHORITY(span, authorityId);
+    LICENSEPP_PROBE2(validate__entry, authorityId.c_str(), payloadSize(license));
+    const LicenseError error = status(license, publicKey, masterKey, validateSignature, licenseeSignature,
+                                      negativeCache);
+    LICENSEPP_PROBE3(validate__return, authorityId.c_str(), error == LicenseError::None ? 1 : 0,
+                     payloadSize(license));
+    LICENSEPP_TRACE_RESULT(span, error == LicenseError::None);
+    return error;
+}
+
+bool LicenseCheck::check(const License* license,
+                         const std::string& authorityId,
+                         const RSAPublicKey* publicKey,
+                         const std::string& masterKey,
+                         bool validateSignature,
+                         const std::string& licenseeSignature,
+                         NegativeCache* negativeCache)
+{
+    const LicenseError error = status(license, publicKey, masterKey, validateSignature, licenseeSignature,
+                                      negativeCache);
+    switch (error) {
+    case LicenseError::KeyNotAvailable:
+        std::cerr << "Key " << license->keyId() << " of issuing authority " << authorityId
+                  << " is not available (retired?)" << std::endl;
+        break;
+    case LicenseError::InvalidAuthorityKey:
+        std::cerr << "Failed to verify the licensing authority. " << licenseErrorMessage(error) << std::endl;
+        break;
+    case LicenseError::Expired: {
+        const int64_t diff = static_cast<int64_t>(license->expiryDate() - now());
+        int64_t hourDiff = ceil(llabs(diff) / 3600LL);
+        std::cerr << "License was expired " << hourDiff << " hour"
+                  << (hourDiff > 1 ? "s" : "") << " ago" << std::endl;
+        break;
+    }
+    case LicenseError::InvalidFormat:
+    case LicenseError::InvalidAuthoritySignature:
+    case LicenseError::LicenseeSignatureRequired:
+        std::cerr << licenseErrorMessage(error) << std::endl;
+        break;
+    default:
+        break;
+    }
+    return error == LicenseError::None;
+}
+
+LicenseError LicenseCheck::status(const License* license,
+                                  const RSAPublicKey* publicKey,
+                                  const std::string& masterKey,
+                                  bool validateSignature,
+                                  const std::string& licenseeSignature,
+                                  NegativeCache* negativeCache) noexcept
+{
+    // stages are ordered cheapest first so invalid licenses are rejected before any crypto
+
+    // 1. size and format
+    const LicenseError format = checkFormat(license);
+    if (format != LicenseError::None) {
+        return format;
+    }
+
+    // 2. key license is stamped with
+    if (publicKey == nullptr) {
+        return LicenseError::KeyNotAvailable;
+    }
+    if (publicKey->empty()) {
+        return LicenseError::InvalidAuthorityKey;
+    }
+
+    // 3. expiry
+    if (static_cast<int64_t>(license->expiryDate() - now()) < 0) {
+        return LicenseError::Expired;
+    }
+
+    // 4. licensee signature required
+    const bool licenseeSigned = !license->licenseeSignature().empty();
+    if (licenseeSigned && !validateSignature) {
+        return LicenseError::LicenseeSignatureRequired;
+    }
+
+    // 5. crypto, authority signature (and remembering forged blob) then licensee signature
+    try {
+        if (negativeCache != nullptr && negativeCache->contains(license)) {
+            return LicenseError::InvalidAuthoritySignature;
+        }
+        if (!verifyAuthoritySignature(license, *publicKey)) {
+            if (negativeCache != nullptr) {
+                negativeCache->insert(license);
+            }
+            return LicenseError::InvalidAuthoritySignature;
+        }
+    } catch (const std::exception&) {
+        return LicenseError::InvalidAuthoritySignature;
+    }
+    if (!licenseeSigned) {
+        return LicenseError::None;
+    }
+    try {
+        const std::string decodedLicense = Base16::decode(license->licenseeSignature());
+        // reused per thread to avoid allocating iv for every validation
+        static thread_local std::string iv;
+        iv.clear();
+        auto ivPos = decodedLicense.find(":");
+        if (ivPos != std::string::npos) {
+            iv.assign(decodedLicense, 0, ivPos);
+        }
+        return AES::encrypt(licenseeSignature, masterKey, iv) == decodedLicense
+                ? LicenseError::None : LicenseError::InvalidLicenseeSignature;
+    } catch (const std::exception&) {
+        return LicenseError::InvalidLicenseeSignature;
+    }
+}
+
+bool LicenseCheck::verifySignature(const License* license, const std::string& authorityId,
+                                   const RSAPublicKey* publicKey)
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.verify_signature");
+    LICENSEPP_TRACE_AUTHORITY(span, authorityId);
+    (void) authorityId;
+    const bool result = publicKey != nullptr && !publicKey->empty() && authoritySignatureValid(license, *publicKey);
+    LICENSEPP_TRACE_RESULT(span, result);
+    return result;
+}
+
+void LicenseCheck::verifySignatures(const License* const* licenses, std::size_t n,
+                                    const std::string& authorityId, const PublicKeyLookup& publicKey,
+                                    bool* results)
+{
+    LICENSEPP_TRACE_SPAN(span, "authority.verify_signatures");
+    LICENSEPP_TRACE_AUTHORITY(span, authorityId);
+    (void) authorityId;
+    // reused by next call on same thread
+    static thread_local std::vector<const RSAPublicKey*> s_publicKeys;
+    s_publicKeys.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        s_publicKeys[i] = publicKey(licenses[i]->keyId());
+    }
+    if (!RSA::verifiesDigests()) {
+        for (std::size_t i = 0; i < n; ++i) {
+            results[i] = s_publicKeys[i] != nullptr && !s_publicKeys[i]->empty()
+                    && authoritySignatureValid(licenses[i], *s_publicKeys[i]);
+        }
+        return;
+    }
+    static thread_local std::vector<const std::string*> s_messages;
+    static thread_local std::vector<std::size_t> s_indexes;
+    static thread_local std::vector<std::string> s_digests;
+    s_messages.clear();
+    s_indexes.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        const License* license = licenses[i];
+        if (s_publicKeys[i] == nullptr || s_publicKeys[i]->empty() || !isHex(license->authoritySignature())) {
+            results[i] = false;
+        } else if (!license->batchProof().empty()) {
+            // batch root is signed, already cheap after first license of batch
+            results[i] = authoritySignatureValid(license, *s_publicKeys[i]);
+        } else {
+            s_messages.push_back(&license->raw());
+            s_indexes.push_back(i);
+        }
+    }
+    if (s_digests.size() < s_messages.size()) {
+        s_digests.resize(s_messages.size());
+    }
+    SHA1::hashMany(s_messages.data(), s_messages.size(), s_digests.data());
+    for (std::size_t j = 0; j < s_indexes.size(); ++j) {
+        const std::size_t i = s_indexes[j];
+        try {
+            results[i] = RSA::verifyDigest(s_digests[j], licenses[i]->authoritySignature(), *s_publicKeys[i]);
+        } catch (const std::exception&) {
+            results[i] = false;
+        }
+    }
+}
+
+std::size_t LicenseCheck::payloadSize(const License* license) noexcept
+{
+    try {
+        return license->raw().size();
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+LicenseError LicenseCheck::checkFormat(const License* license) noexcept
+{
+    // same limits as IssuingAuthority applies when issuing
+    const std::size_t licenseeSize = license->licensee().size();
+    if (licenseeSize < 2 || licenseeSize > 255 || license->issueDate() > license->expiryDate()) {
+        return LicenseError::InvalidFormat;
+    }
+    const std::string& authoritySignature = license->authoritySignature();
+    if (authoritySignature.size() > kMaxSignatureHexSize || !isHex(authoritySignature)) {
+        return LicenseError::InvalidAuthoritySignature;
+    }
+    if (!license->licenseeSignature().empty() && !isHex(license->licenseeSignature())) {
+        return LicenseError::InvalidLicenseeSignature;
+    }
+    return LicenseError::None;
+}
+
+uint64_t LicenseCheck::now() noexcept
+{
+    auto now = Utils::nowUtc();
+    if (now == 0) {
+        // This should never happen with gcc or clang compilers
+        now = static_cast<unsigned long long>(Utils::now());
+    }
+    return now;
+}
+
+bool LicenseCheck::isHex(const std::string& str) noexcept
+{
+    if (str.empty() || str.size() % 2 != 0) {
+        return false;
+    }
+    for (char c : str) {
+        if (!((c >= '0' && c <= '9') || (c >= 'A' && c <= 'F') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LicenseCheck::authoritySignatureValid(const License* license, const RSAPublicKey& publicKey) noexcept
+{
+    // malformed signatures are rejected here instead of by exception from crypto backend
+    if (!isHex(license->authoritySignature())) {
+        return false;
+    }
+    try {
+        return verifyAuthoritySignature(license, publicKey);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool LicenseCheck::verifyAuthoritySignature(const License* license, const RSAPublicKey& publicKey)
+{
+    if (license->batchProof().empty()) {
+        return RSA::verify(license->raw(), license->authoritySignature(), publicKey);
+    }
+    std::string root;
+    if (!MerkleTree::rootFromProof(MerkleTree::leafHash(license->raw()), license->batchProof(), &root)) {
+        return false;
+    }
+    std::string cacheKey = root;
+    cacheKey.append(publicKey.pem());
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(s_verifiedRootsMutex);
+        if (s_verifiedRoots.find(cacheKey) != s_verifiedRoots.end()) {
+            return true;
+        }
+    }
+    if (!RSA::verify(MerkleTree::signedRoot(root), license->authoritySignature(), publicKey)) {
+        return false;
+    }
+    std::lock_guard<std::shared_timed_mutex> lock(s_verifiedRootsMutex);
+    auto inserted = s_verifiedRoots.insert(std::move(cacheKey));
+    if (!inserted.second) {
+        // verified by other thread meanwhile
+        return true;
+    }
+    s_verifiedRootsOrder.push_back(&*inserted.first);
+    if (s_verifiedRootsOrder.size() > kMaxVerifiedRoots) {
+        s_verifiedRoots.erase(s_verifiedRoots.find(*s_verifiedRootsOrder.front()));
+        s_verifiedRootsOrder.pop_front();
+    }
+    return true;
+}
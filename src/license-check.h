@@ -0,0 +1,129 @@
+//
+//  license-check.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseCheck_h
+#define LICENSEPP_LicenseCheck_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <license++/license-error.h>
+
+namespace licensepp {
+
+class License;
+class NegativeCache;
+class RSAPublicKey;
+
+///
+/// \brief License verification shared by IssuingAuthority and VerifyingAuthority
+///
+/// Authorities only find their public key of license (by key ID), everything else including
+/// tracing spans and validate probes is done here
+///
+class LicenseCheck
+{
+public:
+    ///
+    /// \brief Public key of authority by key ID, nullptr if authority does not have it
+    ///
+    using PublicKeyLookup = std::function<const RSAPublicKey*(uint32_t keyId)>;
+
+    ///
+    /// \brief Verifies authority signature, expiry and licensee signature, writes reason of
+    /// failure to stderr
+    /// \param publicKey Parsed public key license is stamped with, nullptr if authority does
+    /// not have that key and empty if key could not be loaded
+    /// \param negativeCache Licenses that failed authority signature verification, optional
+    ///
+    static bool validate(const License* license,
+                         const std::string& authorityId,
+                         const RSAPublicKey* publicKey,
+                         const std::string& masterKey,
+                         bool validateSignature,
+                         const std::string& licenseeSignature,
+                         NegativeCache* negativeCache);
+
+    ///
+    /// \brief Same checks as validate() without writing to stderr or throwing
+    ///
+    /// Checks are staged cheapest first: format, key, expiry, whether licensee signature
+    /// is required, negative cache and only then authority and licensee signatures
+    ///
+    static LicenseError tryValidate(const License* license,
+                                    const std::string& authorityId,
+                                    const RSAPublicKey* publicKey,
+                                    const std::string& masterKey,
+                                    bool validateSignature,
+                                    const std::string& licenseeSignature,
+                                    NegativeCache* negativeCache) noexcept;
+
+    ///
+    /// \brief Only verifies authority signature without writing to stderr
+    ///
+    static bool verifySignature(const License* license, const std::string& authorityId,
+                                const RSAPublicKey* publicKey);
+
+    ///
+    /// \brief verifySignature() of n licenses, results[i] is result for licenses[i]
+    ///
+    /// When crypto backend verifies digests, licenses that are not batch signed are hashed
+    /// together (SHA1::hashMany()) and only RSA operation is done per license
+    ///
+    static void verifySignatures(const License* const* licenses, std::size_t n,
+                                 const std::string& authorityId, const PublicKeyLookup& publicKey,
+                                 bool* results);
+
+    ///
+    /// \brief Bytes of signed payload (License::raw()), argument of validate probes. 0 if
+    /// license cannot be serialized
+    ///
+    static std::size_t payloadSize(const License* license) noexcept;
+
+private:
+    static bool check(const License* license,
+                      const std::string& authorityId,
+                      const RSAPublicKey* publicKey,
+                      const std::string& masterKey,
+                      bool validateSignature,
+                      const std::string& licenseeSignature,
+                      NegativeCache* negativeCache);
+
+    static LicenseError status(const License* license,
+                               const RSAPublicKey* publicKey,
+                               const std::string& masterKey,
+                               bool validateSignature,
+                               const std::string& licenseeSignature,
+                               NegativeCache* negativeCache) noexcept;
+
+    ///
+    /// \brief Field sizes and signature encodings, everything that is checked without crypto
+    ///
+    static LicenseError checkFormat(const License* license) noexcept;
+
+    ///
+    /// \brief UTC now, local time if UTC is not available
+    ///
+    static uint64_t now() noexcept;
+
+    static bool isHex(const std::string& str) noexcept;
+
+    static bool authoritySignatureValid(const License* license, const RSAPublicKey& publicKey) noexcept;
+
+    ///
+    /// \brief Verifies license signature, or for batch signed license its inclusion proof
+    /// and signature of batch root. Verified roots are cached so rest of the batch only
+    /// costs hashing
+    ///
+    static bool verifyAuthoritySignature(const License* license, const RSAPublicKey& publicKey);
+};
+}
+
+#endif /* LICENSEPP_LicenseCheck_h */
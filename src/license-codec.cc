@@ -0,0 +1,471 @@
+//
+//  license-codec.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <license++/license.h>
+#include "src/json-reader.h"
+#include "src/license-codec.h"
+
+using namespace licensepp;
+
+namespace {
+
+///
+/// \brief State of field after its last occurrence (duplicate keys: last one wins, as in nlohmann::json)
+///
+enum class Field
+{
+    Missing,
+    Valid,
+    Invalid
+};
+
+void appendEscaped(std::string* json, const std::string& value)
+{
+    static const char kHex[] = "0123456789abcdef";
+    json->push_back('"');
+    for (const char c : value) {
+        switch (c) {
+        case '"':
+            json->append("\\\"");
+            break;
+        case '\\':
+            json->append("\\\\");
+            break;
+        case '\b':
+            json->append("\\b");
+            break;
+        case '\f':
+            json->append("\\f");
+            break;
+        case '\n':
+            json->append("\\n");
+            break;
+        case '\r':
+            json->append("\\r");
+            break;
+        case '\t':
+            json->append("\\t");
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                json->append("\\u00");
+                json->push_back(kHex[(c >> 4) & 0x0F]);
+                json->push_back(kHex[c & 0x0F]);
+            } else {
+                json->push_back(c);
+            }
+        }
+    }
+    json->push_back('"');
+}
+
+class Writer
+{
+public:
+    explicit Writer(std::string* json) :
+        m_json(json),
+        m_first(true)
+    {
+        m_json->push_back('{');
+    }
+
+    void key(const char* name)
+    {
+        separate();
+        m_json->push_back('"');
+        m_json->append(name);
+        m_json->append("\":");
+    }
+
+    ///
+    /// \brief Key that is not known in advance (entitlement name) so it is escaped
+    ///
+    void key(const std::string& name)
+    {
+        separate();
+        appendEscaped(m_json, name);
+        m_json->push_back(':');
+    }
+
+    void string(const char* name, const std::string& value)
+    {
+        key(name);
+        appendEscaped(m_json, value);
+    }
+
+    template <typename Key, typename T>
+    void number(const Key& name, T value)
+    {
+        key(name);
+        m_json->append(std::to_string(value));
+    }
+
+    void end()
+    {
+        m_json->push_back('}');
+    }
+
+private:
+    void separate()
+    {
+        if (!m_first) {
+            m_json->push_back(',');
+        }
+        m_first = false;
+    }
+
+    std::string* m_json;
+    bool m_first;
+};
+
+class Reader
+{
+public:
+    explicit Reader(const std::string& json) :
+        m_reader(json)
+    {
+    }
+
+    inline JsonReader& json()
+    {
+        return m_reader;
+    }
+
+    bool key(std::string* out)
+    {
+        return m_reader.string(out) && m_reader.consume(':');
+    }
+
+    bool string(int depth, Field* state, std::string* out)
+    {
+        if (m_reader.peek('"')) {
+            *state = Field::Valid;
+            return m_reader.string(out);
+        }
+        *state = Field::Invalid;
+        return m_reader.skip(depth);
+    }
+
+    ///
+    /// \param signedValue Accepts negative numbers as well (is_number_integer() instead of is_number_unsigned())
+    ///
+    bool number(int depth, bool signedValue, Field* state, uint64_t* out)
+    {
+        if (!m_reader.peekNumber()) {
+            *state = Field::Invalid;
+            return m_reader.skip(depth);
+        }
+        const JsonReader::Number type = m_reader.number(out);
+        if (type == JsonReader::Number::Invalid) {
+            return false;
+        }
+        *state = type == JsonReader::Number::Unsigned || (signedValue && type == JsonReader::Number::Integer)
+                ? Field::Valid : Field::Invalid;
+        return true;
+    }
+
+    template <typename T>
+    bool object(int depth, bool signedValue, Field* state, std::map<std::string, std::pair<Field, T>>* out)
+    {
+        out->clear();
+        if (!m_reader.consume('{')) {
+            *state = Field::Invalid;
+            return m_reader.skip(depth);
+        }
+        *state = Field::Valid;
+        if (m_reader.consume('}')) {
+            return true;
+        }
+        std::string name;
+        do {
+            uint64_t value = 0;
+            Field valueState = Field::Missing;
+            if (!key(&name) || !number(depth + 1, signedValue, &valueState, &value)) {
+                return false;
+            }
+            (*out)[name] = std::make_pair(valueState, static_cast<T>(value));
+        } while (m_reader.consume(','));
+        return m_reader.consume('}');
+    }
+
+    bool array(int depth, Field* state, std::vector<std::string>* out)
+    {
+        out->clear();
+        if (!m_reader.consume('[')) {
+            *state = Field::Invalid;
+            return m_reader.skip(depth);
+        }
+        *state = Field::Valid;
+        if (m_reader.consume(']')) {
+            return true;
+        }
+        do {
+            Field itemState = Field::Missing;
+            out->emplace_back();
+            if (!string(depth + 1, &itemState, &out->back())) {
+                return false;
+            }
+            if (itemState != Field::Valid) {
+                *state = Field::Invalid;
+            }
+        } while (m_reader.consume(','));
+        return m_reader.consume(']');
+    }
+
+private:
+    JsonReader m_reader;
+};
+
+template <typename T>
+bool collect(const std::map<std::string, std::pair<Field, T>>& entries, std::map<std::string, T>* out)
+{
+    for (const auto& entry : entries) {
+        if (entry.second.first != Field::Valid) {
+            return false;
+        }
+        out->emplace(entry.first, entry.second.second);
+    }
+    return true;
+}
+
+LicenseError readFields(const std::string& json, LicenseCodec::Fields* fields)
+{
+    Reader reader(json);
+    if (!reader.json().consume('{')) {
+        return LicenseError::InvalidFormat;
+    }
+
+    // strings are cleared (not freed) so fields can be reused for next license
+    fields->licensee.clear();
+    fields->issuingAuthority.clear();
+    fields->authoritySignature.clear();
+    fields->licenseeSignature.clear();
+    fields->batchProof.clear();
+    fields->additionalPayload.clear();
+    fields->features.clear();
+    fields->limits.clear();
+    fields->moduleExpiries.clear();
+    uint64_t issueDate = 0;
+    uint64_t expiryDate = 0;
+    uint64_t keyId = 0;
+    std::map<std::string, std::pair<Field, int64_t>> limits;
+    std::map<std::string, std::pair<Field, uint64_t>> moduleExpiries;
+    Field licenseeState = Field::Missing;
+    Field issuingAuthorityState = Field::Missing;
+    Field authoritySignatureState = Field::Missing;
+    Field licenseeSignatureState = Field::Missing;
+    Field batchProofState = Field::Missing;
+    Field additionalPayloadState = Field::Missing;
+    Field issueDateState = Field::Missing;
+    Field expiryDateState = Field::Missing;
+    Field keyIdState = Field::Missing;
+    Field entitlementsState = Field::Missing;
+    Field featuresState = Field::Missing;
+    Field limitsState = Field::Missing;
+    Field modulesState = Field::Missing;
+
+    std::string& name = fields->name;
+    if (!reader.json().consume('}')) {
+        do {
+            if (!reader.key(&name)) {
+                return LicenseError::InvalidFormat;
+            }
+            bool ok;
+            if (name == "licensee") {
+                ok = reader.string(1, &licenseeState, &fields->licensee);
+            } else if (name == "issuing_authority") {
+                ok = reader.string(1, &issuingAuthorityState, &fields->issuingAuthority);
+            } else if (name == "authority_signature") {
+                ok = reader.string(1, &authoritySignatureState, &fields->authoritySignature);
+            } else if (name == "licensee_signature") {
+                ok = reader.string(1, &licenseeSignatureState, &fields->licenseeSignature);
+            } else if (name == "batch_proof") {
+                ok = reader.string(1, &batchProofState, &fields->batchProof);
+            } else if (name == "additional_payload") {
+                ok = reader.string(1, &additionalPayloadState, &fields->additionalPayload);
+            } else if (name == "issue_date") {
+                ok = reader.number(1, false, &issueDateState, &issueDate);
+            } else if (name == "expiry_date") {
+                ok = reader.number(1, false, &expiryDateState, &expiryDate);
+            } else if (name == "key_id") {
+                ok = reader.number(1, false, &keyIdState, &keyId);
+            } else if (name == "entitlements") {
+                // later entitlements replace earlier ones entirely
+                fields->features.clear();
+                limits.clear();
+                moduleExpiries.clear();
+                featuresState = limitsState = modulesState = Field::Missing;
+                if (!reader.json().consume('{')) {
+                    entitlementsState = Field::Invalid;
+                    ok = reader.json().skip(1);
+                } else {
+                    entitlementsState = Field::Valid;
+                    ok = true;
+                    if (!reader.json().consume('}')) {
+                        do {
+                            if (!reader.key(&name)) {
+                                return LicenseError::InvalidFormat;
+                            }
+                            if (name == "features") {
+                                ok = reader.array(2, &featuresState, &fields->features);
+                            } else if (name == "limits") {
+                                ok = reader.object(2, true, &limitsState, &limits);
+                            } else if (name == "modules") {
+                                ok = reader.object(2, false, &modulesState, &moduleExpiries);
+                            } else {
+                                ok = reader.json().skip(2);
+                            }
+                        } while (ok && reader.json().consume(','));
+                        ok = ok && reader.json().consume('}');
+                    }
+                }
+            } else {
+                ok = reader.json().skip(1);
+            }
+            if (!ok) {
+                return LicenseError::InvalidFormat;
+            }
+        } while (reader.json().consume(','));
+        if (!reader.json().consume('}')) {
+            return LicenseError::InvalidFormat;
+        }
+    }
+    if (!reader.json().atEnd()) {
+        return LicenseError::InvalidFormat;
+    }
+
+    if (licenseeState != Field::Valid || issuingAuthorityState != Field::Valid
+            || authoritySignatureState != Field::Valid || licenseeSignatureState == Field::Invalid
+            || batchProofState == Field::Invalid || additionalPayloadState == Field::Invalid
+            || issueDateState != Field::Valid || expiryDateState != Field::Valid
+            || keyIdState == Field::Invalid || keyId > UINT32_MAX
+            || entitlementsState == Field::Invalid || featuresState == Field::Invalid
+            || limitsState == Field::Invalid || modulesState == Field::Invalid) {
+        return LicenseError::InvalidFormat;
+    }
+    if (!collect(limits, &fields->limits) || !collect(moduleExpiries, &fields->moduleExpiries)) {
+        return LicenseError::InvalidFormat;
+    }
+    fields->issueDate = issueDate;
+    fields->expiryDate = expiryDate;
+    fields->keyId = static_cast<uint32_t>(keyId);
+    fields->hasEntitlements = entitlementsState == Field::Valid;
+    return LicenseError::None;
+}
+
+LicenseError readLicense(const std::string& json, License* license)
+{
+    LicenseCodec::Fields fields;
+    const LicenseError error = readFields(json, &fields);
+    if (error != LicenseError::None) {
+        return error;
+    }
+    // optional fields that are missing are empty, so license object can be reused for loading
+    license->setLicensee(std::move(fields.licensee));
+    license->setIssuingAuthorityId(std::move(fields.issuingAuthority));
+    license->setLicenseeSignature(std::move(fields.licenseeSignature));
+    license->setIssueDate(fields.issueDate);
+    license->setExpiryDate(fields.expiryDate);
+    license->setKeyId(fields.keyId);
+    license->setAuthoritySignature(std::move(fields.authoritySignature));
+    license->setBatchProof(std::move(fields.batchProof));
+    license->setAdditionalPayload(std::move(fields.additionalPayload));
+    if (fields.hasEntitlements) {
+        license->setEntitlements(Entitlements(std::move(fields.features), fields.limits, fields.moduleExpiries));
+    } else {
+        license->setEntitlements(Entitlements());
+    }
+    return LicenseError::None;
+}
+}
+
+std::string LicenseCodec::write(const License& license, bool full)
+{
+    // keys in sorted order, same as nlohmann::json object
+    std::string json;
+    json.reserve(256 + license.authoritySignature().size() + license.additionalPayload().size());
+    Writer writer(&json);
+    if (!license.additionalPayload().empty()) {
+        writer.string("additional_payload", license.additionalPayload());
+    }
+    if (full) {
+        writer.string("authority_signature", license.authoritySignature());
+        if (!license.batchProof().empty()) {
+            writer.string("batch_proof", license.batchProof());
+        }
+    }
+    // omitted when empty so licenses issued before entitlements keep their signature
+    const Entitlements& entitlements = license.entitlements();
+    if (!entitlements.empty()) {
+        writer.key("entitlements");
+        Writer inner(&json);
+        if (!entitlements.features().empty()) {
+            inner.key("features");
+            json.push_back('[');
+            for (std::size_t i = 0; i < entitlements.features().size(); ++i) {
+                if (i > 0) {
+                    json.push_back(',');
+                }
+                appendEscaped(&json, entitlements.features()[i]);
+            }
+            json.push_back(']');
+        }
+        if (!entitlements.limits().empty()) {
+            inner.key("limits");
+            Writer limits(&json);
+            for (const auto& limit : entitlements.limits()) {
+                limits.number(limit.first, limit.second);
+            }
+            limits.end();
+        }
+        if (!entitlements.moduleExpiries().empty()) {
+            inner.key("modules");
+            Writer modules(&json);
+            for (const auto& module : entitlements.moduleExpiries()) {
+                modules.number(module.first, module.second);
+            }
+            modules.end();
+        }
+        inner.end();
+    }
+    writer.number("expiry_date", license.expiryDate());
+    writer.number("issue_date", license.issueDate());
+    writer.string("issuing_authority", license.issuingAuthorityId());
+    if (license.keyId() != 0) {
+        writer.number("key_id", license.keyId());
+    }
+    writer.string("licensee", license.licensee());
+    if (!license.licenseeSignature().empty()) {
+        writer.string("licensee_signature", license.licenseeSignature());
+    }
+    writer.end();
+    return json;
+}
+
+LicenseError LicenseCodec::read(const std::string& json, License* license) noexcept
+{
+    try {
+        return readLicense(json, license);
+    } catch (const std::exception&) {
+        // allocation failure, nlohmann::json parser is reported the same way
+        return LicenseError::InvalidFormat;
+    }
+}
+
+LicenseError LicenseCodec::read(const std::string& json, Fields* fields) noexcept
+{
+    try {
+        return readFields(json, fields);
+    } catch (const std::exception&) {
+        return LicenseError::InvalidFormat;
+    }
+}
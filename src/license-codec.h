@@ -0,0 +1,74 @@
+//
+//  license-codec.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseCodec_h
+#define LICENSEPP_LicenseCodec_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <license++/entitlements.h>
+#include <license++/license-error.h>
+
+namespace licensepp {
+
+class License;
+
+///
+/// \brief License JSON reader and writer for licensepp-verify-lite, without nlohmann::json
+///
+/// Output is byte for byte what nlohmann::json dump() writes for the same license (keys
+/// sorted, same escapes) as signatures are made over it. Input is accepted and rejected
+/// the same way as License::tryLoad() of full library does. Full library reads licenses
+/// of LicensePool with it as well.
+///
+class LicenseCodec
+{
+public:
+    ///
+    /// \brief Fields of license JSON that was read. Strings are only cleared by next read so
+    /// reusing same fields does not allocate once they are large enough
+    ///
+    struct Fields
+    {
+        std::string licensee;
+        std::string issuingAuthority;
+        std::string authoritySignature;
+        std::string licenseeSignature;
+        std::string batchProof;
+        std::string additionalPayload;
+        uint64_t issueDate = 0;
+        uint64_t expiryDate = 0;
+        uint32_t keyId = 0;
+        bool hasEntitlements = false;
+        std::vector<std::string> features;
+        Entitlements::Limits limits;
+        Entitlements::ModuleExpiries moduleExpiries;
+        // key that is being read
+        std::string name;
+    };
+
+    static std::string write(const License& license, bool full);
+
+    ///
+    /// \brief Reads license JSON, license is only changed if result is LicenseError::None
+    ///
+    static LicenseError read(const std::string& json, License* license) noexcept;
+
+    ///
+    /// \brief Reads license JSON to fields, fields are undefined unless result is LicenseError::None
+    ///
+    static LicenseError read(const std::string& json, Fields* fields) noexcept;
+
+private:
+    LicenseCodec() = delete;
+};
+}
+
+#endif /* LICENSEPP_LicenseCodec_h */
@@ -0,0 +1,41 @@
+//
+//  license-error.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <license++/license-error.h>
+
+using namespace licensepp;
+
+const char* licensepp::licenseErrorMessage(LicenseError error) noexcept
+{
+    switch (error) {
+    case LicenseError::None:
+        return "No error";
+    case LicenseError::InvalidBase64:
+        return "License is not valid base64";
+    case LicenseError::InvalidFormat:
+        return "License is not valid JSON or is missing required field";
+    case LicenseError::UnknownAuthority:
+        return "Issuing authority not found";
+    case LicenseError::KeyNotAvailable:
+        return "Key of issuing authority is not available (retired?)";
+    case LicenseError::InvalidAuthorityKey:
+        return "Issuing authority could not be loaded. Invalid keypair";
+    case LicenseError::InvalidAuthoritySignature:
+        return "Failed to verify the licensing authority";
+    case LicenseError::Expired:
+        return "License was expired";
+    case LicenseError::LicenseeSignatureRequired:
+        return "Signature available on license, you should verify the signature";
+    case LicenseError::InvalidLicenseeSignature:
+        return "Licensee signature does not match";
+    case LicenseError::Internal:
+        break;
+    }
+    return "Internal error";
+}
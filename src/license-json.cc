@@ -0,0 +1,198 @@
+//
+//  license-json.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <license++/license.h>
+#include "src/json-object.h"
+#include "src/tracing.h"
+
+using namespace licensepp;
+
+std::string License::serialize(bool full) const
+{
+    JsonObject::Json j;
+    j["licensee"] = m_licensee;
+    if (!m_licenseeSignature.empty()) {
+        j["licensee_signature"] = m_licenseeSignature;
+    }
+    j["issue_date"] = m_issueDate;
+    j["expiry_date"] = m_expiryDate;
+    j["issuing_authority"] = m_issuingAuthorityId;
+    if (m_keyId != 0) {
+        j["key_id"] = m_keyId;
+    }
+
+    if (full) {
+        j["authority_signature"] = m_authoritySignature;
+        if (!m_batchProof.empty()) {
+            j["batch_proof"] = m_batchProof;
+        }
+    }
+
+    if (!m_additionalPayload.empty()) {
+        j["additional_payload"] = m_additionalPayload;
+    }
+
+    // omitted when empty so licenses issued before entitlements keep their signature
+    if (!m_entitlements.empty()) {
+        JsonObject::Json entitlements = JsonObject::Json::object();
+        if (!m_entitlements.features().empty()) {
+            entitlements["features"] = m_entitlements.features();
+        }
+        for (const auto& limit : m_entitlements.limits()) {
+            entitlements["limits"][limit.first] = limit.second;
+        }
+        for (const auto& module : m_entitlements.moduleExpiries()) {
+            entitlements["modules"][module.first] = module.second;
+        }
+        j["entitlements"] = std::move(entitlements);
+    }
+    return j.dump();
+}
+
+LicenseError License::deserialize(const std::string& json) noexcept
+{
+    // checked first so garbage does not cost parser exception
+    if (!JsonObject::isWellFormed(json)) {
+        return LicenseError::InvalidFormat;
+    }
+    JsonObject::Json j;
+    try {
+        LICENSEPP_TRACE_SPAN(parseSpan, "json.parse");
+        j = JsonObject::Json::parse(json);
+        LICENSEPP_TRACE_END(parseSpan);
+    } catch (const std::exception&) {
+        return LicenseError::InvalidFormat;
+    }
+    if (!j.is_object()) {
+        return LicenseError::InvalidFormat;
+    }
+
+    // everything is type checked before license is changed, json accessors would throw otherwise
+    // (optional fields that are missing point to `missing`)
+    std::string missing;
+    auto stringField = [&](const char* key, bool required) -> std::string* {
+        auto it = j.find(key);
+        if (it == j.end()) {
+            return required ? nullptr : &missing;
+        }
+        return it->is_string() ? &(it->template get_ref<std::string&>()) : nullptr;
+    };
+    auto unsignedField = [&](const char* key, bool required, uint64_t* value) -> bool {
+        auto it = j.find(key);
+        if (it == j.end()) {
+            *value = 0;
+            return !required;
+        }
+        if (!it->is_number_unsigned()) {
+            return false;
+        }
+        *value = it->template get<uint64_t>();
+        return true;
+    };
+    std::string* licensee = stringField("licensee", true);
+    std::string* issuingAuthority = stringField("issuing_authority", true);
+    std::string* authoritySignature = stringField("authority_signature", true);
+    std::string* licenseeSignature = stringField("licensee_signature", false);
+    std::string* batchProof = stringField("batch_proof", false);
+    std::string* additionalPayload = stringField("additional_payload", false);
+    uint64_t issueDate = 0;
+    uint64_t expiryDate = 0;
+    uint64_t keyId = 0;
+    if (licensee == nullptr || issuingAuthority == nullptr || authoritySignature == nullptr
+            || licenseeSignature == nullptr || batchProof == nullptr || additionalPayload == nullptr
+            || !unsignedField("issue_date", true, &issueDate) || !unsignedField("expiry_date", true, &expiryDate)
+            || !unsignedField("key_id", false, &keyId) || keyId > UINT32_MAX) {
+        return LicenseError::InvalidFormat;
+    }
+
+    // everything is collected first so index is compiled only once, entitlements are
+    // compiled before license is changed as it allocates
+    Entitlements compiled;
+    auto entitlements = j.find("entitlements");
+    const bool hasEntitlements = entitlements != j.end();
+    if (hasEntitlements) {
+        try {
+            std::vector<std::string> features;
+            Entitlements::Limits limits;
+            Entitlements::ModuleExpiries moduleExpiries;
+            if (!entitlements->is_object()) {
+                return LicenseError::InvalidFormat;
+            }
+            auto f = entitlements->find("features");
+            if (f != entitlements->end()) {
+                if (!f->is_array()) {
+                    return LicenseError::InvalidFormat;
+                }
+                for (auto& feature : *f) {
+                    if (!feature.is_string()) {
+                        return LicenseError::InvalidFormat;
+                    }
+                    features.push_back(std::move(feature.template get_ref<std::string&>()));
+                }
+            }
+            auto l = entitlements->find("limits");
+            if (l != entitlements->end()) {
+                if (!l->is_object()) {
+                    return LicenseError::InvalidFormat;
+                }
+                for (auto it = l->begin(); it != l->end(); ++it) {
+                    if (!it.value().is_number_integer()) {
+                        return LicenseError::InvalidFormat;
+                    }
+                    limits.emplace(it.key(), it.value().template get<int64_t>());
+                }
+            }
+            auto m = entitlements->find("modules");
+            if (m != entitlements->end()) {
+                if (!m->is_object()) {
+                    return LicenseError::InvalidFormat;
+                }
+                for (auto it = m->begin(); it != m->end(); ++it) {
+                    if (!it.value().is_number_unsigned()) {
+                        return LicenseError::InvalidFormat;
+                    }
+                    moduleExpiries.emplace(it.key(), it.value().template get<uint64_t>());
+                }
+            }
+            compiled = Entitlements(std::move(features), limits, moduleExpiries);
+        } catch (const std::exception&) {
+            return LicenseError::InvalidFormat;
+        }
+    }
+
+    // optional fields are reset when missing so license object can be reused for loading
+    // strings are moved out of parsed json instead of being copied
+    setLicensee(std::move(*licensee));
+    setIssuingAuthorityId(std::move(*issuingAuthority));
+    if (licenseeSignature != &missing) {
+        setLicenseeSignature(std::move(*licenseeSignature));
+    } else {
+        m_licenseeSignature.clear();
+    }
+    setIssueDate(issueDate);
+    setExpiryDate(expiryDate);
+    setKeyId(static_cast<uint32_t>(keyId));
+    setAuthoritySignature(std::move(*authoritySignature));
+    if (batchProof != &missing) {
+        setBatchProof(std::move(*batchProof));
+    } else {
+        m_batchProof.clear();
+    }
+    if (additionalPayload != &missing) {
+        setAdditionalPayload(std::move(*additionalPayload));
+    } else {
+        m_additionalPayload.clear();
+    }
+    if (hasEntitlements) {
+        setEntitlements(std::move(compiled));
+    } else {
+        m_entitlements = Entitlements();
+    }
+    return LicenseError::None;
+}
@@ -0,0 +1,25 @@
+//
+//  license-lite.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <license++/license.h>
+#include "src/license-codec.h"
+#include "src/tracing.h"
+
+using namespace licensepp;
+
+std::string License::serialize(bool full) const
+{
+    return LicenseCodec::write(*this, full);
+}
+
+LicenseError License::deserialize(const std::string& json) noexcept
+{
+    LICENSEPP_TRACE_SPAN(parseSpan, "json.parse");
+    return LicenseCodec::read(json, this);
+}
@@ -0,0 +1,210 @@
+//
+//  license-pool.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <cstdint>
+#include <new>
+#include <license++/license-pool.h>
+#include <license++/license-exception.h>
+#include "src/crypto/base64.h"
+#include "src/license-codec.h"
+
+using namespace licensepp;
+
+const std::size_t LicenseArena::kDefaultBlockSize;
+
+LicenseArena::LicenseArena(std::size_t blockSize) :
+    m_blockSize(blockSize < 1024 ? 1024 : blockSize),
+    m_current(nullptr),
+    m_remaining(0),
+    m_capacity(0)
+{
+}
+
+LicenseArena::~LicenseArena()
+{
+    release();
+}
+
+void* LicenseArena::allocate(std::size_t size, std::size_t alignment)
+{
+    std::size_t padding = (alignment - reinterpret_cast<uintptr_t>(m_current) % alignment) % alignment;
+    if (m_current == nullptr || padding + size > m_remaining) {
+        // request larger than a block gets block of its own
+        const std::size_t blockSize = size > m_blockSize ? size : m_blockSize;
+        char* block = static_cast<char*>(::operator new(blockSize));
+        try {
+            m_blocks.push_back(block);
+        } catch (...) {
+            ::operator delete(block);
+            throw;
+        }
+        m_capacity += blockSize;
+        if (blockSize > m_blockSize) {
+            return block;
+        }
+        m_current = block;
+        m_remaining = blockSize;
+        padding = 0;
+    }
+    void* p = m_current + padding;
+    m_current += padding + size;
+    m_remaining -= padding + size;
+    return p;
+}
+
+void LicenseArena::release()
+{
+    for (char* block : m_blocks) {
+        ::operator delete(block);
+    }
+    m_blocks.clear();
+    m_current = nullptr;
+    m_remaining = 0;
+    m_capacity = 0;
+}
+
+PooledLicense::PooledLicense(LicenseArena* arena) :
+    m_issueDate(0),
+    m_expiryDate(0),
+    m_keyId(0),
+    m_licensee(ArenaAllocator<char>(arena)),
+    m_issuingAuthorityId(ArenaAllocator<char>(arena)),
+    m_licenseeSignature(ArenaAllocator<char>(arena)),
+    m_authoritySignature(ArenaAllocator<char>(arena)),
+    m_batchProof(ArenaAllocator<char>(arena)),
+    m_additionalPayload(ArenaAllocator<char>(arena)),
+    m_raw(ArenaAllocator<char>(arena)),
+    m_entitlements(nullptr)
+{
+}
+
+PooledLicense::~PooledLicense()
+{
+    if (m_entitlements != nullptr) {
+        // storage belongs to arena
+        m_entitlements->~Entitlements();
+    }
+}
+
+const Entitlements& PooledLicense::entitlements() const
+{
+    static const Entitlements s_none;
+    return m_entitlements == nullptr ? s_none : *m_entitlements;
+}
+
+void PooledLicense::copyTo(License* license) const
+{
+    license->m_issueDate = m_issueDate;
+    license->m_expiryDate = m_expiryDate;
+    license->m_keyId = m_keyId;
+    license->m_licensee.assign(m_licensee.data(), m_licensee.size());
+    license->m_issuingAuthorityId.assign(m_issuingAuthorityId.data(), m_issuingAuthorityId.size());
+    license->m_licenseeSignature.assign(m_licenseeSignature.data(), m_licenseeSignature.size());
+    license->m_authoritySignature.assign(m_authoritySignature.data(), m_authoritySignature.size());
+    license->m_batchProof.assign(m_batchProof.data(), m_batchProof.size());
+    license->m_additionalPayload.assign(m_additionalPayload.data(), m_additionalPayload.size());
+    license->m_entitlements = entitlements();
+    license->keepRaw(m_raw.data(), m_raw.size());
+}
+
+///
+/// \brief Buffers reused by every load
+///
+struct LicensePool::Scratch
+{
+    std::string json;
+    LicenseCodec::Fields fields;
+};
+
+LicensePool::LicensePool(std::size_t blockSize) :
+    m_arena(blockSize),
+    m_scratch(new Scratch())
+{
+}
+
+LicensePool::~LicensePool()
+{
+    release();
+}
+
+const PooledLicense* LicensePool::load(const std::string& licenseBase64)
+{
+    const PooledLicense* license = nullptr;
+    const LicenseError error = tryLoad(licenseBase64, &license);
+    if (error != LicenseError::None) {
+        throw LicenseException("Failed to load the license: " + std::string(licenseErrorMessage(error)));
+    }
+    return license;
+}
+
+LicenseError LicensePool::tryLoad(const std::string& licenseBase64, const PooledLicense** license) noexcept
+{
+    Scratch& scratch = *m_scratch;
+    if (!Base64::decode(licenseBase64, &scratch.json)) {
+        return LicenseError::InvalidBase64;
+    }
+    LicenseCodec::Fields& fields = scratch.fields;
+    const LicenseError error = LicenseCodec::read(scratch.json, &fields);
+    if (error != LicenseError::None) {
+        return error;
+    }
+    PooledLicense* pooled = nullptr;
+    try {
+        pooled = new (m_arena.allocate(sizeof(PooledLicense), alignof(PooledLicense))) PooledLicense(&m_arena);
+        pooled->m_issueDate = fields.issueDate;
+        pooled->m_expiryDate = fields.expiryDate;
+        pooled->m_keyId = fields.keyId;
+        pooled->m_licensee.assign(fields.licensee.data(), fields.licensee.size());
+        pooled->m_issuingAuthorityId.assign(fields.issuingAuthority.data(), fields.issuingAuthority.size());
+        pooled->m_licenseeSignature.assign(fields.licenseeSignature.data(), fields.licenseeSignature.size());
+        pooled->m_authoritySignature.assign(fields.authoritySignature.data(), fields.authoritySignature.size());
+        pooled->m_batchProof.assign(fields.batchProof.data(), fields.batchProof.size());
+        pooled->m_additionalPayload.assign(fields.additionalPayload.data(), fields.additionalPayload.size());
+        pooled->m_raw.assign(scratch.json.data(), scratch.json.size());
+        if (fields.hasEntitlements) {
+            void* storage = m_arena.allocate(sizeof(Entitlements), alignof(Entitlements));
+            pooled->m_entitlements = new (storage) Entitlements(std::move(fields.features), fields.limits,
+                                                                fields.moduleExpiries);
+        }
+        m_licenses.push_back(pooled);
+    } catch (const std::exception&) {
+        // pool is left unchanged, arena memory is freed by release()
+        if (pooled != nullptr) {
+            pooled->~PooledLicense();
+        }
+        return LicenseError::Internal;
+    }
+    *license = pooled;
+    return LicenseError::None;
+}
+
+std::size_t LicensePool::load(const std::vector<std::string>& licensesBase64,
+                              std::vector<const PooledLicense*>* loaded)
+{
+    std::size_t count = 0;
+    for (const std::string& licenseBase64 : licensesBase64) {
+        const PooledLicense* license = nullptr;
+        if (tryLoad(licenseBase64, &license) == LicenseError::None) {
+            if (loaded != nullptr) {
+                loaded->push_back(license);
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+void LicensePool::release()
+{
+    for (PooledLicense* license : m_licenses) {
+        license->~PooledLicense();
+    }
+    m_licenses.clear();
+    m_arena.release();
+}
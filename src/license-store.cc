@@ -0,0 +1,815 @@
+//
+//  license-store.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <license++/license-store.h>
+#include <license++/license-exception.h>
+#include "src/crypto/base64.h"
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <fcntl.h>
+#   include <sys/file.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+#if LICENSEPP_OS_UNIX
+namespace {
+
+// Log file is 16-byte file header followed by records, all little endian:
+//
+//   file header:  u32 magic, u32 version, u64 log id (changes on compaction)
+//   record:       u32 magic, u32 crc32 (of everything after it), u32 payload size,
+//                 u32 licensee size, u32 authority size, u32 reserved, u64 expiry date,
+//                 payload (licensee, authority and base64 license)
+//
+// Index file is native byte order (it is rebuilt if magic does not match):
+//
+//   u64 magic, u64 log id, u64 watermark (log size covered), u64 count, sorted entries
+
+const uint32_t kLogMagic = 0x4C53504CU;  // LPSL
+const uint32_t kLogVersion = 1;
+const uint64_t kLogHeaderSize = 16;
+const uint32_t kRecordMagic = 0x5253504CU;  // LPSR
+const uint64_t kRecordHeaderSize = 32;
+const uint64_t kIndexMagic = 0x3158444953504CULL;  // LPSIDX1
+const uint64_t kIndexHeaderSize = 32;
+
+// licenses appended after indexes are persisted are kept in memory until this many
+const std::size_t kMaxUnpersisted = 8192;
+
+const char* kLogFile = "licenses.log";
+const char* kIndexFiles[] = { "licensee.idx", "authority.idx", "expiry.idx" };
+
+inline void writeU32(unsigned char* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void writeU64(unsigned char* p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t readU32(const unsigned char* p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+uint32_t crc32(uint32_t crc, const unsigned char* data, std::size_t size)
+{
+    static const std::vector<uint32_t> kTable = []() {
+        std::vector<uint32_t> table(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return table;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = kTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+inline uint64_t hashName(const char* name, std::size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t newLogId()
+{
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32)
+            ^ static_cast<uint64_t>(device())
+            ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+bool writeFully(int fd, const void* data, std::size_t size, uint64_t offset)
+{
+    const char* p = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t written = ::pwrite(fd, p, size, static_cast<off_t>(offset));
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        p += written;
+        size -= static_cast<std::size_t>(written);
+        offset += static_cast<uint64_t>(written);
+    }
+    return true;
+}
+
+bool readFully(int fd, void* data, std::size_t size, uint64_t offset)
+{
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t read = ::pread(fd, p, size, static_cast<off_t>(offset));
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            return false;
+        }
+        p += read;
+        size -= static_cast<std::size_t>(read);
+        offset += static_cast<uint64_t>(read);
+    }
+    return true;
+}
+
+///
+/// \brief Makes renames and newly created files in directory durable
+///
+void syncDirectory(const std::string& directory)
+{
+    int fd = ::open(directory.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+std::string encodeRecord(uint32_t licenseeSize, uint32_t authoritySize, uint64_t expiryDate,
+                         const std::string& payload)
+{
+    std::string record(kRecordHeaderSize + payload.size(), '\0');
+    unsigned char* p = reinterpret_cast<unsigned char*>(&record[0]);
+    writeU32(p, kRecordMagic);
+    writeU32(p + 8, static_cast<uint32_t>(payload.size()));
+    writeU32(p + 12, licenseeSize);
+    writeU32(p + 16, authoritySize);
+    writeU64(p + 24, expiryDate);
+    std::memcpy(p + kRecordHeaderSize, payload.data(), payload.size());
+    writeU32(p + 4, crc32(0, p + 8, record.size() - 8));
+    return record;
+}
+}
+
+///
+/// \brief Memory-mapped sorted array of (key, record id) entries plus entries
+/// that are not persisted yet
+///
+class LicenseStore::Index
+{
+public:
+    struct Entry
+    {
+        uint64_t key;
+        uint64_t recordId;
+
+        inline bool operator<(const Entry& other) const
+        {
+            return key < other.key || (key == other.key && recordId < other.recordId);
+        }
+    };
+
+    explicit Index(const std::string& path) :
+        m_path(path),
+        m_map(nullptr),
+        m_mapSize(0),
+        m_entries(nullptr),
+        m_count(0),
+        m_watermark(0)
+    {
+    }
+
+    ~Index()
+    {
+        unmap();
+    }
+
+    ///
+    /// \brief Maps index file, false if it is missing or does not belong to log
+    ///
+    bool open(uint64_t logId, uint64_t logSize)
+    {
+        unmap();
+        int fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<uint64_t>(st.st_size) < kIndexHeaderSize) {
+            ::close(fd);
+            return false;
+        }
+        void* map = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        m_map = map;
+        m_mapSize = static_cast<std::size_t>(st.st_size);
+        const uint64_t* header = static_cast<const uint64_t*>(map);
+        if (header[0] != kIndexMagic || header[1] != logId
+                || header[2] < kLogHeaderSize || header[2] > logSize
+                || (m_mapSize - kIndexHeaderSize) / sizeof(Entry) != header[3]
+                || (m_mapSize - kIndexHeaderSize) % sizeof(Entry) != 0) {
+            unmap();
+            return false;
+        }
+        m_watermark = header[2];
+        m_count = static_cast<std::size_t>(header[3]);
+        m_entries = reinterpret_cast<const Entry*>(static_cast<const char*>(map) + kIndexHeaderSize);
+        return true;
+    }
+
+    void reset()
+    {
+        unmap();
+        ::unlink(m_path.c_str());
+        m_unpersisted.clear();
+    }
+
+    inline void add(uint64_t key, RecordId id)
+    {
+        m_unpersisted.push_back(Entry { key, id });
+    }
+
+    void find(uint64_t key, RecordIds* ids) const
+    {
+        auto range = std::equal_range(m_entries, m_entries + m_count, key, KeyLess());
+        for (const Entry* e = range.first; e != range.second; ++e) {
+            ids->push_back(e->recordId);
+        }
+        for (const Entry& e : m_unpersisted) {
+            if (e.key == key) {
+                ids->push_back(e.recordId);
+            }
+        }
+    }
+
+    void findRange(uint64_t from, uint64_t to, RecordIds* ids) const
+    {
+        if (from >= to) {
+            return;
+        }
+        const Entry* begin = std::lower_bound(m_entries, m_entries + m_count, from, KeyLess());
+        const Entry* end = std::lower_bound(begin, m_entries + m_count, to, KeyLess());
+        std::vector<Entry> recent;
+        for (const Entry& e : m_unpersisted) {
+            if (e.key >= from && e.key < to) {
+                recent.push_back(e);
+            }
+        }
+        std::sort(recent.begin(), recent.end());
+        ids->reserve(ids->size() + static_cast<std::size_t>(end - begin) + recent.size());
+        auto r = recent.begin();
+        for (const Entry* e = begin; e != end; ++e) {
+            for (; r != recent.end() && *r < *e; ++r) {
+                ids->push_back(r->recordId);
+            }
+            ids->push_back(e->recordId);
+        }
+        for (; r != recent.end(); ++r) {
+            ids->push_back(r->recordId);
+        }
+    }
+
+    ///
+    /// \brief Merges unpersisted entries into index file (written to temporary file and renamed)
+    ///
+    void persist(uint64_t logId, uint64_t watermark)
+    {
+        if (m_map != nullptr && m_unpersisted.empty() && m_watermark == watermark) {
+            return;
+        }
+        std::sort(m_unpersisted.begin(), m_unpersisted.end());
+        const std::string tmpPath = m_path + ".tmp";
+        int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw LicenseException("Failed to write license store index " + tmpPath);
+        }
+        const uint64_t header[4] = { kIndexMagic, logId, watermark, m_count + m_unpersisted.size() };
+        bool ok = writeFully(fd, header, sizeof(header), 0);
+        uint64_t offset = sizeof(header);
+        std::vector<Entry> buffer;
+        buffer.reserve(4096);
+        const Entry* mapped = m_entries;
+        const Entry* mappedEnd = m_entries + m_count;
+        auto recent = m_unpersisted.begin();
+        while (ok && (mapped != mappedEnd || recent != m_unpersisted.end())) {
+            if (recent == m_unpersisted.end() || (mapped != mappedEnd && *mapped < *recent)) {
+                buffer.push_back(*mapped++);
+            } else {
+                buffer.push_back(*recent++);
+            }
+            if (buffer.size() == buffer.capacity() || (mapped == mappedEnd && recent == m_unpersisted.end())) {
+                ok = writeFully(fd, buffer.data(), buffer.size() * sizeof(Entry), offset);
+                offset += buffer.size() * sizeof(Entry);
+                buffer.clear();
+            }
+        }
+        ok = ok && ::fsync(fd) == 0;
+        ::close(fd);
+        if (!ok || ::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+            ::unlink(tmpPath.c_str());
+            throw LicenseException("Failed to write license store index " + m_path);
+        }
+        m_unpersisted.clear();
+        if (!open(logId, watermark)) {
+            throw LicenseException("Failed to map license store index " + m_path);
+        }
+    }
+
+    inline uint64_t watermark() const
+    {
+        return m_watermark;
+    }
+
+    inline std::size_t size() const
+    {
+        return m_count + m_unpersisted.size();
+    }
+
+    inline std::size_t unpersisted() const
+    {
+        return m_unpersisted.size();
+    }
+
+private:
+    struct KeyLess
+    {
+        inline bool operator()(const Entry& e, uint64_t key) const
+        {
+            return e.key < key;
+        }
+
+        inline bool operator()(uint64_t key, const Entry& e) const
+        {
+            return key < e.key;
+        }
+    };
+
+    void unmap()
+    {
+        if (m_map != nullptr) {
+            ::munmap(m_map, m_mapSize);
+        }
+        m_map = nullptr;
+        m_mapSize = 0;
+        m_entries = nullptr;
+        m_count = 0;
+        m_watermark = 0;
+    }
+
+    std::string m_path;
+    void* m_map;
+    std::size_t m_mapSize;
+    const Entry* m_entries;
+    std::size_t m_count;
+    uint64_t m_watermark;
+    std::vector<Entry> m_unpersisted;
+};
+
+LicenseStore::LicenseStore(const std::string& directory, bool syncAppends) :
+    m_directory(directory),
+    m_syncAppends(syncAppends),
+    m_logFd(-1),
+    m_logId(0),
+    m_logSize(0)
+{
+    if (::mkdir(m_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw LicenseException("Failed to create license store directory " + m_directory);
+    }
+    for (unsigned int i = 0; i < IndexCount; ++i) {
+        m_indexes[i].reset(new Index(m_directory + "/" + kIndexFiles[i]));
+    }
+    try {
+        openLog();
+        openIndexes();
+    } catch (...) {
+        // destructor does not run, log is closed here so its lock is released
+        if (m_logFd >= 0) {
+            ::close(m_logFd);
+        }
+        throw;
+    }
+}
+
+LicenseStore::~LicenseStore()
+{
+    try {
+        flush();
+    } catch (const LicenseException&) {
+        // indexes are rebuilt from log next time
+    }
+    if (m_logFd >= 0) {
+        ::close(m_logFd);
+    }
+}
+
+void LicenseStore::openLog()
+{
+    const std::string path = m_directory + "/" + kLogFile;
+    m_logFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    struct stat st;
+    if (m_logFd < 0 || ::fstat(m_logFd, &st) != 0) {
+        throw LicenseException("Failed to open license store " + path);
+    }
+    if (::flock(m_logFd, LOCK_EX | LOCK_NB) != 0) {
+        throw LicenseException("License store " + m_directory + " is in use by another process");
+    }
+    unsigned char header[kLogHeaderSize];
+    if (static_cast<uint64_t>(st.st_size) < kLogHeaderSize) {
+        // new store (or crashed while creating it)
+        m_logId = newLogId();
+        writeU32(header, kLogMagic);
+        writeU32(header + 4, kLogVersion);
+        writeU64(header + 8, m_logId);
+        if (::ftruncate(m_logFd, 0) != 0 || !writeFully(m_logFd, header, sizeof(header), 0)
+                || ::fsync(m_logFd) != 0) {
+            throw LicenseException("Failed to create license store " + path);
+        }
+        syncDirectory(m_directory);
+        m_logSize = kLogHeaderSize;
+        return;
+    }
+    if (!readFully(m_logFd, header, sizeof(header), 0) || readU32(header) != kLogMagic
+            || readU32(header + 4) != kLogVersion) {
+        throw LicenseException("Invalid license store " + path);
+    }
+    m_logId = readU64(header + 8);
+    m_logSize = static_cast<uint64_t>(st.st_size);
+}
+
+void LicenseStore::openIndexes()
+{
+    bool usable = true;
+    for (auto& index : m_indexes) {
+        usable = index->open(m_logId, m_logSize) && index->watermark() == m_indexes[0]->watermark() && usable;
+    }
+    if (!usable) {
+        for (auto& index : m_indexes) {
+            index->reset();
+        }
+    }
+    recover(usable ? m_indexes[0]->watermark() : kLogHeaderSize);
+    if (m_indexes[0]->unpersisted() >= kMaxUnpersisted) {
+        flush();
+    }
+}
+
+uint64_t LicenseStore::recover(uint64_t from)
+{
+    RecordHeader header;
+    std::string payload;
+    uint64_t offset = from;
+    while (offset < m_logSize && readRecord(offset, &header, &payload)) {
+        index(offset, header, payload.data(), payload.data() + header.licenseeSize);
+        offset += kRecordHeaderSize + header.payloadSize;
+    }
+    if (offset < m_logSize) {
+        std::string tail(static_cast<std::size_t>(m_logSize - offset), '\0');
+        if (!readFully(m_logFd, &tail[0], tail.size(), offset)) {
+            throw LicenseException("Failed to recover license store " + m_directory);
+        }
+        // only record cut short by end of log (or zero-filled by file system) is left by crash
+        // during append, bad record that fits in log is damage and licenses after it would be lost
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(tail.data());
+        const bool torn = tail.size() < kRecordHeaderSize
+                || tail.size() - kRecordHeaderSize < readU32(p + 8)
+                || tail.find_first_not_of('\0') == std::string::npos;
+        if (!torn) {
+            throw LicenseException("Damaged license store " + m_directory + ": invalid record at offset "
+                                   + std::to_string(offset));
+        }
+        // keep a copy for inspection, named after offset so earlier copies are not replaced
+        const std::string damagedPath = m_directory + "/" + kLogFile + ".damaged." + std::to_string(offset);
+        int fd = -1;
+        for (unsigned int i = 0; fd < 0 && i < 100; ++i) {
+            const std::string candidate = i == 0 ? damagedPath : damagedPath + "." + std::to_string(i);
+            fd = ::open(candidate.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+            if (fd < 0 && errno != EEXIST) {
+                break;
+            }
+        }
+        if (fd >= 0) {
+            writeFully(fd, tail.data(), tail.size(), 0);
+            ::close(fd);
+        }
+        if (::ftruncate(m_logFd, static_cast<off_t>(offset)) != 0 || ::fsync(m_logFd) != 0) {
+            throw LicenseException("Failed to recover license store " + m_directory);
+        }
+        m_logSize = offset;
+    }
+    return offset;
+}
+
+void LicenseStore::index(RecordId id, const RecordHeader& header, const char* licensee, const char* authority)
+{
+    m_indexes[LicenseeIndex]->add(hashName(licensee, header.licenseeSize), id);
+    m_indexes[AuthorityIndex]->add(hashName(authority, header.authoritySize), id);
+    m_indexes[ExpiryIndex]->add(header.expiryDate, id);
+}
+
+bool LicenseStore::readHeader(RecordId id, RecordHeader* header) const
+{
+    unsigned char buf[kRecordHeaderSize];
+    if (id < kLogHeaderSize || id > m_logSize || m_logSize - id < kRecordHeaderSize
+            || !readFully(m_logFd, buf, sizeof(buf), id) || readU32(buf) != kRecordMagic) {
+        return false;
+    }
+    header->payloadSize = readU32(buf + 8);
+    header->licenseeSize = readU32(buf + 12);
+    header->authoritySize = readU32(buf + 16);
+    header->expiryDate = readU64(buf + 24);
+    return static_cast<uint64_t>(header->licenseeSize) + header->authoritySize <= header->payloadSize
+            && m_logSize - id - kRecordHeaderSize >= header->payloadSize;
+}
+
+bool LicenseStore::readRecord(RecordId id, RecordHeader* header, std::string* payload) const
+{
+    if (!readHeader(id, header)) {
+        return false;
+    }
+    std::string record(kRecordHeaderSize + header->payloadSize, '\0');
+    if (!readFully(m_logFd, &record[0], record.size(), id)) {
+        return false;
+    }
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(record.data());
+    if (crc32(0, p + 8, record.size() - 8) != readU32(p + 4)) {
+        return false;
+    }
+    payload->assign(record, kRecordHeaderSize, std::string::npos);
+    return true;
+}
+
+LicenseStore::RecordId LicenseStore::append(const License& license)
+{
+    const std::string blob = Base64::encode(license.raw(true));
+    if (license.licensee().size() > UINT32_MAX || license.issuingAuthorityId().size() > UINT32_MAX
+            || license.licensee().size() + license.issuingAuthorityId().size() + blob.size() > UINT32_MAX) {
+        throw LicenseException("License is too large for license store");
+    }
+    std::string payload;
+    payload.reserve(license.licensee().size() + license.issuingAuthorityId().size() + blob.size());
+    payload.append(license.licensee()).append(license.issuingAuthorityId()).append(blob);
+    const std::string record = encodeRecord(static_cast<uint32_t>(license.licensee().size()),
+                                            static_cast<uint32_t>(license.issuingAuthorityId().size()),
+                                            license.expiryDate(), payload);
+    const RecordId id = m_logSize;
+    if (!writeFully(m_logFd, record.data(), record.size(), id)
+            || (m_syncAppends && ::fdatasync(m_logFd) != 0)) {
+        if (::ftruncate(m_logFd, static_cast<off_t>(id)) != 0) {
+            // next open drops partial record
+        }
+        throw LicenseException("Failed to append license to license store " + m_directory);
+    }
+    m_logSize += record.size();
+    RecordHeader header { static_cast<uint32_t>(payload.size()), static_cast<uint32_t>(license.licensee().size()),
+                          static_cast<uint32_t>(license.issuingAuthorityId().size()), license.expiryDate() };
+    index(id, header, payload.data(), payload.data() + header.licenseeSize);
+    if (m_indexes[0]->unpersisted() >= kMaxUnpersisted) {
+        flush();
+    }
+    return id;
+}
+
+License LicenseStore::get(RecordId id) const
+{
+    RecordHeader header;
+    std::string payload;
+    if (!readRecord(id, &header, &payload)) {
+        throw LicenseException("Invalid license store record " + std::to_string(id));
+    }
+    License license;
+    license.load(payload.substr(header.licenseeSize + header.authoritySize));
+    return license;
+}
+
+std::string LicenseStore::licensee(RecordId id) const
+{
+    RecordHeader header;
+    std::string licensee;
+    if (!readHeader(id, &header)) {
+        throw LicenseException("Invalid license store record " + std::to_string(id));
+    }
+    licensee.resize(header.licenseeSize);
+    if (header.licenseeSize > 0 && !readFully(m_logFd, &licensee[0], licensee.size(), id + kRecordHeaderSize)) {
+        throw LicenseException("Invalid license store record " + std::to_string(id));
+    }
+    return licensee;
+}
+
+LicenseStore::RecordIds LicenseStore::matching(IndexType type, const std::string& value) const
+{
+    RecordIds candidates;
+    m_indexes[type]->find(hashName(value.data(), value.size()), &candidates);
+    RecordIds ids;
+    ids.reserve(candidates.size());
+    RecordHeader header;
+    std::string name;
+    for (RecordId id : candidates) {
+        // rule out hash collisions without decoding license
+        if (!readHeader(id, &header)) {
+            continue;
+        }
+        const uint32_t size = type == LicenseeIndex ? header.licenseeSize : header.authoritySize;
+        const uint64_t offset = id + kRecordHeaderSize + (type == LicenseeIndex ? 0 : header.licenseeSize);
+        if (size != value.size()) {
+            continue;
+        }
+        name.resize(size);
+        if (size == 0 || (readFully(m_logFd, &name[0], size, offset) && name == value)) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+LicenseStore::RecordIds LicenseStore::findByLicensee(const std::string& licensee) const
+{
+    return matching(LicenseeIndex, licensee);
+}
+
+LicenseStore::RecordIds LicenseStore::findByAuthority(const std::string& issuingAuthorityId) const
+{
+    return matching(AuthorityIndex, issuingAuthorityId);
+}
+
+LicenseStore::RecordIds LicenseStore::findExpiring(uint64_t from, uint64_t to) const
+{
+    RecordIds ids;
+    m_indexes[ExpiryIndex]->findRange(from, to, &ids);
+    return ids;
+}
+
+std::size_t LicenseStore::size() const
+{
+    return m_indexes[ExpiryIndex]->size();
+}
+
+void LicenseStore::flush()
+{
+    for (auto& index : m_indexes) {
+        index->persist(m_logId, m_logSize);
+    }
+    syncDirectory(m_directory);
+}
+
+std::size_t LicenseStore::compact(uint64_t expiredBefore)
+{
+    const std::string path = m_directory + "/" + kLogFile;
+    const std::string tmpPath = path + ".compact";
+    int fd = ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    // compacted log replaces the locked one so it is locked before it is renamed
+    if (fd >= 0 && ::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    if (fd < 0) {
+        throw LicenseException("Failed to compact license store " + m_directory);
+    }
+    const uint64_t logId = newLogId();
+    unsigned char fileHeader[kLogHeaderSize];
+    writeU32(fileHeader, kLogMagic);
+    writeU32(fileHeader + 4, kLogVersion);
+    writeU64(fileHeader + 8, logId);
+    bool ok = writeFully(fd, fileHeader, sizeof(fileHeader), 0);
+    uint64_t size = kLogHeaderSize;
+    std::size_t removed = 0;
+    RecordHeader header;
+    std::string payload;
+    for (uint64_t offset = kLogHeaderSize; ok && offset < m_logSize;
+            offset += kRecordHeaderSize + header.payloadSize) {
+        if (!readRecord(offset, &header, &payload)) {
+            ok = false;
+            break;
+        }
+        if (header.expiryDate < expiredBefore) {
+            ++removed;
+            continue;
+        }
+        const std::string record = encodeRecord(header.licenseeSize, header.authoritySize, header.expiryDate, payload);
+        ok = writeFully(fd, record.data(), record.size(), size);
+        size += record.size();
+    }
+    ok = ok && ::fsync(fd) == 0;
+    if (!ok || ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        ::close(fd);
+        ::unlink(tmpPath.c_str());
+        throw LicenseException("Failed to compact license store " + m_directory);
+    }
+    syncDirectory(m_directory);
+    ::close(m_logFd);
+    m_logFd = fd;
+    m_logId = logId;
+    m_logSize = size;
+    for (auto& index : m_indexes) {
+        index->reset();
+    }
+    recover(kLogHeaderSize);
+    flush();
+    return removed;
+}
+
+#else
+
+class LicenseStore::Index
+{
+};
+
+LicenseStore::LicenseStore(const std::string& directory, bool syncAppends) :
+    m_directory(directory),
+    m_syncAppends(syncAppends),
+    m_logFd(-1),
+    m_logId(0),
+    m_logSize(0)
+{
+    throw LicenseException("License store is only available on unix");
+}
+
+LicenseStore::~LicenseStore()
+{
+}
+
+LicenseStore::RecordId LicenseStore::append(const License&)
+{
+    return 0;
+}
+
+License LicenseStore::get(RecordId) const
+{
+    return License();
+}
+
+std::string LicenseStore::licensee(RecordId) const
+{
+    return "";
+}
+
+LicenseStore::RecordIds LicenseStore::findByLicensee(const std::string&) const
+{
+    return RecordIds();
+}
+
+LicenseStore::RecordIds LicenseStore::findByAuthority(const std::string&) const
+{
+    return RecordIds();
+}
+
+LicenseStore::RecordIds LicenseStore::findExpiring(uint64_t, uint64_t) const
+{
+    return RecordIds();
+}
+
+std::size_t LicenseStore::size() const
+{
+    return 0;
+}
+
+void LicenseStore::flush()
+{
+}
+
+std::size_t LicenseStore::compact(uint64_t)
+{
+    return 0;
+}
+
+#endif // LICENSEPP_OS_UNIX
@@ -0,0 +1,216 @@
+//
+//  license-table-kernels.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include "src/license-table-kernels.h"
+
+#if LICENSEPP_HAS_AVX2_KERNELS
+#   include <immintrin.h>
+#endif
+
+using namespace licensepp;
+
+// Range check from <= e < to is done as single unsigned compare (e - from) < (to - from)
+// which is valid as long as from < to (callers return early otherwise)
+
+std::size_t LicenseTableKernels::expiringScalar(const uint64_t* expiry, std::size_t n,
+                                                uint64_t from, uint64_t to, uint32_t* out)
+{
+    if (from >= to) {
+        return 0;
+    }
+    const uint64_t width = to - from;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        // branchless so it is not at mercy of data distribution
+        out[count] = static_cast<uint32_t>(i);
+        count += (expiry[i] - from) < width;
+    }
+    return count;
+}
+
+std::size_t LicenseTableKernels::expiringFromScalar(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                                    uint64_t from, uint64_t to, uint16_t code, uint32_t* out)
+{
+    if (from >= to) {
+        return 0;
+    }
+    const uint64_t width = to - from;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[count] = static_cast<uint32_t>(i);
+        count += ((expiry[i] - from) < width) & (codes[i] == code);
+    }
+    return count;
+}
+
+std::size_t LicenseTableKernels::authorityScalar(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[count] = static_cast<uint32_t>(i);
+        count += codes[i] == code;
+    }
+    return count;
+}
+
+#if LICENSEPP_HAS_AVX2_KERNELS
+
+namespace {
+
+///
+/// \brief Appends base + position of every set bit in mask
+///
+inline std::size_t emit(uint32_t mask, uint32_t base, uint32_t* out)
+{
+    std::size_t count = 0;
+    while (mask != 0) {
+        out[count++] = base + static_cast<uint32_t>(__builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+// AVX2 only has signed 64-bit compare, flipping sign bit turns it into unsigned one
+
+__attribute__((target("avx2")))
+inline __m256i inRange(const uint64_t* expiry, __m256i from, __m256i widthFlipped, __m256i signBit)
+{
+    const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(expiry));
+    const __m256i offset = _mm256_xor_si256(_mm256_sub_epi64(e, from), signBit);
+    return _mm256_cmpgt_epi64(widthFlipped, offset);
+}
+
+__attribute__((target("avx2")))
+inline uint32_t laneMask(__m256i v)
+{
+    return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+}
+}
+
+__attribute__((target("avx2")))
+std::size_t LicenseTableKernels::expiringAvx2(const uint64_t* expiry, std::size_t n,
+                                              uint64_t from, uint64_t to, uint32_t* out)
+{
+    if (from >= to) {
+        return 0;
+    }
+    const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+    const __m256i fromV = _mm256_set1_epi64x(static_cast<long long>(from));
+    const __m256i widthFlipped = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(to - from)), signBit);
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const uint32_t mask = laneMask(inRange(expiry + i, fromV, widthFlipped, signBit))
+                | laneMask(inRange(expiry + i + 4, fromV, widthFlipped, signBit)) << 4
+                | laneMask(inRange(expiry + i + 8, fromV, widthFlipped, signBit)) << 8
+                | laneMask(inRange(expiry + i + 12, fromV, widthFlipped, signBit)) << 12;
+        count += emit(mask, static_cast<uint32_t>(i), out + count);
+    }
+    const std::size_t tail = expiringScalar(expiry + i, n - i, from, to, out + count);
+    for (std::size_t j = count; j < count + tail; ++j) {
+        out[j] += static_cast<uint32_t>(i);
+    }
+    return count + tail;
+}
+
+__attribute__((target("avx2")))
+std::size_t LicenseTableKernels::expiringFromAvx2(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                                  uint64_t from, uint64_t to, uint16_t code, uint32_t* out)
+{
+    if (from >= to) {
+        return 0;
+    }
+    const __m256i signBit = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ULL));
+    const __m256i fromV = _mm256_set1_epi64x(static_cast<long long>(from));
+    const __m256i widthFlipped = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(to - from)), signBit);
+    const __m256i codeV = _mm256_set1_epi64x(code);
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // four 16-bit codes widened to match 64-bit expiry lanes
+        const __m256i c = _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes + i)));
+        const __m256i match = _mm256_and_si256(inRange(expiry + i, fromV, widthFlipped, signBit),
+                                               _mm256_cmpeq_epi64(c, codeV));
+        count += emit(laneMask(match), static_cast<uint32_t>(i), out + count);
+    }
+    const std::size_t tail = expiringFromScalar(expiry + i, codes + i, n - i, from, to, code, out + count);
+    for (std::size_t j = count; j < count + tail; ++j) {
+        out[j] += static_cast<uint32_t>(i);
+    }
+    return count + tail;
+}
+
+__attribute__((target("avx2")))
+std::size_t LicenseTableKernels::authorityAvx2(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out)
+{
+    const __m256i codeV = _mm256_set1_epi16(static_cast<short>(code));
+    std::size_t count = 0;
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+        // byte mask, two bits per 16-bit lane so keep even bits only
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(c, codeV))) & 0x55555555U;
+        while (mask != 0) {
+            out[count++] = static_cast<uint32_t>(i) + static_cast<uint32_t>(__builtin_ctz(mask) >> 1);
+            mask &= mask - 1;
+        }
+    }
+    const std::size_t tail = authorityScalar(codes + i, n - i, code, out + count);
+    for (std::size_t j = count; j < count + tail; ++j) {
+        out[j] += static_cast<uint32_t>(i);
+    }
+    return count + tail;
+}
+
+bool LicenseTableKernels::avx2Supported()
+{
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#else
+
+bool LicenseTableKernels::avx2Supported()
+{
+    return false;
+}
+
+#endif // LICENSEPP_HAS_AVX2_KERNELS
+
+std::size_t LicenseTableKernels::expiring(const uint64_t* expiry, std::size_t n,
+                                          uint64_t from, uint64_t to, uint32_t* out)
+{
+#if LICENSEPP_HAS_AVX2_KERNELS
+    if (avx2Supported()) {
+        return expiringAvx2(expiry, n, from, to, out);
+    }
+#endif
+    return expiringScalar(expiry, n, from, to, out);
+}
+
+std::size_t LicenseTableKernels::expiringFrom(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                              uint64_t from, uint64_t to, uint16_t code, uint32_t* out)
+{
+#if LICENSEPP_HAS_AVX2_KERNELS
+    if (avx2Supported()) {
+        return expiringFromAvx2(expiry, codes, n, from, to, code, out);
+    }
+#endif
+    return expiringFromScalar(expiry, codes, n, from, to, code, out);
+}
+
+std::size_t LicenseTableKernels::authority(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out)
+{
+#if LICENSEPP_HAS_AVX2_KERNELS
+    if (avx2Supported()) {
+        return authorityAvx2(codes, n, code, out);
+    }
+#endif
+    return authorityScalar(codes, n, code, out);
+}
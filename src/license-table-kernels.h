@@ -0,0 +1,72 @@
+//
+//  license-table-kernels.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_LicenseTableKernels_h
+#define LICENSEPP_LicenseTableKernels_h
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#   define LICENSEPP_HAS_AVX2_KERNELS 1
+#else
+#   define LICENSEPP_HAS_AVX2_KERNELS 0
+#endif
+
+namespace licensepp {
+
+///
+/// \brief Column scans used by LicenseTable filters
+///
+/// Every kernel writes ids of matching rows (ascending) to out, which must have room
+/// for n ids, and returns number of matches. Scalar and AVX2 variants produce identical
+/// output, the AVX2 ones must only be called when avx2Supported() is true.
+///
+class LicenseTableKernels
+{
+public:
+    ///
+    /// \brief from <= expiry[i] < to
+    ///
+    static std::size_t expiringScalar(const uint64_t* expiry, std::size_t n,
+                                      uint64_t from, uint64_t to, uint32_t* out);
+
+    ///
+    /// \brief from <= expiry[i] < to && codes[i] == code
+    ///
+    static std::size_t expiringFromScalar(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                          uint64_t from, uint64_t to, uint16_t code, uint32_t* out);
+
+    static std::size_t authorityScalar(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out);
+
+#if LICENSEPP_HAS_AVX2_KERNELS
+    static std::size_t expiringAvx2(const uint64_t* expiry, std::size_t n,
+                                    uint64_t from, uint64_t to, uint32_t* out);
+
+    static std::size_t expiringFromAvx2(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                        uint64_t from, uint64_t to, uint16_t code, uint32_t* out);
+
+    static std::size_t authorityAvx2(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out);
+#endif
+
+    ///
+    /// \brief Whether CPU (and build) supports AVX2 kernels, checked once
+    ///
+    static bool avx2Supported();
+
+    // dispatching to AVX2 or scalar kernels
+    static std::size_t expiring(const uint64_t* expiry, std::size_t n,
+                                uint64_t from, uint64_t to, uint32_t* out);
+    static std::size_t expiringFrom(const uint64_t* expiry, const uint16_t* codes, std::size_t n,
+                                    uint64_t from, uint64_t to, uint16_t code, uint32_t* out);
+    static std::size_t authority(const uint16_t* codes, std::size_t n, uint16_t code, uint32_t* out);
+};
+}
+
+#endif /* LICENSEPP_LicenseTableKernels_h */
@@ -0,0 +1,141 @@
+//
+//  license-table.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <limits>
+#include <license++/license-table.h>
+#include <license++/license-exception.h>
+#include "src/license-table-kernels.h"
+
+using namespace licensepp;
+
+const uint16_t LicenseTable::kUnknownAuthority;
+
+LicenseTable::LicenseTable()
+{
+}
+
+void LicenseTable::reserve(std::size_t rows)
+{
+    m_issueDates.reserve(rows);
+    m_expiryDates.reserve(rows);
+    m_authorityCodes.reserve(rows);
+    m_keyIds.reserve(rows);
+    for (auto& strings : m_strings) {
+        strings.reserve(rows);
+    }
+}
+
+LicenseTable::RowId LicenseTable::append(const License& license)
+{
+    if (size() >= std::numeric_limits<RowId>::max()) {
+        throw LicenseException("License table is full");
+    }
+    uint16_t code;
+    auto iter = m_authorityCodeMap.find(license.issuingAuthorityId());
+    if (iter != m_authorityCodeMap.end()) {
+        code = iter->second;
+    } else {
+        if (m_authorityIds.size() >= kUnknownAuthority) {
+            throw LicenseException("Too many issuing authorities in license table");
+        }
+        code = static_cast<uint16_t>(m_authorityIds.size());
+        m_authorityIds.push_back(license.issuingAuthorityId());
+        m_authorityCodeMap.emplace(license.issuingAuthorityId(), code);
+    }
+    const RowId row = static_cast<RowId>(size());
+    appendString(Licensee, license.licensee());
+    appendString(LicenseeSignature, license.licenseeSignature());
+    appendString(AuthoritySignature, license.authoritySignature());
+    appendString(AdditionalPayload, license.additionalPayload());
+    appendString(BatchProof, license.batchProof());
+    m_issueDates.push_back(license.issueDate());
+    m_expiryDates.push_back(license.expiryDate());
+    m_authorityCodes.push_back(code);
+    m_keyIds.push_back(license.keyId());
+    if (!license.entitlements().empty()) {
+        m_entitlements.emplace(row, license.entitlements());
+    }
+    return row;
+}
+
+void LicenseTable::appendString(StringField field, const std::string& value)
+{
+    if (value.size() > std::numeric_limits<uint32_t>::max()) {
+        throw LicenseException("License field is too large for license table");
+    }
+    m_strings[field].push_back(Span { m_stringPool.size(), static_cast<uint32_t>(value.size()) });
+    m_stringPool.append(value);
+}
+
+std::string LicenseTable::string(RowId row, StringField field) const
+{
+    const Span& span = m_strings[field].at(row);
+    return m_stringPool.substr(span.offset, span.size);
+}
+
+License LicenseTable::row(RowId row) const
+{
+    License license;
+    license.setLicensee(string(row, Licensee));
+    license.setIssuingAuthorityId(m_authorityIds[m_authorityCodes.at(row)]);
+    license.setLicenseeSignature(string(row, LicenseeSignature));
+    license.setAuthoritySignature(string(row, AuthoritySignature));
+    license.setAdditionalPayload(string(row, AdditionalPayload));
+    license.setBatchProof(string(row, BatchProof));
+    license.setIssueDate(m_issueDates[row]);
+    license.setExpiryDate(m_expiryDates[row]);
+    license.setKeyId(m_keyIds[row]);
+    auto iter = m_entitlements.find(row);
+    if (iter != m_entitlements.end()) {
+        license.setEntitlements(iter->second);
+    }
+    return license;
+}
+
+uint16_t LicenseTable::authorityCode(const std::string& issuingAuthorityId) const
+{
+    auto iter = m_authorityCodeMap.find(issuingAuthorityId);
+    return iter == m_authorityCodeMap.end() ? kUnknownAuthority : iter->second;
+}
+
+LicenseTable::Selection LicenseTable::selectExpiring(uint64_t from, uint64_t to) const
+{
+    Selection selection(size());
+    selection.resize(LicenseTableKernels::expiring(expiryDates(), size(), from, to, selection.data()));
+    return selection;
+}
+
+LicenseTable::Selection LicenseTable::selectExpiring(uint64_t from, uint64_t to,
+                                                     const std::string& issuingAuthorityId) const
+{
+    const uint16_t code = authorityCode(issuingAuthorityId);
+    if (code == kUnknownAuthority) {
+        return Selection();
+    }
+    Selection selection(size());
+    selection.resize(LicenseTableKernels::expiringFrom(expiryDates(), authorityCodes(), size(),
+                                                       from, to, code, selection.data()));
+    return selection;
+}
+
+LicenseTable::Selection LicenseTable::selectByAuthority(const std::string& issuingAuthorityId) const
+{
+    const uint16_t code = authorityCode(issuingAuthorityId);
+    if (code == kUnknownAuthority) {
+        return Selection();
+    }
+    Selection selection(size());
+    selection.resize(LicenseTableKernels::authority(authorityCodes(), size(), code, selection.data()));
+    return selection;
+}
+
+bool LicenseTable::simdEnabled()
+{
+    return LicenseTableKernels::avx2Supported();
+}
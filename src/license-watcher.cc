@@ -0,0 +1,247 @@
+//
+//  license-watcher.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <iostream>
+#include <license++/license-watcher.h>
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <fcntl.h>
+#   include <poll.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+#if LICENSEPP_OS_LINUX
+#   include <sys/inotify.h>
+#endif
+
+using namespace licensepp;
+
+#if LICENSEPP_OS_UNIX
+namespace {
+
+inline std::string baseName(const std::string& path)
+{
+    const std::size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+///
+/// \brief Watches directory of the file so that file replaced by rename is also seen
+/// \return inotify descriptor or -1 if modification time must be polled instead
+///
+int openInotify(const std::string& path)
+{
+#   if LICENSEPP_OS_LINUX
+    std::string directory = ".";
+    const std::size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos) {
+        directory = slash == 0 ? "/" : path.substr(0, slash);
+    }
+    int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0 && ::inotify_add_watch(fd, directory.c_str(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    return fd;
+#   else
+    (void) path;
+    return -1;
+#   endif // LICENSEPP_OS_LINUX
+}
+
+///
+/// \brief Identity of current file contents (0 if file does not exist)
+///
+uint64_t fileStamp(const std::string& path)
+{
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    uint64_t stamp = 14695981039346656037ULL;
+    const uint64_t fields[] = {
+        static_cast<uint64_t>(st.st_mtime),
+        static_cast<uint64_t>(st.st_ino),
+        static_cast<uint64_t>(st.st_size),
+    };
+    for (uint64_t field : fields) {
+        stamp = (stamp ^ field) * 1099511628211ULL;
+    }
+    return stamp == 0 ? 1 : stamp;
+}
+}
+#endif // LICENSEPP_OS_UNIX
+
+LicenseWatcher::LicenseWatcher(const std::string& licenseFile, Validator validator) :
+    m_licenseFile(licenseFile),
+    m_validator(std::move(validator)),
+    m_licensed(false),
+    m_generation(0)
+{
+    m_wakeupPipe[0] = -1;
+    m_wakeupPipe[1] = -1;
+#if LICENSEPP_OS_UNIX
+    if (::pipe(m_wakeupPipe) != 0) {
+        m_wakeupPipe[0] = -1;
+        m_wakeupPipe[1] = -1;
+    }
+#endif
+}
+
+LicenseWatcher::~LicenseWatcher()
+{
+    stop();
+#if LICENSEPP_OS_UNIX
+    if (m_wakeupPipe[0] >= 0) {
+        ::close(m_wakeupPipe[0]);
+        ::close(m_wakeupPipe[1]);
+    }
+#endif
+}
+
+bool LicenseWatcher::start()
+{
+#if LICENSEPP_OS_UNIX
+    if (!m_thread.joinable() && m_wakeupPipe[0] >= 0) {
+        // watch is set up before first validation so changes in between are not missed
+        const int inotifyFd = openInotify(m_licenseFile);
+        const uint64_t stamp = fileStamp(m_licenseFile);
+        const bool result = revalidate();
+        m_thread = std::thread(&LicenseWatcher::watch, this, inotifyFd, stamp);
+        return result;
+    }
+#endif
+    return revalidate();
+}
+
+void LicenseWatcher::stop()
+{
+    if (!m_thread.joinable()) {
+        return;
+    }
+#if LICENSEPP_OS_UNIX
+    const char c = 'x';
+    while (::write(m_wakeupPipe[1], &c, 1) < 0 && errno == EINTR) {
+    }
+#endif
+    m_thread.join();
+#if LICENSEPP_OS_UNIX
+    char buf[16];
+    // drain the pipe so watcher can be started again
+    ::fcntl(m_wakeupPipe[0], F_SETFL, ::fcntl(m_wakeupPipe[0], F_GETFL) | O_NONBLOCK);
+    while (::read(m_wakeupPipe[0], buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+bool LicenseWatcher::revalidate()
+{
+    std::lock_guard<std::mutex> lock(m_revalidateMutex);
+    std::shared_ptr<License> license = std::make_shared<License>();
+    bool loaded = false;
+    bool valid = false;
+    try {
+        loaded = license->loadFromFile(m_licenseFile);
+        valid = loaded && m_validator(*license);
+    } catch (const std::exception& e) {
+        std::cerr << "Failed to validate license " << m_licenseFile << ": " << e.what() << std::endl;
+        valid = false;
+    }
+    std::shared_ptr<const License> snapshot;
+    if (loaded) {
+        snapshot = license;
+    }
+    std::atomic_store(&m_license, snapshot);
+    m_licensed.store(valid, std::memory_order_release);
+    m_generation.fetch_add(1, std::memory_order_relaxed);
+    return valid;
+}
+
+int64_t LicenseWatcher::msUntilExpiry() const
+{
+    std::shared_ptr<const License> license = this->license();
+    if (license == nullptr || !isLicensed()) {
+        return -1;
+    }
+    // validate() uses same clock and only fails once expiry date has passed
+    const int64_t now = static_cast<int64_t>(Utils::nowUtc());
+    const int64_t expiry = static_cast<int64_t>(license->expiryDate()) + 1;
+    return expiry <= now ? 0 : (expiry - now) * 1000;
+}
+
+void LicenseWatcher::watch(int inotifyFd, uint64_t lastStamp)
+{
+#if LICENSEPP_OS_UNIX
+    const std::string filename = baseName(m_licenseFile);
+
+    while (true) {
+        const int64_t untilExpiry = msUntilExpiry();
+        int timeout;
+        if (inotifyFd >= 0) {
+            timeout = untilExpiry < 0 ? -1 : static_cast<int>(std::min<int64_t>(untilExpiry, INT_MAX));
+        } else {
+            // without inotify, file is checked every second
+            timeout = untilExpiry < 0 ? 1000 : static_cast<int>(std::min<int64_t>(untilExpiry, 1000));
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = m_wakeupPipe[0];
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = inotifyFd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        const int ready = ::poll(fds, inotifyFd >= 0 ? 2 : 1, timeout);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (fds[0].revents != 0) {
+            break; // stop()
+        }
+
+        bool changed = false;
+#   if LICENSEPP_OS_LINUX
+        if (inotifyFd >= 0 && (fds[1].revents & POLLIN) != 0) {
+            alignas(struct inotify_event) char buf[4096];
+            ssize_t len;
+            while ((len = ::read(inotifyFd, buf, sizeof(buf))) > 0) {
+                for (char* p = buf; p < buf + len; ) {
+                    const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(p);
+                    if (event->len > 0 && filename == event->name) {
+                        changed = true;
+                    }
+                    p += sizeof(struct inotify_event) + event->len;
+                }
+            }
+        }
+#   endif // LICENSEPP_OS_LINUX
+        if (inotifyFd < 0) {
+            const uint64_t stamp = fileStamp(m_licenseFile);
+            changed = stamp != lastStamp;
+            lastStamp = stamp;
+        }
+
+        if (changed || (untilExpiry >= 0 && msUntilExpiry() == 0)) {
+            revalidate();
+        }
+    }
+
+    if (inotifyFd >= 0) {
+        ::close(inotifyFd);
+    }
+#else
+    (void) inotifyFd;
+    (void) lastStamp;
+#endif // LICENSEPP_OS_UNIX
+}
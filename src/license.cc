@@ -9,49 +9,141 @@
 
 #include <ctime>
 #include <fstream>
+#include <iostream>
 #include <iterator>
+#include <thread>
 #include <license++/license.h>
 #include <license++/license-exception.h>
+#include "src/calendar.h"
 #include "src/crypto/base64.h"
-#include "src/json-object.h"
+#include "src/probes.h"
+#include "src/tracing.h"
 #include "src/utils.h"
 
 using namespace licensepp;
 
+namespace {
+const int kRawEmpty = 0;
+const int kRawBuilding = 1;
+const int kRawReady = 2;
+}
+
 License::License() :
     m_issueDate(0),
-    m_expiryDate(0)
+    m_expiryDate(0),
+    m_keyId(0)
 {
+    m_rawState[0].store(kRawEmpty, std::memory_order_relaxed);
+    m_rawState[1].store(kRawEmpty, std::memory_order_relaxed);
 }
 
 License::License(const License& other):
     m_issueDate(other.m_issueDate),
     m_expiryDate(other.m_expiryDate),
+    m_keyId(other.m_keyId),
     m_licensee(other.m_licensee),
     m_issuingAuthorityId(other.m_issuingAuthorityId),
     m_licenseeSignature(other.m_licenseeSignature),
     m_authoritySignature(other.m_authoritySignature),
-    m_additionalPayload(other.m_additionalPayload)
+    m_batchProof(other.m_batchProof),
+    m_additionalPayload(other.m_additionalPayload),
+    m_entitlements(other.m_entitlements)
+{
+    copyRaw(other);
+}
+
+License::License(License&& other) noexcept :
+    m_issueDate(other.m_issueDate),
+    m_expiryDate(other.m_expiryDate),
+    m_keyId(other.m_keyId),
+    m_licensee(std::move(other.m_licensee)),
+    m_issuingAuthorityId(std::move(other.m_issuingAuthorityId)),
+    m_licenseeSignature(std::move(other.m_licenseeSignature)),
+    m_authoritySignature(std::move(other.m_authoritySignature)),
+    m_batchProof(std::move(other.m_batchProof)),
+    m_additionalPayload(std::move(other.m_additionalPayload)),
+    m_entitlements(std::move(other.m_entitlements))
+{
+    moveRaw(other);
+}
+
+License& License::operator=(const License& other)
 {
+    if (this != &other) {
+        m_issueDate = other.m_issueDate;
+        m_expiryDate = other.m_expiryDate;
+        m_keyId = other.m_keyId;
+        m_licensee = other.m_licensee;
+        m_issuingAuthorityId = other.m_issuingAuthorityId;
+        m_licenseeSignature = other.m_licenseeSignature;
+        m_authoritySignature = other.m_authoritySignature;
+        m_batchProof = other.m_batchProof;
+        m_additionalPayload = other.m_additionalPayload;
+        m_entitlements = other.m_entitlements;
+        copyRaw(other);
+    }
+    return *this;
 }
 
-License& License::operator=(License other)
+License& License::operator=(License&& other) noexcept
 {
-    std::swap(m_issueDate, other.m_issueDate);
-    std::swap(m_expiryDate, other.m_expiryDate);
-    std::swap(m_licensee, other.m_licensee);
-    std::swap(m_licenseeSignature, other.m_licenseeSignature);
-    std::swap(m_issuingAuthorityId, other.m_issuingAuthorityId);
-    std::swap(m_authoritySignature, other.m_authoritySignature);
-    std::swap(m_additionalPayload, other.m_additionalPayload);
+    m_issueDate = other.m_issueDate;
+    m_expiryDate = other.m_expiryDate;
+    m_keyId = other.m_keyId;
+    m_licensee = std::move(other.m_licensee);
+    m_issuingAuthorityId = std::move(other.m_issuingAuthorityId);
+    m_licenseeSignature = std::move(other.m_licenseeSignature);
+    m_authoritySignature = std::move(other.m_authoritySignature);
+    m_batchProof = std::move(other.m_batchProof);
+    m_additionalPayload = std::move(other.m_additionalPayload);
+    m_entitlements = std::move(other.m_entitlements);
+    moveRaw(other);
     return *this;
 }
 
+void License::copyRaw(const License& other)
+{
+    // raw bytes that are still being built by other thread are not copied
+    for (int i = 0; i < 2; ++i) {
+        if (other.m_rawState[i].load(std::memory_order_acquire) == kRawReady) {
+            m_raw[i] = other.m_raw[i];
+            m_rawState[i].store(kRawReady, std::memory_order_relaxed);
+        } else {
+            m_rawState[i].store(kRawEmpty, std::memory_order_relaxed);
+        }
+    }
+}
+
+void License::moveRaw(License& other) noexcept
+{
+    for (int i = 0; i < 2; ++i) {
+        if (other.m_rawState[i].load(std::memory_order_acquire) == kRawReady) {
+            m_raw[i] = std::move(other.m_raw[i]);
+            m_rawState[i].store(kRawReady, std::memory_order_relaxed);
+        } else {
+            m_rawState[i].store(kRawEmpty, std::memory_order_relaxed);
+        }
+        other.m_rawState[i].store(kRawEmpty, std::memory_order_relaxed);
+    }
+}
+
+void License::keepRaw(const char* json, std::size_t size)
+{
+    m_rawState[0].store(kRawEmpty, std::memory_order_relaxed);
+    m_raw[1].assign(json, size);
+    m_rawState[1].store(kRawReady, std::memory_order_release);
+}
+
 std::string License::formattedExpiry() const
 {
-    struct timeval tval;
-    tval.tv_sec = static_cast<long>(m_expiryDate);
-    return Utils::timevalToString(tval, "%d %b, %Y %H:%m UTC");
+    char buf[32];
+    const std::size_t len = formattedExpiry(buf, sizeof(buf));
+    return std::string(buf, len < sizeof(buf) ? len : sizeof(buf) - 1);
+}
+
+std::size_t License::formattedExpiry(char* buf, std::size_t size) const
+{
+    return Calendar::format(static_cast<int64_t>(m_expiryDate), 0, "%d %b, %Y %H:%m UTC", buf, size);
 }
 
 std::string License::toString()
@@ -59,49 +151,76 @@ std::string License::toString()
     return Base64::encode(raw(true));
 }
 
-std::string License::raw(bool full) const
+const std::string& License::raw(bool full) const
 {
-    JsonObject::Json j;
-    j["licensee"] = m_licensee;
-    if (!m_licenseeSignature.empty()) {
-        j["licensee_signature"] = m_licenseeSignature;
+    const int i = full ? 1 : 0;
+    if (m_rawState[i].load(std::memory_order_acquire) == kRawReady) {
+        return m_raw[i];
     }
-    j["issue_date"] = m_issueDate;
-    j["expiry_date"] = m_expiryDate;
-    j["issuing_authority"] = m_issuingAuthorityId;
-
-    if (full) {
-        j["authority_signature"] = m_authoritySignature;
+    while (true) {
+        int expected = kRawEmpty;
+        if (m_rawState[i].compare_exchange_strong(expected, kRawBuilding, std::memory_order_acq_rel)) {
+            try {
+                m_raw[i] = serialize(full);
+            } catch (...) {
+                m_rawState[i].store(kRawEmpty, std::memory_order_release);
+                throw;
+            }
+            m_rawState[i].store(kRawReady, std::memory_order_release);
+            return m_raw[i];
+        }
+        // other thread is serializing the same license, if it fails (throws) state goes
+        // back to empty and this thread tries (and throws) itself
+        while (expected == kRawBuilding) {
+            std::this_thread::yield();
+            expected = m_rawState[i].load(std::memory_order_acquire);
+        }
+        if (expected == kRawReady) {
+            return m_raw[i];
+        }
     }
+}
 
-    if (!m_additionalPayload.empty()) {
-        j["additional_payload"] = m_additionalPayload;
+bool License::load(const std::string& licenseBase64)
+{
+    const LicenseError error = tryLoad(licenseBase64);
+    if (error != LicenseError::None) {
+        throw LicenseException("Failed to load the license: " + std::string(licenseErrorMessage(error)));
     }
-    return j.dump();
+    return true;
 }
 
-bool License::load(const std::string& licenseBase64)
+LicenseError License::tryLoad(const std::string& licenseBase64) noexcept
 {
-    try {
-        const std::string jsonLicense = Base64::decode(licenseBase64);
+    LICENSEPP_TRACE_SPAN(span, "license.load");
+    LICENSEPP_PROBE1(license__load__entry, licenseBase64.size());
+    const LicenseError error = parse(licenseBase64);
+    if (error == LicenseError::None) {
+        LICENSEPP_TRACE_AUTHORITY(span, m_issuingAuthorityId);
+    }
+    LICENSEPP_TRACE_RESULT(span, error == LicenseError::None);
+    LICENSEPP_PROBE3(license__load__return, error == LicenseError::None ? m_issuingAuthorityId.c_str() : "",
+                     error == LicenseError::None ? 1 : 0, licenseBase64.size());
+    return error;
+}
 
-        JsonObject::Json j = JsonObject::Json::parse(jsonLicense);
-        setLicensee(j["licensee"].get<std::string>());
-        setIssuingAuthorityId(j["issuing_authority"].get<std::string>());
-        if (j.count("licensee_signature") > 0) {
-            setLicenseeSignature(j["licensee_signature"].get<std::string>());
-        }
-        setIssueDate(j["issue_date"].get<uint64_t>());
-        setExpiryDate(j["expiry_date"].get<uint64_t>());
-        setAuthoritySignature(j["authority_signature"].get<std::string>());
-        if (j.count("additional_payload") > 0) {
-            setAdditionalPayload(j["additional_payload"].get<std::string>());
-        }
-        return true;
-    } catch (const std::exception& e) {
-        throw LicenseException("Failed to load the license: " + std::string(e.what()));
+LicenseError License::parse(const std::string& licenseBase64) noexcept
+{
+    std::string jsonLicense;
+    LICENSEPP_TRACE_SPAN(decodeSpan, "base64.decode");
+    const bool decoded = Base64::decode(licenseBase64, &jsonLicense);
+    LICENSEPP_TRACE_END(decodeSpan);
+    if (!decoded) {
+        return LicenseError::InvalidBase64;
     }
-    return false;
+    const LicenseError error = deserialize(jsonLicense);
+    if (error != LicenseError::None) {
+        return error;
+    }
+    // keep exact bytes received so they are not serialized again
+    m_raw[1] = std::move(jsonLicense);
+    m_rawState[1].store(kRawReady, std::memory_order_release);
+    return LicenseError::None;
 }
 
 bool License::loadFromFile(const std::string& licenseFile)
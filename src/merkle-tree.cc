@@ -0,0 +1,183 @@
+//
+//  merkle-tree.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <cstdlib>
+#include <license++/license-exception.h>
+#include "src/crypto/sha256.h"
+#include "src/merkle-tree.h"
+
+using namespace licensepp;
+
+namespace {
+
+const char* kHexDigits = "0123456789abcdef";
+
+void appendHex(const std::string& raw, std::string* out)
+{
+    for (unsigned char c : raw) {
+        out->push_back(kHexDigits[c >> 4]);
+        out->push_back(kHexDigits[c & 0x0f]);
+    }
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool parseNumber(const std::string& str, std::size_t begin, std::size_t end, uint32_t* value)
+{
+    if (begin >= end || end - begin > 10) {
+        return false;
+    }
+    uint64_t result = 0;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (str[i] < '0' || str[i] > '9') {
+            return false;
+        }
+        result = result * 10 + static_cast<uint64_t>(str[i] - '0');
+    }
+    if (result > 0xffffffffULL) {
+        return false;
+    }
+    *value = static_cast<uint32_t>(result);
+    return true;
+}
+}
+
+MerkleTree::MerkleTree(std::vector<std::string>&& leaves)
+{
+    if (leaves.empty()) {
+        throw LicenseException("Merkle tree needs at least one leaf");
+    }
+    m_levels.push_back(std::move(leaves));
+    while (m_levels.back().size() > 1) {
+        const std::vector<std::string>& level = m_levels.back();
+        std::vector<std::string> parents;
+        parents.reserve((level.size() + 1) / 2);
+        for (std::size_t i = 0; i + 1 < level.size(); i += 2) {
+            parents.push_back(nodeHash(level[i], level[i + 1]));
+        }
+        if (level.size() % 2 == 1) {
+            parents.push_back(level.back());
+        }
+        m_levels.push_back(std::move(parents));
+    }
+}
+
+const std::string& MerkleTree::root() const
+{
+    return m_levels.back().front();
+}
+
+std::string MerkleTree::proof(uint32_t index) const
+{
+    const std::size_t size = m_levels.front().size();
+    if (index >= size) {
+        throw LicenseException("Merkle leaf index out of range");
+    }
+    std::string result = std::to_string(index) + "/" + std::to_string(size) + ":";
+    std::size_t position = index;
+    for (std::size_t i = 0; i + 1 < m_levels.size(); ++i) {
+        const std::size_t sibling = position ^ 1;
+        // promoted node has no sibling on this level
+        if (sibling < m_levels[i].size()) {
+            appendHex(m_levels[i][sibling], &result);
+        }
+        position >>= 1;
+    }
+    return result;
+}
+
+std::string MerkleTree::leafHash(const std::string& data)
+{
+    SHA256 sha;
+    const unsigned char prefix = 0x00;
+    sha.update(&prefix, 1);
+    sha.update(data);
+    return sha.digest();
+}
+
+std::string MerkleTree::signedRoot(const std::string& root)
+{
+    std::string result = "licensepp-batch:";
+    appendHex(root, &result);
+    return result;
+}
+
+bool MerkleTree::rootFromProof(const std::string& leaf, const std::string& proof, std::string* root)
+{
+    const std::size_t slash = proof.find('/');
+    const std::size_t colon = proof.find(':');
+    uint32_t index = 0;
+    uint32_t size = 0;
+    if (slash == std::string::npos || colon == std::string::npos || slash > colon
+            || !parseNumber(proof, 0, slash, &index) || !parseNumber(proof, slash + 1, colon, &size)
+            || index >= size) {
+        return false;
+    }
+    const std::size_t hexSize = SHA256::kDigestSize * 2;
+    if ((proof.size() - colon - 1) % hexSize != 0) {
+        return false;
+    }
+
+    // RFC 9162 2.1.3.2 inclusion proof verification
+    uint32_t fn = index;
+    uint32_t sn = size - 1;
+    std::string node = leaf;
+    std::string sibling(SHA256::kDigestSize, '\0');
+    for (std::size_t pos = colon + 1; pos < proof.size(); pos += hexSize) {
+        for (std::size_t i = 0; i < SHA256::kDigestSize; ++i) {
+            const int high = hexValue(proof[pos + 2 * i]);
+            const int low = hexValue(proof[pos + 2 * i + 1]);
+            if (high < 0 || low < 0) {
+                return false;
+            }
+            sibling[i] = static_cast<char>((high << 4) | low);
+        }
+        if (sn == 0) {
+            return false;
+        }
+        if ((fn & 1) == 1 || fn == sn) {
+            node = nodeHash(sibling, node);
+            while ((fn & 1) == 0 && fn != 0) {
+                fn >>= 1;
+                sn >>= 1;
+            }
+        } else {
+            node = nodeHash(node, sibling);
+        }
+        fn >>= 1;
+        sn >>= 1;
+    }
+    if (sn != 0) {
+        return false;
+    }
+    *root = std::move(node);
+    return true;
+}
+
+std::string MerkleTree::nodeHash(const std::string& left, const std::string& right)
+{
+    SHA256 sha;
+    const unsigned char prefix = 0x01;
+    sha.update(&prefix, 1);
+    sha.update(left);
+    sha.update(right);
+    return sha.digest();
+}
@@ -0,0 +1,65 @@
+//
+//  merkle-tree.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_MerkleTree_h
+#define LICENSEPP_MerkleTree_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace licensepp {
+
+///
+/// \brief SHA-256 Merkle tree for batch signed licenses (RFC 6962 / RFC 9162 shape)
+///
+/// Leaves are SHA-256(0x00 || license raw()), nodes are SHA-256(0x01 || left || right) and
+/// last node of a level without sibling is promoted as is. Batch root is signed once and
+/// each license carries inclusion proof:
+/// <pre>
+///   [leaf index]/[tree size]:[hex encoded sibling hashes, leaf to root]
+/// </pre>
+///
+class MerkleTree
+{
+public:
+    ///
+    /// \param leaves Leaf hashes
+    ///
+    explicit MerkleTree(std::vector<std::string>&& leaves);
+
+    const std::string& root() const;
+
+    ///
+    /// \brief Encoded inclusion proof of leaf
+    ///
+    std::string proof(uint32_t index) const;
+
+    static std::string leafHash(const std::string& data);
+
+    ///
+    /// \brief Data authority signs for batch root
+    ///
+    static std::string signedRoot(const std::string& root);
+
+    ///
+    /// \brief Root from leaf hash and encoded proof
+    /// \return False if proof is malformed
+    ///
+    static bool rootFromProof(const std::string& leaf, const std::string& proof, std::string* root);
+
+private:
+    static std::string nodeHash(const std::string& left, const std::string& right);
+
+    // levels[0] are leaves, last level is root
+    std::vector<std::vector<std::string>> m_levels;
+};
+}
+
+#endif /* LICENSEPP_MerkleTree_h */
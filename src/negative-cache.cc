@@ -0,0 +1,69 @@
+//
+//  negative-cache.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <random>
+#include <license++/license.h>
+#include <license++/negative-cache.h>
+#include "src/utils.h"
+
+using namespace licensepp;
+
+NegativeCache::NegativeCache(std::size_t capacity) :
+    m_capacity(1),
+    m_hits(0)
+{
+    std::random_device device;
+    for (uint64_t& key : m_key) {
+        key = (static_cast<uint64_t>(device()) << 32) ^ static_cast<uint64_t>(device());
+    }
+    while (m_capacity < capacity) {
+        m_capacity <<= 1;
+    }
+    m_slots.reset(new std::atomic<uint64_t>[m_capacity]);
+    clear();
+}
+
+bool NegativeCache::contains(const License* license) const
+{
+    const uint64_t d = digest(license);
+    if (m_slots[d & (m_capacity - 1)].load(std::memory_order_relaxed) != d) {
+        return false;
+    }
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void NegativeCache::insert(const License* license)
+{
+    const uint64_t d = digest(license);
+    m_slots[d & (m_capacity - 1)].store(d, std::memory_order_relaxed);
+}
+
+void NegativeCache::clear()
+{
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_slots[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t NegativeCache::size() const
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        size += m_slots[i].load(std::memory_order_relaxed) != 0 ? 1 : 0;
+    }
+    return size;
+}
+
+uint64_t NegativeCache::digest(const License* license) const
+{
+    const std::string& raw = license->raw(true);
+    const uint64_t d = Utils::sipHash(m_key, raw.data(), raw.size());
+    return d == 0 ? 1 : d;
+}
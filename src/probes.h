@@ -0,0 +1,49 @@
+//
+//  probes.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_Probes_h
+#define LICENSEPP_Probes_h
+
+//
+// USDT (user statically defined tracing) probes for bpftrace, perf and systemtap,
+// enabled with `cmake -Dusdt=ON ..` (needs sys/sdt.h, e.g, systemtap-sdt-dev).
+// Probes are nop instructions until a tracer attaches. Provider is `licensepp`:
+//
+//   license__load__entry(size)                      License::load()
+//   license__load__return(authority, result, size)
+//   validate__entry(authority, size)                Issuing/VerifyingAuthority::validate(),
+//   validate__return(authority, result, size)       which BaseLicenseManager::validate() calls
+//   issue__entry(authority, licensee)               IssuingAuthority::issue()
+//   issue__return(authority, result, payloadSize)
+//   rsa__verify__entry(size) / rsa__verify__return(result, size)
+//   rsa__sign__entry(size) / rsa__sign__return(size)
+//   aes__encrypt__entry(size) / aes__encrypt__return(size)
+//   aes__decrypt__entry(size) / aes__decrypt__return(size)
+//
+// Strings are char*, sizes are bytes of input (signed payload, License::raw(), for validate)
+// and result is 1 (success) or 0.
+// Arguments must stay stable, bpftrace scripts in tools/bpftrace depend on them.
+//
+
+#ifndef LICENSEPP_USDT
+#   define LICENSEPP_USDT 0
+#endif
+
+#if LICENSEPP_USDT
+#   include <sys/sdt.h>
+#   define LICENSEPP_PROBE1(name, a) DTRACE_PROBE1(licensepp, name, a)
+#   define LICENSEPP_PROBE2(name, a, b) DTRACE_PROBE2(licensepp, name, a, b)
+#   define LICENSEPP_PROBE3(name, a, b, c) DTRACE_PROBE3(licensepp, name, a, b, c)
+#else
+#   define LICENSEPP_PROBE1(name, a) ((void) 0)
+#   define LICENSEPP_PROBE2(name, a, b) ((void) 0)
+#   define LICENSEPP_PROBE3(name, a, b, c) ((void) 0)
+#endif // LICENSEPP_USDT
+
+#endif /* LICENSEPP_Probes_h */
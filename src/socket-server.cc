@@ -0,0 +1,250 @@
+//
+//  socket-server.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "src/socket-server.h"
+#include "src/utils.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <fcntl.h>
+#   include <poll.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <sys/time.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+const unsigned int SocketServer::kDefaultSocketMode;
+const std::size_t SocketServer::kDefaultMaxConnections;
+const unsigned int SocketServer::kDefaultWorkers;
+const int SocketServer::kRequestTimeoutSeconds;
+
+SocketServer::SocketServer(const std::string& socketPath, Handler handler, unsigned int socketMode,
+                           std::size_t maxConnections, unsigned int workers, unsigned int idleTimeoutMs) :
+    m_socketPath(socketPath),
+    m_handler(std::move(handler)),
+    m_socketMode(socketMode),
+    m_maxConnections(maxConnections == 0 ? 1 : maxConnections),
+    m_idleTimeoutMs(idleTimeoutMs),
+    m_listenFd(-1),
+    m_running(false),
+    m_connections(0)
+{
+    for (unsigned int i = 0; i < (workers == 0 ? 1 : workers); ++i) {
+        m_workers.emplace_back(new Worker());
+        m_workers.back()->wakeFds[0] = -1;
+        m_workers.back()->wakeFds[1] = -1;
+    }
+}
+
+SocketServer::~SocketServer()
+{
+    stop();
+#if LICENSEPP_OS_UNIX
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        ::unlink(m_socketPath.c_str());
+    }
+    for (const auto& worker : m_workers) {
+        for (int fd : worker->wakeFds) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+#endif
+}
+
+bool SocketServer::start(const char* name)
+{
+#if LICENSEPP_OS_UNIX
+    struct sockaddr_un addr;
+    if (m_socketPath.empty() || m_socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Invalid socket path " << m_socketPath << std::endl;
+        return false;
+    }
+    // run() wakes worker through its pipe when it hands over a connection
+    for (const auto& worker : m_workers) {
+        if (::pipe(worker->wakeFds) != 0) {
+            std::cerr << "Failed to create pipe: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        for (int fd : worker->wakeFds) {
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+    }
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "Failed to create socket" << std::endl;
+        return false;
+    }
+    ::fcntl(m_listenFd, F_SETFL, ::fcntl(m_listenFd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(m_listenFd, F_SETFD, FD_CLOEXEC);
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, m_socketPath.c_str(), m_socketPath.size());
+    ::unlink(m_socketPath.c_str());
+    if (::bind(m_listenFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0
+            || ::listen(m_listenFd, SOMAXCONN) != 0) {
+        std::cerr << "Failed to listen on " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    if (::chmod(m_socketPath.c_str(), static_cast<mode_t>(m_socketMode)) != 0) {
+        std::cerr << "Failed to set mode of " << m_socketPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    m_running = true;
+    return true;
+#else
+    std::cerr << name << " is only supported on unix" << std::endl;
+    return false;
+#endif // LICENSEPP_OS_UNIX
+}
+
+void SocketServer::run()
+{
+#if LICENSEPP_OS_UNIX
+    std::vector<std::thread> threads;
+    try {
+        while (threads.size() < m_workers.size()) {
+            threads.emplace_back(&SocketServer::work, this, m_workers[threads.size()].get());
+        }
+    } catch (const std::system_error& e) {
+        // serve with workers that did start
+        std::cerr << "Failed to start worker thread: " << e.what() << std::endl;
+    }
+
+    std::size_t next = 0;
+    while (m_running && !threads.empty()) {
+        // at capacity listening socket is not polled and new clients wait in backlog
+        struct pollfd pfd = { m_connections < m_maxConnections ? m_listenFd : -1, POLLIN, 0 };
+        const int ready = ::poll(&pfd, 1, 200);
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "Failed to poll: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        while (ready > 0 && m_connections < m_maxConnections) {
+            const int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                break;
+            }
+            // accepted socket inherits O_NONBLOCK on some systems, requests are read blocking
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            // client that stops in the middle of request must not hold the worker
+            struct timeval tv;
+            tv.tv_sec = kRequestTimeoutSeconds;
+            tv.tv_usec = 0;
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+            ++m_connections;
+            // connections are spread over workers in turn
+            Worker* worker = m_workers[next++ % threads.size()].get();
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->accepted.push_back(fd);
+            }
+            const char wake = 0;
+            if (::write(worker->wakeFds[1], &wake, 1) < 0 && errno != EAGAIN) {
+                std::cerr << "Failed to wake worker: " << std::strerror(errno) << std::endl;
+            }
+        }
+    }
+    m_running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // handed to worker that did not start
+    for (const auto& worker : m_workers) {
+        for (int fd : worker->accepted) {
+            closeConnection(fd);
+        }
+        worker->accepted.clear();
+    }
+#endif // LICENSEPP_OS_UNIX
+}
+
+void SocketServer::work(Worker* worker)
+{
+#if LICENSEPP_OS_UNIX
+    using Clock = std::chrono::steady_clock;
+    std::vector<int> connections;
+    std::vector<Clock::time_point> lastActive;
+    std::vector<struct pollfd> pfds;
+    while (m_running) {
+        pfds.clear();
+        pfds.push_back({ worker->wakeFds[0], POLLIN, 0 });
+        for (int fd : connections) {
+            pfds.push_back({ fd, POLLIN, 0 });
+        }
+        const int ready = ::poll(pfds.data(), static_cast<nfds_t>(pfds.size()), 200);
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "Failed to poll: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        const Clock::time_point now = Clock::now();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < connections.size(); ++i) {
+            const int fd = connections[i];
+            if (ready > 0 && pfds[i + 1].revents != 0) {
+                if (!m_handler(fd)) {
+                    closeConnection(fd);
+                    continue;
+                }
+                lastActive[i] = Clock::now();
+            } else if (now - lastActive[i] >= std::chrono::milliseconds(m_idleTimeoutMs)) {
+                closeConnection(fd);
+                continue;
+            }
+            connections[kept] = fd;
+            lastActive[kept] = lastActive[i];
+            ++kept;
+        }
+        connections.resize(kept);
+        lastActive.resize(kept);
+        if (ready > 0 && pfds[0].revents != 0) {
+            char drain[64];
+            while (::read(worker->wakeFds[0], drain, sizeof(drain)) > 0) {
+            }
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            for (int fd : worker->accepted) {
+                connections.push_back(fd);
+                lastActive.push_back(now);
+            }
+            worker->accepted.clear();
+        }
+    }
+    for (int fd : connections) {
+        closeConnection(fd);
+    }
+#else
+    (void) worker;
+#endif // LICENSEPP_OS_UNIX
+}
+void SocketServer::closeConnection(int fd)
+{
+#if LICENSEPP_OS_UNIX
+    ::close(fd);
+    --m_connections;
+#else
+    (void) fd;
+#endif // LICENSEPP_OS_UNIX
+}
@@ -0,0 +1,120 @@
+//
+//  socket-server.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_SocketServer_h
+#define LICENSEPP_SocketServer_h
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace licensepp {
+
+///
+/// \brief UNIX socket server loop shared by licensepp-verifyd and licensepp-leased
+///
+/// One thread (run()) accepts connections and hands each to one of fixed number of worker
+/// threads, which polls its connections and serves requests as they arrive, so number of
+/// threads does not depend on number of clients. Open connections are capped at
+/// maxConnections; more clients wait in listen backlog until a connection is closed.
+/// Connection that is idle for idleTimeoutMs is closed and client reconnects. Requests are
+/// served by worker one at a time, so handler must read request by requestDeadline().
+///
+class SocketServer
+{
+public:
+    static const unsigned int kDefaultSocketMode = 0660;
+    static const std::size_t kDefaultMaxConnections = 256;
+    static const unsigned int kDefaultWorkers = 4;
+
+    ///
+    /// \brief Seconds a client may take to send rest of request (or read response)
+    ///
+    static const int kRequestTimeoutSeconds = 5;
+
+    ///
+    /// \brief Time by which request that starts now must be read in full, handlers read
+    /// with it so client that sends request byte by byte holds worker for kRequestTimeoutSeconds
+    /// at most
+    ///
+    static inline std::chrono::steady_clock::time_point requestDeadline()
+    {
+        return std::chrono::steady_clock::now() + std::chrono::seconds(kRequestTimeoutSeconds);
+    }
+
+    ///
+    /// \brief Serves one request that is ready on connection
+    /// \return False to close the connection
+    ///
+    using Handler = std::function<bool(int fd)>;
+
+    ///
+    /// \param socketMode Permission bits of socket file, i.e, who may connect
+    ///
+    SocketServer(const std::string& socketPath, Handler handler, unsigned int socketMode,
+                 std::size_t maxConnections, unsigned int workers, unsigned int idleTimeoutMs);
+    ~SocketServer();
+
+    ///
+    /// \brief Binds and listens on socket. Existing socket file is replaced
+    /// \param name Daemon name for error messages
+    ///
+    bool start(const char* name);
+
+    ///
+    /// \brief Serves connections until stop() is called, workers are joined before it returns
+    ///
+    void run();
+
+    ///
+    /// \brief Stops run() loop. Safe to call from signal handler
+    ///
+    inline void stop()
+    {
+        m_running = false;
+    }
+
+    inline std::size_t connections() const
+    {
+        return m_connections;
+    }
+
+private:
+    SocketServer(const SocketServer&) = delete;
+    SocketServer& operator=(const SocketServer&) = delete;
+
+    struct Worker
+    {
+        int wakeFds[2];
+        // accepted connections not yet polled by worker
+        std::mutex mutex;
+        std::vector<int> accepted;
+    };
+
+    void work(Worker* worker);
+    void closeConnection(int fd);
+
+    std::string m_socketPath;
+    Handler m_handler;
+    unsigned int m_socketMode;
+    std::size_t m_maxConnections;
+    unsigned int m_idleTimeoutMs;
+    int m_listenFd;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<bool> m_running;
+    std::atomic<std::size_t> m_connections;
+};
+}
+
+#endif /* LICENSEPP_SocketServer_h */
@@ -0,0 +1,325 @@
+//
+//  tracing.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <fstream>
+#include <license++/tracing.h>
+#include "src/tracing.h"
+
+#if LICENSEPP_TRACING
+#   include <algorithm>
+#   include <array>
+#   include <atomic>
+#   include <chrono>
+#   include <cstdio>
+#   include <cstring>
+#   include <exception>
+#   include <memory>
+#   include <mutex>
+#   include <vector>
+#   include "src/utils.h"
+#   if LICENSEPP_OS_UNIX
+#       include <unistd.h>
+#   endif
+#endif
+
+using namespace licensepp;
+
+#if LICENSEPP_TRACING
+namespace {
+
+const std::size_t kRingCapacity = 8192;
+
+inline uint64_t nowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+///
+/// \brief Span slot. Fields are relaxed atomics guarded by sequence number (seqlock)
+/// so dump can read ring while its thread keeps writing
+///
+struct TraceEvent
+{
+    std::atomic<uint64_t> sequence { 0 };  // odd while being written
+    std::atomic<const char*> name { nullptr };
+    std::atomic<uint64_t> begin { 0 };
+    std::atomic<uint64_t> end { 0 };
+    std::atomic<int> result { TraceSpan::Unset };
+    std::array<std::atomic<uint64_t>, TraceSpan::kAuthorityWords> authority {};
+};
+
+///
+/// \brief Spans of one thread, written only by that thread
+///
+struct TraceRing
+{
+    explicit TraceRing(uint32_t tid) :
+        tid(tid),
+        head(0),
+        clearedHead(0),
+        events(kRingCapacity)
+    {
+    }
+
+    uint32_t tid;
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> clearedHead;  // spans before it were cleared
+    std::vector<TraceEvent> events;
+};
+
+///
+/// \brief Rings of all threads. Rings outlive their threads so they can still be dumped,
+/// and ring of thread that exited is reused by next new thread so there are only as many
+/// rings as threads that traced at the same time
+///
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    std::vector<TraceRing*> freeRings;
+    uint32_t nextTid = 1;
+};
+
+TraceRegistry& registry()
+{
+    static TraceRegistry* s_registry = new TraceRegistry();  // never destroyed, threads may trace during exit
+    return *s_registry;
+}
+
+// trivially destructible so it can still be read by spans in thread_local destructors
+thread_local TraceRing* t_ring = nullptr;
+thread_local bool t_exited = false;
+
+///
+/// \brief Returns ring of thread to free list when thread exits
+///
+struct TraceRingOwner
+{
+    ~TraceRingOwner()
+    {
+        TraceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.freeRings.push_back(t_ring);
+        t_ring = nullptr;
+        t_exited = true;
+    }
+};
+
+///
+/// \return Nullptr once thread is exiting, span is then not recorded
+///
+TraceRing* threadRing()
+{
+    if (t_ring == nullptr && !t_exited) {
+        static thread_local TraceRingOwner owner;
+        TraceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (r.freeRings.empty()) {
+            r.rings.push_back(std::make_shared<TraceRing>(r.nextTid++));
+            t_ring = r.rings.back().get();
+        } else {
+            // keeps tid and spans of previous thread, they are overwritten as usual
+            t_ring = r.freeRings.back();
+            r.freeRings.pop_back();
+        }
+    }
+    return t_ring;
+}
+
+// authority of innermost tagged span on this thread
+thread_local uint64_t t_authority[TraceSpan::kAuthorityWords] = {};
+
+void appendEscaped(std::string* out, const char* str, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c == '"' || c == '\\') {
+            out->push_back('\\');
+            out->push_back(static_cast<char>(c));
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out->append(buf);
+        } else {
+            out->push_back(static_cast<char>(c));
+        }
+    }
+}
+
+void appendMicros(std::string* out, uint64_t ns)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03llu", static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out->append(buf);
+}
+}
+
+TraceSpan::TraceSpan(const char* name) :
+    m_name(name),
+    m_begin(nowNs()),
+    m_result(Unset),
+    m_ownsAuthority(false),
+    m_ended(false)
+{
+    std::memcpy(m_authority, t_authority, sizeof(m_authority));
+}
+
+TraceSpan::~TraceSpan()
+{
+    end();
+}
+
+void TraceSpan::end()
+{
+    if (m_ended) {
+        return;
+    }
+    m_ended = true;
+    const uint64_t end = nowNs();
+    if (m_result == Unset && std::uncaught_exception()) {
+        m_result = Exception;
+    }
+    TraceRing* ring = threadRing();
+    if (ring != nullptr) {
+        const uint64_t n = ring->head.load(std::memory_order_relaxed);
+        TraceEvent& e = ring->events[n % kRingCapacity];
+        e.sequence.store(2 * n + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        e.name.store(m_name, std::memory_order_relaxed);
+        e.begin.store(m_begin, std::memory_order_relaxed);
+        e.end.store(end, std::memory_order_relaxed);
+        e.result.store(m_result, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < kAuthorityWords; ++i) {
+            e.authority[i].store(m_authority[i], std::memory_order_relaxed);
+        }
+        e.sequence.store(2 * n + 2, std::memory_order_release);
+        ring->head.store(n + 1, std::memory_order_release);
+    }
+    if (m_ownsAuthority) {
+        std::memcpy(t_authority, m_parentAuthority, sizeof(t_authority));
+    }
+}
+
+void TraceSpan::setAuthority(const std::string& authorityId)
+{
+    if (!m_ownsAuthority) {
+        std::memcpy(m_parentAuthority, t_authority, sizeof(m_parentAuthority));
+        m_ownsAuthority = true;
+    }
+    std::memset(m_authority, 0, sizeof(m_authority));
+    std::memcpy(m_authority, authorityId.data(), std::min(authorityId.size(), sizeof(m_authority)));
+    std::memcpy(t_authority, m_authority, sizeof(t_authority));
+}
+
+bool Tracing::enabled()
+{
+    return true;
+}
+
+std::string Tracing::chromeTrace()
+{
+    std::vector<std::shared_ptr<TraceRing>> rings;
+    {
+        TraceRegistry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        rings = r.rings;
+    }
+#   if LICENSEPP_OS_UNIX
+    const std::string pid = std::to_string(::getpid());
+#   else
+    const std::string pid = "1";
+#   endif
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& ring : rings) {
+        const std::string tid = std::to_string(ring->tid);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        const uint64_t cleared = ring->clearedHead.load(std::memory_order_relaxed);
+        for (uint64_t n = std::max(cleared, head > kRingCapacity ? head - kRingCapacity : 0); n < head; ++n) {
+            const TraceEvent& e = ring->events[n % kRingCapacity];
+            const uint64_t sequence = e.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * n + 2) {
+                continue;  // overwritten since head was read
+            }
+            const char* name = e.name.load(std::memory_order_relaxed);
+            const uint64_t begin = e.begin.load(std::memory_order_relaxed);
+            const uint64_t end = e.end.load(std::memory_order_relaxed);
+            const int result = e.result.load(std::memory_order_relaxed);
+            uint64_t authority[TraceSpan::kAuthorityWords];
+            for (std::size_t i = 0; i < TraceSpan::kAuthorityWords; ++i) {
+                authority[i] = e.authority[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (e.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+            out.append(first ? "{" : ",{");
+            first = false;
+            out.append("\"name\":\"").append(name).append("\",\"cat\":\"licensepp\",\"ph\":\"X\",\"ts\":");
+            appendMicros(&out, begin);
+            out.append(",\"dur\":");
+            appendMicros(&out, end - begin);
+            out.append(",\"pid\":").append(pid).append(",\"tid\":").append(tid).append(",\"args\":{");
+            const char* authorityId = reinterpret_cast<const char*>(authority);
+            const std::size_t authoritySize = strnlen(authorityId, sizeof(authority));
+            if (authoritySize > 0) {
+                out.append("\"authority\":\"");
+                appendEscaped(&out, authorityId, authoritySize);
+                out.append(result == TraceSpan::Unset ? "\"" : "\",");
+            }
+            if (result != TraceSpan::Unset) {
+                out.append("\"result\":").append(result == TraceSpan::True ? "true"
+                                                 : result == TraceSpan::False ? "false" : "\"exception\"");
+            }
+            out.append("}}");
+        }
+    }
+    out.append("]}");
+    return out;
+}
+
+void Tracing::clear()
+{
+    TraceRegistry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (const auto& ring : r.rings) {
+        // owner thread keeps writing, spans before current head are just skipped
+        ring->clearedHead.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+#else
+
+bool Tracing::enabled()
+{
+    return false;
+}
+
+std::string Tracing::chromeTrace()
+{
+    return "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}";
+}
+
+void Tracing::clear()
+{
+}
+
+#endif // LICENSEPP_TRACING
+
+bool Tracing::dump(const std::string& file)
+{
+    std::ofstream stream(file, std::ios::out | std::ios::trunc);
+    if (!stream.is_open()) {
+        return false;
+    }
+    stream << chromeTrace();
+    return stream.good();
+}
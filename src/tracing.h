@@ -0,0 +1,88 @@
+//
+//  tracing.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_TraceSpan_h
+#define LICENSEPP_TraceSpan_h
+
+#ifndef LICENSEPP_TRACING
+#   define LICENSEPP_TRACING 0
+#endif
+
+#if LICENSEPP_TRACING
+#   include <cstddef>
+#   include <cstdint>
+#   include <string>
+#   define LICENSEPP_TRACE_SPAN(span, name) licensepp::TraceSpan span(name)
+#   define LICENSEPP_TRACE_AUTHORITY(span, authorityId) span.setAuthority(authorityId)
+#   define LICENSEPP_TRACE_RESULT(span, result) span.setResult(result)
+#   define LICENSEPP_TRACE_END(span) span.end()
+#else
+#   define LICENSEPP_TRACE_SPAN(span, name) ((void) 0)
+#   define LICENSEPP_TRACE_AUTHORITY(span, authorityId) ((void) 0)
+#   define LICENSEPP_TRACE_RESULT(span, result) ((void) 0)
+#   define LICENSEPP_TRACE_END(span) ((void) 0)
+#endif // LICENSEPP_TRACING
+
+#if LICENSEPP_TRACING
+namespace licensepp {
+
+///
+/// \brief Records [construction, destruction) of scope to thread's trace ring
+///
+/// Use LICENSEPP_TRACE_* macros so spans are compiled out when tracing is off.
+/// Spans inherit authority of enclosing span on same thread.
+///
+class TraceSpan
+{
+public:
+    enum Result : int
+    {
+        Unset = -1,
+        False = 0,
+        True = 1,
+        Exception = 2
+    };
+
+    // authority ids longer than this are truncated in trace
+    static const std::size_t kAuthorityWords = 3;
+
+    explicit TraceSpan(const char* name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ///
+    /// \brief Tags this span and spans started inside it
+    ///
+    void setAuthority(const std::string& authorityId);
+
+    inline void setResult(bool result)
+    {
+        m_result = result ? True : False;
+    }
+
+    ///
+    /// \brief Records span now instead of at end of scope
+    ///
+    void end();
+
+private:
+    const char* m_name;
+    uint64_t m_begin;
+    Result m_result;
+    bool m_ownsAuthority;
+    bool m_ended;
+    uint64_t m_authority[kAuthorityWords];
+    uint64_t m_parentAuthority[kAuthorityWords];
+};
+}
+#endif // LICENSEPP_TRACING
+
+#endif /* LICENSEPP_TraceSpan_h */
@@ -8,154 +8,121 @@
 //
 
 #include <ctime>
+#include "src/calendar.h"
+#include "src/tracing.h"
 #include "src/utils.h"
 
 using namespace licensepp;
 
-const char* Utils::kDays[7] = { "Sunday", "Monday", "Tuesday",
-                                "Wednesday", "Thursday", "Friday",
-                                "Saturday" };
-const char* Utils::kDaysAbbrev[7] = { "Sun", "Mon", "Tue",
-                                      "Wed", "Thu", "Fri", "Sat" };
-const char* Utils::kMonths[12] = { "January", "February", "March",
-                                   "Apri", "May", "June", "July",
-                                   "August", "September", "October",
-                                   "November", "December" };
-const char* Utils::kMonthsAbbrev[12] = { "Jan", "Feb", "Mar", "Apr",
-                                         "May", "Jun", "Jul", "Aug",
-                                         "Sep", "Oct", "Nov", "Dec" };
+namespace {
+thread_local uint64_t t_clock = 0;
+// last result of nowUtc() and second it was for; mktime() reads time zone on every call
+thread_local std::time_t t_lastTime = 0;
+thread_local uint64_t t_lastUtc = 0;
 
-uint64_t Utils::nowUtc()
+inline uint64_t rotl(uint64_t x, int n)
 {
-    std::time_t t = std::time(nullptr);
-    std::tm* nowTm;
-    nowTm = std::gmtime(&t);
-    return nowTm != nullptr ? mktime(nowTm) : 0;
+    return (x << n) | (x >> (64 - n));
 }
 
-std::string Utils::timevalToString(struct timeval tval, const char* format)
+inline void sipRound(uint64_t* v)
 {
-  struct ::tm timeInfo;
-  buildTimeInfo(&tval, &timeInfo);
-  const int kBuffSize = 30;
-  char buff_[kBuffSize] = "";
-  parseFormat(buff_, kBuffSize, format, &timeInfo, static_cast<std::size_t>(tval.tv_usec / 1000 /* subsecond = 3 */));
-  return std::string(buff_);
+    v[0] += v[1];
+    v[1] = rotl(v[1], 13);
+    v[1] ^= v[0];
+    v[0] = rotl(v[0], 32);
+    v[2] += v[3];
+    v[3] = rotl(v[3], 16);
+    v[3] ^= v[2];
+    v[0] += v[3];
+    v[3] = rotl(v[3], 21);
+    v[3] ^= v[0];
+    v[2] += v[1];
+    v[1] = rotl(v[1], 17);
+    v[1] ^= v[2];
+    v[2] = rotl(v[2], 32);
 }
 
-struct ::tm* Utils::buildTimeInfo(struct timeval* currTime, struct ::tm* timeInfo)
+inline uint64_t readU64(const unsigned char* p)
 {
-#if LICENSEPP_OS_UNIX
-  time_t rawTime = currTime->tv_sec;
-  ::gmtime_r(&rawTime, timeInfo);
-  return timeInfo;
-#else
-#  ifdef _MSC_VER
-  time_t t;
-#    if defined(_USE_32BIT_TIME_T)
-  _time32(&t);
-#    else
-  _time64(&t);
-#    endif
-  gmtime_s(timeInfo, &t);
-  return timeInfo;
-#  else
-  // For any other compilers that don't have CRT warnings issue e.g, MinGW or TDM GCC- we use different method
-  time_t rawTime = currTime->tv_sec;
-  struct tm* tmInf = gmtime(&rawTime);
-  *timeInfo = *tmInf;
-  return timeInfo;
-#  endif  // _MSC_VER
-#endif  // LICENSEPP_OS_UNIX
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
 }
 
-char* Utils::convertAndAddToBuff(std::size_t n, int len, char* buf, const char* bufLim, bool zeroPadded)
+uint64_t Utils::nowUtc()
 {
-    char localBuff[10] = "";
-    char* p = localBuff + sizeof(localBuff) - 2;
-    if (n > 0) {
-        for (; n > 0 && p > localBuff && len > 0; n /= 10, --len) {
-            *--p = static_cast<char>(n % 10 + '0');
-        }
-    } else {
-        *--p = '0';
-        --len;
+    if (t_clock != 0) {
+        return t_clock;
     }
-    while (zeroPadded && p > localBuff && len-- > 0) {
-        *--p = static_cast<char>('0');
+    std::time_t t = std::time(nullptr);
+    if (t == t_lastTime && t_lastUtc != 0) {
+        return t_lastUtc;
     }
-    return addToBuff(p, buf, bufLim);
+    LICENSEPP_TRACE_SPAN(span, "clock.now_utc");
+    // std::gmtime() returns shared buffer that other threads overwrite
+    std::tm nowTm;
+#if defined(_WIN32)
+    const bool converted = gmtime_s(&nowTm, &t) == 0;
+#else
+    const bool converted = gmtime_r(&t, &nowTm) != nullptr;
+#endif
+    t_lastTime = t;
+    t_lastUtc = converted ? mktime(&nowTm) : 0;
+    return t_lastUtc;
 }
 
-char* Utils::addToBuff(const char* str, char* buf, const char* bufLim)
+void Utils::setThreadClock(uint64_t utc)
 {
-    while ((buf < bufLim) && ((*buf = *str++) != '\0')) {
-        ++buf;
+    t_clock = utc;
+}
+
+std::string Utils::timevalToString(struct timeval tval, const char* format)
+{
+    const unsigned int msec = static_cast<unsigned int>(tval.tv_usec / 1000 /* subsecond = 3 */);
+    char buff[64];
+    const std::size_t len = Calendar::format(tval.tv_sec, msec, format, buff, sizeof(buff));
+    if (len < sizeof(buff)) {
+        return std::string(buff, len);
     }
-    return buf;
+    // longer output is formatted again instead of being truncated
+    std::string result(len + 1, '\0');
+    Calendar::format(tval.tv_sec, msec, format, &result[0], result.size());
+    result.resize(len);
+    return result;
 }
 
-char* Utils::parseFormat(char* buf, std::size_t bufSz, const char* format, const struct tm* tInfo,
-                            std::size_t msec)
+uint64_t Utils::sipHash(const uint64_t* key, const void* data, std::size_t size)
 {
-    const char* bufLim = buf + bufSz;
-    for (; *format; ++format) {
-        if (*format == '%') {
-            switch (*++format) {
-            case '%':  // Escape
-                break;
-            case '\0':  // End
-                --format;
-                break;
-            case 'd':  // Day
-                buf = convertAndAddToBuff(tInfo->tm_mday, 2, buf, bufLim);
-                continue;
-            case 'a':  // Day of week (short)
-                buf = addToBuff(kDaysAbbrev[tInfo->tm_wday], buf, bufLim);
-                continue;
-            case 'A':  // Day of week (long)
-                buf = addToBuff(kDays[tInfo->tm_wday], buf, bufLim);
-                continue;
-            case 'M':  // month
-                buf = convertAndAddToBuff(tInfo->tm_mon + 1, 2, buf, bufLim);
-                continue;
-            case 'b':  // month (short)
-                buf = addToBuff(kMonthsAbbrev[tInfo->tm_mon], buf, bufLim);
-                continue;
-            case 'B':  // month (long)
-                buf = addToBuff(kMonths[tInfo->tm_mon], buf, bufLim);
-                continue;
-            case 'y':  // year (two digits)
-                buf = convertAndAddToBuff(tInfo->tm_year + 1900, 2, buf, bufLim);
-                continue;
-            case 'Y':  // year (four digits)
-                buf = convertAndAddToBuff(tInfo->tm_year + 1900, 4, buf, bufLim);
-                continue;
-            case 'h':  // hour (12-hour)
-                buf = convertAndAddToBuff(tInfo->tm_hour % 12, 2, buf, bufLim);
-                continue;
-            case 'H':  // hour (24-hour)
-                buf = convertAndAddToBuff(tInfo->tm_hour, 2, buf, bufLim);
-                continue;
-            case 'm':  // minute
-                buf = convertAndAddToBuff(tInfo->tm_min, 2, buf, bufLim);
-                continue;
-            case 's':  // second
-                buf = convertAndAddToBuff(tInfo->tm_sec, 2, buf, bufLim);
-                continue;
-            case 'z':  // subsecond part
-            case 'g':
-                buf = convertAndAddToBuff(msec, 3 /* subsecond precision */, buf, bufLim);
-                continue;
-            case 'F':  // AM/PM
-                buf = addToBuff((tInfo->tm_hour >= 12) ? "PM" : "AM", buf, bufLim);
-                continue;
-            default:
-              continue;
-            }
-        }
-        if (buf == bufLim) break;
-        *buf++ = *format;
+    uint64_t v[4] = {
+        key[0] ^ 0x736f6d6570736575ULL,
+        key[1] ^ 0x646f72616e646f6dULL,
+        key[0] ^ 0x6c7967656e657261ULL,
+        key[1] ^ 0x7465646279746573ULL
+    };
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const std::size_t end = size - size % 8;
+    for (std::size_t i = 0; i < end; i += 8) {
+        const uint64_t m = readU64(p + i);
+        v[3] ^= m;
+        sipRound(v);
+        sipRound(v);
+        v[0] ^= m;
+    }
+    uint64_t last = static_cast<uint64_t>(size) << 56;
+    for (std::size_t i = end; i < size; ++i) {
+        last |= static_cast<uint64_t>(p[i]) << (8 * (i - end));
+    }
+    v[3] ^= last;
+    sipRound(v);
+    sipRound(v);
+    v[0] ^= last;
+    v[2] ^= 0xff;
+    for (int i = 0; i < 4; ++i) {
+        sipRound(v);
     }
-    return buf;
+    return v[0] ^ v[1] ^ v[2] ^ v[3];
 }
@@ -56,6 +56,8 @@
 #endif
 #include <ctime>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 #if LICENSEPP_OS_WINDOWS
@@ -73,11 +75,6 @@ namespace licensepp {
 class Utils
 {
 public:
-    static const char* kDays[7];
-    static const char* kDaysAbbrev[7];
-    static const char* kMonths[12];
-    static const char* kMonthsAbbrev[12];
-
     static inline uint64_t now()
     {
         return std::chrono::system_clock::now().time_since_epoch() / std::chrono::seconds(1);
@@ -85,13 +82,22 @@ public:
 
     static uint64_t nowUtc();
 
-    static std::string timevalToString(struct timeval tval, const char* format);
-    static struct ::tm* buildTimeInfo(struct timeval* currTime, struct ::tm* timeInfo);
-    static char* convertAndAddToBuff(std::size_t n, int len, char* buf, const char* bufLim, bool zeroPadded = true);
+    ///
+    /// \brief Makes nowUtc() return utc on calling thread (0 goes back to system clock)
+    ///
+    /// Used by licensepp-replay to validate recorded licenses with clock they were validated at
+    ///
+    static void setThreadClock(uint64_t utc);
 
-    static char* addToBuff(const char* str, char* buf, const char* bufLim);
+    ///
+    /// \brief Formats UTC time, see Calendar::format() for format specifiers
+    ///
+    static std::string timevalToString(struct timeval tval, const char* format);
 
-    static char* parseFormat(char* buf, std::size_t bufSz, const char* format, const struct tm* tInfo, std::size_t msec);
+    ///
+    /// \brief SipHash-2-4 with 128-bit key, digest that cannot be predicted without key
+    ///
+    static uint64_t sipHash(const uint64_t* key, const void* data, std::size_t size);
 };
 }
 #endif /* LICENSEPP_Utils_h */
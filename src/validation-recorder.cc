@@ -0,0 +1,194 @@
+//
+//  validation-recorder.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <license++/license.h>
+#include <license++/license-exception.h>
+#include <license++/validation-recorder.h>
+#include "src/crypto/base64.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+//
+// Trace is 8-byte header (magic LPVT, version) followed by entries, all little endian:
+//
+//   'B' blobId:u32 size:u32 <base64 license>                           first use of license
+//   'V' blobId:u32 latencyNs:u32 timestampUs:u64 clock:u64 flags:u8    validation
+//
+// flags: bit 0 verify licensee signature, bit 1 licensee signature given, bits 2-3 result
+//
+namespace {
+
+const uint32_t kTraceMagic = 0x5456504C;  // LPVT
+const uint32_t kTraceVersion = 1;
+const std::size_t kValidationSize = 1 + 4 + 4 + 8 + 8 + 1;
+const std::size_t kWriteBufferSize = 64 * 1024;
+
+inline void writeU32(unsigned char* p, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void writeU64(unsigned char* p, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t readU32(const unsigned char* p)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+}
+
+ValidationRecorder::ValidationRecorder(const std::string& file) :
+    m_file(std::fopen(file.c_str(), "wb")),
+    m_size(0)
+{
+    if (m_file == nullptr) {
+        throw LicenseException("Failed to open validation trace " + file);
+    }
+    std::setvbuf(m_file, nullptr, _IOFBF, kWriteBufferSize);
+    unsigned char header[8];
+    writeU32(header, kTraceMagic);
+    writeU32(header + 4, kTraceVersion);
+    write(header, sizeof(header));
+}
+
+ValidationRecorder::~ValidationRecorder()
+{
+    std::fclose(m_file);
+}
+
+uint64_t ValidationRecorder::clock()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void ValidationRecorder::record(const License* license, bool verifyLicenseeSignature,
+                                bool licenseeSignatureGiven, uint64_t started, Result result)
+{
+    const uint64_t latency = clock() - started;
+    const uint64_t timestampUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t utc = Utils::nowUtc();
+    std::string blob = Base64::encode(license->raw(true));
+
+    unsigned char validation[kValidationSize];
+    validation[0] = 'V';
+    writeU32(validation + 5, static_cast<uint32_t>(std::min<uint64_t>(latency, std::numeric_limits<uint32_t>::max())));
+    writeU64(validation + 9, timestampUs);
+    writeU64(validation + 17, utc);
+    validation[25] = static_cast<unsigned char>((verifyLicenseeSignature ? 1 : 0)
+                                                | (licenseeSignatureGiven ? 2 : 0)
+                                                | (static_cast<unsigned char>(result) << 2));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto blobId = m_blobIds.find(blob);
+    if (blobId == m_blobIds.end()) {
+        const uint32_t id = static_cast<uint32_t>(m_blobIds.size());
+        unsigned char header[9];
+        header[0] = 'B';
+        writeU32(header + 1, id);
+        writeU32(header + 5, static_cast<uint32_t>(blob.size()));
+        write(header, sizeof(header));
+        write(blob.data(), blob.size());
+        blobId = m_blobIds.emplace(std::move(blob), id).first;
+    }
+    writeU32(validation + 1, blobId->second);
+    write(validation, sizeof(validation));
+    ++m_size;
+}
+
+void ValidationRecorder::flush()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::fflush(m_file);
+}
+
+uint64_t ValidationRecorder::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_size;
+}
+
+void ValidationRecorder::write(const void* data, std::size_t size)
+{
+    // recording is best effort, failed write must not fail validation
+    if (std::fwrite(data, 1, size, m_file) != size) {
+        std::clearerr(m_file);
+    }
+}
+
+ValidationTrace::ValidationTrace(const std::string& file) :
+    m_complete(true)
+{
+    std::ifstream stream(file, std::ios::binary);
+    if (!stream.is_open()) {
+        throw LicenseException("Failed to open validation trace " + file);
+    }
+    const std::string data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data.data());
+    const std::size_t size = data.size();
+    if (size < 8 || readU32(p) != kTraceMagic || readU32(p + 4) != kTraceVersion) {
+        throw LicenseException("Not a validation trace " + file);
+    }
+    std::size_t offset = 8;
+    while (offset < size) {
+        if (p[offset] == 'B' && offset + 9 <= size) {
+            const uint32_t id = readU32(p + offset + 1);
+            const uint32_t blobSize = readU32(p + offset + 5);
+            if (id != m_blobs.size() || offset + 9 + blobSize > size) {
+                break;
+            }
+            m_blobs.emplace_back(data, offset + 9, blobSize);
+            offset += 9 + blobSize;
+        } else if (p[offset] == 'V' && offset + kValidationSize <= size) {
+            Record record;
+            record.blobId = readU32(p + offset + 1);
+            record.latencyNs = readU32(p + offset + 5);
+            record.timestampUs = readU64(p + offset + 9);
+            record.clock = readU64(p + offset + 17);
+            const unsigned char flags = p[offset + 25];
+            record.verifyLicenseeSignature = (flags & 1) != 0;
+            record.licenseeSignatureGiven = (flags & 2) != 0;
+            record.result = static_cast<ValidationRecorder::Result>((flags >> 2) & 3);
+            if (record.blobId >= m_blobs.size()) {
+                break;
+            }
+            m_records.push_back(record);
+            offset += kValidationSize;
+        } else {
+            break;
+        }
+    }
+    m_complete = offset == size;
+}
@@ -0,0 +1,99 @@
+//
+//  verify-client.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <vector>
+#include <license++/verify-client.h>
+#include "src/utils.h"
+#include "src/verify-protocol.h"
+
+#if LICENSEPP_OS_UNIX
+#   include <sys/socket.h>
+#   include <sys/time.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace licensepp;
+
+const char* VerifyClient::kDefaultSocketPath = "/var/run/licensepp-verifyd.sock";
+
+VerifyClient::VerifyClient(const std::string& socketPath, unsigned int timeoutMs) :
+    m_socketPath(socketPath),
+    m_timeoutMs(timeoutMs)
+{
+}
+
+VerifyClient::Status VerifyClient::query(const std::string& licenseBase64,
+                                         bool verifyLicenseeSignature,
+                                         const std::string& licenseeSignature,
+                                         uint64_t* expiryDate) const
+{
+#if LICENSEPP_OS_UNIX
+    if (licenseBase64.size() > VerifyProtocol::kMaxBlobSize
+            || licenseeSignature.size() > VerifyProtocol::kMaxSignatureSize) {
+        // daemon would reject it, let in-process validation decide
+        return Status::Unavailable;
+    }
+    struct sockaddr_un addr;
+    if (m_socketPath.empty() || m_socketPath.size() >= sizeof(addr.sun_path)) {
+        return Status::Unavailable;
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return Status::Unavailable;
+    }
+    struct timeval tv;
+    tv.tv_sec = static_cast<long>(m_timeoutMs / 1000U);
+    tv.tv_usec = static_cast<long>((m_timeoutMs % 1000U) * 1000U);
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, m_socketPath.c_str(), m_socketPath.size());
+    if (::connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return Status::Unavailable;
+    }
+
+    std::vector<unsigned char> request(VerifyProtocol::kHeaderSize + licenseBase64.size() + licenseeSignature.size());
+    VerifyProtocol::writeU32(&request[0], VerifyProtocol::kMagic);
+    request[4] = VerifyProtocol::kVersion;
+    request[5] = VerifyProtocol::OpValidate;
+    request[6] = verifyLicenseeSignature ? VerifyProtocol::FlagVerifyLicenseeSignature : 0;
+    request[7] = 0;
+    VerifyProtocol::writeU32(&request[8], static_cast<uint32_t>(licenseBase64.size()));
+    VerifyProtocol::writeU32(&request[12], static_cast<uint32_t>(licenseeSignature.size()));
+    std::memcpy(&request[VerifyProtocol::kHeaderSize], licenseBase64.data(), licenseBase64.size());
+    if (!licenseeSignature.empty()) {
+        std::memcpy(&request[VerifyProtocol::kHeaderSize + licenseBase64.size()],
+                licenseeSignature.data(), licenseeSignature.size());
+    }
+
+    unsigned char response[VerifyProtocol::kResponseSize];
+    const bool ok = VerifyProtocol::writeFully(fd, request.data(), request.size())
+            && VerifyProtocol::readFully(fd, response, sizeof(response));
+    ::close(fd);
+    if (!ok || VerifyProtocol::readU32(response) != VerifyProtocol::kMagic
+            || response[4] != VerifyProtocol::kVersion
+            || response[5] > VerifyProtocol::StatusUnknownAuthority) {
+        return Status::Unavailable;
+    }
+    if (expiryDate != nullptr) {
+        *expiryDate = VerifyProtocol::readU64(&response[8]);
+    }
+    return static_cast<Status>(response[5]);
+#else
+    (void) licenseBase64;
+    (void) verifyLicenseeSignature;
+    (void) licenseeSignature;
+    (void) expiryDate;
+    return Status::Unavailable;
+#endif // LICENSEPP_OS_UNIX
+}
@@ -0,0 +1,177 @@
+//
+//  verify-protocol.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_VerifyProtocol_h
+#define LICENSEPP_VerifyProtocol_h
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "src/utils.h"
+#if LICENSEPP_OS_UNIX
+#   include <poll.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+namespace licensepp {
+
+///
+/// \brief Wire format between VerifyClient and licensepp-verifyd
+///
+/// All integers are little-endian. Every request is answered with exactly one response
+/// and a connection may carry any number of requests.
+/// <pre>
+/// request:  | magic (4) | version (1) | opcode (1) | flags (1) | reserved (1) | blob length (4) | signature length (4) | blob | signature |
+/// response: | magic (4) | version (1) | status (1) | reserved (2) | expiry date (8) |
+/// </pre>
+///
+namespace VerifyProtocol {
+
+static const uint32_t kMagic = 0x4456504CU; // "LPVD"
+static const uint8_t kVersion = 1;
+static const std::size_t kHeaderSize = 16;
+static const std::size_t kResponseSize = 16;
+static const uint32_t kMaxBlobSize = 64 * 1024;
+static const uint32_t kMaxSignatureSize = 4 * 1024;
+
+enum Opcode : uint8_t
+{
+    OpValidate = 1
+};
+
+enum Flags : uint8_t
+{
+    FlagVerifyLicenseeSignature = 1
+};
+
+enum Status : uint8_t
+{
+    StatusValid = 0,
+    StatusInvalid = 1,
+    StatusMalformed = 2,
+    StatusUnknownAuthority = 3
+};
+
+inline void writeU32(unsigned char* buf, uint32_t v)
+{
+    for (int i = 0; i < 4; ++i) {
+        buf[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline void writeU64(unsigned char* buf, uint64_t v)
+{
+    for (int i = 0; i < 8; ++i) {
+        buf[i] = static_cast<unsigned char>(v >> (8 * i));
+    }
+}
+
+inline uint32_t readU32(const unsigned char* buf)
+{
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) {
+        v = (v << 8) | buf[i];
+    }
+    return v;
+}
+
+inline uint64_t readU64(const unsigned char* buf)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | buf[i];
+    }
+    return v;
+}
+
+#if LICENSEPP_OS_UNIX
+///
+/// \brief Reads exactly len bytes. Returns false on error, timeout or closed connection
+///
+inline bool readFully(int fd, void* buf, std::size_t len)
+{
+    unsigned char* p = static_cast<unsigned char*>(buf);
+    while (len > 0) {
+        ssize_t n = ::recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+///
+/// \brief Same as readFully() but gives up at deadline, however slowly bytes keep coming
+///
+inline bool readFully(int fd, void* buf, std::size_t len, std::chrono::steady_clock::time_point deadline)
+{
+    unsigned char* p = static_cast<unsigned char*>(buf);
+    while (len > 0) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            return false;
+        }
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        const int ready = ::poll(&pfd, 1, static_cast<int>(remaining));
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            return false;
+        }
+        ssize_t n = ::recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+///
+/// \brief Writes exactly len bytes. Returns false on error
+///
+inline bool writeFully(int fd, const void* buf, std::size_t len)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(buf);
+    while (len > 0) {
+#ifdef MSG_NOSIGNAL
+        ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+#else
+        ssize_t n = ::send(fd, p, len, 0);
+#endif
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+#endif // LICENSEPP_OS_UNIX
+
+}
+}
+
+#endif /* LICENSEPP_VerifyProtocol_h */
@@ -0,0 +1,154 @@
+//
+//  verify-server.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <random>
+#include <license++/license-exception.h>
+#include "src/utils.h"
+#include "src/verify-protocol.h"
+#include "src/verify-server.h"
+
+using namespace licensepp;
+
+// idle clients are disconnected as soon as they would time out in the middle of request
+static const unsigned int kIdleTimeoutMs = SocketServer::kRequestTimeoutSeconds * 1000U;
+
+VerifyServer::VerifyServer(const std::string& socketPath, Validator validator,
+                           std::size_t cacheSize, unsigned int socketMode, std::size_t maxConnections) :
+    m_validator(std::move(validator)),
+    m_cacheSize(cacheSize),
+    m_requests(0),
+    m_cacheHits(0),
+    m_server(socketPath, [this](int fd) { return serve(fd); }, socketMode, maxConnections,
+             SocketServer::kDefaultWorkers, kIdleTimeoutMs)
+{
+    std::random_device device;
+    for (auto& key : m_cacheKeys) {
+        for (uint64_t& half : key) {
+            half = (static_cast<uint64_t>(device()) << 32) ^ static_cast<uint64_t>(device());
+        }
+    }
+}
+
+bool VerifyServer::serve(int fd)
+{
+#if LICENSEPP_OS_UNIX
+    const auto deadline = SocketServer::requestDeadline();
+    unsigned char header[VerifyProtocol::kHeaderSize];
+    if (!VerifyProtocol::readFully(fd, header, sizeof(header), deadline)) {
+        return false;
+    }
+    const uint32_t blobSize = VerifyProtocol::readU32(&header[8]);
+    const uint32_t signatureSize = VerifyProtocol::readU32(&header[12]);
+    if (VerifyProtocol::readU32(header) != VerifyProtocol::kMagic
+            || header[4] != VerifyProtocol::kVersion
+            || header[5] != VerifyProtocol::OpValidate
+            || blobSize > VerifyProtocol::kMaxBlobSize
+            || signatureSize > VerifyProtocol::kMaxSignatureSize) {
+        return false;
+    }
+    std::string blob(blobSize, '\0');
+    std::string signature(signatureSize, '\0');
+    if ((blobSize > 0 && !VerifyProtocol::readFully(fd, &blob[0], blobSize, deadline))
+            || (signatureSize > 0 && !VerifyProtocol::readFully(fd, &signature[0], signatureSize, deadline))) {
+        return false;
+    }
+    uint64_t expiryDate = 0;
+    const uint8_t status = handle(blob, header[6], signature, &expiryDate);
+
+    unsigned char response[VerifyProtocol::kResponseSize] = {};
+    VerifyProtocol::writeU32(response, VerifyProtocol::kMagic);
+    response[4] = VerifyProtocol::kVersion;
+    response[5] = status;
+    VerifyProtocol::writeU64(&response[8], expiryDate);
+    return VerifyProtocol::writeFully(fd, response, sizeof(response));
+#else
+    (void) fd;
+    return false;
+#endif // LICENSEPP_OS_UNIX
+}
+
+uint8_t VerifyServer::handle(const std::string& licenseBase64, uint8_t flags,
+                             const std::string& licenseeSignature, uint64_t* expiryDate)
+{
+    ++m_requests;
+    const bool verifyLicenseeSignature = (flags & VerifyProtocol::FlagVerifyLicenseeSignature) != 0;
+    const CacheKey key = cacheKey(licenseBase64, verifyLicenseeSignature, licenseeSignature);
+
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        auto iter = m_cache.find(key);
+        if (iter != m_cache.end()) {
+            ++m_cacheHits;
+            if (iter->second.status == VerifyProtocol::StatusValid
+                    && iter->second.expiryDate < Utils::nowUtc()) {
+                // license has expired since it was verified
+                iter->second.status = VerifyProtocol::StatusInvalid;
+            }
+            *expiryDate = iter->second.expiryDate;
+            return iter->second.status;
+        }
+    }
+
+    CacheEntry entry;
+    entry.expiryDate = 0;
+    License license;
+    try {
+        license.load(licenseBase64);
+        entry.expiryDate = license.expiryDate();
+    } catch (const LicenseException&) {
+        // not cached, rejected without RSA and would only push verified results out of cache
+        *expiryDate = 0;
+        return VerifyProtocol::StatusMalformed;
+    }
+    try {
+        entry.status = m_validator(license, verifyLicenseeSignature, licenseeSignature)
+                ? VerifyProtocol::StatusValid : VerifyProtocol::StatusInvalid;
+    } catch (const LicenseException&) {
+        // not cached either, same as malformed license
+        *expiryDate = entry.expiryDate;
+        return VerifyProtocol::StatusUnknownAuthority;
+    } catch (const std::exception&) {
+        entry.status = VerifyProtocol::StatusInvalid;
+    }
+    cache(key, entry);
+    *expiryDate = entry.expiryDate;
+    return entry.status;
+}
+
+VerifyServer::CacheKey VerifyServer::cacheKey(const std::string& licenseBase64, bool verifyLicenseeSignature,
+                                              const std::string& licenseeSignature) const
+{
+    CacheKey key;
+    for (int i = 0; i < 2; ++i) {
+        // digest of (digest of license, digest of signature, flag) so nothing is concatenated
+        const uint64_t parts[3] = {
+            Utils::sipHash(m_cacheKeys[i], licenseBase64.data(), licenseBase64.size()),
+            Utils::sipHash(m_cacheKeys[i], licenseeSignature.data(), licenseeSignature.size()),
+            verifyLicenseeSignature ? 1U : 0U
+        };
+        key.digest[i] = Utils::sipHash(m_cacheKeys[i], parts, sizeof(parts));
+    }
+    return key;
+}
+
+void VerifyServer::cache(const CacheKey& key, const CacheEntry& entry)
+{
+    if (m_cacheSize == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (!m_cache.emplace(key, entry).second) {
+        return;
+    }
+    m_cacheOrder.push_back(key);
+    while (m_cacheOrder.size() > m_cacheSize) {
+        m_cache.erase(m_cacheOrder.front());
+        m_cacheOrder.pop_front();
+    }
+}
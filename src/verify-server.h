@@ -0,0 +1,154 @@
+//
+//  verify-server.h
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSEPP_VerifyServer_h
+#define LICENSEPP_VerifyServer_h
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <license++/license.h>
+#include "src/socket-server.h"
+
+namespace licensepp {
+
+///
+/// \brief Server side of licensepp-verifyd
+///
+/// Accepts VerifyClient connections on UNIX socket and answers validation requests with
+/// fixed number of worker threads (see SocketServer). Results are cached by keyed digest of
+/// (license, flags, licensee signature) so the same license is verified only once; cached valid
+/// results are still checked against expiry date. Malformed licenses and licenses of unknown
+/// authority are not cached.
+///
+class VerifyServer
+{
+public:
+    ///
+    /// \brief Validator provided by daemon (usually BaseLicenseManager::validate)
+    /// \throws LicenseException if issuing authority is unknown
+    ///
+    using Validator = std::function<bool(const License& license,
+                                         bool verifyLicenseeSignature,
+                                         const std::string& licenseeSignature)>;
+
+    ///
+    /// \param socketMode Permission bits of socket file, i.e, who may ask for validation
+    /// \param maxConnections Open connections at a time, more clients wait until one is closed
+    ///
+    VerifyServer(const std::string& socketPath, Validator validator,
+                 std::size_t cacheSize = 4096,
+                 unsigned int socketMode = SocketServer::kDefaultSocketMode,
+                 std::size_t maxConnections = SocketServer::kDefaultMaxConnections);
+
+    ///
+    /// \brief Binds and listens on socket. Existing socket file is replaced
+    ///
+    inline bool start()
+    {
+        return m_server.start("licensepp-verifyd");
+    }
+
+    ///
+    /// \brief Serves connections until stop() is called
+    ///
+    inline void run()
+    {
+        m_server.run();
+    }
+
+    ///
+    /// \brief Stops run() loop. Safe to call from signal handler
+    ///
+    inline void stop()
+    {
+        m_server.stop();
+    }
+
+    ///
+    /// \brief Handles single request, returns VerifyProtocol::Status
+    ///
+    uint8_t handle(const std::string& licenseBase64, uint8_t flags,
+                   const std::string& licenseeSignature, uint64_t* expiryDate);
+
+    inline uint64_t requests() const
+    {
+        return m_requests;
+    }
+
+    inline uint64_t cacheHits() const
+    {
+        return m_cacheHits;
+    }
+
+    inline std::size_t connections() const
+    {
+        return m_server.connections();
+    }
+
+private:
+    VerifyServer(const VerifyServer&) = delete;
+    VerifyServer& operator=(const VerifyServer&) = delete;
+
+    struct CacheEntry
+    {
+        uint8_t status;
+        uint64_t expiryDate;
+    };
+
+    ///
+    /// \brief 128-bit SipHash digest of request, fixed size whatever size of license is
+    ///
+    struct CacheKey
+    {
+        uint64_t digest[2];
+
+        inline bool operator==(const CacheKey& other) const
+        {
+            return digest[0] == other.digest[0] && digest[1] == other.digest[1];
+        }
+    };
+
+    struct CacheKeyHash
+    {
+        inline std::size_t operator()(const CacheKey& key) const
+        {
+            return static_cast<std::size_t>(key.digest[0]);
+        }
+    };
+
+    ///
+    /// \brief Serves one request, false if connection should be closed
+    ///
+    bool serve(int fd);
+    CacheKey cacheKey(const std::string& licenseBase64, bool verifyLicenseeSignature,
+                      const std::string& licenseeSignature) const;
+    void cache(const CacheKey& key, const CacheEntry& entry);
+
+    Validator m_validator;
+    std::size_t m_cacheSize;
+    std::atomic<uint64_t> m_requests;
+    std::atomic<uint64_t> m_cacheHits;
+    // two SipHash keys, one for each half of digest
+    uint64_t m_cacheKeys[2][2];
+
+    std::mutex m_cacheMutex;
+    std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> m_cache;
+    std::deque<CacheKey> m_cacheOrder;
+
+    // last so connections are closed before cache is destroyed
+    SocketServer m_server;
+};
+}
+
+#endif /* LICENSEPP_VerifyServer_h */
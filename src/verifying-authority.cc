@@ -0,0 +1,90 @@
+//
+//  verifying-authority.cc
+//  License++
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include <algorithm>
+#include <license++/verifying-authority.h>
+#include "src/crypto/base64.h"
+#include "src/crypto/rsa.h"
+#include "src/license-check.h"
+
+using namespace licensepp;
+
+VerifyingAuthority::VerifyingAuthority(const std::string& id,
+                                       const std::string& publicKey,
+                                       bool active,
+                                       uint32_t keyId) :
+    m_id(id),
+    m_active(active)
+{
+    addPublicKey(keyId, publicKey);
+}
+
+VerifyingAuthority& VerifyingAuthority::addPublicKey(uint32_t keyId, const std::string& publicKey)
+{
+    std::shared_ptr<const RSAPublicKey> key;
+    try {
+        key = std::make_shared<RSAPublicKey>(RSA::loadPublicKey(Base64::decode(publicKey)));
+    } catch (const std::exception&) {
+        // empty key is reported by validate()
+        key = std::make_shared<RSAPublicKey>();
+    }
+    retirePublicKey(keyId);
+    m_publicKeys.emplace_back(keyId, std::move(key));
+    m_publicKeys.shrink_to_fit();
+    return *this;
+}
+
+VerifyingAuthority& VerifyingAuthority::retirePublicKey(uint32_t keyId)
+{
+    m_publicKeys.erase(std::remove_if(m_publicKeys.begin(), m_publicKeys.end(),
+                                      [keyId](const std::pair<uint32_t, std::shared_ptr<const RSAPublicKey>>& key) {
+                                          return key.first == keyId;
+                                      }), m_publicKeys.end());
+    return *this;
+}
+
+bool VerifyingAuthority::validate(const License* license,
+                                  const std::string& masterKey,
+                                  bool validateSignature,
+                                  const std::string& licenseeSignature,
+                                  NegativeCache* negativeCache) const
+{
+    return LicenseCheck::validate(license, m_id, publicKey(license->keyId()), masterKey, validateSignature,
+                                  licenseeSignature, negativeCache);
+}
+
+LicenseError VerifyingAuthority::tryValidate(const License* license,
+                                             const std::string& masterKey,
+                                             bool validateSignature,
+                                             const std::string& licenseeSignature,
+                                             NegativeCache* negativeCache) const noexcept
+{
+    return LicenseCheck::tryValidate(license, m_id, publicKey(license->keyId()), masterKey, validateSignature,
+                                     licenseeSignature, negativeCache);
+}
+
+bool VerifyingAuthority::verifySignature(const License* license) const
+{
+    return LicenseCheck::verifySignature(license, m_id, publicKey(license->keyId()));
+}
+
+void VerifyingAuthority::verifySignatures(const License* const* licenses, std::size_t n, bool* results) const
+{
+    LicenseCheck::verifySignatures(licenses, n, m_id, [this](uint32_t keyId) { return publicKey(keyId); }, results);
+}
+
+const RSAPublicKey* VerifyingAuthority::publicKey(uint32_t keyId) const
+{
+    for (const auto& key : m_publicKeys) {
+        if (key.first == keyId) {
+            return key.second.get();
+        }
+    }
+    return nullptr;
+}
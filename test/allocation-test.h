@@ -0,0 +1,293 @@
+//
+//  allocation-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef ALLOCATION_TEST_H
+#define ALLOCATION_TEST_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/license.h>
+#include "src/crypto/aes.h"
+#include "src/crypto/base16.h"
+#include "src/crypto/base64.h"
+#include "src/crypto/rsa.h"
+#include "src/json-object.h"
+
+///
+/// \brief One-shot latch, wait() blocks until open() is called
+///
+class Latch
+{
+public:
+    Latch() : m_open(false)
+    {
+    }
+
+    void open()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this]() { return m_open; });
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_open;
+};
+
+// Global operator new is replaced for the whole test binary but only counts
+// allocations made by current thread while an AllocationCounter is alive
+// (or fails them while s_failAllocations is set, once s_failRelease is open)
+static thread_local bool s_countAllocations = false;
+static thread_local unsigned long s_allocationCount = 0;
+static thread_local bool s_failAllocations = false;
+static Latch s_failingAllocation;
+static Latch s_failRelease;
+
+void* operator new(std::size_t size)
+{
+    if (s_failAllocations) {
+        s_failAllocations = false; // latch itself must not fail
+        s_failingAllocation.open();
+        s_failRelease.wait();
+        throw std::bad_alloc();
+    }
+    if (s_countAllocations) {
+        ++s_allocationCount;
+    }
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+// gcc sees free() on memory from operator new once these are inlined
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#   pragma GCC diagnostic pop
+#endif
+
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        s_allocationCount = 0;
+        s_countAllocations = true;
+    }
+
+    ~AllocationCounter()
+    {
+        s_countAllocations = false;
+    }
+
+    inline unsigned long count() const
+    {
+        return s_allocationCount;
+    }
+};
+
+// Budgets are allocations made by License and license manager themselves on top of
+// json parser (load) and crypto backend (validate), so they stay tight with any backend
+// and scratch buffers that stop being reused (signature key, IV, public keys) show up.
+// Load budget has headroom for standard libraries that allocate differently
+static const unsigned long kLoadAllocationBudget = 12;
+static const unsigned long kValidateAllocationBudget = 0;
+static const unsigned long kValidateLicenseeSignatureAllocationBudget = 1;
+
+///
+/// \brief Allocations made by crypto backend alone for checking signatures of license
+/// issued by unittest-issuer-1
+///
+static unsigned long cryptoAllocations(const License& license, const std::string& licenseeSignature)
+{
+    const std::string keypair = kUnitTestIssuer1Keypair;
+    const RSA::PublicKey publicKey = RSA::loadPublicKey(Base64::decode(keypair.substr(keypair.find(':') + 1)));
+    std::string masterKey;
+    for (const auto c : LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY) {
+        masterKey.push_back("0123456789ABCDEF"[c >> 4]);
+        masterKey.push_back("0123456789ABCDEF"[c & 0xf]);
+    }
+    const std::string decodedSignature = licenseeSignature.empty() ? "" : Base16::decode(license.licenseeSignature());
+    const std::string iv = decodedSignature.substr(0, decodedSignature.find(':'));
+
+    AllocationCounter counter;
+    EXPECT_TRUE(RSA::verify(license.raw(), license.authoritySignature(), publicKey));
+    if (!licenseeSignature.empty()) {
+        EXPECT_EQ(AES::encrypt(licenseeSignature, masterKey, iv), Base16::decode(license.licenseeSignature()));
+    }
+    return counter.count();
+}
+
+///
+/// \brief Allocations made by json parser alone for parsing license
+///
+static unsigned long jsonAllocations(const std::string& licenseBase64)
+{
+    const std::string json = Base64::decode(licenseBase64);
+    AllocationCounter counter;
+    JsonObject::Json j = JsonObject::Json::parse(json);
+    EXPECT_TRUE(j.is_object());
+    return counter.count();
+}
+
+TEST(AllocationTest, MoveDoesNotAllocate)
+{
+    License license;
+    license.load(kSampleLicense);
+
+    std::string licensee = "a licensee name that does not fit small string buffer";
+
+    AllocationCounter counter;
+    License moved(std::move(license));
+    License assigned;
+    assigned = std::move(moved);
+    assigned.setLicensee(std::move(licensee));
+    ASSERT_EQ(counter.count(), 0UL);
+    ASSERT_EQ(assigned.additionalPayload(), "SomeRandomString");
+}
+
+TEST(AllocationTest, LoadBudget)
+{
+    License license;
+    unsigned long count = 0;
+    {
+        AllocationCounter counter;
+        license.load(kSampleLicense);
+        count = counter.count();
+    }
+    const unsigned long json = jsonAllocations(kSampleLicense);
+    std::cout << "License::load() allocations: " << count << " (json parser: " << json << ")" << std::endl;
+    ASSERT_LE(count, json + kLoadAllocationBudget);
+}
+
+TEST(AllocationTest, ValidateBudget)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const License license = licenseManager.issue("allocation-test", 24U, authority);
+    ASSERT_TRUE(licenseManager.validate(&license, false)); // warm up
+
+    unsigned long count = 0;
+    {
+        AllocationCounter counter;
+        ASSERT_TRUE(licenseManager.validate(&license, false));
+        count = counter.count();
+    }
+    const unsigned long crypto = cryptoAllocations(license, "");
+    std::cout << "BaseLicenseManager::validate() allocations: " << count << " (crypto backend: " << crypto << ")" << std::endl;
+    ASSERT_LE(count, crypto + kValidateAllocationBudget);
+}
+
+TEST(AllocationTest, ValidateLicenseeSignatureBudget)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const License license = licenseManager.issue("allocation-test", 24U, authority, "", "allocation-signature");
+    ASSERT_TRUE(licenseManager.validate(&license, true, "allocation-signature")); // warm up
+
+    unsigned long count = 0;
+    {
+        AllocationCounter counter;
+        ASSERT_TRUE(licenseManager.validate(&license, true, "allocation-signature"));
+        count = counter.count();
+    }
+    const unsigned long crypto = cryptoAllocations(license, "allocation-signature");
+    std::cout << "BaseLicenseManager::validate() with licensee signature allocations: " << count
+              << " (crypto backend: " << crypto << ")" << std::endl;
+    ASSERT_LE(count, crypto + kValidateLicenseeSignatureAllocationBudget);
+}
+
+TEST(AllocationTest, RawIsCachedUntilChanged)
+{
+    License license;
+    license.load(kSampleLicense);
+    const std::string& full = license.raw(true);
+    ASSERT_EQ(license.toString(), kSampleLicense); // exact bytes that were loaded
+
+    const std::string raw = license.raw();
+    {
+        AllocationCounter counter;
+        ASSERT_EQ(&license.raw(), &license.raw());
+        ASSERT_EQ(&license.raw(true), &full);
+        ASSERT_EQ(counter.count(), 0UL);
+    }
+    ASSERT_EQ(raw.find("authority_signature"), std::string::npos);
+
+    license.setAuthoritySignature("AB");
+    ASSERT_EQ(license.raw(), raw); // signature is not part of raw(false)
+    ASSERT_NE(license.raw(true).find("\"authority_signature\":\"AB\""), std::string::npos);
+
+    license.setLicensee("other-licensee");
+    ASSERT_NE(license.raw(), raw);
+    ASSERT_NE(license.raw().find("other-licensee"), std::string::npos);
+
+    License copy(license);
+    ASSERT_EQ(copy.raw(), license.raw());
+    LicenseManagerForTest licenseManager;
+    ASSERT_FALSE(licenseManager.validate(&copy, false));
+}
+
+TEST(AllocationTest, RawBuildFailureIsRetried)
+{
+    // thread waiting for raw bytes that other thread fails to serialize must serialize
+    // them itself instead of waiting for ever
+    License license;
+    license.setLicensee("raw-build-failure");
+    bool failed = false;
+    std::string raw;
+    std::thread failing([&]() {
+        s_failAllocations = true;
+        try {
+            license.raw();
+        } catch (const std::bad_alloc&) {
+            failed = true;
+        }
+    });
+    s_failingAllocation.wait(); // failing thread is building raw bytes and holds on
+    std::thread waiting([&]() {
+        raw = license.raw(); // waits for failing thread first
+    });
+    // failure is let go without timing assumptions, waiting thread gets raw bytes
+    // whether it was already waiting or starts after failure
+    s_failRelease.open();
+    waiting.join();
+    failing.join();
+    ASSERT_TRUE(failed);
+    ASSERT_NE(raw.find("raw-build-failure"), std::string::npos);
+}
+
+#endif // ALLOCATION_TEST_H
@@ -0,0 +1,131 @@
+//
+//  batch-signing-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef BATCH_SIGNING_TEST_H
+#define BATCH_SIGNING_TEST_H
+
+#include <string>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "test/verifying-authority-test.h"
+#include "src/crypto/base16.h"
+#include "src/crypto/base64.h"
+#include "src/crypto/sha256.h"
+#include "src/merkle-tree.h"
+
+using namespace licensepp;
+
+TEST(BatchSigningTest, Sha256)
+{
+    ASSERT_EQ(Base16::encode(SHA256::hash("abc")), "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD");
+    ASSERT_EQ(Base16::encode(SHA256::hash("")), "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855");
+    // spans more than one block and is fed in uneven pieces
+    const std::string data(1000, 'a');
+    SHA256 sha;
+    for (std::size_t i = 0; i < data.size(); i += 7) {
+        sha.update(data.substr(i, 7));
+    }
+    ASSERT_EQ(sha.digest(), SHA256::hash(data));
+}
+
+TEST(BatchSigningTest, MerkleProofs)
+{
+    for (uint32_t size = 1; size <= 17; ++size) {
+        std::vector<std::string> leaves;
+        for (uint32_t i = 0; i < size; ++i) {
+            leaves.push_back(MerkleTree::leafHash("license-" + std::to_string(i)));
+        }
+        const std::vector<std::string> copy = leaves;
+        const MerkleTree tree(std::move(leaves));
+        for (uint32_t i = 0; i < size; ++i) {
+            std::string root;
+            ASSERT_TRUE(MerkleTree::rootFromProof(copy[i], tree.proof(i), &root)) << size << " " << i;
+            ASSERT_EQ(root, tree.root()) << size << " " << i;
+            if (size > 1) {
+                ASSERT_TRUE(MerkleTree::rootFromProof(copy[(i + 1) % size], tree.proof(i), &root));
+                ASSERT_NE(root, tree.root()) << size << " " << i;
+            }
+        }
+    }
+    std::string root;
+    ASSERT_FALSE(MerkleTree::rootFromProof(MerkleTree::leafHash("x"), "", &root));
+    ASSERT_FALSE(MerkleTree::rootFromProof(MerkleTree::leafHash("x"), "1/1:", &root));
+    ASSERT_FALSE(MerkleTree::rootFromProof(MerkleTree::leafHash("x"), "0/2:", &root));
+    ASSERT_FALSE(MerkleTree::rootFromProof(MerkleTree::leafHash("x"), "0/1:ab", &root));
+    ASSERT_TRUE(MerkleTree::rootFromProof(MerkleTree::leafHash("x"), "0/1:", &root));
+}
+
+TEST(BatchSigningTest, IssueAndValidateBatch)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const std::vector<std::string> licensees = { "batch-a", "batch-b", "batch-c", "batch-d", "batch-e" };
+    std::vector<License> licenses = licenseManager.issueBatch(licensees, 24U, authority, "", "batch-signature");
+    ASSERT_EQ(licenses.size(), licensees.size());
+    for (std::size_t i = 0; i < licenses.size(); ++i) {
+        ASSERT_EQ(licenses[i].licensee(), licensees[i]);
+        ASSERT_FALSE(licenses[i].batchProof().empty());
+        ASSERT_EQ(licenses[i].authoritySignature(), licenses[0].authoritySignature());
+        ASSERT_TRUE(licenseManager.validate(&licenses[i], true, "batch-signature"));
+        ASSERT_FALSE(licenseManager.validate(&licenses[i], true, "wrong-signature"));
+
+        License loaded;
+        loaded.load(licenses[i].toString());
+        ASSERT_EQ(loaded.batchProof(), licenses[i].batchProof());
+        ASSERT_TRUE(licenseManager.validate(&loaded, true, "batch-signature"));
+        ASSERT_TRUE(authority->verifySignature(&loaded));
+    }
+
+    // tampered license is not in the batch
+    License tampered(licenses[2]);
+    tampered.setExpiryDate(tampered.expiryDate() + 3600);
+    ASSERT_FALSE(licenseManager.validate(&tampered, true, "batch-signature"));
+    ASSERT_FALSE(authority->verifySignature(&tampered));
+
+    // proof of other license
+    License swapped(licenses[2]);
+    swapped.setBatchProof(licenses[3].batchProof());
+    ASSERT_FALSE(licenseManager.validate(&swapped, true, "batch-signature"));
+
+    // signature of batch root is not signature of license
+    License unbatched(licenses[2]);
+    unbatched.setBatchProof("");
+    ASSERT_FALSE(licenseManager.validate(&unbatched, true, "batch-signature"));
+
+    // license signed on its own does not carry proof
+    License single = licenseManager.issue("single", 24U, authority);
+    ASSERT_TRUE(single.batchProof().empty());
+    ASSERT_EQ(Base64::decode(single.toString()).find("batch_proof"), std::string::npos);
+
+    std::vector<License> one = licenseManager.issueBatch({ "batch-of-one" }, 24U, authority);
+    ASSERT_EQ(one.size(), 1U);
+    ASSERT_EQ(one[0].batchProof(), "0/1:");
+    ASSERT_TRUE(licenseManager.validate(&one[0], false));
+
+    ASSERT_THROW(licenseManager.issueBatch({}, 24U, authority), LicenseException);
+    ASSERT_THROW(licenseManager.issueBatch({ "ok", "x" }, 24U, authority), LicenseException);
+}
+
+TEST(BatchSigningTest, VerifyingAuthorityValidatesBatch)
+{
+    LicenseManagerForTest issuer;
+    VerifyOnlyLicenseManager verifier;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<License> licenses = issuer.issueBatch({ "verify-batch-1", "verify-batch-2", "verify-batch-3" }, 24U, authority);
+    for (License& license : licenses) {
+        License loaded;
+        loaded.load(license.toString());
+        ASSERT_TRUE(verifier.validate(&loaded, false));
+        loaded.setLicensee("verify-batch-4");
+        ASSERT_FALSE(verifier.validate(&loaded, false));
+    }
+}
+
+#endif // BATCH_SIGNING_TEST_H
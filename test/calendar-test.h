@@ -0,0 +1,81 @@
+//
+//  calendar-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef CALENDAR_TEST_H
+#define CALENDAR_TEST_H
+
+#include <cstring>
+#include <ctime>
+#include <string>
+#include "test.h"
+#include "src/calendar.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+TEST(CalendarTest, MatchesLibc)
+{
+    char expected[64];
+    char actual[64];
+    // every ~3 days from 1901 to 2099 plus some odd seconds
+    for (int64_t seconds = -2145916800LL; seconds < 4102444800LL; seconds += 259201LL) {
+        const time_t rawTime = static_cast<time_t>(seconds);
+        struct tm tm;
+        ASSERT_NE(gmtime_r(&rawTime, &tm), nullptr);
+        std::strftime(expected, sizeof(expected), "%d %b, %Y %H:%M:%S %a %A %m %y", &tm);
+        Calendar::format(seconds, 0, "%d %b, %Y %H:%m:%s %a %A %M %y", actual, sizeof(actual));
+        ASSERT_STREQ(actual, expected);
+
+        std::strftime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%SZ", &tm);
+        ASSERT_EQ(Calendar::formatRfc3339(seconds, actual, sizeof(actual)), Calendar::kRfc3339Length);
+        ASSERT_STREQ(actual, expected);
+        int64_t parsed = 0;
+        ASSERT_TRUE(Calendar::parseRfc3339(actual, std::strlen(actual), &parsed));
+        ASSERT_EQ(parsed, seconds);
+    }
+}
+
+TEST(CalendarTest, Format)
+{
+    struct timeval tval;
+    tval.tv_sec = 1830791460L;
+    tval.tv_usec = 7000;
+    ASSERT_EQ(Utils::timevalToString(tval, "%d %b, %Y %H:%m UTC"), "06 Jan, 2028 17:11 UTC");
+    ASSERT_EQ(Utils::timevalToString(tval, "%h:%m:%s.%g %F %% %B"), "05:11:00.007 PM % January");
+    // longer than any internal buffer, must not be truncated
+    const std::string longFormat(100, 'x');
+    ASSERT_EQ(Utils::timevalToString(tval, (longFormat + " %Y").c_str()), longFormat + " 2028");
+
+    char buf[8];
+    ASSERT_EQ(Calendar::format(1830791460, 0, "%d %b, %Y", buf, sizeof(buf)), 12U);
+    ASSERT_STREQ(buf, "06 Jan,");
+    ASSERT_EQ(Calendar::formatRfc3339(1830791460, buf, sizeof(buf)), 0U);
+}
+
+TEST(CalendarTest, ParseRfc3339)
+{
+    int64_t seconds = 0;
+    const char* withOffset = "2028-01-06T19:41:00.250+02:30";
+    ASSERT_TRUE(Calendar::parseRfc3339(withOffset, std::strlen(withOffset), &seconds));
+    ASSERT_EQ(seconds, 1830791460);
+    const char* lowercase = "2028-01-06t17:11:00z";
+    ASSERT_TRUE(Calendar::parseRfc3339(lowercase, std::strlen(lowercase), &seconds));
+    ASSERT_EQ(seconds, 1830791460);
+    const char* leapDay = "2024-02-29T00:00:00Z";
+    ASSERT_TRUE(Calendar::parseRfc3339(leapDay, std::strlen(leapDay), &seconds));
+    ASSERT_EQ(seconds, 1709164800);
+
+    for (const char* invalid : { "2023-02-29T00:00:00Z", "2028-13-01T00:00:00Z", "2028-01-06T24:00:00Z",
+                                 "2028-01-06T17:11:00", "2028-01-06T17:11:00Zx", "2028-01-06T17:11:00.Z",
+                                 "2028-01-06 17:11Z", "" }) {
+        ASSERT_FALSE(Calendar::parseRfc3339(invalid, std::strlen(invalid), &seconds)) << invalid;
+    }
+}
+
+#endif // CALENDAR_TEST_H
@@ -0,0 +1,160 @@
+//
+//  concurrency-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef CONCURRENCY_TEST_H
+#define CONCURRENCY_TEST_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/utils.h"
+#include <license++/c-bindings.h>
+#include <license++/negative-cache.h>
+
+using namespace licensepp;
+
+// Objects shared by threads in these tests are the ones documented as safe to share (see
+// README "Thread Safety"). Build with -Dtsan=ON to run them under ThreadSanitizer.
+
+static const int kConcurrencyThreads = 4;
+
+template <typename Operation>
+static void runThreads(int threads, Operation op)
+{
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(op, i);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+TEST(ConcurrencyTest, NowUtc)
+{
+    const uint64_t before = Utils::nowUtc();
+    std::atomic<int> outOfRange(0);
+    runThreads(kConcurrencyThreads, [&](int) {
+        for (int i = 0; i < 2000; ++i) {
+            const uint64_t now = Utils::nowUtc();
+            if (now < before || now > before + 60) {
+                outOfRange.fetch_add(1);
+            }
+        }
+    });
+    ASSERT_EQ(outOfRange.load(), 0);
+}
+
+TEST(ConcurrencyTest, SharedLicenseManager)
+{
+    LicenseManagerForTest licenseManager;
+    NegativeCache negativeCache;
+    licenseManager.setNegativeCache(&negativeCache);
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("concurrency", 24U, authority, "", "concurrency-signature");
+
+    // loaded licenses serialize raw(false) on first validation, from whichever thread gets there first
+    License valid;
+    valid.load(issued.toString());
+    License forged;
+    forged.load(issued.toString());
+    forged.setLicensee("concurrency-forged");
+
+    std::atomic<int> unexpected(0);
+    runThreads(kConcurrencyThreads, [&](int thread) {
+        for (int i = 0; i < 20; ++i) {
+            if (licenseManager.tryValidate(&valid, true, "concurrency-signature") != LicenseError::None
+                    || licenseManager.tryValidate(&forged, true, "concurrency-signature")
+                        != LicenseError::InvalidAuthoritySignature) {
+                unexpected.fetch_add(1);
+            }
+        }
+        // authorities issue from any thread
+        License own = licenseManager.issue("concurrency-" + std::to_string(thread), 24U, authority);
+        if (!licenseManager.validate(&own, false)) {
+            unexpected.fetch_add(1);
+        }
+    });
+    ASSERT_EQ(unexpected.load(), 0);
+    ASSERT_GT(negativeCache.hits(), 0U);
+}
+
+TEST(ConcurrencyTest, CBindingsRegisterReplacedWhileValidating)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const std::string blob = licenseManager.issue("c-concurrency", 24U, authority).toString();
+
+    IssuingAuthorityParameters parameters = { "unittest-issuer-1", "Firewebkit (development)",
+                                              kUnitTestIssuer1Keypair, 24U, 1, nullptr };
+    license_key_register_init(LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY.data(), &parameters);
+    void* manager = license_manager_create();
+
+    std::atomic<bool> done(false);
+    std::atomic<int> unexpected(0);
+    std::thread replacer([&]() {
+        while (!done.load()) {
+            license_key_register_init(LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY.data(), &parameters);
+        }
+    });
+    runThreads(kConcurrencyThreads, [&](int) {
+        void* license = license_create();
+        if (license_load_status(license, blob.c_str()) != LICENSEPP_ERROR_NONE) {
+            unexpected.fetch_add(1);
+        }
+        for (int i = 0; i < 20; ++i) {
+            if (license_manager_validate_status(manager, license, 0, "") != LICENSEPP_ERROR_NONE) {
+                unexpected.fetch_add(1);
+            }
+        }
+        license_delete(license);
+    });
+    done.store(true);
+    replacer.join();
+    license_manager_delete(manager);
+    ASSERT_EQ(unexpected.load(), 0);
+}
+
+TEST(ConcurrencyTest, CBindingsAuthorityOutlivesRegister)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    const std::string blob = licenseManager.issue("c-authority", 24U, authority).toString();
+
+    IssuingAuthorityParameters parameters = { "unittest-issuer-1", "Firewebkit (development)",
+                                              kUnitTestIssuer1Keypair, 24U, 1, nullptr };
+    license_key_register_init(LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY.data(), &parameters);
+    void* manager = license_manager_create();
+    void* license = license_create();
+    ASSERT_EQ(license_load_status(license, blob.c_str()), LICENSEPP_ERROR_NONE);
+    const void* issuingAuthority = license_manager_get_issuing_authority(manager, license);
+    ASSERT_NE(issuingAuthority, nullptr);
+    ASSERT_EQ(license_manager_get_issuing_authority(manager, license), issuingAuthority);
+
+    // other thread replaces register before authority is used
+    license_key_register_init(LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY.data(), &parameters);
+    const void* current = license_manager_get_issuing_authority(manager, license);
+    ASSERT_NE(current, issuingAuthority);
+    license_manager_release_issuing_authority(current);
+
+    // handed out twice, so replaced register is still held after first release
+    license_manager_release_issuing_authority(issuingAuthority);
+    const void* issued = license_manager_issue(manager, "c-authority-issued", 24U, issuingAuthority, "", "", "");
+    ASSERT_NE(issued, nullptr);
+    ASSERT_EQ(license_manager_validate_status(manager, issued, 0, ""), LICENSEPP_ERROR_NONE);
+    license_manager_release_issuing_authority(issuingAuthority);
+    license_delete(const_cast<void*>(issued));
+    license_delete(license);
+    license_manager_delete(manager);
+}
+
+#endif // CONCURRENCY_TEST_H
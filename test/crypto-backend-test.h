@@ -0,0 +1,221 @@
+//
+//  crypto-backend-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Interop tests run for every pair of built backends, build with
+// `cmake -Dcrypto_interop=ON ..` to test ripe against openssl
+//
+
+#ifndef CRYPTO_BACKEND_TEST_H
+#define CRYPTO_BACKEND_TEST_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/crypto/crypto-backend.h"
+#include "src/crypto/sha1.h"
+
+using namespace licensepp;
+
+static std::vector<const CryptoBackend*> builtBackends()
+{
+    std::vector<const CryptoBackend*> backends;
+    for (const auto& name : CryptoBackend::available()) {
+        backends.push_back(CryptoBackend::get(name));
+    }
+    return backends;
+}
+
+static std::string keypairPart(const char* keypair, bool publicKey)
+{
+    const std::string pair(keypair);
+    const auto separatorPos = pair.find(':');
+    return CryptoBackend::instance().base64Decode(publicKey ? pair.substr(separatorPos + 1)
+                                                            : pair.substr(0, separatorPos));
+}
+
+TEST(CryptoBackendTest, DefaultBackend)
+{
+    ASSERT_FALSE(CryptoBackend::available().empty());
+    ASSERT_EQ(CryptoBackend::available()[0], CryptoBackend::instance().name());
+    ASSERT_EQ(CryptoBackend::get(CryptoBackend::instance().name()), &CryptoBackend::instance());
+    ASSERT_EQ(CryptoBackend::get("unknown"), nullptr);
+}
+
+TEST(CryptoBackendTest, FormatsMatchAcrossBackends)
+{
+    const std::string binary("\x00\x01\xfe\xfflicense++\x7f", 14);
+    const std::string key = "82F36C25A912389ABFF8091C759303D2";
+    const std::string iv = "fbb4d489c956d50e5afcf49c3536c9d5";
+    const std::string privateKey = keypairPart(kUnitTestIssuer1Keypair, false);
+    const std::string publicKey = keypairPart(kUnitTestIssuer1Keypair, true);
+    for (const CryptoBackend* a : builtBackends()) {
+        for (const CryptoBackend* b : builtBackends()) {
+            SCOPED_TRACE(std::string(a->name()) + " -> " + b->name());
+
+            ASSERT_EQ(a->base64Encode(binary), b->base64Encode(binary));
+            ASSERT_EQ(b->base64Decode(a->base64Encode(binary)), binary);
+            ASSERT_EQ(b->base64Decode("bGljZW5z\nZSsr"), "license++");
+            ASSERT_EQ(a->base16Encode(binary), b->base16Encode(binary));
+            ASSERT_EQ(b->base16Decode(a->base16Encode(binary)), binary);
+
+            // same key and iv give same cipher text
+            const std::string encrypted = a->aesEncrypt("unittest-signature", key, iv);
+            ASSERT_EQ(encrypted, b->aesEncrypt("unittest-signature", key, iv));
+            ASSERT_EQ(encrypted.substr(0, iv.size() + 1), iv + ":");
+            const std::string cipher = encrypted.substr(iv.size() + 1, encrypted.size() - iv.size() - 5);
+            ASSERT_EQ(b->aesDecrypt(cipher, key, iv), "unittest-signature");
+            ASSERT_EQ(b->aesDecrypt(a->aesEncrypt(binary, key + key, iv).substr(iv.size() + 1), key + key, iv), binary);
+
+            // PKCS#1 v1.5 signatures are deterministic
+            const std::string signature = a->rsaSign("data to sign", privateKey, "");
+            ASSERT_EQ(signature, b->rsaSign("data to sign", privateKey, ""));
+            ASSERT_TRUE(b->rsaVerify("data to sign", signature, publicKey));
+            ASSERT_FALSE(b->rsaVerify("data to sigN", signature, publicKey));
+
+            ASSERT_EQ(b->rsaDecrypt(a->rsaEncrypt("test_rsa", publicKey), privateKey, ""), "test_rsa");
+
+            // keys parsed once give same results as PEM
+            const std::shared_ptr<const ParsedPublicKey> parsed = b->parsePublicKey(publicKey);
+            ASSERT_TRUE(b->rsaVerify("data to sign", signature, *parsed));
+            ASSERT_FALSE(b->rsaVerify("data to sigN", signature, *parsed));
+            ASSERT_EQ(b->rsaDecrypt(b->rsaEncrypt("test_rsa", *parsed), privateKey, ""), "test_rsa");
+            ASSERT_EQ(a->generateKey(32).size(), 64U);
+        }
+    }
+}
+
+TEST(CryptoBackendTest, LicensesSignedByEitherBackendValidate)
+{
+    LicenseManagerForTest licenseManager;
+    const std::string privateKey = keypairPart(kUnitTestIssuer1Keypair, false);
+    const std::string publicKey = keypairPart(kUnitTestIssuer1Keypair, true);
+    const std::string masterKey = "82F36C25A912389ABFF8091C759303D2";
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+
+    // issued with default backend
+    License issued = licenseManager.issue("interop", 24U, authority, "", "interop-signature");
+    for (const CryptoBackend* backend : builtBackends()) {
+        SCOPED_TRACE(backend->name());
+        ASSERT_TRUE(backend->rsaVerify(issued.raw(), issued.authoritySignature(), publicKey));
+    }
+
+    // signed with each backend, validated with default backend
+    for (const CryptoBackend* backend : builtBackends()) {
+        SCOPED_TRACE(backend->name());
+        License license;
+        license.setLicensee(std::string("signed by ") + backend->name());
+        license.setIssuingAuthorityId(authority->id());
+        license.setIssueDate(issued.issueDate());
+        license.setExpiryDate(issued.expiryDate());
+        license.setLicenseeSignature(backend->base16Encode(backend->aesEncrypt("interop-signature", masterKey, "")));
+        license.setAuthoritySignature(backend->rsaSign(license.raw(), privateKey, ""));
+        ASSERT_TRUE(licenseManager.validate(&license, true, "interop-signature"));
+        ASSERT_FALSE(licenseManager.validate(&license, true, "wrong-signature"));
+    }
+
+    // signed with Ripe (Crypto++) by older release
+    License license;
+    license.load(kSampleLicense);
+    for (const CryptoBackend* backend : builtBackends()) {
+        SCOPED_TRACE(backend->name());
+        ASSERT_TRUE(backend->rsaVerify(license.raw(), license.authoritySignature(),
+                                       keypairPart(kSampleAuthorityKeypair, true)));
+    }
+}
+
+TEST(CryptoBackendTest, Sha1HashMany)
+{
+    ASSERT_EQ(CryptoBackend::instance().base16Encode(SHA1::hash("abc")), "A9993E364706816ABA3E25717850C26C9CD0D89D");
+    ASSERT_EQ(CryptoBackend::instance().base16Encode(SHA1::hash("")), "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709");
+    ASSERT_EQ(CryptoBackend::instance().base16Encode(SHA1::hash(std::string(1000000, 'a'))),
+              "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F");
+
+    // sizes around padding and block boundaries, lanes with different number of blocks
+    std::vector<std::string> messages;
+    for (std::size_t size : { 0, 1, 55, 56, 57, 63, 64, 65, 119, 120, 128, 300, 1000, 3, 56, 64 }) {
+        std::string message(size, '\0');
+        for (std::size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<char>(i * 31 + size);
+        }
+        messages.push_back(message);
+    }
+    for (std::size_t n = 0; n <= messages.size(); ++n) {
+        std::vector<const std::string*> pointers;
+        for (std::size_t i = 0; i < n; ++i) {
+            pointers.push_back(&messages[i]);
+        }
+        std::vector<std::string> digests(n);
+        SHA1::hashMany(pointers.data(), n, digests.data());
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(digests[i], SHA1::hash(messages[i])) << n << " messages, message " << i;
+        }
+    }
+}
+
+TEST(CryptoBackendTest, VerifyDigest)
+{
+    const std::string privateKey = keypairPart(kUnitTestIssuer1Keypair, false);
+    const std::string publicKey = keypairPart(kUnitTestIssuer1Keypair, true);
+    for (const CryptoBackend* a : builtBackends()) {
+        for (const CryptoBackend* b : builtBackends()) {
+            SCOPED_TRACE(std::string(a->name()) + " -> " + b->name());
+            const std::string signature = a->rsaSign("data to sign", privateKey, "");
+            if (!b->verifiesDigests()) {
+                ASSERT_THROW(b->rsaVerifyDigest(SHA1::hash("data to sign"), signature, publicKey), std::exception);
+                continue;
+            }
+            ASSERT_TRUE(b->rsaVerifyDigest(SHA1::hash("data to sign"), signature, publicKey));
+            ASSERT_FALSE(b->rsaVerifyDigest(SHA1::hash("data to sigN"), signature, publicKey));
+            ASSERT_FALSE(b->rsaVerifyDigest(SHA1::hash("data to sign").substr(1), signature, publicKey));
+            ASSERT_FALSE(b->rsaVerifyDigest(SHA1::hash("data to sign"), "ZZ", publicKey));
+            ASSERT_TRUE(b->rsaVerifyDigest(SHA1::hash("data to sign"), signature, *b->parsePublicKey(publicKey)));
+        }
+    }
+}
+
+TEST(CryptoBackendTest, VerifySignaturesMatchesVerifySignature)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<License> licenses = licenseManager.issueBatch({ "batch-a", "batch-b" }, 24U, authority);
+    for (int i = 0; i < 12; ++i) {
+        licenses.push_back(licenseManager.issue("verify-signatures-" + std::string(i * 20, 'x'), 24U, authority));
+    }
+    licenses[3].setLicensee("forged-licensee");
+    licenses[5].setAuthoritySignature("not hex");
+    licenses[7].setKeyId(99);
+    licenses[8].setAuthoritySignature(licenses[9].authoritySignature());
+    licenses[1].setExpiryDate(licenses[1].expiryDate() + 1);
+
+    std::vector<const License*> pointers;
+    for (const License& license : licenses) {
+        pointers.push_back(&license);
+    }
+    // every batch size so licenses are hashed in full and partly used lanes
+    for (std::size_t n = 0; n <= licenses.size(); ++n) {
+        std::unique_ptr<bool[]> results(new bool[n]);
+        authority->verifySignatures(pointers.data(), n, results.get());
+        for (std::size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(results[i], authority->verifySignature(&licenses[i])) << n << " licenses, license " << i;
+        }
+    }
+    bool results[14];
+    authority->verifySignatures(pointers.data(), licenses.size(), results);
+    ASSERT_TRUE(results[0]);
+    ASSERT_FALSE(results[1]);
+    ASSERT_TRUE(results[2]);
+    ASSERT_FALSE(results[3]);
+    ASSERT_FALSE(results[5]);
+    ASSERT_FALSE(results[7]);
+    ASSERT_FALSE(results[8]);
+    ASSERT_TRUE(results[13]);
+}
+
+#endif // CRYPTO_BACKEND_TEST_H
@@ -0,0 +1,78 @@
+//
+//  entitlements-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef ENTITLEMENTS_TEST_H
+#define ENTITLEMENTS_TEST_H
+
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/c-bindings.h>
+#include <license++/entitlements.h>
+
+using namespace licensepp;
+
+TEST(EntitlementsTest, Lookup)
+{
+    Entitlements entitlements({ "export", "reports", "export" },
+                              { { "seats", 25 }, { "projects", -1 } },
+                              { { "analytics", 1909516522U } });
+    ASSERT_EQ(entitlements.features().size(), 2U);
+    ASSERT_TRUE(entitlements.hasFeature("export"));
+    ASSERT_TRUE(entitlements.hasFeature(std::string("reports")));
+    ASSERT_FALSE(entitlements.hasFeature("import"));
+    ASSERT_FALSE(entitlements.hasFeature(""));
+    ASSERT_EQ(entitlements.limit("seats"), 25);
+    ASSERT_EQ(entitlements.limit("projects"), -1);
+    ASSERT_EQ(entitlements.limit("users", 5), 5);
+    ASSERT_EQ(entitlements.moduleExpiry("analytics"), 1909516522U);
+    ASSERT_EQ(entitlements.moduleExpiry("billing"), 0U);
+
+    entitlements.addFeature("import").setLimit("seats", 30).setModuleExpiry("billing", 1U);
+    ASSERT_TRUE(entitlements.hasFeature("import"));
+    ASSERT_TRUE(entitlements.hasFeature("export"));
+    ASSERT_EQ(entitlements.limit("seats"), 30);
+    ASSERT_EQ(entitlements.moduleExpiry("billing"), 1U);
+    ASSERT_EQ(entitlements.moduleExpiry("analytics"), 1909516522U);
+
+    ASSERT_TRUE(Entitlements().empty());
+    ASSERT_FALSE(Entitlements().hasFeature("export"));
+}
+
+TEST(EntitlementsTest, SignedWithLicense)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    Entitlements entitlements;
+    entitlements.addFeature("export").setLimit("seats", 10).setModuleExpiry("analytics", 1909516522U);
+    License issued = licenseManager.issue("licensepp unit-test", 24U, authority, "", "", "", entitlements);
+    ASSERT_NE(issued.raw().find("\"entitlements\":{\"features\":[\"export\"],\"limits\":{\"seats\":10},\"modules\":{\"analytics\":1909516522}}"),
+              std::string::npos);
+
+    License license;
+    ASSERT_TRUE(license.load(issued.toString()));
+    ASSERT_TRUE(licenseManager.validate(&license, false));
+    ASSERT_TRUE(license.entitlements().hasFeature("export"));
+    ASSERT_EQ(license.entitlements().limit("seats"), 10);
+    ASSERT_EQ(license_has_feature(&license, "export"), 1);
+    ASSERT_EQ(license_has_feature(&license, "import"), 0);
+    ASSERT_EQ(license_get_limit(&license, "seats", 0), 10);
+    ASSERT_EQ(license_get_limit(&license, "users", 3), 3);
+    ASSERT_EQ(license_get_module_expiry(&license, "analytics"), 1909516522U);
+
+    Entitlements more = license.entitlements();
+    more.setLimit("seats", 1000);
+    license.setEntitlements(more);
+    ASSERT_FALSE(licenseManager.validate(&license, false));
+
+    // licenses without entitlements are serialized as before
+    License plain = licenseManager.issue("licensepp unit-test", 24U, authority);
+    ASSERT_EQ(plain.raw().find("entitlements"), std::string::npos);
+}
+
+#endif // ENTITLEMENTS_TEST_H
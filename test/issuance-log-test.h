@@ -0,0 +1,238 @@
+//
+//  issuance-log-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef ISSUANCE_LOG_TEST_H
+#define ISSUANCE_LOG_TEST_H
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/issuance-log.h>
+#include <license++/license-bundle.h>
+
+using namespace licensepp;
+
+static std::string newIssuanceLogPath(const std::string& name)
+{
+    const std::string path = "/tmp/licensepp-unit-test-issuance-" + name + "-" + std::to_string(::getpid()) + ".log";
+    std::remove(path.c_str());
+    return path;
+}
+
+static License issuanceLogTestLicense(const std::string& licensee)
+{
+    License license;
+    license.setLicensee(licensee);
+    license.setIssuingAuthorityId("issuance-log-test");
+    license.setIssueDate(1000);
+    license.setExpiryDate(2000);
+    license.setAuthoritySignature("ABCDEF");
+    return license;
+}
+
+static void overwriteByte(const std::string& path, long offset)
+{
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, offset, SEEK_SET);
+    const int c = std::fgetc(file);
+    std::fseek(file, offset, SEEK_SET);
+    std::fputc(c ^ 0x01, file);
+    std::fclose(file);
+}
+
+TEST(IssuanceLogTest, AppendAndReopen)
+{
+    const std::string path = newIssuanceLogPath("reopen");
+    const License first = issuanceLogTestLicense("licensee-a");
+    std::string head;
+    {
+        IssuanceLog issuanceLog(path, 0);
+        ASSERT_TRUE(issuanceLog.append(first));
+        ASSERT_TRUE(issuanceLog.append(std::vector<License> { issuanceLogTestLicense("licensee-b"),
+                                                              issuanceLogTestLicense("licensee-c") }));
+        ASSERT_EQ(issuanceLog.size(), 3U);
+        ASSERT_EQ(issuanceLog.commits(), 2U);
+        head = issuanceLog.head();
+    }
+    {
+        // chain continues from last record
+        IssuanceLog issuanceLog(path, 0);
+        ASSERT_EQ(issuanceLog.size(), 3U);
+        ASSERT_EQ(issuanceLog.head(), head);
+        ASSERT_TRUE(issuanceLog.append(issuanceLogTestLicense("licensee-d")));
+        ASSERT_NE(issuanceLog.head(), head);
+    }
+    std::vector<IssuanceLog::Record> records;
+    const IssuanceLog::Verification verification = IssuanceLog::verify(path, &records);
+    ASSERT_TRUE(verification.valid);
+    ASSERT_EQ(verification.records, 4U);
+    ASSERT_EQ(records.size(), 4U);
+    ASSERT_EQ(records[0].sequence, 1U);
+    ASSERT_EQ(records[0].licensee, "licensee-a");
+    ASSERT_EQ(records[0].issuingAuthorityId, "issuance-log-test");
+    ASSERT_EQ(records[0].issueDate, 1000U);
+    ASSERT_EQ(records[0].expiryDate, 2000U);
+    ASSERT_EQ(records[0].fingerprint, LicenseBundle::fingerprint(first));
+    ASSERT_GT(records[0].loggedAtUs, 0U);
+    ASSERT_EQ(records[2].hash, head);
+    ASSERT_EQ(records[3].licensee, "licensee-d");
+    ASSERT_EQ(records[3].hash, verification.head);
+    std::remove(path.c_str());
+}
+
+TEST(IssuanceLogTest, ConcurrentAppendsShareCommits)
+{
+    const std::string path = newIssuanceLogPath("group");
+    const int threads = 8;
+    const int perThread = 50;
+    IssuanceLog issuanceLog(path, 2000);
+    std::vector<std::thread> workers;
+    std::atomic<int> failed(0);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i) {
+                if (!issuanceLog.append(issuanceLogTestLicense("licensee-" + std::to_string(t)))) {
+                    failed.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    ASSERT_EQ(failed.load(), 0);
+    ASSERT_EQ(issuanceLog.size(), static_cast<uint64_t>(threads * perThread));
+    ASSERT_LT(issuanceLog.commits(), issuanceLog.size());
+    const IssuanceLog::Verification verification = IssuanceLog::verify(path);
+    ASSERT_TRUE(verification.valid);
+    ASSERT_EQ(verification.records, static_cast<uint64_t>(threads * perThread));
+    ASSERT_EQ(verification.head, issuanceLog.head());
+    std::remove(path.c_str());
+}
+
+TEST(IssuanceLogTest, DetectsTampering)
+{
+    const std::string path = newIssuanceLogPath("tamper");
+    {
+        IssuanceLog issuanceLog(path, 0);
+        for (const char* licensee : { "licensee-a", "licensee-b", "licensee-c" }) {
+            ASSERT_TRUE(issuanceLog.append(issuanceLogTestLicense(licensee)));
+        }
+    }
+    std::vector<IssuanceLog::Record> records;
+    ASSERT_TRUE(IssuanceLog::verify(path, &records).valid);
+    // header (16) + first record (80 + 17 + 10 + 32), change licensee of second record
+    const long secondRecord = 16 + 139;
+    overwriteByte(path, secondRecord + 80 + 17);
+    const IssuanceLog::Verification verification = IssuanceLog::verify(path);
+    ASSERT_FALSE(verification.valid);
+    ASSERT_EQ(verification.records, 1U);
+    ASSERT_EQ(verification.brokenAt, static_cast<uint64_t>(secondRecord));
+    ASSERT_EQ(verification.head, records[0].hash);
+    ASSERT_EQ(verification.error, "Hash chain broken");
+    // log is not appended to after records that are not trusted
+    ASSERT_THROW(IssuanceLog issuanceLog(path), LicenseException);
+    std::remove(path.c_str());
+}
+
+TEST(IssuanceLogTest, RecoversTornAppend)
+{
+    const std::string path = newIssuanceLogPath("torn");
+    {
+        IssuanceLog issuanceLog(path, 0);
+        ASSERT_TRUE(issuanceLog.append(issuanceLogTestLicense("licensee-a")));
+        ASSERT_TRUE(issuanceLog.append(issuanceLogTestLicense("licensee-b")));
+    }
+    // crash in the middle of writing second record
+    ASSERT_EQ(::truncate(path.c_str(), 16 + 139 + 50), 0);
+    ASSERT_FALSE(IssuanceLog::verify(path).valid);
+    {
+        IssuanceLog issuanceLog(path, 0);
+        ASSERT_EQ(issuanceLog.size(), 1U);
+        ASSERT_TRUE(issuanceLog.append(issuanceLogTestLicense("licensee-c")));
+    }
+    std::vector<IssuanceLog::Record> records;
+    ASSERT_TRUE(IssuanceLog::verify(path, &records).valid);
+    ASSERT_EQ(records.size(), 2U);
+    ASSERT_EQ(records[1].sequence, 2U);
+    ASSERT_EQ(records[1].licensee, "licensee-c");
+    std::remove(path.c_str());
+}
+
+TEST(IssuanceLogTest, RecordsLicensesIssuedByManager)
+{
+    const std::string path = newIssuanceLogPath("manager");
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    IssuanceLog issuanceLog(path);
+    licenseManager.setIssuanceLog(&issuanceLog);
+    const License license = licenseManager.issue("issuance-log-licensee", 24U, authority);
+    const std::vector<License> batch = licenseManager.issueBatch({ "batch-a", "batch-b" }, 24U, authority);
+    licenseManager.setIssuanceLog(nullptr);
+    licenseManager.issue("not-logged", 24U, authority);
+    ASSERT_EQ(issuanceLog.size(), 3U);
+
+    std::vector<IssuanceLog::Record> records;
+    ASSERT_TRUE(IssuanceLog::verify(path, &records).valid);
+    ASSERT_EQ(records.size(), 3U);
+    ASSERT_EQ(records[0].licensee, "issuance-log-licensee");
+    ASSERT_EQ(records[0].issuingAuthorityId, authority->id());
+    ASSERT_EQ(records[0].expiryDate, license.expiryDate());
+    ASSERT_EQ(records[0].fingerprint, LicenseBundle::fingerprint(license));
+    ASSERT_EQ(records[2].fingerprint, LicenseBundle::fingerprint(batch[1]));
+    std::remove(path.c_str());
+}
+
+TEST(IssuanceLogTest, TryIssueReportsLogFailure)
+{
+    const std::string path = newIssuanceLogPath("try-issue");
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    IssuanceLog issuanceLog(path);
+    licenseManager.setIssuanceLog(&issuanceLog);
+    License license;
+    ASSERT_EQ(licenseManager.tryIssue(&license, "try-issue-licensee", 24U, nullptr), LicenseError::UnknownAuthority);
+    ASSERT_EQ(licenseManager.tryIssue(&license, "try-issue-licensee", 24U, authority), LicenseError::None);
+    ASSERT_EQ(license.licensee(), "try-issue-licensee");
+    ASSERT_EQ(issuanceLog.size(), 1U);
+
+    // log cannot grow past its current size so next record fails to write
+    struct stat st;
+    ASSERT_EQ(::stat(path.c_str(), &st), 0);
+    struct rlimit limit;
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &limit), 0);
+    struct rlimit capped = limit;
+    capped.rlim_cur = static_cast<rlim_t>(st.st_size);
+    void (*previousHandler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &capped), 0);
+    const LicenseError error = licenseManager.tryIssue(&license, "not-recorded", 24U, authority);
+    std::vector<License> batch;
+    const LicenseError batchError = licenseManager.tryIssueBatch(&batch, { "batch-a", "batch-b" }, 24U, authority);
+    ::setrlimit(RLIMIT_FSIZE, &limit);
+    std::signal(SIGXFSZ, previousHandler);
+
+    ASSERT_EQ(error, LicenseError::Internal);
+    ASSERT_EQ(license.licensee(), "try-issue-licensee");
+    ASSERT_EQ(batchError, LicenseError::Internal);
+    ASSERT_TRUE(batch.empty());
+    ASSERT_EQ(issuanceLog.size(), 1U);
+    licenseManager.setIssuanceLog(nullptr);
+    std::remove(path.c_str());
+}
+
+#endif // ISSUANCE_LOG_TEST_H
@@ -0,0 +1,234 @@
+//
+//  lease-server-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LEASE_SERVER_TEST_H
+#define LEASE_SERVER_TEST_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/lease-client.h>
+#include <license++/lease-server.h>
+#include "src/lease-socket-server.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+static uint64_t s_leaseTestNow = 1000000;
+
+static uint64_t leaseTestClock()
+{
+    return s_leaseTestNow;
+}
+
+static License floatingLicense(const std::string& licensee, int64_t seats)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    return licenseManager.issue(licensee, 24U, authority, "", "", "", Entitlements().setLimit("seats", seats));
+}
+
+TEST(LeaseServerTest, SeatsOfFloatingLicense)
+{
+    LeaseServer leaseServer(2, 4, 100, &leaseTestClock);
+    ASSERT_EQ(leaseServer.addLicense(floatingLicense("lease-fixed", 0)), LeaseServer::kInvalidPool);
+    const uint32_t pool = leaseServer.addLicense(floatingLicense("lease-floating", 2));
+    ASSERT_EQ(pool, 0U);
+    ASSERT_EQ(leaseServer.addLicense(floatingLicense("lease-floating", 5)), LeaseServer::kInvalidPool);
+    ASSERT_EQ(leaseServer.findPool("lease-floating"), pool);
+    ASSERT_EQ(leaseServer.findPool("lease-unknown"), LeaseServer::kInvalidPool);
+    ASSERT_EQ(leaseServer.seats(pool), 2);
+
+    Lease first;
+    Lease second;
+    Lease third;
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &first), LeaseStatus::Granted);
+    ASSERT_EQ(first.expiresAt, s_leaseTestNow + 1000);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &second), LeaseStatus::Granted);
+    ASSERT_NE(first.id, second.id);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &third), LeaseStatus::NoSeatAvailable);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 2);
+
+    ASSERT_EQ(leaseServer.release(first.id), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.release(first.id), LeaseStatus::UnknownLease);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &third), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.acquire(1, 1000, &first), LeaseStatus::UnknownPool);
+    ASSERT_EQ(leaseServer.acquire(pool, 0, &first), LeaseStatus::InvalidRequest);
+    ASSERT_EQ(leaseServer.granted(), 3U);
+    ASSERT_EQ(leaseServer.denied(), 1U);
+}
+
+TEST(LeaseServerTest, ExpiredLicense)
+{
+    LeaseServer leaseServer(1, 4, 100, &leaseTestClock);
+    License license = floatingLicense("lease-expired", 1);
+    const uint32_t pool = leaseServer.addLicense(license);
+    Lease lease;
+    Utils::setThreadClock(license.expiryDate() + 1);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &lease), LeaseStatus::LicenseExpired);
+    Utils::setThreadClock(0);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &lease), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.renew(lease.id, 1000, &lease), LeaseStatus::Granted);
+
+    // license expires while lease is held
+    Utils::setThreadClock(license.expiryDate() + 1);
+    ASSERT_EQ(leaseServer.renew(lease.id, 1000, &lease), LeaseStatus::LicenseExpired);
+    Utils::setThreadClock(0);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 0);
+    ASSERT_EQ(leaseServer.renew(lease.id, 1000, &lease), LeaseStatus::UnknownLease);
+}
+
+TEST(LeaseServerTest, TimerWheelReclaimsExpiredLeases)
+{
+    s_leaseTestNow = 1000000;
+    LeaseServer leaseServer(1, 4, 100, &leaseTestClock);
+    const uint32_t pool = leaseServer.addLicense(floatingLicense("lease-wheel", 10));
+
+    Lease renewed;
+    Lease shortened;
+    Lease released;
+    Lease longLived;
+    Lease expiring;
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &renewed), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.acquire(pool, 5000, &shortened), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &released), LeaseStatus::Granted);
+    // longer than one turn of the wheel (512 * 100 ms)
+    ASSERT_EQ(leaseServer.acquire(pool, 120000, &longLived), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.acquire(pool, 1050, &expiring), LeaseStatus::Granted);
+    ASSERT_EQ(leaseServer.release(released.id), LeaseStatus::Granted);
+
+    s_leaseTestNow += 900;
+    ASSERT_EQ(leaseServer.expire(), 0U);
+    ASSERT_EQ(leaseServer.renew(renewed.id, 1000, &renewed), LeaseStatus::Granted);
+    ASSERT_EQ(renewed.expiresAt, s_leaseTestNow + 1000);
+    ASSERT_EQ(leaseServer.renew(shortened.id, 500, &shortened), LeaseStatus::Granted);
+
+    // expiring is due at 1050 ms, reclaimed at first tick after it
+    s_leaseTestNow += 100;
+    ASSERT_EQ(leaseServer.expire(), 0U);
+    s_leaseTestNow += 100;
+    ASSERT_EQ(leaseServer.expire(), 1U);
+    ASSERT_EQ(leaseServer.renew(expiring.id, 1000, &expiring), LeaseStatus::UnknownLease);
+
+    s_leaseTestNow += 300;
+    ASSERT_EQ(leaseServer.expire(), 1U); // shortened, at 1400 ms
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 2);
+    s_leaseTestNow += 500;
+    ASSERT_EQ(leaseServer.expire(), 1U); // renewed, at 1900 ms
+    ASSERT_EQ(leaseServer.renew(renewed.id, 1000, &renewed), LeaseStatus::UnknownLease);
+
+    s_leaseTestNow += 60000;
+    ASSERT_EQ(leaseServer.expire(), 0U);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 1);
+    // long pause, more than a turn of the wheel between calls
+    s_leaseTestNow += 100000;
+    ASSERT_EQ(leaseServer.expire(), 1U);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 0);
+    ASSERT_EQ(leaseServer.reclaimed(), 4U);
+}
+
+TEST(LeaseServerTest, LeaseExpiredBeforeTickIsNotRenewed)
+{
+    s_leaseTestNow = 1000000;
+    LeaseServer leaseServer(1, 4, 100, &leaseTestClock);
+    const uint32_t pool = leaseServer.addLicense(floatingLicense("lease-late", 1));
+    Lease lease;
+    ASSERT_EQ(leaseServer.acquire(pool, 1000, &lease), LeaseStatus::Granted);
+    s_leaseTestNow += 1000;
+    ASSERT_EQ(leaseServer.renew(lease.id, 1000, &lease), LeaseStatus::UnknownLease);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 0);
+    ASSERT_EQ(leaseServer.expire(), 0U);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 0);
+}
+
+TEST(LeaseServerTest, ConcurrentLeasesNeverExceedSeats)
+{
+    LeaseServer leaseServer(1, 8);
+    const uint32_t pool = leaseServer.addLicense(floatingLicense("lease-concurrent", 3));
+    leaseServer.start();
+    std::atomic<int> holding(0);
+    std::atomic<int> mostHeld(0);
+    std::atomic<int> unexpected(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 6; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < 2000; ++i) {
+                Lease lease;
+                const LeaseStatus status = leaseServer.acquire(pool, 60000, &lease);
+                if (status == LeaseStatus::NoSeatAvailable) {
+                    continue;
+                }
+                const int held = holding.fetch_add(1) + 1;
+                int most = mostHeld.load();
+                while (held > most && !mostHeld.compare_exchange_weak(most, held)) {
+                }
+                if (status != LeaseStatus::Granted
+                        || leaseServer.renew(lease.id, 60000, &lease) != LeaseStatus::Granted) {
+                    unexpected.fetch_add(1);
+                }
+                holding.fetch_sub(1);
+                if (leaseServer.release(lease.id) != LeaseStatus::Granted) {
+                    unexpected.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    leaseServer.stop();
+    ASSERT_EQ(unexpected.load(), 0);
+    ASSERT_LE(mostHeld.load(), 3);
+    ASSERT_EQ(leaseServer.seatsInUse(pool), 0);
+}
+
+TEST(LeaseServerTest, LeasesOverSocket)
+{
+    LeaseServer leaseServer;
+    leaseServer.addLicense(floatingLicense("lease-socket", 1));
+    const std::string socketPath = "/tmp/licensepp-unit-test-lease-" + std::to_string(::getpid()) + ".sock";
+    LeaseClient unavailable(socketPath);
+    uint64_t leaseId = 0;
+    ASSERT_EQ(unavailable.acquire("lease-socket", 1000, &leaseId), LeaseStatus::Unavailable);
+
+    LeaseSocketServer server(socketPath, &leaseServer);
+    ASSERT_TRUE(server.start());
+    struct stat st;
+    ASSERT_EQ(::stat(socketPath.c_str(), &st), 0);
+    ASSERT_EQ(st.st_mode & 0777, 0660U);
+    std::thread serverThread([&]() { server.run(); });
+
+    LeaseClient client(socketPath);
+    uint32_t ttlMs = 0;
+    uint32_t seatsAvailable = 1;
+    ASSERT_EQ(client.acquire("lease-socket", 5000, &leaseId, &ttlMs, &seatsAvailable), LeaseStatus::Granted);
+    ASSERT_NE(leaseId, 0U);
+    ASSERT_EQ(ttlMs, 5000U);
+    ASSERT_EQ(seatsAvailable, 0U);
+    uint64_t otherId = 0;
+    ASSERT_EQ(client.acquire("lease-socket", 5000, &otherId), LeaseStatus::NoSeatAvailable);
+    ASSERT_EQ(otherId, 0U);
+    ASSERT_EQ(client.acquire("lease-unknown", 5000, &otherId), LeaseStatus::UnknownPool);
+    ASSERT_EQ(client.renew(leaseId, UINT32_MAX, &ttlMs), LeaseStatus::Granted);
+    ASSERT_EQ(ttlMs, LeaseServer::kMaxTtlMs);
+    ASSERT_EQ(client.release(leaseId), LeaseStatus::Granted);
+    ASSERT_EQ(client.renew(leaseId, 5000), LeaseStatus::UnknownLease);
+    // client that could not connect before connects now
+    ASSERT_EQ(unavailable.acquire("lease-socket", 1000, &leaseId), LeaseStatus::Granted);
+    ASSERT_EQ(server.requests(), 7U);
+
+    server.stop();
+    serverThread.join();
+}
+
+#endif // LEASE_SERVER_TEST_H
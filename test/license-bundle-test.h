@@ -0,0 +1,112 @@
+//
+//  license-bundle-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_BUNDLE_TEST_H
+#define LICENSE_BUNDLE_TEST_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/license-bundle.h>
+
+using namespace licensepp;
+
+TEST(LicenseBundleTest, PackAndFind)
+{
+    const std::string file = "/tmp/licensepp-unit-test-bundle-" + std::to_string(::getpid()) + ".lpb";
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<License> licenses;
+    for (int i = 0; i < 40; ++i) {
+        License license;
+        license.setLicensee("appliance-" + std::to_string(i));
+        license.setIssuingAuthorityId("bundle-authority");
+        license.setIssueDate(1000);
+        license.setExpiryDate(2000 + i);
+        license.setAuthoritySignature("ABCDEF");
+        licenses.push_back(license);
+    }
+    License renewed(licenses[7]);
+    renewed.setExpiryDate(9000);
+    licenses.push_back(renewed);
+    licenses.push_back(licenseManager.issue("issued-appliance", 24U, authority, "", "bundle-signature"));
+
+    LicenseBundle::write(file, licenses);
+    {
+        LicenseBundle bundle(file);
+        ASSERT_EQ(bundle.size(), licenses.size());
+        ASSERT_EQ(bundle.keyType(), LicenseBundle::KeyType::Licensee);
+        License license;
+        for (int i = 0; i < 40; ++i) {
+            ASSERT_TRUE(bundle.find("appliance-" + std::to_string(i), &license));
+            ASSERT_EQ(license.licensee(), "appliance-" + std::to_string(i));
+            ASSERT_EQ(license.expiryDate(), 2000U + i);
+        }
+        ASSERT_FALSE(bundle.find("appliance-40", &license));
+        ASSERT_FALSE(bundle.find("", &license));
+
+        // same key are kept in order they were written
+        std::vector<License> all = bundle.findAll("appliance-7");
+        ASSERT_EQ(all.size(), 2U);
+        ASSERT_EQ(all[0].expiryDate(), 2007U);
+        ASSERT_EQ(all[1].expiryDate(), 9000U);
+
+        ASSERT_TRUE(bundle.find("issued-appliance", &license));
+        ASSERT_EQ(license.raw(true), licenses.back().raw(true));
+        ASSERT_TRUE(licenseManager.validate(&license, true, "bundle-signature"));
+
+        ASSERT_THROW(bundle.key(bundle.size()), LicenseException);
+    }
+
+    LicenseBundle::write(file, licenses, LicenseBundle::KeyType::Fingerprint);
+    {
+        LicenseBundle bundle(file);
+        ASSERT_EQ(bundle.keyType(), LicenseBundle::KeyType::Fingerprint);
+        License license;
+        const std::string fingerprint = LicenseBundle::fingerprint(licenses[3]);
+        ASSERT_EQ(fingerprint.size(), 64U);
+        ASSERT_TRUE(bundle.find(fingerprint, &license));
+        ASSERT_EQ(license.licensee(), "appliance-3");
+        ASSERT_FALSE(bundle.find("appliance-3", &license));
+    }
+    std::remove(file.c_str());
+}
+
+TEST(LicenseBundleTest, InvalidBundle)
+{
+    const std::string file = "/tmp/licensepp-unit-test-bundle-invalid-" + std::to_string(::getpid()) + ".lpb";
+    ASSERT_THROW(LicenseBundle("/tmp/licensepp-unit-test-no-such-bundle"), LicenseException);
+    std::ofstream(file, std::ios::binary | std::ios::trunc) << "not a license bundle, just some text";
+    ASSERT_THROW(LicenseBundle bundle(file), LicenseException);
+
+    // truncated records are reported when they are read
+    License license;
+    license.setLicensee("truncated");
+    license.setIssuingAuthorityId("bundle-authority");
+    license.setAuthoritySignature("ABCDEF");
+    LicenseBundle::write(file, { license });
+    std::ifstream in(file, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::ofstream(file, std::ios::binary | std::ios::trunc) << contents.substr(0, contents.size() - 10);
+    LicenseBundle bundle(file);
+    ASSERT_EQ(bundle.size(), 1U);
+    ASSERT_THROW(bundle.find("truncated", &license), LicenseException);
+    std::remove(file.c_str());
+
+    LicenseBundle::write(file, {});
+    ASSERT_EQ(LicenseBundle(file).size(), 0U);
+    ASSERT_FALSE(LicenseBundle(file).find("anything", &license));
+    std::remove(file.c_str());
+}
+
+#endif // LICENSE_BUNDLE_TEST_H
@@ -0,0 +1,140 @@
+//
+//  license-codec-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_CODEC_TEST_H
+#define LICENSE_CODEC_TEST_H
+
+#include <string>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/crypto/base64.h"
+#include "src/license-codec.h"
+
+using namespace licensepp;
+
+// licensepp-verify-lite must read and write the same bytes as License with nlohmann::json
+
+TEST(LicenseCodecTest, WritesSameBytesAsNlohmann)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<License> licenses;
+    licenses.push_back(licenseManager.issue("codec", 24U, authority));
+    licenses.push_back(licenseManager.issue("codec \"quoted\" \\ /", 24U, authority, "", "codec-signature",
+                                            "payload\b\f\n\r\t\x01\x1f\x7f é 😀"));
+    std::vector<License> batch = licenseManager.issueBatch({ "codec-1", "codec-2" }, 24U, authority);
+    licenses.insert(licenses.end(), batch.begin(), batch.end());
+
+    License custom;
+    custom.setLicensee(std::string("nul\0inside", 10));
+    custom.setIssuingAuthorityId("codec-authority");
+    custom.setAuthoritySignature("ABCDEF");
+    custom.setIssueDate(0);
+    custom.setExpiryDate(UINT64_MAX);
+    custom.setKeyId(UINT32_MAX);
+    custom.setEntitlements(Entitlements({ "b", "a\"", "é" },
+                                        { { "min", INT64_MIN }, { "max", INT64_MAX }, { "zero", 0 }, { "\n", -1 } },
+                                        { { "module", UINT64_MAX }, { "", 1 } }));
+    licenses.push_back(custom);
+    custom.setEntitlements(Entitlements().setLimit("only", 5));
+    custom.setKeyId(0);
+    licenses.push_back(custom);
+    custom.setEntitlements(Entitlements().setModuleExpiry("only", 5));
+    licenses.push_back(custom);
+
+    for (const License& license : licenses) {
+        ASSERT_EQ(LicenseCodec::write(license, false), license.raw(false));
+        ASSERT_EQ(LicenseCodec::write(license, true), license.raw(true));
+    }
+}
+
+TEST(LicenseCodecTest, ReadsSameAsNlohmann)
+{
+    const std::string head = "{\"authority_signature\":\"AB\",\"issuing_authority\":\"a\",\"issue_date\":100,";
+    const std::string required = head + "\"expiry_date\":200,\"licensee\":\"lic\"";
+    std::vector<std::string> documents = {
+        required + "}",
+        " \r\n\t" + required + " } \n",
+        required + ",\"key_id\":7}",
+        required + ",\"key_id\":4294967295}",
+        required + ",\"key_id\":4294967296}",
+        required + ",\"key_id\":-1}",
+        required + ",\"key_id\":1.0}",
+        required + ",\"key_id\":null}",
+        required + ",\"licensee\":1}",
+        head + "\"expiry_date\":200,\"licensee\":1,\"licensee\":\"x\"}",
+        head + "\"expiry_date\":\"200\",\"licensee\":\"lic\"}",
+        head + "\"expiry_date\":-0,\"licensee\":\"lic\"}",
+        head + "\"expiry_date\":18446744073709551615,\"licensee\":\"lic\"}",
+        head + "\"expiry_date\":18446744073709551616,\"licensee\":\"lic\"}",
+        head + "\"expiry_date\":2e2,\"licensee\":\"lic\"}",
+        head + "\"licensee\":\"lic\"}",
+        head + "\"expiry_date\":200,\"licens\\u0065e\":\"escaped key\"}",
+        required + ",\"licensee_signature\":\"s\",\"batch_proof\":\"p\",\"additional_payload\":\"\"}",
+        required + ",\"licensee_signature\":null}",
+        required + ",\"batch_proof\":[]}",
+        required + ",\"additional_payload\":{}}",
+        required + ",\"additional_payload\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\\u0000\\u001f\\u00e9\\ud83d\\ude00\"}",
+        required + ",\"additional_payload\":\"raw \xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80 \xf4\x8f\xbf\xbf\"}",
+        required + ",\"additional_payload\":\"\xff\"}",
+        required + ",\"additional_payload\":\"\xc0\x80\"}",
+        required + ",\"additional_payload\":\"\xc3\"}",
+        required + ",\"additional_payload\":\"\xed\xa0\x80\"}",
+        required + ",\"additional_payload\":\"\xe0\x80\x80\"}",
+        required + ",\"additional_payload\":\"\xf4\x90\x80\x80\"}",
+        required + ",\"additional_payload\":\"\x01\"}",
+        required + ",\"additional_payload\":\"\\ud83d\"}",
+        required + ",\"entitlements\":{}}",
+        required + ",\"entitlements\":[]}",
+        required + ",\"entitlements\":{\"features\":[\"b\",\"a\",\"b\"],\"limits\":{\"x\":-9223372036854775808,"
+                   "\"y\":18446744073709551615,\"z\":-0},\"modules\":{\"m\":5},\"other\":[1,{\"a\":null}]}}",
+        required + ",\"entitlements\":{\"features\":[]}}",
+        required + ",\"entitlements\":{\"features\":[1]}}",
+        required + ",\"entitlements\":{\"features\":\"a\"}}",
+        required + ",\"entitlements\":{\"limits\":{\"x\":1.5}}}",
+        required + ",\"entitlements\":{\"limits\":{\"x\":-9223372036854775809}}}",
+        required + ",\"entitlements\":{\"limits\":{\"x\":\"s\",\"x\":1}}}",
+        required + ",\"entitlements\":{\"limits\":{\"x\":1,\"x\":\"s\"}}}",
+        required + ",\"entitlements\":{\"modules\":{\"m\":-1}}}",
+        required + ",\"entitlements\":{\"features\":[\"a\"]},\"entitlements\":{\"limits\":{\"b\":1}}}",
+        required + ",\"entitlements\":{\"features\":[\"a\"],\"features\":[\"b\"]}}",
+        required + ",\"entitlements\":{\"features\":[1],\"features\":[\"b\"]}}",
+        required + ",\"unknown\":[true,false,null,-1.5e-3,{\"nested\":[[]]}]}",
+        required + ",\"unknown\":" + std::string(62, '[') + std::string(62, ']') + "}",
+        required + ",\"unknown\":" + std::string(64, '[') + std::string(64, ']') + "}",
+        required + ",\"unknown\":" + std::string(65, '[') + std::string(65, ']') + "}",
+        required + ",\"unknown\":tru}",
+        required + ",}",
+        required + "} x",
+        required,
+        "{}",
+        "[]",
+        "\"license\"",
+        "{\"licensee\" \"lic\"}",
+    };
+
+    for (const std::string& document : documents) {
+        License expected;
+        License actual;
+        const LicenseError error = expected.tryLoad(Base64::encode(document));
+        ASSERT_EQ(LicenseCodec::read(document, &actual), error) << document;
+        if (error != LicenseError::None) {
+            // license is not changed
+            ASSERT_EQ(actual.raw(false), License().raw(false)) << document;
+            continue;
+        }
+        ASSERT_EQ(actual.raw(false), expected.raw(false)) << document;
+        ASSERT_EQ(actual.authoritySignature(), expected.authoritySignature()) << document;
+        ASSERT_EQ(actual.batchProof(), expected.batchProof()) << document;
+        ASSERT_EQ(LicenseCodec::write(actual, true), LicenseCodec::write(expected, true)) << document;
+    }
+}
+
+#endif // LICENSE_CODEC_TEST_H
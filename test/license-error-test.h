@@ -0,0 +1,133 @@
+//
+//  license-error-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_ERROR_TEST_H
+#define LICENSE_ERROR_TEST_H
+
+#include <string>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/crypto/base64.h"
+#include "src/json-object.h"
+#include <license++/c-bindings.h>
+#include <license++/license-error.h>
+
+using namespace licensepp;
+
+TEST(LicenseErrorTest, JsonSyntax)
+{
+    for (const char* json : { "{}", " { \"a\" : [1, -2.5e3, true, false, null, \"\\u00e9\\n\"] } ", "[]", "0",
+                              "{\"a\":{\"b\":{}}}", "\"\\ud83d\\ude00\"" }) {
+        ASSERT_TRUE(JsonObject::isWellFormed(json)) << json;
+    }
+    for (const char* json : { "", "{", "{\"a\"}", "{\"a\":1,}", "[1 2]", "01", "1.", "-", "tru", "{} x",
+                              "\"\\x\"", "\"\\ud83d\"", "\"\\ude00\"", "\"a\nb\"", "{a:1}", "\"abc" }) {
+        ASSERT_FALSE(JsonObject::isWellFormed(json)) << json;
+    }
+    ASSERT_TRUE(JsonObject::isWellFormed(std::string(64, '[') + std::string(64, ']')));
+    ASSERT_FALSE(JsonObject::isWellFormed(std::string(100000, '[') + std::string(100000, ']')));
+}
+
+TEST(LicenseErrorTest, TryLoad)
+{
+    static_assert(noexcept(std::declval<License&>().tryLoad(std::declval<const std::string&>())), "tryLoad() is noexcept");
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("try-load", 24U, authority);
+
+    License license;
+    ASSERT_EQ(license.tryLoad(issued.toString()), LicenseError::None);
+    ASSERT_EQ(license.raw(true), issued.raw(true));
+
+    ASSERT_EQ(license.tryLoad("not a license!"), LicenseError::InvalidBase64);
+    ASSERT_EQ(license.tryLoad(Base64::encode("{\"licensee\":")), LicenseError::InvalidFormat);
+    ASSERT_EQ(license.tryLoad(Base64::encode("[1,2]")), LicenseError::InvalidFormat);
+    ASSERT_EQ(license.tryLoad(Base64::encode("{\"licensee\":1,\"issuing_authority\":\"a\",\"authority_signature\":\"AB\","
+                                             "\"issue_date\":1,\"expiry_date\":2}")), LicenseError::InvalidFormat);
+    ASSERT_EQ(license.tryLoad(Base64::encode("{\"licensee\":\"x\",\"issuing_authority\":\"a\",\"authority_signature\":\"AB\","
+                                             "\"issue_date\":-1,\"expiry_date\":2}")), LicenseError::InvalidFormat);
+    ASSERT_EQ(license.tryLoad(Base64::encode("{\"licensee\":\"x\",\"issuing_authority\":\"a\",\"authority_signature\":\"AB\","
+                                             "\"issue_date\":1,\"expiry_date\":2,\"entitlements\":{\"limits\":{\"a\":\"b\"}}}")),
+              LicenseError::InvalidFormat);
+    // failed load does not change license
+    ASSERT_EQ(license.licensee(), "try-load");
+    ASSERT_EQ(license.raw(true), issued.raw(true));
+
+    ASSERT_THROW(license.load("not a license!"), LicenseException);
+    ASSERT_STREQ(licenseErrorMessage(LicenseError::InvalidBase64), "License is not valid base64");
+}
+
+TEST(LicenseErrorTest, TryValidate)
+{
+    LicenseManagerForTest licenseManager;
+    static_assert(noexcept(licenseManager.tryValidate(nullptr, false, std::declval<const std::string&>())),
+                  "tryValidate() is noexcept");
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License license = licenseManager.issue("try-validate", 24U, authority);
+    License signedLicense = licenseManager.issue("try-validate-signed", 24U, authority, "", "try-signature");
+
+    ASSERT_EQ(licenseManager.tryValidate(&license, false), LicenseError::None);
+    ASSERT_EQ(licenseManager.tryValidate(&signedLicense, true, "try-signature"), LicenseError::None);
+    ASSERT_EQ(licenseManager.tryValidate(&signedLicense, true, "wrong-signature"), LicenseError::InvalidLicenseeSignature);
+    ASSERT_EQ(licenseManager.tryValidate(&signedLicense, false), LicenseError::LicenseeSignatureRequired);
+
+    License unknown(license);
+    unknown.setIssuingAuthorityId("unknown-authority");
+    ASSERT_EQ(licenseManager.tryValidate(&unknown, false), LicenseError::UnknownAuthority);
+
+    License tampered(license);
+    tampered.setLicensee("try-validate-tampered");
+    ASSERT_EQ(licenseManager.tryValidate(&tampered, false), LicenseError::InvalidAuthoritySignature);
+    tampered = license;
+    tampered.setAuthoritySignature("not hex");
+    ASSERT_EQ(licenseManager.tryValidate(&tampered, false), LicenseError::InvalidAuthoritySignature);
+    tampered.setAuthoritySignature("");
+    ASSERT_EQ(licenseManager.tryValidate(&tampered, false), LicenseError::InvalidAuthoritySignature);
+
+    License retired(license);
+    retired.setKeyId(42);
+    ASSERT_EQ(licenseManager.tryValidate(&retired, false), LicenseError::KeyNotAvailable);
+
+    License badSignature(signedLicense);
+    badSignature.setLicenseeSignature("XYZ");
+    ASSERT_EQ(licenseManager.tryValidate(&badSignature, true, "try-signature"), LicenseError::InvalidLicenseeSignature);
+    ASSERT_EQ(licenseManager.tryValidate(&signedLicense, true, "wrong-signature"), LicenseError::InvalidLicenseeSignature);
+
+    Utils::setThreadClock(license.expiryDate() + 1);
+    ASSERT_EQ(licenseManager.tryValidate(&license, false), LicenseError::Expired);
+    Utils::setThreadClock(0);
+}
+
+TEST(LicenseErrorTest, CBindingsDoNotThrow)
+{
+    void* license = license_create();
+    ASSERT_EQ(license_load(license, "not a license!"), 0);
+    ASSERT_EQ(license_load_status(license, "not a license!"), LICENSEPP_ERROR_INVALID_BASE64);
+    ASSERT_STREQ(license_error_message(LICENSEPP_ERROR_EXPIRED), "License was expired");
+
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    ASSERT_EQ(license_load_status(license, licenseManager.issue("c-binding", 24U, authority).toString().c_str()),
+              LICENSEPP_ERROR_NONE);
+
+    // invalid issue is NULL instead of exception
+    ASSERT_EQ(issuing_authority_issue(authority, "x", 24U, "", "", "", ""), nullptr);
+    ASSERT_EQ(issuing_authority_validate(authority, license, "", 0, ""), 1);
+
+    // empty register
+    const unsigned char key[16] = {};
+    license_key_register_init(key, nullptr);
+    void* manager = license_manager_create();
+    ASSERT_EQ(license_manager_validate(manager, license, 0, ""), 0);
+    ASSERT_EQ(license_manager_validate_status(manager, license, 0, ""), LICENSEPP_ERROR_UNKNOWN_AUTHORITY);
+    license_manager_delete(manager);
+    license_delete(license);
+}
+
+#endif // LICENSE_ERROR_TEST_H
@@ -100,4 +100,51 @@ TEST(LicenseManagerTest, VerificationOfAdditionalPayloadUsingSecureAuthority)
     ASSERT_EQ(license.additionalPayload(),"SomeRandomString");
 }
 
+TEST(LicenseManagerTest, LoadResetsMissingFields)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority0 = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License full = licenseManager.issue("licensepp unit-test", 24U, authority0, "", "fasdf", "payload",
+                                        Entitlements().addFeature("export"));
+    License plain = licenseManager.issue("licensepp unit-test", 24U, authority0);
+
+    // same object is reused, e.g, when scanning many licenses
+    License license;
+    license.load(full.toString());
+    license.load(plain.toString());
+    ASSERT_TRUE(license.licenseeSignature().empty());
+    ASSERT_TRUE(license.additionalPayload().empty());
+    ASSERT_TRUE(license.entitlements().empty());
+    ASSERT_TRUE(licenseManager.validate(&license, false));
+}
+
+TEST(LicenseManagerTest, KeyRotation)
+{
+    const std::string keypair1 = kUnitTestIssuer1Keypair;
+    const std::string publicKey1 = keypair1.substr(keypair1.find(':') + 1);
+    IssuingAuthority original("rotating-issuer", "Rotating", kUnitTestIssuer1Keypair, 24U);
+    License oldLicense = original.issue("licensepp unit-test", 24U, "");
+    ASSERT_EQ(oldLicense.keyId(), 0U);
+    ASSERT_EQ(oldLicense.raw().find("key_id"), std::string::npos);
+
+    IssuingAuthority rotated = IssuingAuthority("rotating-issuer", "Rotating", kUnitTestIssuer2Keypair, 24U, true, 2)
+            .addPublicKey(0, publicKey1);
+    License newLicense;
+    newLicense.load(rotated.issue("licensepp unit-test", 24U, "").toString());
+    ASSERT_EQ(newLicense.keyId(), 2U);
+    ASSERT_TRUE(rotated.validate(&newLicense, "", false));
+    ASSERT_TRUE(rotated.validate(&oldLicense, "", false));
+    ASSERT_FALSE(original.validate(&newLicense, "", false));
+
+    // key id is signed
+    License forged(oldLicense);
+    forged.setKeyId(2);
+    ASSERT_FALSE(rotated.validate(&forged, "", false));
+
+    rotated.retirePublicKey(0);
+    ASSERT_FALSE(rotated.hasPublicKey(0));
+    ASSERT_FALSE(rotated.validate(&oldLicense, "", false));
+    ASSERT_TRUE(rotated.validate(&newLicense, "", false));
+}
+
 #endif // LICENSE_MANAGER_TEST_H
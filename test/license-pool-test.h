@@ -0,0 +1,114 @@
+//
+//  license-pool-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_POOL_TEST_H
+#define LICENSE_POOL_TEST_H
+
+#include <string>
+#include <vector>
+#include "test.h"
+#include "test/allocation-test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/license-pool.h>
+
+using namespace licensepp;
+
+TEST(LicensePoolTest, BulkLoadAndRelease)
+{
+    LicensePool pool;
+    std::vector<const PooledLicense*> loaded;
+    const std::vector<std::string> blobs = { kSampleLicense, "not-a-license", kSampleLicense, kSampleLicense };
+    ASSERT_EQ(pool.load(blobs, &loaded), 3U);
+    ASSERT_EQ(pool.size(), 3U);
+    ASSERT_EQ(loaded.size(), 3U);
+    ASSERT_EQ(pool.at(2), loaded[2]);
+    ASSERT_EQ(pool.capacity(), LicenseArena::kDefaultBlockSize);
+
+    License expected;
+    expected.load(kSampleLicense);
+    LicenseManagerForTest licenseManager;
+    License license;
+    for (const PooledLicense* pooled : loaded) {
+        ASSERT_EQ(pooled->licensee(), "unit-test");
+        ASSERT_EQ(pooled->additionalPayload(), "SomeRandomString");
+        ASSERT_EQ(pooled->issuingAuthorityId(), expected.issuingAuthorityId().c_str());
+        ASSERT_EQ(pooled->authoritySignature(), expected.authoritySignature().c_str());
+        ASSERT_EQ(pooled->expiryDate(), expected.expiryDate());
+        ASSERT_EQ(pooled->issueDate(), expected.issueDate());
+        ASSERT_EQ(pooled->raw(), expected.raw(true).c_str());
+        ASSERT_TRUE(pooled->entitlements().empty());
+        pooled->copyTo(&license);
+        ASSERT_EQ(license.toString(), kSampleLicense);
+        ASSERT_TRUE(licenseManager.validate(&license, false));
+    }
+
+    ASSERT_THROW(pool.load("not-a-license"), LicenseException);
+    ASSERT_EQ(pool.size(), 3U);
+
+    pool.release();
+    ASSERT_EQ(pool.size(), 0U);
+    ASSERT_EQ(pool.capacity(), 0U);
+}
+
+TEST(LicensePoolTest, TryLoadErrors)
+{
+    LicensePool pool;
+    const PooledLicense* license = nullptr;
+    ASSERT_EQ(pool.tryLoad("not-a-license", &license), LicenseError::InvalidBase64);
+    ASSERT_EQ(pool.tryLoad(Base64::encode("{\"licensee\":1}"), &license), LicenseError::InvalidFormat);
+    ASSERT_EQ(license, nullptr);
+    ASSERT_EQ(pool.size(), 0U);
+    ASSERT_EQ(pool.tryLoad(kSampleLicense, &license), LicenseError::None);
+    ASSERT_EQ(license, pool.at(0));
+}
+
+TEST(LicensePoolTest, EntitlementsAreKept)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("pool unit-test", 24U, authority, "", "", "",
+                                          Entitlements().addFeature("export").setLimit("seats", 10));
+    LicensePool pool;
+    const PooledLicense* pooled = pool.load(issued.toString());
+    ASSERT_TRUE(pooled->entitlements().hasFeature("export"));
+    ASSERT_EQ(pooled->entitlements().limit("seats"), 10);
+    // plain license loaded after one with entitlements has none
+    ASSERT_TRUE(pool.load(kSampleLicense)->entitlements().empty());
+
+    License license;
+    pooled->copyTo(&license);
+    ASSERT_EQ(license.entitlements().limit("seats"), 10);
+    ASSERT_TRUE(licenseManager.validate(&license, false));
+}
+
+TEST(LicensePoolTest, LoadDoesNotAllocatePerString)
+{
+    LicensePool pool;
+    pool.load(kSampleLicense); // warms up scratch buffers
+    unsigned long pooled = 0;
+    {
+        AllocationCounter counter;
+        for (int i = 0; i < 100; ++i) {
+            pool.load(kSampleLicense);
+        }
+        pooled = counter.count();
+    }
+    unsigned long heap = 0;
+    {
+        License license;
+        AllocationCounter counter;
+        license.load(kSampleLicense);
+        heap = counter.count();
+    }
+    // only arena blocks and growth of license list
+    ASSERT_LT(pooled, 20U);
+    ASSERT_GT(heap, 1U);
+}
+
+#endif // LICENSE_POOL_TEST_H
@@ -0,0 +1,176 @@
+//
+//  license-store-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_STORE_TEST_H
+#define LICENSE_STORE_TEST_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/license-store.h>
+
+using namespace licensepp;
+
+static std::string newStoreDirectory(const std::string& name)
+{
+    const std::string directory = "/tmp/licensepp-unit-test-store-" + name + "-" + std::to_string(::getpid());
+    if (DIR* dir = ::opendir(directory.c_str())) {
+        while (struct dirent* entry = ::readdir(dir)) {
+            if (entry->d_name[0] != '.') {
+                std::remove((directory + "/" + entry->d_name).c_str());
+            }
+        }
+        ::closedir(dir);
+    }
+    return directory;
+}
+
+static License storeTestLicense(const std::string& licensee, const std::string& authority, uint64_t expiryDate)
+{
+    License license;
+    license.setLicensee(licensee);
+    license.setIssuingAuthorityId(authority);
+    license.setIssueDate(1000);
+    license.setExpiryDate(expiryDate);
+    license.setAuthoritySignature("ABCDEF");
+    return license;
+}
+
+TEST(LicenseStoreTest, AppendAndFind)
+{
+    const std::string directory = newStoreDirectory("find");
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("licensee-a", 24U, authority);
+    LicenseStore::RecordId issuedId;
+    {
+        LicenseStore store(directory, false);
+        issuedId = store.append(issued);
+        store.append(storeTestLicense("licensee-b", "authority-x", 300));
+        store.append(storeTestLicense("licensee-a", "authority-x", 100));
+        store.flush();
+        store.append(storeTestLicense("licensee-c", "authority-y", 200));
+        ASSERT_EQ(store.size(), 4U);
+
+        ASSERT_EQ(store.findByLicensee("licensee-a").size(), 2U);
+        ASSERT_EQ(store.findByLicensee("licensee-a")[0], issuedId);
+        ASSERT_EQ(store.findByAuthority("authority-x").size(), 2U);
+        ASSERT_TRUE(store.findByLicensee("licensee-z").empty());
+        LicenseStore::RecordIds expiring = store.findExpiring(100, 301);
+        ASSERT_EQ(expiring.size(), 3U);
+        ASSERT_EQ(store.licensee(expiring[0]), "licensee-a");
+        ASSERT_EQ(store.licensee(expiring[1]), "licensee-c");
+        ASSERT_EQ(store.licensee(expiring[2]), "licensee-b");
+
+        License loaded = store.get(issuedId);
+        ASSERT_EQ(loaded.toString(), issued.toString());
+        ASSERT_TRUE(licenseManager.validate(&loaded, false));
+        ASSERT_THROW(store.get(issuedId + 1), LicenseException);
+    }
+    // reopened from persisted indexes
+    LicenseStore store(directory);
+    ASSERT_EQ(store.size(), 4U);
+    ASSERT_EQ(store.findByAuthority("authority-y").size(), 1U);
+    ASSERT_EQ(store.findExpiring(0, 250).size(), 2U);
+    ASSERT_EQ(store.get(store.findByLicensee("licensee-b")[0]).expiryDate(), 300U);
+}
+
+TEST(LicenseStoreTest, RecoversUnindexedAndTornAppends)
+{
+    const std::string directory = newStoreDirectory("recover");
+    {
+        LicenseStore store(directory);
+        store.append(storeTestLicense("licensee-a", "authority-x", 100));
+        store.flush();
+    }
+    // simulates crash: appended but indexes not persisted, then partial record
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+        LicenseStore store(directory);
+        store.append(storeTestLicense("licensee-b", "authority-x", 200));
+        std::ofstream log(directory + "/licenses.log", std::ios::binary | std::ios::app);
+        log << "LPSR-torn";
+        log.close();
+        ::_exit(0);
+    }
+    int status = -1;
+    ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+    ASSERT_EQ(status, 0);
+    LicenseStore store(directory);
+    ASSERT_EQ(store.size(), 2U);
+    ASSERT_EQ(store.findByLicensee("licensee-b").size(), 1U);
+    ASSERT_EQ(store.findExpiring(150, 250).size(), 1U);
+    LicenseStore::RecordId id = store.append(storeTestLicense("licensee-c", "authority-x", 300));
+    ASSERT_EQ(store.get(id).licensee(), "licensee-c");
+    std::ifstream damaged(directory + "/licenses.log.damaged." + std::to_string(id));
+    ASSERT_TRUE(damaged.good());
+}
+
+TEST(LicenseStoreTest, RefusesDamagedLog)
+{
+    const std::string directory = newStoreDirectory("damaged");
+    LicenseStore::RecordId damagedId;
+    {
+        LicenseStore store(directory);
+        store.append(storeTestLicense("licensee-a", "authority-x", 100));
+        damagedId = store.append(storeTestLicense("licensee-b", "authority-x", 200));
+        store.append(storeTestLicense("licensee-c", "authority-x", 300));
+    }
+    // flips a bit in payload of record in the middle of log, indexes are rebuilt on open
+    std::remove((directory + "/licensee.idx").c_str());
+    {
+        std::fstream log(directory + "/licenses.log", std::ios::binary | std::ios::in | std::ios::out);
+        log.seekg(static_cast<std::streamoff>(damagedId + 40));
+        const char c = static_cast<char>(log.get() ^ 0x01);
+        log.seekp(static_cast<std::streamoff>(damagedId + 40));
+        log.put(c);
+    }
+    std::ifstream before(directory + "/licenses.log", std::ios::binary | std::ios::ate);
+    const std::streamoff size = before.tellg();
+    ASSERT_THROW(LicenseStore store(directory), LicenseException);
+    std::ifstream after(directory + "/licenses.log", std::ios::binary | std::ios::ate);
+    ASSERT_EQ(after.tellg(), size);
+    std::ifstream damaged(directory + "/licenses.log.damaged." + std::to_string(damagedId));
+    ASSERT_FALSE(damaged.good());
+}
+
+TEST(LicenseStoreTest, LocksStore)
+{
+    const std::string directory = newStoreDirectory("lock");
+    {
+        LicenseStore store(directory);
+        ASSERT_THROW(LicenseStore other(directory), LicenseException);
+        store.append(storeTestLicense("licensee-a", "authority-x", 100));
+        store.compact(0);
+        ASSERT_THROW(LicenseStore other(directory), LicenseException);
+    }
+    LicenseStore store(directory);
+    ASSERT_EQ(store.size(), 1U);
+}
+
+TEST(LicenseStoreTest, Compact)
+{
+    const std::string directory = newStoreDirectory("compact");
+    LicenseStore store(directory, false);
+    for (uint64_t i = 0; i < 100; ++i) {
+        store.append(storeTestLicense("licensee-" + std::to_string(i % 10), "authority-x", i * 10));
+    }
+    ASSERT_EQ(store.compact(500), 50U);
+    ASSERT_EQ(store.size(), 50U);
+    ASSERT_EQ(store.findByLicensee("licensee-3").size(), 5U);
+    ASSERT_TRUE(store.findExpiring(0, 500).empty());
+    ASSERT_EQ(store.get(store.findExpiring(500, 510)[0]).expiryDate(), 500U);
+}
+
+#endif // LICENSE_STORE_TEST_H
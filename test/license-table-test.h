@@ -0,0 +1,121 @@
+//
+//  license-table-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_TABLE_TEST_H
+#define LICENSE_TABLE_TEST_H
+
+#include <random>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/license-table-kernels.h"
+#include <license++/license-table.h>
+
+using namespace licensepp;
+
+TEST(LicenseTableTest, AppendAndRow)
+{
+    LicenseManagerForTest licenseManager;
+    Entitlements entitlements;
+    entitlements.addFeature("export").setLimit("users", 10);
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License issued = licenseManager.issue("table-licensee", 24U, authority, "", "", "payload", entitlements);
+
+    LicenseTable table;
+    License other;
+    other.setLicensee("other");
+    other.setIssuingAuthorityId("another-authority");
+    other.setExpiryDate(100);
+    ASSERT_EQ(table.append(other), 0U);
+    ASSERT_EQ(table.append(issued), 1U);
+    ASSERT_EQ(table.size(), 2U);
+    ASSERT_EQ(table.licensee(0), "other");
+    ASSERT_EQ(table.licensee(1), "table-licensee");
+    ASSERT_EQ(table.additionalPayload(1), "payload");
+    ASSERT_EQ(table.expiryDates()[1], issued.expiryDate());
+    ASSERT_EQ(table.authorityCode("another-authority"), 0U);
+    ASSERT_EQ(table.authorityCode(authority->id()), 1U);
+    ASSERT_EQ(table.authorityCode("unknown"), LicenseTable::kUnknownAuthority);
+    ASSERT_EQ(table.authorityId(table.authorityCodes()[1]), authority->id());
+
+    License row = table.row(1);
+    ASSERT_EQ(row.toString(), issued.toString());
+    ASSERT_TRUE(row.entitlements().hasFeature("export"));
+    ASSERT_TRUE(licenseManager.validate(&row, false));
+    ASSERT_TRUE(table.row(0).entitlements().empty());
+
+    ASSERT_EQ(table.selectByAuthority("another-authority"), LicenseTable::Selection({ 0 }));
+    ASSERT_EQ(table.selectExpiring(0, 101), LicenseTable::Selection({ 0 }));
+    ASSERT_EQ(table.selectExpiring(0, issued.expiryDate() + 1), LicenseTable::Selection({ 0, 1 }));
+    ASSERT_EQ(table.selectExpiring(0, issued.expiryDate() + 1, authority->id()), LicenseTable::Selection({ 1 }));
+    ASSERT_TRUE(table.selectExpiring(0, 101, "unknown").empty());
+    ASSERT_TRUE(table.selectExpiring(101, 100).empty());
+}
+
+TEST(LicenseTableTest, BatchSignedRows)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::vector<License> licenses = licenseManager.issueBatch({ "batch-a", "batch-b", "batch-c" }, 24U, authority,
+                                                              "", "batch-signature");
+    LicenseTable table;
+    for (const License& license : licenses) {
+        table.append(license);
+    }
+    for (LicenseTable::RowId i = 0; i < licenses.size(); ++i) {
+        License row = table.row(i);
+        ASSERT_EQ(row.batchProof(), licenses[i].batchProof());
+        ASSERT_EQ(row.toString(), licenses[i].toString());
+        ASSERT_TRUE(licenseManager.validate(&row, true, "batch-signature"));
+    }
+}
+
+TEST(LicenseTableTest, KernelsMatchScalar)
+{
+    if (!LicenseTableKernels::avx2Supported()) {
+        return;
+    }
+#if LICENSEPP_HAS_AVX2_KERNELS
+    std::mt19937_64 random(42);
+    // odd size to cover tails, values near sign bit to cover unsigned compare
+    const std::size_t n = 1003;
+    std::vector<uint64_t> expiry(n);
+    std::vector<uint16_t> codes(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        expiry[i] = i % 7 == 0 ? 0x8000000000000000ULL + random() % 1000 : random() % 1000;
+        codes[i] = static_cast<uint16_t>(random() % 5);
+    }
+    std::vector<uint32_t> expected(n);
+    std::vector<uint32_t> actual(n);
+    const uint64_t ranges[][2] = { { 0, 1000 }, { 100, 400 }, { 500, 501 }, { 0x8000000000000000ULL, 0x8000000000000200ULL },
+                                   { 300, 0x8000000000000100ULL }, { 0, ~0ULL }, { 400, 400 }, { 600, 5 } };
+    for (const auto& range : ranges) {
+        for (std::size_t size : { n, n - 1, static_cast<std::size_t>(15), static_cast<std::size_t>(3) }) {
+            std::size_t count = LicenseTableKernels::expiringScalar(expiry.data(), size, range[0], range[1], expected.data());
+            ASSERT_EQ(LicenseTableKernels::expiringAvx2(expiry.data(), size, range[0], range[1], actual.data()), count);
+            ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+            for (std::size_t i = 0; i < count; ++i) {
+                ASSERT_TRUE(expiry[expected[i]] >= range[0] && expiry[expected[i]] < range[1]);
+            }
+
+            for (uint16_t code = 0; code < 6; ++code) {
+                count = LicenseTableKernels::expiringFromScalar(expiry.data(), codes.data(), size, range[0], range[1], code, expected.data());
+                ASSERT_EQ(LicenseTableKernels::expiringFromAvx2(expiry.data(), codes.data(), size, range[0], range[1], code, actual.data()), count);
+                ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+
+                count = LicenseTableKernels::authorityScalar(codes.data(), size, code, expected.data());
+                ASSERT_EQ(LicenseTableKernels::authorityAvx2(codes.data(), size, code, actual.data()), count);
+                ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + count, actual.begin()));
+            }
+        }
+    }
+#endif
+}
+
+#endif // LICENSE_TABLE_TEST_H
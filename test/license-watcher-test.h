@@ -0,0 +1,114 @@
+//
+//  license-watcher-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef LICENSE_WATCHER_TEST_H
+#define LICENSE_WATCHER_TEST_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/license-watcher.h>
+#include "src/utils.h"
+
+using namespace licensepp;
+
+static bool waitForGeneration(const LicenseWatcher& watcher, uint64_t generation)
+{
+    for (int i = 0; i < 300 && watcher.generation() <= generation; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return watcher.generation() > generation;
+}
+
+TEST(LicenseWatcherTest, RevalidatesWhenFileIsReplaced)
+{
+    LicenseManagerForTest licenseManager;
+    const std::string licenseFile = "/tmp/licensepp-unit-test-watcher-" + std::to_string(::getpid()) + ".lic";
+    const std::string tempFile = licenseFile + ".tmp";
+    std::ofstream(licenseFile) << kSampleLicense;
+
+    LicenseWatcher watcher(licenseFile, [&](const License& license) {
+        return licenseManager.validate(&license, false);
+    });
+    ASSERT_TRUE(watcher.start());
+    ASSERT_TRUE(watcher.isLicensed());
+    ASSERT_EQ(watcher.license()->licensee(), "unit-test");
+
+    License tampered;
+    tampered.load(kSampleLicense);
+    tampered.setLicensee("someone-else");
+    uint64_t generation = watcher.generation();
+    std::ofstream(tempFile) << tampered.toString();
+    ASSERT_EQ(std::rename(tempFile.c_str(), licenseFile.c_str()), 0);
+    ASSERT_TRUE(waitForGeneration(watcher, generation));
+    ASSERT_FALSE(watcher.isLicensed());
+    ASSERT_EQ(watcher.license()->licensee(), "someone-else");
+
+    generation = watcher.generation();
+    std::remove(licenseFile.c_str());
+    ASSERT_TRUE(waitForGeneration(watcher, generation));
+    ASSERT_FALSE(watcher.isLicensed());
+    ASSERT_EQ(watcher.license(), nullptr);
+
+    generation = watcher.generation();
+    std::ofstream(licenseFile) << kSampleLicense;
+    ASSERT_TRUE(waitForGeneration(watcher, generation));
+    ASSERT_TRUE(watcher.isLicensed());
+
+    watcher.stop();
+    std::remove(licenseFile.c_str());
+}
+
+TEST(LicenseWatcherTest, RevalidatesWhenLicenseExpires)
+{
+    const std::string licenseFile = "/tmp/licensepp-unit-test-watcher-expiry-" + std::to_string(::getpid()) + ".lic";
+    const uint64_t expiryDate = Utils::nowUtc() + 2;
+    License shortLicense;
+    shortLicense.setLicensee("watcher-expiry");
+    shortLicense.setIssuingAuthorityId("unittest-issuer-1");
+    shortLicense.setIssueDate(expiryDate - 2);
+    shortLicense.setExpiryDate(expiryDate);
+    std::ofstream(licenseFile) << shortLicense.toString();
+
+    // only expiry is checked (same check as validate()) so license does not need signature
+    std::atomic<int> calls(0);
+    std::atomic<bool> lastResult(false);
+    std::atomic<uint64_t> lastCalledAt(0);
+    LicenseWatcher watcher(licenseFile, [&](const License& license) {
+        const uint64_t now = Utils::nowUtc();
+        const bool valid = static_cast<int64_t>(license.expiryDate() - now) >= 0;
+        lastCalledAt = now;
+        lastResult = valid;
+        ++calls;
+        return valid;
+    });
+    ASSERT_TRUE(watcher.start());
+    ASSERT_TRUE(watcher.isLicensed());
+    ASSERT_EQ(calls.load(), 1);
+
+    for (int i = 0; i < 600 && calls.load() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(calls.load(), 2);
+    ASSERT_FALSE(lastResult.load());
+    ASSERT_FALSE(watcher.isLicensed());
+    // expiry + 1s, nothing in between
+    ASSERT_GT(lastCalledAt.load(), expiryDate);
+    ASSERT_LE(lastCalledAt.load(), expiryDate + 2);
+
+    watcher.stop();
+    std::remove(licenseFile.c_str());
+}
+
+#endif // LICENSE_WATCHER_TEST_H
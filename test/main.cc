@@ -9,6 +9,26 @@
 
 #include "test.h"
 #include "license-manager-test.h"
+#include "allocation-test.h"
+#include "verify-client-test.h"
+#include "license-watcher-test.h"
+#include "entitlements-test.h"
+#include "calendar-test.h"
+#include "license-table-test.h"
+#include "license-store-test.h"
+#include "tracing-test.h"
+#include "crypto-backend-test.h"
+#include "verifying-authority-test.h"
+#include "validation-recorder-test.h"
+#include "batch-signing-test.h"
+#include "license-bundle-test.h"
+#include "license-error-test.h"
+#include "negative-cache-test.h"
+#include "license-codec-test.h"
+#include "license-pool-test.h"
+#include "concurrency-test.h"
+#include "lease-server-test.h"
+#include "issuance-log-test.h"
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,105 @@
+//
+//  negative-cache-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef NEGATIVE_CACHE_TEST_H
+#define NEGATIVE_CACHE_TEST_H
+
+#include <string>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/utils.h"
+#include <license++/negative-cache.h>
+
+using namespace licensepp;
+
+TEST(NegativeCacheTest, CheapChecksComeBeforeCrypto)
+{
+    LicenseManagerForTest licenseManager;
+    NegativeCache negativeCache;
+    licenseManager.setNegativeCache(&negativeCache);
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License forged = licenseManager.issue("staged", 24U, authority);
+    forged.setLicensee("staged-forged");
+
+    // expired forgery is rejected by expiry, signature is never verified
+    Utils::setThreadClock(forged.expiryDate() + 1);
+    ASSERT_EQ(licenseManager.tryValidate(&forged, false), LicenseError::Expired);
+    Utils::setThreadClock(0);
+    ASSERT_EQ(negativeCache.size(), 0U);
+
+    License signedForged = licenseManager.issue("staged-signed", 24U, authority, "", "staged-signature");
+    signedForged.setLicensee("staged-signed-forged");
+    ASSERT_EQ(licenseManager.tryValidate(&signedForged, false), LicenseError::LicenseeSignatureRequired);
+    ASSERT_EQ(negativeCache.size(), 0U);
+
+    License malformed(forged);
+    malformed.setLicensee("x");
+    ASSERT_EQ(licenseManager.tryValidate(&malformed, false), LicenseError::InvalidFormat);
+    malformed = forged;
+    malformed.setAuthoritySignature(std::string(4096, 'A'));
+    ASSERT_EQ(licenseManager.tryValidate(&malformed, false), LicenseError::InvalidAuthoritySignature);
+    malformed = forged;
+    malformed.setIssueDate(forged.expiryDate() + 1);
+    ASSERT_EQ(licenseManager.tryValidate(&malformed, false), LicenseError::InvalidFormat);
+    ASSERT_EQ(negativeCache.size(), 0U);
+}
+
+TEST(NegativeCacheTest, RemembersForgedLicenses)
+{
+    LicenseManagerForTest licenseManager;
+    NegativeCache negativeCache;
+    licenseManager.setNegativeCache(&negativeCache);
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License license = licenseManager.issue("negative-cache", 24U, authority);
+    License forged;
+    forged.load(license.toString());
+    forged.setLicensee("negative-cache-forged");
+
+    ASSERT_EQ(licenseManager.tryValidate(&forged, false), LicenseError::InvalidAuthoritySignature);
+    ASSERT_EQ(negativeCache.size(), 1U);
+    ASSERT_EQ(negativeCache.hits(), 0U);
+    ASSERT_EQ(licenseManager.tryValidate(&forged, false), LicenseError::InvalidAuthoritySignature);
+    ASSERT_FALSE(licenseManager.validate(&forged, false));
+    ASSERT_EQ(negativeCache.hits(), 2U);
+
+    // same blob loaded again is same entry
+    License reloaded;
+    reloaded.load(forged.toString());
+    ASSERT_EQ(licenseManager.tryValidate(&reloaded, false), LicenseError::InvalidAuthoritySignature);
+    ASSERT_EQ(negativeCache.hits(), 3U);
+
+    // valid licenses are not cached
+    ASSERT_EQ(licenseManager.tryValidate(&license, false), LicenseError::None);
+    ASSERT_TRUE(licenseManager.validate(&license, false));
+    ASSERT_EQ(negativeCache.size(), 1U);
+
+    licenseManager.setNegativeCache(nullptr);
+    ASSERT_EQ(licenseManager.tryValidate(&forged, false), LicenseError::InvalidAuthoritySignature);
+    ASSERT_EQ(negativeCache.hits(), 3U);
+}
+
+TEST(NegativeCacheTest, Bounded)
+{
+    NegativeCache negativeCache(3);
+    ASSERT_EQ(negativeCache.capacity(), 4U);
+    License license;
+    license.setLicensee("bounded");
+    for (int i = 0; i < 100; ++i) {
+        license.setAdditionalPayload(std::to_string(i));
+        negativeCache.insert(&license);
+        ASSERT_TRUE(negativeCache.contains(&license));
+    }
+    ASSERT_LE(negativeCache.size(), 4U);
+    ASSERT_GT(negativeCache.size(), 0U);
+    negativeCache.clear();
+    ASSERT_EQ(negativeCache.size(), 0U);
+    ASSERT_FALSE(negativeCache.contains(&license));
+}
+
+#endif // NEGATIVE_CACHE_TEST_H
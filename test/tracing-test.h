@@ -0,0 +1,102 @@
+//
+//  tracing-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef TRACING_TEST_H
+#define TRACING_TEST_H
+
+#include <set>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/json-object.h"
+#include <license++/tracing.h>
+
+using namespace licensepp;
+
+TEST(TracingTest, ChromeTrace)
+{
+    Tracing::clear();
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::string blob = licenseManager.issue("licensepp unit-test", 24U, authority).toString();
+    std::thread worker([&]() {
+        License license;
+        license.load(blob);
+        licenseManager.validate(&license, false);
+        ASSERT_THROW(license.load("not-a-license"), LicenseException);
+    });
+    worker.join();
+
+    JsonObject::Json trace = JsonObject::Json::parse(Tracing::chromeTrace());
+    const JsonObject::Json& events = trace["traceEvents"];
+    if (!Tracing::enabled()) {
+        ASSERT_TRUE(events.empty());
+        return;
+    }
+    bool loaded = false;
+    bool failedLoad = false;
+    bool verified = false;
+    bool validated = false;
+    for (const auto& e : events) {
+        const std::string name = e["name"];
+        ASSERT_EQ(e["ph"], "X");
+        if (name == "license.load" && e["args"].count("authority") > 0) {
+            loaded = e["args"]["authority"] == authority->id() && e["args"]["result"] == true;
+        } else if (name == "license.load") {
+            // load() throws after tryLoad() span has ended with result
+            failedLoad = e["args"]["result"] == false;
+        } else if (name == "rsa.verify" && e["args"].count("authority") > 0) {
+            // inherited from enclosing authority.validate span
+            verified = e["args"]["authority"] == authority->id() && e["args"]["result"] == true;
+        } else if (name == "authority.validate") {
+            validated = e["args"]["result"] == true;
+        }
+    }
+    ASSERT_TRUE(loaded);
+    ASSERT_TRUE(failedLoad);
+    ASSERT_TRUE(verified);
+    ASSERT_TRUE(validated);
+
+    Tracing::clear();
+    ASSERT_TRUE(JsonObject::Json::parse(Tracing::chromeTrace())["traceEvents"].empty());
+}
+
+TEST(TracingTest, ReusesRingsOfExitedThreads)
+{
+    Tracing::clear();
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    std::string blob = licenseManager.issue("licensepp unit-test", 24U, authority).toString();
+    for (int i = 0; i < 8; ++i) {
+        std::thread worker([&]() {
+            License license;
+            license.load(blob);
+        });
+        worker.join();
+    }
+    std::set<int> tids;
+    std::size_t loads = 0;
+    JsonObject::Json trace = JsonObject::Json::parse(Tracing::chromeTrace());
+    for (const auto& e : trace["traceEvents"]) {
+        if (e["name"] == "license.load") {
+            tids.insert(e["tid"].get<int>());
+            ++loads;
+        }
+    }
+    if (!Tracing::enabled()) {
+        ASSERT_EQ(loads, 0U);
+        return;
+    }
+    // spans of exited threads are kept until their ring is overwritten
+    ASSERT_EQ(loads, 8U);
+    ASSERT_EQ(tids.size(), 1U);
+}
+
+#endif // TRACING_TEST_H
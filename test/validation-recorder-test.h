@@ -0,0 +1,84 @@
+//
+//  validation-recorder-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef VALIDATION_RECORDER_TEST_H
+#define VALIDATION_RECORDER_TEST_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include "src/utils.h"
+#include <license++/validation-recorder.h>
+
+using namespace licensepp;
+
+TEST(ValidationRecorderTest, RecordsAndReadsTrace)
+{
+    const std::string file = "/tmp/licensepp-unit-test-validations-" + std::to_string(::getpid()) + ".lpvt";
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License license = licenseManager.issue("recorded", 24U, authority);
+    License signedLicense = licenseManager.issue("recorded-signed", 24U, authority, "", "recorded-signature");
+    License unknown(license);
+    unknown.setIssuingAuthorityId("unknown-authority");
+    {
+        ValidationRecorder recorder(file);
+        licenseManager.setRecorder(&recorder);
+        ASSERT_TRUE(licenseManager.validate(&license, false));
+        ASSERT_TRUE(licenseManager.validate(&signedLicense, true, "recorded-signature"));
+        ASSERT_TRUE(licenseManager.validate(&license, false));
+        ASSERT_THROW(licenseManager.validate(&unknown, false), LicenseException);
+        licenseManager.setRecorder(nullptr);
+        ASSERT_TRUE(licenseManager.validate(&license, false));
+        ASSERT_EQ(recorder.size(), 4U);
+    }
+
+    ValidationTrace trace(file);
+    ASSERT_TRUE(trace.complete());
+    ASSERT_EQ(trace.blobs().size(), 3U);
+    ASSERT_EQ(trace.records().size(), 4U);
+    ASSERT_EQ(trace.blobs()[0], license.toString());
+    ASSERT_EQ(trace.records()[2].blobId, 0U);
+    ASSERT_EQ(trace.records()[0].result, ValidationRecorder::Valid);
+    ASSERT_FALSE(trace.records()[0].verifyLicenseeSignature);
+    ASSERT_TRUE(trace.records()[1].verifyLicenseeSignature);
+    ASSERT_TRUE(trace.records()[1].licenseeSignatureGiven);
+    ASSERT_EQ(trace.records()[3].result, ValidationRecorder::Exception);
+    ASSERT_GT(trace.records()[0].latencyNs, 0U);
+    ASSERT_GE(trace.records()[0].clock, license.issueDate());
+
+    // torn tail is ignored
+    std::ofstream(file, std::ios::binary | std::ios::app) << "V\x01";
+    ValidationTrace torn(file);
+    ASSERT_FALSE(torn.complete());
+    ASSERT_EQ(torn.records().size(), 4U);
+    std::remove(file.c_str());
+
+    ASSERT_THROW(ValidationTrace("/tmp/licensepp-unit-test-no-such-trace"), LicenseException);
+}
+
+TEST(ValidationRecorderTest, ThreadClock)
+{
+    LicenseManagerForTest licenseManager;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License license = licenseManager.issue("clock", 24U, authority);
+
+    Utils::setThreadClock(license.expiryDate() + 1);
+    ASSERT_EQ(Utils::nowUtc(), license.expiryDate() + 1);
+    ASSERT_FALSE(licenseManager.validate(&license, false));
+    Utils::setThreadClock(license.issueDate() + 60);
+    ASSERT_TRUE(licenseManager.validate(&license, false));
+    Utils::setThreadClock(0);
+    ASSERT_LT(Utils::nowUtc(), license.expiryDate());
+}
+
+#endif // VALIDATION_RECORDER_TEST_H
@@ -0,0 +1,115 @@
+//
+//  verify-client-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef VERIFY_CLIENT_TEST_H
+#define VERIFY_CLIENT_TEST_H
+
+#include <chrono>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/verify-client.h>
+#include "src/verify-server.h"
+
+using namespace licensepp;
+
+TEST(VerifyClientTest, FallsBackWhenDaemonIsNotRunning)
+{
+    LicenseManagerForTest licenseManager;
+    VerifyClient client("/tmp/licensepp-unit-test-no-daemon.sock");
+    ASSERT_EQ(client.query(kSampleLicense, false), VerifyClient::Status::Unavailable);
+    ASSERT_TRUE(client.validate(licenseManager, kSampleLicense, false));
+}
+
+TEST(VerifyClientTest, ValidatesUsingDaemon)
+{
+    LicenseManagerForTest licenseManager;
+    const std::string socketPath = "/tmp/licensepp-unit-test-" + std::to_string(::getpid()) + ".sock";
+    VerifyServer server(socketPath, [&](const License& license, bool verifyLicenseeSignature,
+                                        const std::string& licenseeSignature) {
+        return licenseManager.validate(&license, verifyLicenseeSignature, licenseeSignature);
+    });
+    ASSERT_TRUE(server.start());
+    struct stat st;
+    ASSERT_EQ(::stat(socketPath.c_str(), &st), 0);
+    ASSERT_EQ(st.st_mode & 0777, 0660U);
+    std::thread serverThread([&]() { server.run(); });
+
+    VerifyClient client(socketPath);
+    uint64_t expiryDate = 0;
+    ASSERT_EQ(client.query(kSampleLicense, false, "", &expiryDate), VerifyClient::Status::Valid);
+    ASSERT_EQ(expiryDate, 1909516522U);
+    ASSERT_TRUE(client.validate(licenseManager, kSampleLicense, false));
+    ASSERT_EQ(server.cacheHits(), 1U);
+
+    ASSERT_EQ(client.query("not-a-license", false), VerifyClient::Status::Malformed);
+    ASSERT_EQ(client.query("not-a-license", false), VerifyClient::Status::Malformed);
+    ASSERT_EQ(server.cacheHits(), 1U); // malformed licenses are not cached
+
+    License unknown;
+    unknown.setLicensee("unit-test");
+    unknown.setIssuingAuthorityId("unknown-authority");
+    ASSERT_EQ(client.query(unknown.toString(), false), VerifyClient::Status::UnknownAuthority);
+
+    License tampered;
+    tampered.load(kSampleLicense);
+    tampered.setLicensee("someone-else");
+    ASSERT_EQ(client.query(tampered.toString(), false), VerifyClient::Status::Invalid);
+    ASSERT_FALSE(client.validate(licenseManager, tampered.toString(), false));
+    ASSERT_EQ(server.cacheHits(), 2U);
+    ASSERT_EQ(server.requests(), 7U);
+
+    server.stop();
+    serverThread.join();
+}
+
+TEST(VerifyClientTest, DaemonCapsConnections)
+{
+    LicenseManagerForTest licenseManager;
+    const std::string socketPath = "/tmp/licensepp-unit-test-cap-" + std::to_string(::getpid()) + ".sock";
+    VerifyServer server(socketPath, [&](const License& license, bool verifyLicenseeSignature,
+                                        const std::string& licenseeSignature) {
+        return licenseManager.validate(&license, verifyLicenseeSignature, licenseeSignature);
+    }, 4096, 0600, 1);
+    ASSERT_TRUE(server.start());
+    struct stat st;
+    ASSERT_EQ(::stat(socketPath.c_str(), &st), 0);
+    ASSERT_EQ(st.st_mode & 0777, 0600U);
+    std::thread serverThread([&]() { server.run(); });
+
+    // idle connection takes the only slot
+    int holder = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size());
+    ASSERT_EQ(::connect(holder, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+    for (int i = 0; i < 100 && server.connections() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(server.connections(), 1U);
+
+    VerifyClient client(socketPath, 300);
+    ASSERT_EQ(client.query(kSampleLicense, false), VerifyClient::Status::Unavailable);
+    ASSERT_EQ(server.requests(), 0U);
+
+    ::close(holder);
+    VerifyClient patientClient(socketPath, 2000);
+    ASSERT_EQ(patientClient.query(kSampleLicense, false), VerifyClient::Status::Valid);
+
+    server.stop();
+    serverThread.join();
+    ASSERT_EQ(server.connections(), 0U);
+}
+
+#endif // VERIFY_CLIENT_TEST_H
@@ -0,0 +1,59 @@
+//
+//  verify-lite-for-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef VERIFY_LITE_FOR_TEST_H
+#define VERIFY_LITE_FOR_TEST_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <license++/base-license-manager.h>
+#include <license++/verifying-authority.h>
+
+using namespace licensepp;
+
+// licensepp-verify-lite has no IssuingAuthority, licenses below were issued by full library with
+// sample-license-authority of license-manager-for-test.h (valid until 2036)
+
+static const char* kVerifyLiteAuthorityPublicKey = "LS0tLS1CRUdJTiBQVUJMSUMgS0VZLS0tLS0KTUlJQklEQU5CZ2txaGtpRzl3MEJBUUVGQUFPQ0FRMEFNSUlCQ0FLQ0FRRUF0eGdKUENWSUhQanhWamcwNWUydQpaNURqNDNIdDF0WFlUK3VkVVRTL3RrSlgyQzltcWg    4aktQdU9mQXV6cWJQK2V6ckF0Q0hDem1ETmxmRTBqZU5TClVUZlFWbFhxNzd3UGh6ajZWNm1lWTNlcmYxK0pUY0dROTVDRTdBbFFmaW9ObVoxTU45MFI5ejZCWUkwUmlUeHUKQVFXckZqdm1rMUsrZ1RRN2dPbVV1WEx1MzJ2R2k1UTRw    SUpUcEkwTFhCSnlCclU0SzVlN1ZNWFowdCtvV1Fzdwpjcm05bkJYWVpleVRJcUZ2VmVkbEpxZTArTm9GTzN4T3VUdjFKK2Jxa1Z4UW5CVzNDZ3JHa2NPRlZFa0RDRE44CkZoZ0N5SEpJRDliZkdsNlBJUEp0TE94UlF2M21KK25qS01yc    XlrcE9panpZc3JSNFJZeURXTDZ2bWEyWlJkaVkKS1FJQkVRPT0KLS0tLS1FTkQgUFVCTElDIEtFWS0tLS0tCg==";
+
+class VerifyLiteKeyRegister
+{
+public:
+    static const std::array<unsigned char, 16> LICENSE_MANAGER_SIGNATURE_KEY;
+
+    static const std::vector<VerifyingAuthority> LICENSE_ISSUING_AUTHORITIES;
+};
+
+const std::array<unsigned char, 16> VerifyLiteKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY =
+{
+    0x82, 0xF3, 0x6C, 0x25, 0xA9, 0x12, 0x38, 0x9A, 0xBF, 0xF8, 0x09, 0x1C, 0x75, 0x93, 0x03, 0xD2
+};
+
+const std::vector<VerifyingAuthority> VerifyLiteKeyRegister::LICENSE_ISSUING_AUTHORITIES = {
+    VerifyingAuthority("sample-license-authority", kVerifyLiteAuthorityPublicKey),
+};
+
+class VerifyLiteLicenseManager : public BaseLicenseManager<VerifyLiteKeyRegister>
+{
+};
+
+static const uint64_t kVerifyLiteIssueDate = 1792384222;
+
+// licensee: verify-lite
+static const std::string kVerifyLitePlainLicense = "eyJhdXRob3JpdHlfc2lnbmF0dXJlIjoiMTU2MTEzRkM0NDVBRDNFNzUwMTc4RTA4QTZDN0FCQ0NBMzJBQUJGNjY3NkJENkM2MzQyNzY1MDM0Q0EyRTlBNEQ2MEYxOUE4OUU1NUQzODlGRjM5OEE4ODE2QUUzODNCOUREMUQ4RkNGMjM4RjM0M0NENDQzNDBBNjBERTU1Q0YzOEQ4QjM4MjlFMEJCMTFEQkUzQTBBODcxMzJBMUQ1RTUzQzg5NzQ2MDlCQkY4NzQwNjhDNkM0RkRBMkRBNzBBRTE2RUYyOTQ1MUU2QzA4N0RFQUNCREZBRDdGOEE5QTQwMEY2MzJDOTIxOTFENUJFMDAwRjJEMDhBQzAyQjA4Q0U3QTFDMjVBMzQ5QjYxNkYyQ0Y1MEVCQ0Q1QkZEM0JFMjQyMzE3NzA4NTA1RkM3NTE0N0UzMjVEOEZEMTJGQjgyN0ZCOTkwQTQ0QUQxQUMyNEZEMUE1QkI4QjU1MDdDNTlGRkREMEM2QjJENjI1NzA3QTI0RUZBREEzNjVENDQxQUFERTk3ODYyMzIzOEY5NjRFRDYzQTY1QkE3REIxQjZCOUQzRUFEQjExNDVBRUY0OUVCMTE0ODVDNkE2RkMwNTI4MjA1N0MyMkI2NDIzNUQyQUUzODZGQkFFQkZCQjIwRDIzMzQzRThCNkFBQ0FCNDdFNUQzRjhFQ0Q3OTBENUIiLCJleHBpcnlfZGF0ZSI6MjEwNzc0NDIyMiwiaXNzdWVfZGF0ZSI6MTc5MjM4NDIyMiwiaXNzdWluZ19hdXRob3JpdHkiOiJzYW1wbGUtbGljZW5zZS1hdXRob3JpdHkiLCJsaWNlbnNlZSI6InZlcmlmeS1saXRlIn0=";
+
+// licensee: verify-lite "quoted" é, licensee signature: verify-lite-signature, entitlements and
+// payload with escapes
+static const std::string kVerifyLiteRichLicense = "eyJhZGRpdGlvbmFsX3BheWxvYWQiOiJwYXlsb2FkXG5cdFx1MDAwMSDwn5iAIiwiYXV0aG9yaXR5X3NpZ25hdHVyZSI6IjA4REY3RTAwN0I0RjFFRjVGMUZGMDIxNEYyNkE0RkY2QUYwRUYyNzlDRTgwRkQyOTEzRjg5OTc3NTE1NEJBMDY4REZGQzFGNUE1MkI2MDYzMzJEQkVBMTdDNENDODU5MTlGNURFNUJEODA2QjM3NkQ1NTcwNkZBMDIxQzFEQ0U3RkI4OUFEODMyQjVCQzRCOTMxMEE2OTg1MUIyRjk0NUYxMTFBRTVDMTUwOTg0RjlERUE2OUFBQjVCMkZENDI3MDVFQjk0NjZBN0ZFN0MxRDc2MDgyQzE5OEI3MkM5NTREMDEzMDU3NUU5NjRBRTU4OTcxOTRGOUYwOURCMEIzRTY4MDI3NEEzN0QwQzM4Q0U4ODUyMzAzNzRDODFBQzAzNTAzQTU3OEY0NjdGQzU1RUVBQ0RBRTAwOTVDOEEyQjEwQjg0Q0Y0ODc0RDUzNzlERjFFNkZGOTI4MTYzRUI1NTBBRTMyRDQ5NkRFNTVCQjQwQzI1NzBGRkIwOUE3QThDQ0Y1RTg1MjVFNzRFMkM5Q0RCRUFGRkQxQjRGMzFENDc0Rjg0RDM1MTExRUFEQTRFMEZGQjhERDQ3MzM5NzNEQjI2MkY2MUZGRkYyNkYyQkU3QTBFMjVCOTA3MjM1REI3N0I2MDBCRjM3MDMyQTAyNjQ1OTNFRDZFRUM4NTdCRkQxIiwiZW50aXRsZW1lbnRzIjp7ImZlYXR1cmVzIjpbImV4cG9ydCIsInN5bmMiXSwibGltaXRzIjp7Im5lZ2F0aXZlIjotMywic2VhdHMiOjV9LCJtb2R1bGVzIjp7InJlcG9ydHMiOjIxMDc3NDQyMjJ9fSwiZXhwaXJ5X2RhdGUiOjIxMDc3NDQyMjIsImlzc3VlX2RhdGUiOjE3OTIzODQyMjIsImlzc3VpbmdfYXV0aG9yaXR5Ijoic2FtcGxlLWxpY2Vuc2UtYXV0aG9yaXR5IiwibGljZW5zZWUiOiJ2ZXJpZnktbGl0ZSBcInF1b3RlZFwiIMOpIiwibGljZW5zZWVfc2lnbmF0dXJlIjoiNjUzOTMzNjM2MjM0MzAzNjYzMzUzNjYxMzMzMDM3MzEzOTMxMzI2MjYyNjEzNzM3MzUzNzMwMzczMDM1NjMzNDNBNzU2NDM2NDUyRjM3NDY1MjYxNEQ3MzMzNEM1MjU2NDc1NjRBMzM3MjcyMzQ0Njc3MzI2NDY2N0E1MjZENDQ2QTQ3MzIyRjc0NjI1MzU4NjE1NTc2NDkzRDBEMEEwRDBBIn0=";
+
+// second license of batch verify-lite-1, verify-lite-2, verify-lite-3
+static const std::string kVerifyLiteBatchLicense = "eyJhdXRob3JpdHlfc2lnbmF0dXJlIjoiMTUxM0FCNEVFNTRDRjAwREE4NzNBNDk2M0E3OTNCMEUyNkEyNEM1QTdEQTdERkJCMDE0NzY5NTlGNzZCOUIwMDVFN0I3MTE3MTc2OTEwQjgxMEFGNzAzOEJENDM4MkRDN0Q2MjE1ODg2M0U4RDNDRTgwQzY4QkE5RjBDMUMyQzlBMzcwNzNBNjVFMzkzMTNBOTRBQ0VBQ0MyNjE4ODMwMjcxREU1NUQwNDI2NEMxNUYwQzI1ODU2RjNBQzRDNjRBMTY0MDBFQjA5QjVGNTA0NjExQjY4OTA5N0RFOUFEQTM2OENFNzY1RDkzN0QzNUFEQkQ3ODMwMDA5QTFBM0VCNUIxOUQ5RDM3NDgxODFFMUU3Qzc3NjVEQzI5RDkzM0VCRDQzMjhFOTBENDlEMTcyNTg1QTNCMTUxMUM0Qjc2ODBDMjIzQ0EzRjdCQkY3NEMwQjJDRDQ5RDlDM0M0RDY1Mzk4N0RENEEwRDY2NjFEODRGREVCNjhGRjc0ODIxNkFDMDBFNzUzRUE1NzVGOTlGNEM5MDk2M0Q5MDU0MkExQzEzQTAyNDM5OUQzNDBDNkQwMjZGNTQ2NzMzNkVGQTRCQkVBMDdCMDk4NzIzMzhEQUE5QzI1RjQ0NEI1NzIxN0VCRjEwQUI2MjU4NDY4MUM0MjU4RjQzODQxNkNFRTlGQkEiLCJiYXRjaF9wcm9vZiI6IjEvMzowNDE1OTVlYjViNDJjZWE3MjMzMGIwMjkwMjgyZTQyMjhjYTFhMTVhMjM1YzhlMGU4Nzc2YzJkOGMzYmE5YTc1OWUzNGFiMGZlMGZkZDZiNmY0ZmI1ODNhY2FiMWMwNWQ0ZTc3ZWJlOTc1OWNjMDg5OWFlYzRhMmZmZjNiNDI5NyIsImV4cGlyeV9kYXRlIjoyMTA3NzQ0MjIyLCJpc3N1ZV9kYXRlIjoxNzkyMzg0MjIyLCJpc3N1aW5nX2F1dGhvcml0eSI6InNhbXBsZS1saWNlbnNlLWF1dGhvcml0eSIsImxpY2Vuc2VlIjoidmVyaWZ5LWxpdGUtMiJ9";
+
+#endif // VERIFY_LITE_FOR_TEST_H
@@ -0,0 +1,16 @@
+//
+//  verify-lite-main.cc
+//  License++ Unit Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#include "test.h"
+#include "verify-lite-test.h"
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return ::testing::UnitTest::GetInstance()->Run();
+}
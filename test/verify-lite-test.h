@@ -0,0 +1,106 @@
+//
+//  verify-lite-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef VERIFY_LITE_TEST_H
+#define VERIFY_LITE_TEST_H
+
+#include <string>
+#include "test.h"
+#include "test/verify-lite-for-test.h"
+#include "src/crypto/base64.h"
+#include "src/utils.h"
+#include <license++/license-exception.h>
+
+using namespace licensepp;
+
+class VerifyLiteTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Utils::setThreadClock(kVerifyLiteIssueDate + 3600);
+    }
+
+    void TearDown() override
+    {
+        Utils::setThreadClock(0);
+    }
+
+    VerifyLiteLicenseManager licenseManager;
+};
+
+TEST_F(VerifyLiteTest, LoadsAndValidates)
+{
+    License plain;
+    ASSERT_EQ(plain.tryLoad(kVerifyLitePlainLicense), LicenseError::None);
+    ASSERT_EQ(plain.toString(), kVerifyLitePlainLicense);
+    ASSERT_EQ(plain.licensee(), "verify-lite");
+    ASSERT_EQ(plain.issuingAuthorityId(), "sample-license-authority");
+    ASSERT_EQ(plain.issueDate(), kVerifyLiteIssueDate);
+    ASSERT_TRUE(plain.entitlements().empty());
+    ASSERT_EQ(licenseManager.tryValidate(&plain, false), LicenseError::None);
+    ASSERT_TRUE(licenseManager.validate(&plain, false));
+
+    License rich;
+    rich.load(kVerifyLiteRichLicense);
+    ASSERT_EQ(rich.licensee(), "verify-lite \"quoted\" é");
+    ASSERT_EQ(rich.licenseeSignature().empty(), false);
+    ASSERT_EQ(rich.additionalPayload(), "payload\n\t\x01 😀");
+    ASSERT_TRUE(rich.entitlements().hasFeature("export"));
+    ASSERT_TRUE(rich.entitlements().hasFeature("sync"));
+    ASSERT_EQ(rich.entitlements().limit("seats"), 5);
+    ASSERT_EQ(rich.entitlements().limit("negative"), -3);
+    ASSERT_EQ(rich.entitlements().moduleExpiry("reports"), rich.expiryDate());
+    ASSERT_EQ(licenseManager.tryValidate(&rich, true, "verify-lite-signature"), LicenseError::None);
+    ASSERT_EQ(licenseManager.tryValidate(&rich, false), LicenseError::LicenseeSignatureRequired);
+    ASSERT_EQ(licenseManager.tryValidate(&rich, true, "wrong-signature"), LicenseError::InvalidLicenseeSignature);
+
+    License batch;
+    ASSERT_EQ(batch.tryLoad(kVerifyLiteBatchLicense), LicenseError::None);
+    ASSERT_EQ(batch.licensee(), "verify-lite-2");
+    ASSERT_FALSE(batch.batchProof().empty());
+    ASSERT_EQ(licenseManager.tryValidate(&batch, false), LicenseError::None);
+}
+
+TEST_F(VerifyLiteTest, SerializesSignedBytes)
+{
+    // signature is verified over JSON written by built-in writer once license is changed
+    for (const std::string& blob : { kVerifyLitePlainLicense, kVerifyLiteRichLicense, kVerifyLiteBatchLicense }) {
+        License license;
+        license.load(blob);
+        const std::string licensee = license.licensee();
+        const std::string raw = license.raw(true);
+        license.setLicensee("someone-else");
+        ASSERT_EQ(licenseManager.tryValidate(&license, true, "verify-lite-signature"),
+                  LicenseError::InvalidAuthoritySignature);
+        license.setLicensee(licensee);
+        ASSERT_EQ(license.raw(true), raw);
+        ASSERT_EQ(licenseManager.tryValidate(&license, true, "verify-lite-signature"), LicenseError::None);
+    }
+}
+
+TEST_F(VerifyLiteTest, RejectsInvalidLicenses)
+{
+    License license;
+    license.load(kVerifyLitePlainLicense);
+    ASSERT_EQ(license.tryLoad("not a license!"), LicenseError::InvalidBase64);
+    ASSERT_EQ(license.tryLoad(Base64::encode("[1]")), LicenseError::InvalidFormat);
+    ASSERT_EQ(license.tryLoad(Base64::encode("{\"licensee\":\"x\"}")), LicenseError::InvalidFormat);
+    ASSERT_THROW(license.load(Base64::encode("{\"licensee\":")), LicenseException);
+    ASSERT_EQ(license.licensee(), "verify-lite");
+
+    Utils::setThreadClock(license.expiryDate() + 1);
+    ASSERT_EQ(licenseManager.tryValidate(&license, false), LicenseError::Expired);
+
+    License unknown(license);
+    unknown.setIssuingAuthorityId("unknown-authority");
+    ASSERT_EQ(licenseManager.tryValidate(&unknown, false), LicenseError::UnknownAuthority);
+}
+
+#endif // VERIFY_LITE_TEST_H
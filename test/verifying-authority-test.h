@@ -0,0 +1,101 @@
+//
+//  verifying-authority-test.h
+//  License++ Tests
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+
+#ifndef VERIFYING_AUTHORITY_TEST_H
+#define VERIFYING_AUTHORITY_TEST_H
+
+#include <string>
+#include <vector>
+#include "test.h"
+#include "test/license-manager-for-test.h"
+#include <license++/verifying-authority.h>
+
+using namespace licensepp;
+
+static std::string publicKeyOf(const char* keypair)
+{
+    const std::string pair(keypair);
+    return pair.substr(pair.find(':') + 1);
+}
+
+class VerifyOnlyKeyRegister
+{
+public:
+    static const std::array<unsigned char, 16> LICENSE_MANAGER_SIGNATURE_KEY;
+
+    static const std::vector<VerifyingAuthority> LICENSE_ISSUING_AUTHORITIES;
+};
+
+const std::array<unsigned char, 16> VerifyOnlyKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY =
+        LicenseManagerKeyRegister::LICENSE_MANAGER_SIGNATURE_KEY;
+
+const std::vector<VerifyingAuthority> VerifyOnlyKeyRegister::LICENSE_ISSUING_AUTHORITIES = {
+    VerifyingAuthority("unittest-issuer-1", publicKeyOf(kUnitTestIssuer1Keypair)),
+    VerifyingAuthority("rotating-issuer", publicKeyOf(kUnitTestIssuer2Keypair), true, 2)
+        .addPublicKey(0, publicKeyOf(kUnitTestIssuer1Keypair)),
+    VerifyingAuthority("sample-license-authority", publicKeyOf(kSampleAuthorityKeypair), false),
+    VerifyingAuthority("broken-authority", "not-a-key"),
+};
+
+class VerifyOnlyLicenseManager : public BaseLicenseManager<VerifyOnlyKeyRegister>
+{
+};
+
+TEST(VerifyingAuthorityTest, ValidatesLicensesIssuedWithKeypair)
+{
+    static_assert(std::is_same<VerifyOnlyLicenseManager::Authority, VerifyingAuthority>::value,
+                  "authority type is taken from register");
+    ASSERT_LT(sizeof(VerifyingAuthority), sizeof(IssuingAuthority));
+
+    LicenseManagerForTest issuer;
+    VerifyOnlyLicenseManager verifier;
+    const IssuingAuthority* authority = &(LicenseManagerKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    License license = issuer.issue("verify-only", 24U, authority, "", "verify-only-signature");
+    ASSERT_EQ(verifier.getIssuingAuthority(&license), &VerifyOnlyKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(0));
+    ASSERT_TRUE(verifier.validate(&license, true, "verify-only-signature"));
+    ASSERT_FALSE(verifier.validate(&license, true, "wrong-signature"));
+    ASSERT_FALSE(verifier.validate(&license, false));
+    ASSERT_TRUE(verifier.getIssuingAuthority(&license)->verifySignature(&license));
+
+    License tampered(license);
+    tampered.setLicensee("someone-else");
+    ASSERT_FALSE(verifier.validate(&tampered, true, "verify-only-signature"));
+
+    // inactive authority still validates
+    License sample;
+    sample.load(kSampleLicense);
+    ASSERT_TRUE(verifier.validate(&sample, false));
+
+    License unknown(license);
+    unknown.setIssuingAuthorityId("unknown-authority");
+    ASSERT_THROW(verifier.validate(&unknown, false), LicenseException);
+    unknown.setIssuingAuthorityId("broken-authority");
+    ASSERT_FALSE(verifier.validate(&unknown, true, "verify-only-signature"));
+}
+
+TEST(VerifyingAuthorityTest, RotatedKeys)
+{
+    IssuingAuthority original("rotating-issuer", "Rotating", kUnitTestIssuer1Keypair, 24U);
+    IssuingAuthority rotated("rotating-issuer", "Rotating", kUnitTestIssuer2Keypair, 24U, true, 2);
+    License oldLicense = original.issue("licensepp unit-test", 24U, "");
+    License newLicense = rotated.issue("licensepp unit-test", 24U, "");
+
+    VerifyOnlyLicenseManager verifier;
+    ASSERT_TRUE(verifier.validate(&oldLicense, false));
+    ASSERT_TRUE(verifier.validate(&newLicense, false));
+
+    VerifyingAuthority authority = VerifyOnlyKeyRegister::LICENSE_ISSUING_AUTHORITIES.at(1);
+    ASSERT_TRUE(authority.hasPublicKey(0));
+    authority.retirePublicKey(0);
+    ASSERT_FALSE(authority.hasPublicKey(0));
+    ASSERT_FALSE(authority.validate(&oldLicense, "", false));
+    ASSERT_TRUE(authority.validate(&newLicense, "", false));
+}
+
+#endif // VERIFYING_AUTHORITY_TEST_H
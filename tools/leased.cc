@@ -0,0 +1,112 @@
+//
+//  leased.cc
+//  License++ lease server
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Grants, renews and expires leases on seats of floating licenses (licenses with "seats"
+// limit) to LeaseClient over UNIX socket. Licenses are validated with your key register
+// (see cli/licensing/license-manager-key-register.cc) when server starts.
+//
+// Usage: ./licensepp-leased --license <file> [--license <file>...] [--signature <signature>]
+//                           [--socket <path>] [--tick-ms <ms>] [--socket-mode <octal>]
+//                           [--max-connections <n>]
+//
+
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <license++/lease-client.h>
+#include <license++/lease-server.h>
+#include "cli/licensing/license-manager.h"
+#include "src/lease-socket-server.h"
+
+static licensepp::LeaseSocketServer* s_server = nullptr;
+
+static void handleSignal(int)
+{
+    if (s_server != nullptr) {
+        s_server->stop();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string socketPath = licensepp::LeaseClient::kDefaultSocketPath;
+    std::vector<std::string> licenseFiles;
+    std::string signature;
+    unsigned int tickMs = 100;
+    unsigned int socketMode = licensepp::SocketServer::kDefaultSocketMode;
+    std::size_t maxConnections = licensepp::SocketServer::kDefaultMaxConnections;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--license" && i + 1 < argc) {
+            licenseFiles.push_back(argv[++i]);
+        } else if (arg == "--signature" && i + 1 < argc) {
+            signature = argv[++i];
+        } else if (arg == "--tick-ms" && i + 1 < argc) {
+            tickMs = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--socket-mode" && i + 1 < argc) {
+            socketMode = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 8));
+        } else if (arg == "--max-connections" && i + 1 < argc) {
+            maxConnections = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--help") {
+            std::cout << "USAGE: licensepp-leased --license <file> [--license <file>...] [--signature <signature>]"
+                         " [--socket <path>] [--tick-ms <ms>] [--socket-mode <octal>] [--max-connections <n>]"
+                      << std::endl;
+            return 0;
+        }
+    }
+
+    LicenseManager licenseManager;
+    licensepp::LeaseServer leaseServer(licenseFiles.size(), 64, tickMs);
+    for (const std::string& licenseFile : licenseFiles) {
+        std::ifstream stream(licenseFile);
+        const std::string licenseBase64((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        licensepp::License license;
+        if (!stream.is_open() || license.tryLoad(licenseBase64) != licensepp::LicenseError::None
+                || licenseManager.tryValidate(&license, !license.licenseeSignature().empty(), signature)
+                    != licensepp::LicenseError::None) {
+            std::cerr << "Invalid license " << licenseFile << std::endl;
+            return 1;
+        }
+        if (leaseServer.addLicense(license) == licensepp::LeaseServer::kInvalidPool) {
+            std::cerr << "License " << licenseFile << " is not floating license (no seats) or licensee "
+                      << license.licensee() << " is repeated" << std::endl;
+            return 1;
+        }
+        std::cout << "Serving " << license.entitlements().limit("seats") << " seats of " << license.licensee()
+                  << std::endl;
+    }
+    if (licenseFiles.empty()) {
+        std::cerr << "No --license given" << std::endl;
+        return 1;
+    }
+
+    licensepp::LeaseSocketServer server(socketPath, &leaseServer, socketMode, maxConnections);
+    if (!server.start()) {
+        return 1;
+    }
+    s_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    leaseServer.start();
+    std::cout << "licensepp-leased listening on " << socketPath << std::endl;
+    server.run();
+    leaseServer.stop();
+    std::cout << "licensepp-leased stopped after " << server.requests() << " requests ("
+              << leaseServer.granted() << " granted, " << leaseServer.denied() << " denied, "
+              << leaseServer.reclaimed() << " reclaimed)" << std::endl;
+    s_server = nullptr;
+    return 0;
+}
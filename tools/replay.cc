@@ -0,0 +1,192 @@
+//
+//  replay.cc
+//  License++ validation replay
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Replays validations recorded by ValidationRecorder (BaseLicenseManager::setRecorder())
+// and reports throughput and latency percentiles. Each validation runs with clock it was
+// recorded with so expiry results match production. Licensee signatures are not recorded,
+// validations that verified one are replayed with placeholder signature (same work, but
+// result is not compared). Like the CLI, replay is linked with your key register
+// (see cli/licensing/license-manager-key-register.cc)
+//
+// Usage: ./licensepp-replay <trace> [--threads <n>] [--speed recorded|max] [--repeat <n>] [--verbose]
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <license++/validation-recorder.h>
+#include "cli/licensing/license-manager.h"
+#include "src/utils.h"
+
+using namespace licensepp;
+
+static const char* kPlaceholderSignature = "licensepp-replay";
+
+struct ThreadResult
+{
+    std::vector<uint64_t> latencies;
+    uint64_t mismatches = 0;
+    uint64_t uncompared = 0;
+    uint64_t exceptions = 0;
+};
+
+static uint64_t percentile(const std::vector<uint64_t>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0;
+    }
+    const std::size_t index = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void printLatencies(const char* name, std::vector<uint64_t>& latencies)
+{
+    std::sort(latencies.begin(), latencies.end());
+    std::cout << name << " latency_us:"
+              << " p50=" << percentile(latencies, 50) / 1000.0
+              << " p90=" << percentile(latencies, 90) / 1000.0
+              << " p99=" << percentile(latencies, 99) / 1000.0
+              << " p99.9=" << percentile(latencies, 99.9) / 1000.0
+              << " max=" << (latencies.empty() ? 0 : latencies.back() / 1000.0) << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string traceFile;
+    unsigned int threadCount = 1;
+    bool recordedSpeed = false;
+    unsigned int repeat = 1;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "--threads" && i + 1 < argc) {
+            threadCount = std::max(1U, static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--speed" && i + 1 < argc) {
+            recordedSpeed = std::string(argv[++i]) == "recorded";
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1U, static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--help") {
+            std::cout << "USAGE: licensepp-replay <trace> [--threads <n>] [--speed recorded|max] [--repeat <n>] [--verbose]" << std::endl;
+            return 0;
+        } else {
+            traceFile = arg;
+        }
+    }
+    if (traceFile.empty()) {
+        std::cerr << "Please provide trace recorded by ValidationRecorder" << std::endl;
+        return 1;
+    }
+
+    try {
+        const ValidationTrace trace(traceFile);
+        const std::vector<ValidationTrace::Record>& records = trace.records();
+        if (!trace.complete()) {
+            std::cerr << "WARN: trace ends with partial record (recorder was not flushed?)" << std::endl;
+        }
+        if (records.empty()) {
+            std::cerr << "Trace has no validations" << std::endl;
+            return 1;
+        }
+
+        // licenses are parsed once, production validates already loaded licenses
+        std::vector<License> licenses(trace.blobs().size());
+        for (std::size_t i = 0; i < licenses.size(); ++i) {
+            try {
+                licenses[i].load(trace.blobs()[i]);
+            } catch (const LicenseException&) {
+                // replayed as is, validation fails like it did when recorded
+            }
+        }
+
+        const uint64_t firstTimestamp = records.front().timestampUs;
+        const uint64_t recordedSpan = records.back().timestampUs - firstTimestamp + 1;
+        const std::size_t total = records.size() * repeat;
+
+        LicenseManager licenseManager;
+        std::streambuf* cerrBuffer = std::cerr.rdbuf();
+        if (!verbose) {
+            // validate() reports failures (expired etc.) on stderr
+            std::cerr.rdbuf(nullptr);
+        }
+
+        std::atomic<std::size_t> next(0);
+        std::vector<ThreadResult> results(threadCount);
+        std::vector<std::thread> threads;
+        const auto started = std::chrono::steady_clock::now();
+        for (unsigned int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&, t]() {
+                ThreadResult& result = results[t];
+                result.latencies.reserve(total / threadCount + 1);
+                for (std::size_t i = next++; i < total; i = next++) {
+                    const ValidationTrace::Record& record = records[i % records.size()];
+                    if (recordedSpeed) {
+                        const uint64_t offset = (i / records.size()) * recordedSpan + record.timestampUs - firstTimestamp;
+                        std::this_thread::sleep_until(started + std::chrono::microseconds(offset));
+                    }
+                    Utils::setThreadClock(record.clock);
+                    const bool compared = !(record.verifyLicenseeSignature && record.licenseeSignatureGiven);
+                    const std::string signature = compared ? "" : kPlaceholderSignature;
+                    ValidationRecorder::Result replayed = ValidationRecorder::Exception;
+                    const auto begin = std::chrono::steady_clock::now();
+                    try {
+                        replayed = licenseManager.validate(&licenses[record.blobId], record.verifyLicenseeSignature, signature)
+                                ? ValidationRecorder::Valid : ValidationRecorder::Invalid;
+                    } catch (const std::exception&) {
+                        ++result.exceptions;
+                    }
+                    result.latencies.push_back(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                   std::chrono::steady_clock::now() - begin).count()));
+                    if (!compared) {
+                        ++result.uncompared;
+                    } else if (replayed != record.result) {
+                        ++result.mismatches;
+                    }
+                }
+                Utils::setThreadClock(0);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cerr.rdbuf(cerrBuffer);
+
+        ThreadResult merged;
+        for (auto& result : results) {
+            merged.latencies.insert(merged.latencies.end(), result.latencies.begin(), result.latencies.end());
+            merged.mismatches += result.mismatches;
+            merged.uncompared += result.uncompared;
+            merged.exceptions += result.exceptions;
+        }
+        std::vector<uint64_t> recordedLatencies;
+        recordedLatencies.reserve(records.size());
+        for (const auto& record : records) {
+            recordedLatencies.push_back(record.latencyNs);
+        }
+
+        std::cout << "replayed " << total << " validations of " << licenses.size() << " licenses with "
+                  << threadCount << " thread(s) at " << (recordedSpeed ? "recorded" : "maximum") << " speed" << std::endl;
+        std::cout << "seconds=" << seconds << " validations_per_second=" << (total / seconds) << std::endl;
+        printLatencies("replayed", merged.latencies);
+        printLatencies("recorded", recordedLatencies);
+        std::cout << "result_mismatches=" << merged.mismatches << " not_compared=" << merged.uncompared
+                  << " exceptions=" << merged.exceptions << std::endl;
+        return merged.mismatches == 0 ? 0 : 2;
+    } catch (const LicenseException& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  verify-issuance-log.cc
+//  License++ issuance log verification
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Checks hash chain of issuance log written by IssuanceLog (BaseLicenseManager::setIssuanceLog())
+// and prints number of records and head hash. Give head printed by earlier run with --head to
+// also check that records up to it are still in the log (i.e, log was not cut or rewritten).
+// Exits with 1 if log is invalid.
+//
+// Usage: ./licensepp-verify-issuance-log <log> [--head <hash>] [--verbose]
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <license++/issuance-log.h>
+
+using namespace licensepp;
+
+int main(int argc, char* argv[])
+{
+    std::string path;
+    std::string anchoredHead;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "--head" && i + 1 < argc) {
+            anchoredHead = argv[++i];
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--help") {
+            std::cout << "USAGE: licensepp-verify-issuance-log <log> [--head <hash>] [--verbose]" << std::endl;
+            return 0;
+        } else {
+            path = arg;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "No log given" << std::endl;
+        return 1;
+    }
+
+    std::vector<IssuanceLog::Record> records;
+    const IssuanceLog::Verification verification = IssuanceLog::verify(path, &records);
+    if (verbose) {
+        for (const IssuanceLog::Record& record : records) {
+            std::cout << record.sequence << " logged_at_us=" << record.loggedAtUs
+                      << " authority=" << record.issuingAuthorityId
+                      << " licensee=" << record.licensee
+                      << " issued=" << record.issueDate
+                      << " expires=" << record.expiryDate
+                      << " fingerprint=" << record.fingerprint
+                      << " hash=" << record.hash << std::endl;
+        }
+    }
+    if (verification.head.empty()) {
+        // could not be read at all
+        std::cerr << path << ": " << verification.error << std::endl;
+        return 1;
+    }
+    std::cout << "records=" << verification.records << " head=" << verification.head << std::endl;
+    if (!verification.valid) {
+        std::cerr << path << ": " << verification.error << " at offset " << verification.brokenAt
+                  << " (after record " << verification.records << ")" << std::endl;
+        return 1;
+    }
+    if (!anchoredHead.empty()) {
+        bool found = false;
+        for (const IssuanceLog::Record& record : records) {
+            found = found || record.hash == anchoredHead;
+        }
+        if (!found) {
+            std::cerr << path << ": head " << anchoredHead << " is not in the log" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+//
+//  verifyd.cc
+//  License++ verification daemon
+//
+//  Copyright © 2018-present @abumq (Majid Q.)
+//
+//  See https://github.com/abumq/licensepp/blob/master/LICENSE
+//
+// Keeps parsed authority keys and verified licenses in memory and answers
+// VerifyClient requests over UNIX socket. Like the CLI, the daemon is linked
+// with your key register (see cli/licensing/license-manager-key-register.cc)
+//
+// Usage: ./licensepp-verifyd [--socket <path>] [--cache-size <entries>] [--socket-mode <octal>]
+//                            [--max-connections <n>]
+//
+// Socket is 0660 by default, i.e, only processes of daemon user and group may connect.
+//
+
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <license++/verify-client.h>
+#include "cli/licensing/license-manager.h"
+#include "src/verify-server.h"
+
+static licensepp::VerifyServer* s_server = nullptr;
+
+static void handleSignal(int)
+{
+    if (s_server != nullptr) {
+        s_server->stop();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::string socketPath = licensepp::VerifyClient::kDefaultSocketPath;
+    std::size_t cacheSize = 4096;
+    unsigned int socketMode = licensepp::SocketServer::kDefaultSocketMode;
+    std::size_t maxConnections = licensepp::SocketServer::kDefaultMaxConnections;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg(argv[i]);
+        if (arg == "--socket" && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (arg == "--cache-size" && i + 1 < argc) {
+            cacheSize = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--socket-mode" && i + 1 < argc) {
+            socketMode = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 8));
+        } else if (arg == "--max-connections" && i + 1 < argc) {
+            maxConnections = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--help") {
+            std::cout << "USAGE: licensepp-verifyd [--socket <path>] [--cache-size <entries>] [--socket-mode <octal>]"
+                         " [--max-connections <n>]" << std::endl;
+            return 0;
+        }
+    }
+
+    LicenseManager licenseManager;
+    licensepp::VerifyServer server(socketPath, [&](const licensepp::License& license,
+                                                   bool verifyLicenseeSignature,
+                                                   const std::string& licenseeSignature) {
+        return licenseManager.validate(&license, verifyLicenseeSignature, licenseeSignature);
+    }, cacheSize, socketMode, maxConnections);
+
+    if (!server.start()) {
+        return 1;
+    }
+    s_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    std::cout << "licensepp-verifyd listening on " << socketPath << std::endl;
+    server.run();
+    std::cout << "licensepp-verifyd stopped after " << server.requests() << " requests ("
+              << server.cacheHits() << " cache hits)" << std::endl;
+    s_server = nullptr;
+    return 0;
+}